@@ -27,6 +27,7 @@ struct HeteroduplexSettings
         static constexpr int MINIMUM_PER_STRAND_SUBREAD_COVERAGE = 5;
         static constexpr bool SKIP_DELETIONS = true;
         static constexpr double ADJACENT_INSERTION_THRESHOLD = 0.75;
+        static constexpr unsigned int NUM_THREADS = 1;
     };
     // clang-format on
 
@@ -39,6 +40,8 @@ struct HeteroduplexSettings
     int MinimumPerStrandSubreadCoverage = Defaults::MINIMUM_PER_STRAND_SUBREAD_COVERAGE;
     bool SkipDeletions = Defaults::SKIP_DELETIONS;
     double AdjacentInsertionThreshold = Defaults::ADJACENT_INSERTION_THRESHOLD;
+    // pileup threads per strand, 0 for all available
+    unsigned int NumThreads = Defaults::NUM_THREADS;
 };
 
 struct HeteroduplexResults
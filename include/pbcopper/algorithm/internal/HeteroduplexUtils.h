@@ -6,11 +6,13 @@
 #include <pbcopper/data/Cigar.h>
 
 #include <array>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -73,6 +75,74 @@ struct StrandCounts
 // gather mismatches, base counts, etc for a single strand
 StrandRawData CalculateStrandRawData(const std::string& reference, const StrandInput& input);
 
+// add mismatches, base counts, etc from 'input' to 'result'
+void AddStrandRawData(const std::string& reference, const StrandInput& input,
+                      StrandRawData& result);
+
+// ----------------
+// pileup
+// ----------------
+
+///
+/// Number of reads with insertion 'Sequence' before a reference position
+///
+struct InsertionTally
+{
+    std::string_view Sequence;
+    int Count;
+};
+
+///
+/// Pileup of a single strand, with the same counts as StrandRawData.
+///
+/// Base counts are stored column-major (one array per base), so match runs
+/// are counted 16 bases at a time. Identical insertions are tallied rather
+/// than stored per read. Reads are split across up to 'numThreads' threads
+/// (0 for all available), each filling a partial pileup that is summed at
+/// the end.
+///
+/// Bases other than ACGT- (e.g. N) count towards coverage only.
+///
+class StrandPileup
+{
+public:
+    /// \throws std::runtime_error on unsupported CIGAR operations
+    StrandPileup(std::size_t refLength, const StrandInput& input, unsigned int numThreads = 1);
+
+    std::size_t Size() const noexcept { return numReads_.size(); }
+
+    /// \returns number of reads covering 'pos', including deletions
+    int NumReads(const std::size_t pos) const noexcept { return numReads_[pos]; }
+
+    BaseCount BaseCounts(const std::size_t pos) const noexcept
+    {
+        return {counts_[0][pos], counts_[1][pos], counts_[2][pos], counts_[3][pos],
+                counts_[4][pos]};
+    }
+
+    /// \returns true if any read has a mismatch or deletion at 'pos'
+    bool PotentialMismatch(const std::size_t pos) const noexcept
+    {
+        return potentialMismatches_[pos] != 0;
+    }
+
+    /// \returns distinct insertions before 'pos', in lexical order
+    std::span<const InsertionTally> Insertions(const std::size_t pos) const noexcept
+    {
+        return std::span<const InsertionTally>{insertions_}.subspan(
+            insertionOffsets_[pos], insertionOffsets_[pos + 1] - insertionOffsets_[pos]);
+    }
+
+private:
+    std::vector<int> numReads_;
+    std::array<std::vector<int>, 5> counts_;  // counts_[base][pos], order as BaseCount
+    std::vector<std::uint8_t> potentialMismatches_;
+
+    // tallies of position i are insertions_[insertionOffsets_[i], insertionOffsets_[i + 1])
+    std::vector<std::uint32_t> insertionOffsets_;
+    std::vector<InsertionTally> insertions_;
+};
+
 }  // namespace internal
 }  // namespace Algorithm
 }  // namespace PacBio
@@ -29,10 +29,41 @@ enum struct AlignMode
     LOCAL = 2        // Local in both sequences
 };
 
+//
+// Dynamic programming kernel, for aligners that provide more than one.
+// Both produce identical alignments.
+//
+enum struct AlignKernel
+{
+    SCALAR = 0,  // one matrix cell at a time
+    SIMD = 1     // vectorized along the query (used by PoaGraph)
+};
+
+//
+// Adaptive band, for aligners that support it (PoaGraph, when no range finder
+// is given). Each DP column spans Width + WidthFraction * (query length) rows
+// either side of where its predecessors scored best, and twice that on a side
+// where the best score came close to the predecessor's band edge. Under local
+// alignment, reads must align from near the start of the band (so not, e.g.,
+// staggered reads); use a range finder for those.
+//
+struct AlignBand
+{
+    int Width = -1;  // negative: unbanded
+    float WidthFraction = 0.01F;
+
+    bool IsEnabled() const { return Width >= 0; }
+
+    // 10 rows + 1% of the query either side
+    static AlignBand Default();
+};
+
 struct AlignConfig
 {
     AlignParams Params;
     AlignMode Mode;
+    AlignKernel Kernel = AlignKernel::SCALAR;
+    AlignBand Band{};
 
     // edit distance params, global alignment mode
     static AlignConfig Default();
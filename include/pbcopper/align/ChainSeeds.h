@@ -4,6 +4,7 @@
 #include <pbcopper/PbcopperConfig.h>
 
 #include <pbcopper/align/ChainSeedsConfig.h>
+#include <pbcopper/align/SeedArray.h>
 #include <pbcopper/align/Seeds.h>
 
 #include <map>
@@ -13,6 +14,8 @@
 #include <utility>
 #include <vector>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace Align {
 
@@ -243,6 +246,61 @@ std::vector<Seeds> ChainedSeedSets(const Seeds& seedSet, const ChainSeedsConfig&
 std::vector<std::pair<std::size_t, Seeds>> ChainSeeds(std::map<std::size_t, Seeds> seedSets,
                                                       ChainSeedsConfig config);
 
+/// Search a flat array of seeds for the best numCandidates non-overlapping
+/// chains, with a bounded-lookback dynamic program (as in minimap2) instead
+/// of the tree-based sweeps of ChainSeeds. Seeds are sorted by HVCompare, and
+/// each seed may extend the best-scoring chain ending at one of the
+/// config.maxLookback seeds before it that lie strictly up-left of it and
+/// within config.maxSeedGap query bases. Links are scored with LinkScore.
+/// Avoids the per-seed node allocations of ChainSeeds, at the cost of only
+/// considering nearby predecessors.
+///
+/// Chains are reported from the best-scoring end seed down, each seed
+/// belonging to at most one chain: a chain reaching a seed already used by a
+/// better chain is cut there, and kept only if its remaining score is still at
+/// least config.minScore.
+///
+/// \param  seeds   The seeds to search for chains in
+/// \param  config  Provides scoring values to use when chaining
+///
+/// \return  A vector of Seed vectors containing locally chained seeds, best first.
+///
+std::vector<std::vector<Seed>> ChainSeedsFlat(std::vector<Seed> seeds,
+                                              const ChainSeedsConfig& config);
+
+/// Search a Seed set for the best numCandidates non-overlapping chains, as the
+/// std::vector<Seed> overload.
+///
+/// \param  seedSet The Seeds set to search for chains in
+/// \param  config  Provides scoring values to use when chaining
+///
+/// \return  A vector of Seed vectors containing locally chained seeds, best first.
+///
+std::vector<std::vector<Seed>> ChainSeedsFlat(const Seeds& seedSet, const ChainSeedsConfig& config);
+
+/// Search multiple Seed sets for the best numCandidates non-overlapping chains
+/// across all of them, as the std::vector<Seed> overload.
+///
+/// \param  seedSets  Seed sets, keyed by reference index
+/// \param  config    Provides scoring values to use when chaining
+///
+/// \return  A vector of (reference index, chained seeds), best first.
+///
+std::vector<std::pair<std::size_t, Seeds>> ChainSeedsFlat(
+    const std::map<std::size_t, Seeds>& seedSets, const ChainSeedsConfig& config);
+
+/// Search a SeedArray for the best numCandidates non-overlapping chains across
+/// all of its references, as the std::vector<Seed> overload. Unlike the map
+/// overload, no Seeds trees are built on either side of the chaining.
+///
+/// \param  seeds   The seeds to search for chains in, sorted if not already
+/// \param  config  Provides scoring values to use when chaining
+///
+/// \return  A vector of (reference index, chained seeds in order), best first.
+///
+std::vector<std::pair<std::size_t, std::vector<Seed>>> ChainSeedsFlat(
+    SeedArray* seeds, const ChainSeedsConfig& config);
+
 }  // namespace Align
 }  // namespace PacBio
 
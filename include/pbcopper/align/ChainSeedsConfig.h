@@ -30,6 +30,10 @@ struct ChainSeedsConfig
     int insertionPenalty = -4;
     int deletionPenalty = -8;
     int maxSeedGap = 200;
+
+    // ChainSeedsFlat only: number of preceding seeds (in query order) that
+    // are considered as chain predecessors
+    std::size_t maxLookback = 50;
 };
 }  // namespace Align
 }  // namespace PacBio
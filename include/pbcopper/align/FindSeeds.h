@@ -3,6 +3,7 @@
 
 #include <pbcopper/PbcopperConfig.h>
 
+#include <pbcopper/align/SeedArray.h>
 #include <pbcopper/align/Seeds.h>
 
 #include <map>
@@ -46,6 +47,7 @@ namespace PacBio {
 
 namespace QGram {
 class Index;
+class MinimizerIndex;
 }  // namespace QGram
 
 namespace Align {
@@ -117,6 +119,88 @@ std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const
 ///
 std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const std::string& seq);
 
+/// Find all matching seeds between the minimizers of a query sequence and the
+/// sequences represented in a minimizer index. Seeds have length k and are
+/// reported only at minimizer positions, so they are sparser than those from a
+/// QGram::Index. In addition the query sequence may itself be in the index, in
+/// which case we pass in it's known index so we do not count it.
+///
+/// \param[in]  index               The minimizer index on the reference sequence(s)
+/// \param[in]  seq                 The query sequence
+/// \param[in]  qIdx                (optional) The index of the query sequence, so it can be ignored
+/// \param[in]  filterHomopolymers  If true, homopolymer k-mers will be filtered before searching the index.
+///
+/// \return map containing Seeds for each referenceIndex with a hit
+///
+std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::MinimizerIndex& index,
+                                       const std::string& seq, std::optional<std::size_t> qIdx,
+                                       bool filterHomopolymers);
+
+/// Find all matching seeds between the minimizers of a query sequence and the
+/// sequences represented in a minimizer index.
+///
+/// This overload enables homopolymer-filtering when FILTERHOMOPOLYMERS is defined.
+///
+/// \param[in]  index  The minimizer index on the reference sequence(s)
+/// \param[in]  seq    The query sequence
+///
+/// \return  map containing Seeds for each referenceIndex with a hit
+///
+std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::MinimizerIndex& index,
+                                       const std::string& seq);
+
+/// Find all matching seeds between a DNA index and the sequences
+/// represented in some supplied index, appending them to a flat SeedArray
+/// rather than to a map of Seeds. Hits cost an append instead of a tree node
+/// insertion, and are only grouped by reference once the array is sorted.
+/// Seeds are merged on sort if the array was constructed with mergeOnSort.
+///
+/// \param[in]  index               The hashed index on the reference sequence(s)
+/// \param[in]  seq                 The query sequence
+/// \param[out] seeds               Receives the seeds, tagged with their referenceIndex
+/// \param[in]  qIdx                (optional) The index of the query sequence, so it can be ignored
+/// \param[in]  filterHomopolymers  If true, homopolymer k-mers will be filtered before searching the index.
+///
+void FindSeeds(const PacBio::QGram::Index& index, const std::string& seq, SeedArray* seeds,
+               std::optional<std::size_t> qIdx, bool filterHomopolymers);
+
+/// Find all matching seeds between a DNA index and the sequences
+/// represented in some supplied index, appending them to a flat SeedArray.
+///
+/// This overload enables homopolymer-filtering when FILTERHOMOPOLYMERS is defined.
+///
+/// \param[in]  index  The hashed index on the reference sequence(s)
+/// \param[in]  seq    The query sequence
+/// \param[out] seeds  Receives the seeds, tagged with their referenceIndex
+///
+void FindSeeds(const PacBio::QGram::Index& index, const std::string& seq, SeedArray* seeds);
+
+/// Find all matching seeds between the minimizers of a query sequence and the
+/// sequences represented in a minimizer index, appending them to a flat
+/// SeedArray.
+///
+/// \param[in]  index               The minimizer index on the reference sequence(s)
+/// \param[in]  seq                 The query sequence
+/// \param[out] seeds               Receives the seeds, tagged with their referenceIndex
+/// \param[in]  qIdx                (optional) The index of the query sequence, so it can be ignored
+/// \param[in]  filterHomopolymers  If true, homopolymer k-mers will be filtered before searching the index.
+///
+void FindSeeds(const PacBio::QGram::MinimizerIndex& index, const std::string& seq, SeedArray* seeds,
+               std::optional<std::size_t> qIdx, bool filterHomopolymers);
+
+/// Find all matching seeds between the minimizers of a query sequence and the
+/// sequences represented in a minimizer index, appending them to a flat
+/// SeedArray.
+///
+/// This overload enables homopolymer-filtering when FILTERHOMOPOLYMERS is defined.
+///
+/// \param[in]  index  The minimizer index on the reference sequence(s)
+/// \param[in]  seq    The query sequence
+/// \param[out] seeds  Receives the seeds, tagged with their referenceIndex
+///
+void FindSeeds(const PacBio::QGram::MinimizerIndex& index, const std::string& seq,
+               SeedArray* seeds);
+
 /// Find all matching seeds between two DNA sequences
 ///
 /// \param[in]  qGramSize           qgram size to use for index hashing
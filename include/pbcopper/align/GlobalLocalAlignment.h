@@ -9,6 +9,10 @@ namespace PacBio {
 namespace Align {
 
 // Scores and penalties
+//
+// If the scores describe a scaled unit-cost edit distance, e.g. {0, -1, -1, -1, -1, -1},
+// GlobalLocalAlign transparently switches to a bit-parallel (Myers/Hyyro) kernel.
+// This requires BranchPenalty == InsertionPenalty and MergePenalty == DeletionPenalty.
 struct GlobalLocalParameters
 {
     std::int32_t MatchScore{};
@@ -29,6 +33,7 @@ struct GlobalLocalResult
 struct GlobalLocalStorage
 {
     std::vector<std::int32_t> Columns;
+    std::vector<std::uint64_t> BitVectors;
 };
 
 /// \brief Align a known query against read given the parameters.
@@ -48,6 +48,19 @@ private:
     std::string cigarString_;
 };
 
+///
+/// SIMD instruction set used by LocalAlign. AUTO selects the widest one
+/// supported by the CPU at runtime; requesting an unsupported one falls back
+/// to the widest supported. Results do not depend on the instruction set.
+///
+enum class LocalAlignSimd : std::uint8_t
+{
+    AUTO = 0,
+    SSE2 = 16,
+    AVX2 = 32,
+    AVX512BW = 64,
+};
+
 struct LocalAlignConfig
 {
 public:
@@ -55,6 +68,7 @@ public:
     std::uint8_t MismatchPenalty;
     std::uint8_t GapOpenPenalty;
     std::uint8_t GapExtendPenalty;
+    LocalAlignSimd Simd = LocalAlignSimd::AUTO;
 
 public:
     static LocalAlignConfig Default();
@@ -0,0 +1,130 @@
+#ifndef PBCOPPER_ALIGN_SEEDARRAY_H
+#define PBCOPPER_ALIGN_SEEDARRAY_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/align/Seed.h>
+#include <pbcopper/align/Seeds.h>
+
+#include <map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Align {
+
+///
+/// \brief The SeedArray class is a flat container of seeds against one or more
+///        reference sequences.
+///
+/// Unlike Seeds, which keeps every seed in a std::multiset node, seeds are
+/// appended to parallel arrays of positions (struct-of-arrays) and only
+/// ordered, by (reference, begin H, begin V), on the first call that needs
+/// it. When constructed with 'mergeOnSort', seeds on the same diagonal that
+/// overlap or abut are merged into one while sorting. Unlike
+/// Seeds::TryMergeSeed, seeds on different diagonals are never merged.
+///
+/// Seeds carry no query index, so a SeedArray holds the seeds of a single
+/// query. To reuse its storage for the next query, clear() it first.
+///
+/// Element accessors index seeds in insertion order until the array is
+/// sorted, and in sorted order afterwards.
+///
+class SeedArray
+{
+public:
+    ///
+    /// \brief The Range struct marks the seeds [begin, end) of one reference,
+    ///        in a sorted SeedArray.
+    ///
+    struct Range
+    {
+        std::size_t referenceIdx;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+public:
+    explicit SeedArray(bool mergeOnSort = false);
+
+public:
+    ///
+    /// \brief Add
+    ///
+    /// Appends a seed of 'seedLength' bases, invalidating the sort order.
+    ///
+    void Add(std::size_t referenceIdx, std::uint64_t beginPosH, std::uint64_t beginPosV,
+             std::uint64_t seedLength);
+
+    ///
+    /// \brief Add
+    ///
+    /// Appends the positions of 'seed', invalidating the sort order.
+    ///
+    void Add(std::size_t referenceIdx, const Seed& seed);
+
+    ///
+    /// \brief Sort
+    ///
+    /// Orders seeds by (reference, begin H, begin V), merging them first if
+    /// requested at construction. No-op if already sorted.
+    ///
+    void Sort();
+
+    ///
+    /// \brief ReferenceRanges
+    /// \return the run of seeds for each reference with a hit, by increasing
+    ///         reference index (sorts first, if needed)
+    ///
+    std::vector<Range> ReferenceRanges();
+
+    ///
+    /// \brief Slice
+    /// \return seeds [range.begin, range.end) as Seed objects
+    ///
+    std::vector<Seed> Slice(const Range& range) const;
+
+    ///
+    /// \brief ToSeeds
+    /// \return seeds keyed by reference index, as returned by the map-based
+    ///         FindSeeds (sorts first, if needed)
+    ///
+    std::map<std::size_t, Seeds> ToSeeds();
+
+public:
+    Seed operator[](std::size_t i) const;
+    std::size_t ReferenceIndex(std::size_t i) const;
+    std::uint64_t BeginPositionH(std::size_t i) const;
+    std::uint64_t BeginPositionV(std::size_t i) const;
+    std::uint64_t EndPositionH(std::size_t i) const;
+    std::uint64_t EndPositionV(std::size_t i) const;
+
+    bool IsSorted() const;
+    bool MergeOnSort() const;
+
+    void clear();
+    void reserve(std::size_t n);
+    std::size_t capacity() const;
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    void Merge();
+    void Permute(const std::vector<std::size_t>& order);
+
+private:
+    bool mergeOnSort_;
+    bool sorted_ = true;
+    std::vector<std::uint32_t> referenceIdx_;
+    std::vector<std::uint64_t> beginH_;
+    std::vector<std::uint64_t> beginV_;
+    std::vector<std::uint64_t> endH_;
+    std::vector<std::uint64_t> endV_;
+};
+
+}  // namespace Align
+}  // namespace PacBio
+
+#endif  // PBCOPPER_ALIGN_SEEDARRAY_H
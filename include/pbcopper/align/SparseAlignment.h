@@ -10,6 +10,11 @@
 #include <vector>
 
 namespace PacBio {
+
+namespace QGram {
+class MinimizerIndex;
+}  // namespace QGram
+
 namespace Align {
 
 /// \brief Generate an SDP alignment from two sequences
@@ -37,6 +42,33 @@ std::vector<Seed> SparseAlignSeeds(std::size_t qGramSize, const std::string& seq
 std::vector<Seed> SparseAlignSeeds(std::size_t qGramSize, const std::string& seq1,
                                    const std::string& seq2);
 
+/// \brief Generate an SDP alignment from a query sequence and one sequence of a
+///        pre-built minimizer index (e.g. a long reference).
+///
+/// \param[in] index        minimizer index on the reference sequence(s)
+/// \param[in] refIdx       index number of the reference sequence to align to
+/// \param[in] seq1         The query sequence
+/// \param[in] filterHomopolymers If true, homopolymer k-mers will be filtered before searching the index.
+///
+/// \returns   The SDP alignment as a vector of Seeds
+///
+std::vector<Seed> SparseAlignSeeds(const QGram::MinimizerIndex& index, std::size_t refIdx,
+                                   const std::string& seq1, bool filterHomopolymers);
+
+/// \brief Generate an SDP alignment from a query sequence and one sequence of a
+///        pre-built minimizer index (e.g. a long reference).
+///
+/// This overload enables homopolymer-filtering when FILTERHOMOPOLYMERS is defined.
+///
+/// \param[in] index        minimizer index on the reference sequence(s)
+/// \param[in] refIdx       index number of the reference sequence to align to
+/// \param[in] seq1         The query sequence
+///
+/// \returns   The SDP alignment as a vector of Seeds
+///
+std::vector<Seed> SparseAlignSeeds(const QGram::MinimizerIndex& index, std::size_t refIdx,
+                                   const std::string& seq1);
+
 /// \brief Generate an SDP alignment from the best orientation of two sequences
 ///
 /// \param[in] seq1   The query sequence as a DnaString
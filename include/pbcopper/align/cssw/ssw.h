@@ -77,6 +77,21 @@ extern "C"
     s_profile* ssw_init(const int8_t* read, const int32_t readLen, const int8_t* mat,
                         const int32_t n, const int8_t score_size);
 
+    /*!	@function	Create the query profile for a specific SIMD register width.
+	@param	simd_width	register width in bytes: 16 (SSE2), 32 (AVX2), 64 (AVX-512BW) or 0 for the widest width supported by
+						the CPU; widths not supported by the CPU are reduced to the widest supported one
+	@return	pointer to the query profile structure
+	@note	All other parameters are identical to ssw_init, which is equivalent to simd_width == 0. The alignment results do
+			not depend on the SIMD register width.
+*/
+    s_profile* ssw_init_simd(const int8_t* read, const int32_t readLen, const int8_t* mat,
+                             const int32_t n, const int8_t score_size, int32_t simd_width);
+
+    /*!	@function	Widest SIMD register width in bytes supported by the CPU, detected at runtime.
+	@return	64 if AVX-512BW is available, 32 if AVX2 is available, 16 (SSE2) otherwise
+*/
+    int32_t ssw_simd_width(void);
+
     /*!	@function	Release the memory allocated by function ssw_init.
 	@param	p	pointer to the query profile structure
 */
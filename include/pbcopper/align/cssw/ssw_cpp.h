@@ -121,6 +121,14 @@ public:
         gap_extending_penalty_ = extending;
     };
 
+    // =========
+    // @function Set the SIMD register width in bytes used for aligning
+    //             16: SSE2, 32: AVX2, 64: AVX-512BW
+    //           [NOTICE] The default 0 selects the widest width supported
+    //                    by the CPU, wider widths are reduced to it.
+    // =========
+    void SetSimdWidth(const int& width) { simd_width_ = width; };
+
     // =========
     // @function Align the query againt the reference that is set by
     //             SetReferenceSequence.
@@ -187,6 +195,8 @@ private:
     std::int8_t* translated_reference_;
     std::int32_t reference_length_;
 
+    int simd_width_;  // default: 0, widest supported
+
     int TranslateBase(const char* bases, const int& length, std::int8_t* translated) const;
     void SetAllDefault(void);
     void BuildDefaultMatrix(void);
@@ -14,7 +14,8 @@
 #include <utility>
 #include <vector>
 
-#include <cfloat>
+#include <cstddef>
+#include <cstdint>
 
 namespace PacBio {
 namespace Align {
@@ -32,16 +33,37 @@ struct AlignInput
     std::size_t qLen;
 };
 
+///
+/// \brief The BlockScores struct holds the scoring parameters of a
+///        BandedChainAlignConfig, converted to an alignment block's score type.
+///
+template <typename Score>
+struct BlockScores
+{
+    Score match;
+    Score mismatch;
+    Score gapOpen;
+    Score gapExtend;
+
+    static BlockScores FromConfig(const BandedChainAlignConfig& config);
+};
+
 ///
 /// \brief The BandedGlobalAlignBlock class provides a reusable alignment
 ///        matrix for performing a banded, global alignment.
 ///
+/// Rows within the band are filled with a vectorized kernel when Score is
+/// std::int32_t (only valid for integral scoring parameters), and with scalar
+/// recurrences when Score is float. Both yield identical transcripts.
+///
 /// \note Currently only intended for use within the BandeChainAlign algorithm.
 ///
+template <typename Score>
 class BandedGlobalAlignBlock
 {
 public:
-    BandedGlobalAlignBlock(const BandedChainAlignConfig& config) : config_(config)  // icc 17 hack
+    BandedGlobalAlignBlock(const BandedChainAlignConfig& config)
+        : config_(config), scores_{BlockScores<Score>::FromConfig(config)}  // icc 17 hack
     {}
 
 public:
@@ -69,6 +91,7 @@ private:
 
 private:
     BandedChainAlignConfig config_;
+    BlockScores<Score> scores_;
 
     ///
     /// \brief The LookupElement struct helps provide mappings from the 2-D
@@ -89,20 +112,25 @@ private:
 
     std::vector<LookupElement> lookup_;
 
-    std::vector<float> matchScores_;
-    std::vector<float> gapScores_;
+    std::vector<Score> matchScores_;
+    std::vector<Score> gapScores_;
 };
 
 ///
 /// \brief The StandardGlobalAlignBlock class probides a reusable alignment
 ///        matrix for standard (non-banded) global alignment.
 ///
+/// Scores are kept in flat, row-major storage that is only ever grown, so
+/// consecutive gap blocks reuse the same allocation.
+///
 /// \note Currently only intended for use within the BandeChainAlign algorithm.
 ///
+template <typename Score>
 class StandardGlobalAlignBlock
 {
 public:
-    StandardGlobalAlignBlock(const BandedChainAlignConfig& config) : config_(config)  // icc 17 hack
+    StandardGlobalAlignBlock(const BandedChainAlignConfig& config)
+        : config_(config), scores_{BlockScores<Score>::FromConfig(config)}  // icc 17 hack
     {}
 
 public:
@@ -123,16 +151,26 @@ public:
 private:
     std::pair<std::size_t, std::size_t> BacktraceStart(std::size_t tLen, std::size_t qLen) const;
 
+    std::size_t IndexFor(std::size_t i, std::size_t j) const;
+
     void Init(std::size_t tLen, std::size_t qLen);
 
 private:
     BandedChainAlignConfig config_;
+    BlockScores<Score> scores_;
 
-    using Matrix_t = std::vector<std::vector<float>>;
-    Matrix_t matchScores_;
-    Matrix_t gapScores_;
+    std::size_t stride_ = 0;
+    std::vector<Score> matchScores_;
+    std::vector<Score> gapScores_;
 };
 
+extern template struct BlockScores<float>;
+extern template struct BlockScores<std::int32_t>;
+extern template class BandedGlobalAlignBlock<float>;
+extern template class BandedGlobalAlignBlock<std::int32_t>;
+extern template class StandardGlobalAlignBlock<float>;
+extern template class StandardGlobalAlignBlock<std::int32_t>;
+
 }  // namespace Internal
 }  // namespace Align
 }  // namespace PacBio
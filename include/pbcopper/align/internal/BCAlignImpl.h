@@ -47,6 +47,8 @@ private:
 
     void AlignSeedBlock(const PacBio::Align::Seed& seed);
 
+    bool UseIntegerBlocks(std::size_t hLength, std::size_t vLength) const;
+
     void Initialize(const char* target, std::size_t targetLen, const char* query,
                     std::size_t queryLen);
 
@@ -57,8 +59,12 @@ private:
 private:
     const BandedChainAlignConfig& config_;
 
-    StandardGlobalAlignBlock gapBlock_;
-    BandedGlobalAlignBlock seedBlock_;
+    // integer (vectorized) blocks are used whenever the scoring parameters
+    // allow it, float blocks otherwise
+    StandardGlobalAlignBlock<std::int32_t> gapBlock_;
+    BandedGlobalAlignBlock<std::int32_t> seedBlock_;
+    StandardGlobalAlignBlock<float> floatGapBlock_;
+    BandedGlobalAlignBlock<float> floatSeedBlock_;
     std::string globalTranscript_;
     std::int64_t globalScore_;
     std::size_t gapBlockBeginH_;
@@ -0,0 +1,257 @@
+#ifndef PBCOPPER_CONTAINER_PACKEDDNASTRING_H
+#define PBCOPPER_CONTAINER_PACKEDDNASTRING_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include "BitConversion.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PacBio {
+namespace Container {
+
+///
+/// PackedDNAStringView is a read-only window [pos, pos + len) into a packed
+/// DNA string, without copying its data. It is invalidated by any change to
+/// the underlying string.
+///
+template <typename PackedString>
+class PackedDNAStringView
+{
+public:
+    PackedDNAStringView(const PackedString& str, const std::size_t pos,
+                        const std::size_t len) noexcept
+        : str_{&str}, pos_{pos}, len_{len}
+    {
+        assert(pos_ + len_ <= str_->Size());
+    }
+
+public:
+    std::size_t Size() const noexcept { return len_; }
+    bool Empty() const noexcept { return len_ == 0; }
+
+    char operator[](const std::size_t i) const noexcept
+    {
+        assert(i < len_);
+        return (*str_)[pos_ + i];
+    }
+
+    PackedDNAStringView Substr(const std::size_t pos, const std::size_t len) const noexcept
+    {
+        assert(pos <= len_);
+        return {*str_, pos_ + pos, std::min(len, len_ - pos)};
+    }
+
+    /// \returns the k-mer starting at 'pos' of the view, as
+    ///          PackedString::KMer
+    std::uint64_t KMer(const std::size_t pos, const std::int32_t k) const noexcept
+    {
+        assert(pos + k <= len_);
+        return str_->KMer(pos_ + pos, k);
+    }
+
+    std::string ToString() const { return str_->ToString(pos_, len_); }
+
+private:
+    const PackedString* str_;
+    std::size_t pos_;
+    std::size_t len_;
+};
+
+///
+/// PackedDNA2bitString is a growable nucleotide string stored at 2 bits per
+/// base (NCBI2na, see ConvertAsciiTo2bit), 4 bases per byte with the first
+/// base in the most significant bits, i.e. the layout of
+/// Utility::PackTwoBit. Runs of N are kept in a separate, sorted exception
+/// list and packed as A.
+///
+/// Input is case-insensitive and stored upper-case. Any base other than
+/// ACGTN throws std::invalid_argument, leaving the string unchanged.
+///
+class PackedDNA2bitString
+{
+public:
+    /// Run of consecutive Ns
+    struct NRun
+    {
+        std::size_t Start;
+        std::size_t Length;
+
+        bool operator==(const NRun&) const noexcept = default;
+    };
+
+public:
+    PackedDNA2bitString() = default;
+    explicit PackedDNA2bitString(std::string_view seq);
+
+public:
+    std::size_t Size() const noexcept { return size_; }
+    bool Empty() const noexcept { return size_ == 0; }
+
+    /// \returns 2-bit code of the i-th base, 0 (A) for N
+    std::uint8_t Code(const std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return (data_[i / 4] >> (6 - 2 * (i % 4))) & 0b11;
+    }
+
+    /// \returns true if the i-th base is N
+    bool IsN(std::size_t i) const noexcept;
+
+    /// \returns i-th base, in O(log #runs of N)
+    char operator[](const std::size_t i) const noexcept
+    {
+        return IsN(i) ? 'N' : Convert2bitToAscii(Code(i));
+    }
+
+    ///
+    /// \returns the 'k' (1 - 32) bases starting at 'pos' as 2-bit codes,
+    ///          first base in the most significant bits (the Pbmer::DnaBit
+    ///          layout). Ns count as A.
+    ///
+    std::uint64_t KMer(std::size_t pos, std::int32_t k) const noexcept;
+
+    ///
+    /// Calls 'callback(pos, kmer)' for each k-mer, as from KMer(), in a single
+    /// rolling pass. K-mers overlapping an N are skipped.
+    ///
+    template <typename Callback>
+    void ForEachKMer(std::int32_t k, Callback&& callback) const;
+
+    const std::vector<NRun>& NRuns() const noexcept { return nRuns_; }
+
+    /// \returns packed bases, (Size() + 3) / 4 bytes
+    std::span<const std::uint8_t> Data() const noexcept { return data_; }
+
+    PackedDNAStringView<PackedDNA2bitString> Substr(const std::size_t pos,
+                                                    const std::size_t len) const noexcept
+    {
+        assert(pos <= size_);
+        return {*this, pos, std::min(len, size_ - pos)};
+    }
+
+    std::string ToString() const { return ToString(0, size_); }
+    std::string ToString(std::size_t pos, std::size_t len) const;
+    explicit operator std::string() const { return ToString(); }
+
+public:
+    void Append(std::string_view seq);
+    void PushBack(char base);
+    void Reserve(std::size_t size);
+    void Clear() noexcept;
+
+    /// Reverse complement in place, a 64-bit word (32 bases) at a time
+    void ReverseComplement() noexcept;
+
+public:
+    bool operator==(const PackedDNA2bitString&) const noexcept = default;
+
+private:
+    void AppendN(std::size_t length);
+
+private:
+    std::vector<std::uint8_t> data_;
+    std::size_t size_ = 0;
+    std::vector<NRun> nRuns_;
+};
+
+template <typename Callback>
+void PackedDNA2bitString::ForEachKMer(const std::int32_t k, Callback&& callback) const
+{
+    assert(k > 0 && k <= 32);
+    const std::size_t length = k;
+    if (size_ < length) {
+        return;
+    }
+
+    const std::uint64_t mask = (k == 32) ? ~std::uint64_t{0} : ((std::uint64_t{1} << (2 * k)) - 1);
+    std::uint64_t kmer = 0;
+    auto nRun = nRuns_.cbegin();
+    std::size_t validFrom = 0;  // first position of a k-mer not overlapping an N
+    for (std::size_t i = 0; i < size_; ++i) {
+        kmer = ((kmer << 2) | Code(i)) & mask;
+        if (nRun != nRuns_.cend() && i == nRun->Start) {
+            validFrom = nRun->Start + nRun->Length;
+            ++nRun;
+        }
+        if (i + 1 >= validFrom + length) {
+            callback(i + 1 - length, kmer);
+        }
+    }
+}
+
+///
+/// PackedDNA4bitString is a growable nucleotide string stored at 4 bits per
+/// base in the BAM encoding ("=ACMGRSVTWYHKDBN"), 2 bases per byte with the
+/// first base in the high nibble, i.e. the layout of Utility::PackFourBit.
+///
+/// Input is case-insensitive, U is stored as T. Any other character throws
+/// std::invalid_argument, leaving the string unchanged.
+///
+class PackedDNA4bitString
+{
+public:
+    PackedDNA4bitString() = default;
+    explicit PackedDNA4bitString(std::string_view seq);
+
+public:
+    std::size_t Size() const noexcept { return size_; }
+    bool Empty() const noexcept { return size_ == 0; }
+
+    /// \returns 4-bit code of the i-th base
+    std::uint8_t Code(const std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return (data_[i / 2] >> (4 - 4 * (i % 2))) & 0x0F;
+    }
+
+    char operator[](const std::size_t i) const noexcept { return "=ACMGRSVTWYHKDBN"[Code(i)]; }
+
+    ///
+    /// \returns the 'k' (1 - 16) bases starting at 'pos' as 4-bit codes,
+    ///          first base in the most significant bits
+    ///
+    std::uint64_t KMer(std::size_t pos, std::int32_t k) const noexcept;
+
+    /// \returns packed bases, (Size() + 1) / 2 bytes
+    std::span<const std::uint8_t> Data() const noexcept { return data_; }
+
+    PackedDNAStringView<PackedDNA4bitString> Substr(const std::size_t pos,
+                                                    const std::size_t len) const noexcept
+    {
+        assert(pos <= size_);
+        return {*this, pos, std::min(len, size_ - pos)};
+    }
+
+    std::string ToString() const { return ToString(0, size_); }
+    std::string ToString(std::size_t pos, std::size_t len) const;
+    explicit operator std::string() const { return ToString(); }
+
+public:
+    void Append(std::string_view seq);
+    void PushBack(char base);
+    void Reserve(std::size_t size);
+    void Clear() noexcept;
+
+    /// Reverse complement in place, a 64-bit word (16 bases) at a time
+    void ReverseComplement() noexcept;
+
+public:
+    bool operator==(const PackedDNA4bitString&) const noexcept = default;
+
+private:
+    std::vector<std::uint8_t> data_;
+    std::size_t size_ = 0;
+};
+
+}  // namespace Container
+}  // namespace PacBio
+
+#endif  // PBCOPPER_CONTAINER_PACKEDDNASTRING_H
@@ -8,9 +8,11 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/properties.hpp>
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -93,6 +95,22 @@ struct ConsensusResult
     std::string Seq;
 };
 
+///
+/// Settings for building an AlignmentGraph from a batch of alignments.
+///
+struct AlignmentGraphBuildOptions
+{
+    /// Number of threads, 0 = all available
+    unsigned int NumThreads = 0;
+
+    /// Backbone bases per shard. Each thread accumulates the alignment columns
+    /// falling into one backbone window at a time.
+    std::size_t WindowSize = 1024;
+
+    /// Same as AddAlignment's \p useLocalMerge
+    bool UseLocalMerge = false;
+};
+
 ///
 /// Core alignments into consensus algorithm, implemented using the boost graph
 /// library.  Takes a set of alignments to a reference and builds a higher
@@ -116,6 +134,22 @@ public:
     ///
     explicit AlignmentGraph(std::size_t backboneLength);
 
+    /// Initialize graph based on the given sequence and add all \p alignments.
+    /// The result is identical to calling AddAlignment on each alignment in
+    /// turn, but alignments are first accumulated into per-backbone-position
+    /// columns, in parallel across backbone windows, and the graph is then
+    /// materialized in a single pass.
+    ///
+    /// \param backbone    the reference sequence.
+    /// \param alignments  alignments to the backbone, starting at 1-based
+    ///                    positions and not extending past its end.
+    /// \param options     threading & sharding settings
+    ///
+    /// \throws std::invalid_argument if an alignment does not fit the backbone
+    ///
+    AlignmentGraph(const std::string& backbone, const std::vector<Alignment>& alignments,
+                   const AlignmentGraphBuildOptions& options = AlignmentGraphBuildOptions{});
+
     /// Add alignment to the graph.
     ///
     /// \param Alignment an alignment record (see Alignment.hpp)
@@ -182,6 +216,15 @@ public:
     ///
     std::vector<AlignmentNode> BestPath();
 
+    /// Locates the optimal path through the graph, along with the backbone
+    /// position of each node on it: 0 for the enter node, backbone length + 1
+    /// for the exit node, and for inserted bases, the position of the backbone
+    /// base following them.
+    ///
+    /// \param[out] backbonePositions  1-based backbone position per path node
+    ///
+    std::vector<AlignmentNode> BestPath(std::vector<std::size_t>& backbonePositions);
+
     /// Locate nodes that are missing either in or out edges.
     ///
     bool DanglingNodes();
@@ -0,0 +1,87 @@
+#ifndef PBCOPPER_DAGCON_WINDOWEDALIGNMENTGRAPH_H
+#define PBCOPPER_DAGCON_WINDOWEDALIGNMENTGRAPH_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/dagcon/AlignmentGraph.h>
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace Dagcon {
+
+struct Alignment;
+
+///
+/// Settings for WindowedAlignmentGraph.
+///
+struct WindowedAlignmentGraphOptions
+{
+    /// Backbone bases each window calls consensus for
+    std::size_t WindowSize = 5'000;
+
+    /// Backbone bases each window's graph extends past either side of its
+    /// own bases, so that paths are settled where adjacent windows meet
+    std::size_t Overlap = 250;
+
+    /// Windows processed at once, one per thread; 0 = all available threads
+    unsigned int NumThreads = 0;
+
+    /// Same as AddAlignment's \p useLocalMerge
+    bool UseLocalMerge = false;
+};
+
+///
+/// Consensus caller for long backbones, working in overlapping windows.
+///
+/// Each window builds, merges, and resolves an AlignmentGraph from the
+/// alignments clipped to it, and frees it once its best path is known, so at
+/// most NumThreads window graphs are resident at a time regardless of backbone
+/// length. Window paths are cut at the window boundaries, in the middle of
+/// each overlap, and stitched into one path across the whole backbone.
+///
+/// With a single window, results are the same as from an AlignmentGraph
+/// built from all alignments, after MergeNodes().
+///
+class WindowedAlignmentGraph
+{
+public:
+    /// Calls the best path through the windows of \p backbone.
+    ///
+    /// \param backbone    the reference sequence.
+    /// \param alignments  alignments to the backbone, starting at 1-based
+    ///                    positions and not extending past its end.
+    /// \param options     window & threading settings
+    ///
+    /// \throws std::invalid_argument if an alignment does not fit the backbone
+    ///
+    WindowedAlignmentGraph(
+        const std::string& backbone, const std::vector<Alignment>& alignments,
+        const WindowedAlignmentGraphOptions& options = WindowedAlignmentGraphOptions{});
+
+    /// Same as AlignmentGraph::Consensus
+    std::string Consensus(int minWeight = 0) const;
+
+    /// Same as AlignmentGraph::Consensus
+    void Consensus(std::vector<ConsensusResult>& seqs, int minWeight = 0,
+                   std::size_t minLength = 500) const;
+
+    /// Same as AlignmentGraph::ConsensusWithMinFlankCoverage
+    void ConsensusWithMinFlankCoverage(std::vector<ConsensusResult>& seqs, int minWeight = 0,
+                                       int minFlankCoverage = 0, std::size_t minLen = 500) const;
+
+    /// \returns the stitched best path, from the enter to the exit node. Path
+    ///          nodes' BestInEdge and BestOutEdge are not set.
+    const std::vector<AlignmentNode>& BestPath() const;
+
+private:
+    std::vector<AlignmentNode> path_;
+};
+
+}  // namespace Dagcon
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DAGCON_WINDOWEDALIGNMENTGRAPH_H
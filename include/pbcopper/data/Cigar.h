@@ -4,12 +4,16 @@
 #include <pbcopper/PbcopperConfig.h>
 
 #include <pbcopper/data/CigarOperation.h>
+#include <pbcopper/data/CigarView.h>
 
 #include <iosfwd>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace PacBio {
 namespace Data {
 
@@ -69,6 +73,35 @@ public:
     /// \}
 };
 
+/// \brief Parses SAM/BAM formatted CIGAR data into \p cigar, replacing its
+///        contents. Storage is reused, so repeated parsing into the same
+///        Cigar does not allocate once it is large enough.
+///
+/// \param [in]  str     SAM/BAM formatted CIGAR data
+/// \param [out] cigar   parsed operations
+///
+/// \throws std::invalid_argument if an operation has no length
+/// \throws std::out_of_range if a length does not fit in BAM's 28 bits
+///
+void ParseCigar(std::string_view str, Cigar& cigar);
+
+/// \brief Appends SAM/BAM formatted \p cigar to \p out.
+///
+void AppendCigarString(CigarView cigar, std::string& out);
+
+/// \brief Creates a Cigar from BAM-encoded operations, (length << 4) | type,
+///        e.g. from a BAM record.
+///
+/// \param [in] packed      BAM-encoded operations
+/// \param [in] numOps      number of operations
+///
+Cigar CigarFromPacked(const std::uint32_t* packed, std::size_t numOps);
+
+/// \brief Writes the BAM encoding of \p cigar's operations to \p packed,
+///        which must hold cigar.size() values.
+///
+void CigarToPacked(CigarView cigar, std::uint32_t* packed);
+
 /// https://confluence.pacificbiosciences.com/pages/viewpage.action?spaceKey=SL&title=Concordance%2C+Identity%2C+and+SMRT+Link+Reports
 struct CigarBaseCounts
 {
@@ -91,7 +124,7 @@ struct CigarBaseCounts
 /// \param cigar
 /// \return CigarBaseCounts, which includes identity calculations
 ///
-CigarBaseCounts CigarOpsCalculator(const Cigar& cigar);
+CigarBaseCounts CigarOpsCalculator(CigarView cigar);
 
 ///
 /// \brief
@@ -99,7 +132,7 @@ CigarBaseCounts CigarOpsCalculator(const Cigar& cigar);
 /// \param cigar
 /// \return std::size_t
 ///
-std::size_t ReferenceLength(const Cigar& cigar);
+std::size_t ReferenceLength(CigarView cigar);
 
 std::ostream& operator<<(std::ostream& os, const Cigar& cigar);
 
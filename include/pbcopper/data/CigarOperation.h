@@ -123,6 +123,18 @@ public:
 #endif
     }
 
+    /// Creates an operation from its BAM encoding, (length << 4) | type.
+    /// Unlike the constructors, this does not validate the operation type.
+    ///
+    /// \param[in] packed BAM-encoded operation
+    PB_CUDA_HOST PB_CUDA_DEVICE static constexpr CigarOperation FromPacked(
+        const std::uint32_t packed) noexcept
+    {
+        CigarOperation op;
+        op.data_ = packed;
+        return op;
+    }
+
     /// \}
 
 public:
@@ -141,6 +153,9 @@ public:
         return static_cast<CigarOperationType>(data_ & 0b1111U);
     }
 
+    /// \returns BAM encoding of this operation, (length << 4) | type
+    PB_CUDA_HOST PB_CUDA_DEVICE constexpr std::uint32_t Packed() const noexcept { return data_; }
+
     /// \}
 
 public:
@@ -204,6 +219,10 @@ private:
     std::uint32_t data_ = static_cast<std::uint32_t>(CigarOperationType::UNKNOWN_OP);
 };
 
+// arrays of operations are arrays of BAM-encoded operations
+static_assert(sizeof(CigarOperation) == sizeof(std::uint32_t));
+static_assert(std::is_trivially_copyable_v<CigarOperation>);
+
 bool ConsumesQuery(CigarOperationType type) noexcept;
 
 bool ConsumesReference(CigarOperationType type) noexcept;
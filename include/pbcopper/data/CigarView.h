@@ -0,0 +1,106 @@
+#ifndef PBCOPPER_DATA_CIGARVIEW_H
+#define PBCOPPER_DATA_CIGARVIEW_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/CigarOperation.h>
+
+#include <string>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+namespace PacBio {
+namespace Data {
+
+class Cigar;
+
+/// \brief The CigarView class is a non-owning, read-only view of contiguous
+///        CIGAR operations, e.g. all or part of a Cigar.
+///
+/// Views are cheap to copy and let read-only CIGAR loops run over part of a
+/// Cigar without copying it.
+///
+class CigarView
+{
+public:
+    using value_type = CigarOperation;
+    using size_type = std::size_t;
+    using const_iterator = const CigarOperation*;
+    using iterator = const_iterator;
+
+    /// \name Constructors & Related Methods
+    /// \{
+
+    constexpr CigarView() noexcept = default;
+
+    constexpr CigarView(const CigarOperation* data, const std::size_t size) noexcept
+        : data_{data}, size_{size}
+    {}
+
+    /// Views all operations of \p ops (e.g. a Cigar), which must outlive the view.
+    CigarView(const std::vector<CigarOperation>& ops) noexcept
+        : data_{ops.data()}, size_{ops.size()}
+    {}
+
+    /// \}
+
+public:
+    /// \name Operations
+    /// \{
+
+    constexpr const CigarOperation* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr const_iterator begin() const noexcept { return data_; }
+    constexpr const_iterator end() const noexcept { return data_ + size_; }
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend() const noexcept { return end(); }
+
+    constexpr const CigarOperation& operator[](const std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return data_[i];
+    }
+
+    constexpr const CigarOperation& front() const noexcept { return (*this)[0]; }
+    constexpr const CigarOperation& back() const noexcept { return (*this)[size_ - 1]; }
+
+    /// \returns a view of operations [pos, pos + count)
+    constexpr CigarView SubView(const std::size_t pos, const std::size_t count) const noexcept
+    {
+        assert(pos + count <= size_);
+        return CigarView{data_ + pos, count};
+    }
+
+    /// \}
+
+public:
+    /// \name Conversion Methods
+    /// \{
+
+    /// \returns SAM/BAM formatted std::string
+    std::string ToStdString() const;
+
+    /// \returns a Cigar holding a copy of the viewed operations
+    Cigar ToCigar() const;
+
+    /// \}
+
+private:
+    const CigarOperation* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/// \returns true if both views hold the same operations
+bool operator==(CigarView lhs, CigarView rhs) noexcept;
+
+/// \returns true if the views differ in any operation
+bool operator!=(CigarView lhs, CigarView rhs) noexcept;
+
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_CIGARVIEW_H
@@ -0,0 +1,122 @@
+#ifndef PBCOPPER_DATA_CLIPPEDREAD_H
+#define PBCOPPER_DATA_CLIPPEDREAD_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/Cigar.h>
+#include <pbcopper/data/CigarOperation.h>
+#include <pbcopper/data/Clipping.h>
+#include <pbcopper/data/Interval.h>
+#include <pbcopper/data/MappedRead.h>
+#include <pbcopper/data/Position.h>
+#include <pbcopper/data/QualityValue.h>
+#include <pbcopper/data/Read.h>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Data {
+
+/// \brief The ClippedReadView class is a read-only view of a clipped region of
+///        a Read, without copying its data.
+///
+/// A view is an offset & length into the read's base-level data, so clipping
+/// a read into many windows only costs a ClipSpan per window. Views are
+/// invalidated by any change to the underlying read.
+///
+class ClippedReadView
+{
+public:
+    ClippedReadView(const Read& read, const ClipSpan& span) noexcept;
+
+public:
+    const Read& Source() const noexcept;
+    const ClipSpan& Span() const noexcept;
+
+    std::string_view Seq() const;
+
+    /// \returns qualities, empty if the read has none
+    std::span<const QualityValue> Qualities() const;
+
+    std::optional<std::span<const std::uint16_t>> PulseWidth() const;
+    std::optional<std::span<const std::uint16_t>> IPD() const;
+
+    Position QueryStart() const noexcept;
+    Position QueryEnd() const noexcept;
+    std::int32_t Length() const noexcept;
+
+    /// \returns a standalone copy of the clipped read, as from ClipToQuery
+    Read ToRead() const;
+
+protected:
+    const Read* read_;
+    ClipSpan span_;
+};
+
+/// \brief The ClippedMappedReadView class adds the clipped alignment to
+///        ClippedReadView.
+///
+class ClippedMappedReadView : public ClippedReadView
+{
+public:
+    ClippedMappedReadView(const MappedRead& read, const ClipSpan& span) noexcept;
+
+public:
+    const MappedRead& Source() const noexcept;
+
+    Position TemplateStart() const noexcept;
+    Position TemplateEnd() const noexcept;
+
+    /// \returns number of CIGAR operations in the clip
+    std::size_t NumCigarOperations() const noexcept;
+
+    /// \returns i-th CIGAR operation of the clip, shortened if it straddles
+    ///          the clip boundary
+    CigarOperation CigarOperationAt(std::size_t i) const;
+
+    /// \returns a copy of the clipped CIGAR
+    Data::Cigar Cigar() const;
+
+    /// \returns a standalone copy of the clipped read, as from ClipToQuery or
+    ///          ClipToReference
+    MappedRead ToMappedRead() const;
+};
+
+///
+/// \returns view of 'read' clipped to query positions [start, end). Same clip
+///          as ClipToQuery, leaving 'read' untouched.
+///
+ClippedReadView ClipViewToQuery(const Read& read, Position start, Position end);
+
+///
+/// \returns view of 'read' clipped to query positions [start, end). Same clip
+///          as ClipToQuery, leaving 'read' untouched.
+///
+ClippedMappedReadView ClipViewToQuery(const MappedRead& read, Position start, Position end);
+
+///
+/// \returns view of 'read' clipped to reference positions [start, end). Same
+///          clip as ClipToReference, leaving 'read' untouched.
+///
+ClippedMappedReadView ClipViewToReference(const MappedRead& read, Position start, Position end,
+                                          bool exciseFlankingInserts);
+
+///
+/// \returns views of 'read' clipped to each of the reference 'windows', as
+///          from ClipViewToReference. Windows sorted by start & end share a
+///          single walk over the CIGAR.
+///
+std::vector<ClippedMappedReadView> ClipViewsToReference(const MappedRead& read,
+                                                        std::span<const Interval> windows,
+                                                        bool exciseFlankingInserts);
+
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_CLIPPEDREAD_H
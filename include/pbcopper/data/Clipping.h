@@ -7,6 +7,9 @@
 #include <pbcopper/data/Position.h>
 #include <pbcopper/data/Strand.h>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace PacBio {
 namespace Data {
 
@@ -50,6 +53,33 @@ struct ClipResult
     Cigar cigar_;
 };
 
+///
+/// \brief The ClipSpan struct locates a clipped read within the original,
+///        unmodified read.
+///
+/// Base-level data of the clip is [Offset, Offset + Length) of the read's. Its
+/// CIGAR is operations [CigarBegin, CigarEnd) of the read's, with the first
+/// shortened by FrontTrim and the last by BackTrim.
+///
+struct ClipSpan
+{
+    std::size_t Offset = 0;
+    std::size_t Length = 0;
+    Position QueryStart = UNMAPPED_POSITION;
+    Position QueryEnd = UNMAPPED_POSITION;
+
+    // for clipping mapped reads
+    Position TemplateStart = UNMAPPED_POSITION;
+    Position TemplateEnd = UNMAPPED_POSITION;
+    std::size_t CigarBegin = 0;
+    std::size_t CigarEnd = 0;
+    std::uint32_t FrontTrim = 0;
+    std::uint32_t BackTrim = 0;
+
+    // clip region did not overlap the alignment, leaving nothing
+    bool Disjoint = false;
+};
+
 // configs are non-const so we can steal the input CIGAR, rather than copy,
 // but they're otherwise const
 ClipResult ClipToQuery(ClipToQueryConfig& config);
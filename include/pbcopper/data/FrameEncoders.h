@@ -5,8 +5,13 @@
 
 #include <pbcopper/data/Frames.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <span>
 #include <string>
+#include <type_traits>
+#include <variant>
 
 namespace PacBio {
 namespace Data {
@@ -23,58 +28,132 @@ public:
     std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& rawFrames) const;
     Frames Decode(const std::vector<std::uint8_t>& encodedFrames) const;
     std::string Name() const;
+
+    ///
+    /// Encode/Decode into caller-provided storage, which must be the same size
+    /// as the input.
+    ///
+    void EncodeInto(std::span<const std::uint16_t> rawFrames,
+                    std::span<std::uint8_t> encodedFrames) const;
+    void DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                    std::span<std::uint16_t> rawFrames) const;
 };
 
+///
+/// Codes hold an exponent e and mantissa m, decoding to base * (2^e - 1) + 2^e * m,
+/// with base = 2^mantissaBits. Decoded values are looked up in a table built on
+/// construction (saturating at 65535), and encoding uses SSE4.1 where the
+/// exponent fits in 16-bit lanes.
+///
 struct V2FrameEncoder
 {
 public:
+    ///
+    /// \throws std::invalid_argument if exponentBits < 1, mantissaBits < 0, or
+    ///         codes would need more than 8 bits
+    ///
     V2FrameEncoder(int exponentBits, int mantissaBits);
 
     std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& rawFrames) const;
     Frames Decode(const std::vector<std::uint8_t>& encodedFrames) const;
     std::string Name() const;
 
+    ///
+    /// Encode/Decode into caller-provided storage, which must be the same size
+    /// as the input. If DecodeInto throws on an invalid code, the contents of
+    /// rawFrames are unspecified.
+    ///
+    void EncodeInto(std::span<const std::uint16_t> rawFrames,
+                    std::span<std::uint8_t> encodedFrames) const;
+    void DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                    std::span<std::uint16_t> rawFrames) const;
+
     int ExponentBits() const;
     int MantissaBits() const;
 
 private:
-    const int exponentBits_;
-    const int mantissaBits_;
-    const int base_;
-    const std::uint8_t max_;
+    std::uint8_t EncodeFrame(std::uint16_t frame) const;
+
+    int exponentBits_;
+    int mantissaBits_;
+    int base_;
+    std::uint8_t max_;
+    std::array<std::uint16_t, 256> decodeTable_;
 };
 
 // ---------------------
 // Type-erased encoder
 // ---------------------
 
+///
+/// The built-in codecs are held by value and called directly; only other codec
+/// types go through a virtual interface.
+///
 class FrameEncoder
 {
 public:
     template <typename T>
-    FrameEncoder(T codec) : self_{std::make_unique<EncoderImpl<T>>(std::move(codec))}
+    FrameEncoder(T codec)
+    {
+        if constexpr (std::is_same_v<T, V1FrameEncoder> || std::is_same_v<T, V2FrameEncoder>) {
+            builtin_ = std::move(codec);
+        } else {
+            self_ = std::make_unique<EncoderImpl<T>>(std::move(codec));
+        }
+    }
+    FrameEncoder(const FrameEncoder& other)
+        : builtin_{other.builtin_}, self_{other.self_ ? other.self_->Clone() : nullptr}
     {}
-    FrameEncoder(const FrameEncoder& other) : self_{other.self_->Clone()} {}
     FrameEncoder(FrameEncoder&&) noexcept = default;
     FrameEncoder& operator=(const FrameEncoder& other)
     {
-        self_.reset(other.self_->Clone());
+        builtin_ = other.builtin_;
+        self_.reset(other.self_ ? other.self_->Clone() : nullptr);
         return *this;
     }
     FrameEncoder& operator=(FrameEncoder&&) noexcept = default;
 
+private:
+    // calls the built-in codec directly, or any other through EncoderInterface
+    template <typename F>
+    decltype(auto) Visit(F&& f) const
+    {
+        if (const auto* v1 = std::get_if<V1FrameEncoder>(&builtin_)) {
+            return f(*v1);
+        }
+        if (const auto* v2 = std::get_if<V2FrameEncoder>(&builtin_)) {
+            return f(*v2);
+        }
+        return f(*self_);
+    }
+
 public:
     std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& rawFrames) const
     {
-        return self_->Encode(rawFrames);
+        return Visit([&](const auto& codec) { return codec.Encode(rawFrames); });
     }
 
     Frames Decode(const std::vector<std::uint8_t>& encodedFrames) const
     {
-        return self_->Decode(encodedFrames);
+        return Visit([&](const auto& codec) { return codec.Decode(encodedFrames); });
     }
 
-    std::string Name() const { return self_->Name(); }
+    void EncodeInto(std::span<const std::uint16_t> rawFrames,
+                    std::span<std::uint8_t> encodedFrames) const
+    {
+        Visit([&](const auto& codec) { codec.EncodeInto(rawFrames, encodedFrames); });
+    }
+
+    void DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                    std::span<std::uint16_t> rawFrames) const
+    {
+        Visit([&](const auto& codec) { codec.DecodeInto(encodedFrames, rawFrames); });
+    }
+
+    std::string Name() const
+    {
+        return Visit([](const auto& codec) { return codec.Name(); });
+    }
 
 private:
     struct EncoderInterface
@@ -84,6 +163,10 @@ private:
         virtual std::vector<std::uint8_t> Encode(
             const std::vector<std::uint16_t>& rawFrames) const = 0;
         virtual Frames Decode(const std::vector<std::uint8_t>& encodedFrames) const = 0;
+        virtual void EncodeInto(std::span<const std::uint16_t> rawFrames,
+                                std::span<std::uint8_t> encodedFrames) const = 0;
+        virtual void DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                                std::span<std::uint16_t> rawFrames) const = 0;
         virtual std::string Name() const = 0;
     };
 
@@ -101,11 +184,39 @@ private:
         {
             return codec_.Decode(encodedFrames);
         }
+        void EncodeInto(std::span<const std::uint16_t> rawFrames,
+                        std::span<std::uint8_t> encodedFrames) const override
+        {
+            if constexpr (requires { codec_.EncodeInto(rawFrames, encodedFrames); }) {
+                codec_.EncodeInto(rawFrames, encodedFrames);
+            } else {
+                // codec only provides the allocating API
+                CheckSizes(rawFrames.size(), encodedFrames.size());
+                const auto encoded =
+                    codec_.Encode(std::vector<std::uint16_t>{rawFrames.begin(), rawFrames.end()});
+                std::copy(encoded.cbegin(), encoded.cend(), encodedFrames.begin());
+            }
+        }
+        void DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                        std::span<std::uint16_t> rawFrames) const override
+        {
+            if constexpr (requires { codec_.DecodeInto(encodedFrames, rawFrames); }) {
+                codec_.DecodeInto(encodedFrames, rawFrames);
+            } else {
+                CheckSizes(encodedFrames.size(), rawFrames.size());
+                const Frames decoded = codec_.Decode(
+                    std::vector<std::uint8_t>{encodedFrames.begin(), encodedFrames.end()});
+                std::copy(decoded.cbegin(), decoded.cend(), rawFrames.begin());
+            }
+        }
         std::string Name() const override { return codec_.Name(); }
 
         T codec_;
     };
 
+    static void CheckSizes(std::size_t inputSize, std::size_t outputSize);
+
+    std::variant<std::monostate, V1FrameEncoder, V2FrameEncoder> builtin_;
     std::unique_ptr<EncoderInterface> self_;
 };
 
@@ -6,6 +6,7 @@
 #include <pbcopper/data/FrameCodec.h>
 
 #include <iosfwd>
+#include <span>
 #include <vector>
 
 #include <cstddef>
@@ -62,6 +63,47 @@ public:
     static std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& frames,
                                             const T& encoder);
 
+    /// \brief Decodes encoded (lossy, 8-bit) data into existing Frames,
+    ///        reusing their storage.
+    ///
+    /// \param[in]  codedData  encoded data
+    /// \param[out] frames     decoded frames, resized to match codedData
+    ///
+    static void DecodeInto(std::span<const std::uint8_t> codedData, Frames& frames);
+
+    /// \brief Decodes encoded (lossy, 8-bit) data into existing Frames, using
+    ///        decoder provided.
+    ///
+    /// \param[in]  codedData  encoded data
+    /// \param[out] frames     decoded frames, resized to match codedData
+    /// \param[in]  decoder    frame codec
+    ///
+    template <typename T>
+    static void DecodeInto(std::span<const std::uint8_t> codedData, Frames& frames,
+                           const T& decoder);
+
+    /// \brief Encodes raw frame data into an existing buffer, reusing its
+    ///        storage.
+    ///
+    /// \param[in]  frames     raw frame data
+    /// \param[out] codedData  lossy, 8-bit encoded frame data, resized to match
+    ///                        frames
+    ///
+    static void EncodeInto(std::span<const std::uint16_t> frames,
+                           std::vector<std::uint8_t>& codedData);
+
+    /// \brief Encodes raw frame data into an existing buffer, using encoder
+    ///        provided.
+    ///
+    /// \param[in]  frames     raw frame data
+    /// \param[out] codedData  lossy, 8-bit encoded frame data, resized to match
+    ///                        frames
+    /// \param[in]  encoder    frame codec
+    ///
+    template <typename T>
+    static void EncodeInto(std::span<const std::uint16_t> frames,
+                           std::vector<std::uint8_t>& codedData, const T& encoder);
+
     /// \}
 
 public:
@@ -163,6 +205,21 @@ std::vector<std::uint8_t> Frames::Encode(const std::vector<std::uint16_t>& rawFr
     return encoder.Encode(rawFrames);
 }
 
+template <typename T>
+void Frames::DecodeInto(std::span<const std::uint8_t> encodedData, Frames& frames, const T& decoder)
+{
+    frames.resize(encodedData.size());
+    decoder.DecodeInto(encodedData, std::span<std::uint16_t>{frames.Data()});
+}
+
+template <typename T>
+void Frames::EncodeInto(std::span<const std::uint16_t> rawFrames,
+                        std::vector<std::uint8_t>& encodedData, const T& encoder)
+{
+    encodedData.resize(rawFrames.size());
+    encoder.EncodeInto(rawFrames, std::span<std::uint8_t>{encodedData});
+}
+
 }  // namespace Data
 }  // namespace PacBio
 
@@ -0,0 +1,211 @@
+#ifndef PBCOPPER_DATA_INTERVALINDEX_H
+#define PBCOPPER_DATA_INTERVALINDEX_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/Interval.h>
+#include <pbcopper/data/Position.h>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Data {
+
+/// \brief The IntervalIndex class is an immutable, bulk-built index of
+///        (possibly overlapping) intervals for overlap and stabbing queries.
+///
+/// Intervals are sorted by start into flat arrays, with an implicit augmented
+/// binary tree over the sorted order (as in cgranges): node i stores the
+/// maximum end of its subtree, so queries take O(log n + #hits) without any
+/// pointers. Unlike IntervalTree, intervals are not merged; see Merged().
+///
+/// Queries report the sorted index of each hit, in increasing order. Two
+/// intervals overlap if they share at least one position.
+///
+class IntervalIndex
+{
+public:
+    /// \name Constructors & Related Methods
+    /// \{
+
+    /// \brief Builds the index, sorting on up to 'numThreads' threads (0 for
+    ///        all available). Empty intervals are left out.
+    explicit IntervalIndex(const std::vector<Interval>& intervals, unsigned int numThreads = 1);
+
+    IntervalIndex() = default;
+
+    /// \}
+
+public:
+    /// \name Attributes
+    /// \{
+
+    std::size_t Size() const noexcept { return starts_.size(); }
+    bool Empty() const noexcept { return starts_.empty(); }
+
+    /// \returns the i-th interval, in order of start & end
+    Interval operator[](const std::size_t i) const { return {Start(i), End(i)}; }
+
+    Position Start(const std::size_t i) const noexcept { return starts_[i]; }
+    Position End(const std::size_t i) const noexcept { return ends_[i]; }
+
+    /// \returns position of the i-th interval in the constructor's input
+    std::size_t InputIndex(const std::size_t i) const noexcept { return inputIndices_[i]; }
+
+    /// \returns true if no two intervals share a position
+    bool IsDisjoint() const noexcept { return disjoint_; }
+
+    /// \}
+
+public:
+    /// \name Queries
+    /// \{
+
+    /// \returns true if any interval contains 'value'
+    bool Contains(Position value) const;
+
+    /// \brief Calls 'callback(i)' for each interval overlapping 'query'.
+    template <typename Callback>
+    void ForEachOverlap(const Interval& query, Callback&& callback) const;
+
+    ///
+    /// \brief Calls 'callback(q, i)' for each interval i overlapping query q.
+    ///
+    /// Queries sorted by start are answered in a single merge-like sweep if
+    /// the index is disjoint, and otherwise one at a time.
+    ///
+    template <typename Callback>
+    void ForEachOverlap(std::span<const Interval> queries, Callback&& callback) const;
+
+    /// \returns indices of the intervals overlapping 'query'
+    std::vector<std::size_t> Overlapping(const Interval& query) const;
+
+    /// \returns indices of the intervals containing 'value'
+    std::vector<std::size_t> Stabbing(Position value) const;
+
+    /// \}
+
+public:
+    /// \returns index of the union of overlapping or touching intervals, as
+    ///          IntervalTree would store them
+    IntervalIndex Merged() const;
+
+private:
+    ///
+    /// Visits the intervals overlapping [start, end) in sorted order, until
+    /// 'visit(i)' returns false.
+    ///
+    /// \returns false if stopped early
+    ///
+    template <typename Visitor>
+    bool Visit(Position start, Position end, Visitor&& visit) const;
+
+private:
+    std::vector<Position> starts_;
+    std::vector<Position> ends_;
+    // maximum end of the implicit subtree rooted at each index
+    std::vector<Position> maxEnds_;
+    std::vector<std::uint32_t> inputIndices_;
+    std::int32_t maxLevel_ = -1;
+    bool disjoint_ = true;
+};
+
+template <typename Visitor>
+bool IntervalIndex::Visit(const Position start, const Position end, Visitor&& visit) const
+{
+    if (Empty() || (start >= end)) {
+        return true;
+    }
+
+    // node x at level k has children x -/+ 2^(k-1); leaves are at even indices
+    struct StackEntry
+    {
+        std::int64_t Node;
+        std::int32_t Level;
+        bool LeftDone;
+    };
+    StackEntry stack[64];
+    std::int32_t top = 0;
+    const auto size = static_cast<std::int64_t>(Size());
+    stack[top++] = {(std::int64_t{1} << maxLevel_) - 1, maxLevel_, false};
+
+    while (top) {
+        const StackEntry entry = stack[--top];
+        if (entry.Level <= 3) {
+            // small subtree, scan it
+            const std::int64_t first = (entry.Node >> entry.Level) << entry.Level;
+            const std::int64_t last =
+                std::min(first + (std::int64_t{1} << (entry.Level + 1)) - 1, size);
+            for (std::int64_t i = first; (i < last) && (starts_[i] < end); ++i) {
+                if ((start < ends_[i]) && !visit(static_cast<std::size_t>(i))) {
+                    return false;
+                }
+            }
+        } else if (!entry.LeftDone) {
+            // revisit the node after its left subtree, which may not exist
+            const std::int64_t left = entry.Node - (std::int64_t{1} << (entry.Level - 1));
+            stack[top++] = {entry.Node, entry.Level, true};
+            if ((left >= size) || (maxEnds_[left] > start)) {
+                stack[top++] = {left, entry.Level - 1, false};
+            }
+        } else if ((entry.Node < size) && (starts_[entry.Node] < end)) {
+            if ((start < ends_[entry.Node]) && !visit(static_cast<std::size_t>(entry.Node))) {
+                return false;
+            }
+            stack[top++] = {entry.Node + (std::int64_t{1} << (entry.Level - 1)), entry.Level - 1,
+                            false};
+        }
+    }
+    return true;
+}
+
+template <typename Callback>
+void IntervalIndex::ForEachOverlap(const Interval& query, Callback&& callback) const
+{
+    Visit(query.Start(), query.End(), [&](const std::size_t i) {
+        callback(i);
+        return true;
+    });
+}
+
+template <typename Callback>
+void IntervalIndex::ForEachOverlap(const std::span<const Interval> queries,
+                                   Callback&& callback) const
+{
+    const bool sorted = std::is_sorted(
+        queries.begin(), queries.end(),
+        [](const Interval& lhs, const Interval& rhs) { return lhs.Start() < rhs.Start(); });
+    if (!disjoint_ || !sorted) {
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            ForEachOverlap(queries[q], [&](const std::size_t i) { callback(q, i); });
+        }
+        return;
+    }
+
+    // disjoint intervals have increasing ends: skip those ending before each
+    // query, never to return
+    std::size_t first = 0;
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+        const Position start = queries[q].Start();
+        const Position end = queries[q].End();
+        while ((first < Size()) && (ends_[first] <= start)) {
+            ++first;
+        }
+        if (start >= end) {
+            continue;
+        }
+        for (std::size_t i = first; (i < Size()) && (starts_[i] < end); ++i) {
+            callback(q, i);
+        }
+    }
+}
+
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_INTERVALINDEX_H
@@ -9,6 +9,8 @@
 #include <pbcopper/data/Strand.h>
 
 #include <iosfwd>
+#include <optional>
+#include <string>
 
 namespace PacBio {
 namespace Data {
@@ -25,6 +27,15 @@ enum class SoftClipBehavior
     REMOVE
 };
 
+/// Output buffers for MappedRead::ProjectAligned. Null members are skipped.
+struct AlignedProjection
+{
+    std::string* Sequence = nullptr;
+    QualityValues* Qualities = nullptr;
+    std::optional<Frames>* IPD = nullptr;
+    std::optional<Frames>* PulseWidth = nullptr;
+};
+
 /// A MappedRead extends Read by the strand information and template anchoring
 /// positions.
 struct MappedRead : public Read
@@ -52,6 +63,14 @@ struct MappedRead : public Read
     Position ReferenceStart() const;
     Position ReferenceEnd() const;
 
+    /// Fills any of the aligned sequence, qualities, IPD, and pulse width in
+    /// a single walk over the CIGAR, reusing the outputs' storage. Each output
+    /// matches the corresponding Aligned*() method.
+    void ProjectAligned(const AlignedProjection& outputs,
+                        Orientation orientation = Orientation::NATIVE,
+                        GapBehavior gapBehavior = GapBehavior::IGNORE,
+                        SoftClipBehavior softClipBehavior = SoftClipBehavior::KEEP) const;
+
     std::string AlignedSequence(Orientation orientation = Orientation::NATIVE,
                                 GapBehavior gapBehavior = GapBehavior::IGNORE,
                                 SoftClipBehavior softClipBehavior = SoftClipBehavior::KEEP) const;
@@ -75,7 +94,9 @@ struct MappedRead : public Read
 };
 
 ///
-/// \brief
+/// \brief Clips 'read' to query positions [start, end), in place.
+///
+/// Data is moved within the read's existing storage, without reallocating.
 ///
 /// \param read
 /// \param start
@@ -84,12 +105,14 @@ struct MappedRead : public Read
 void ClipToQuery(MappedRead& read, Position start, Position end);
 
 ///
-/// \brief
+/// \brief Clips 'read' to reference positions [start, end), in place.
+///
+/// Data is moved within the read's existing storage, without reallocating.
 ///
 /// \param read
 /// \param start
 /// \param end
-/// \param exciseFlankingInserts
+/// \param exciseFlankingInserts   also remove insertions left at either end
 ///
 void ClipToReference(MappedRead& read, Position start, Position end, bool exciseFlankingInserts);
 
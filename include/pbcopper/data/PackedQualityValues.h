@@ -0,0 +1,107 @@
+#ifndef PBCOPPER_DATA_PACKEDQUALITYVALUES_H
+#define PBCOPPER_DATA_PACKEDQUALITYVALUES_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/QualityValue.h>
+#include <pbcopper/data/QualityValues.h>
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Data {
+
+/// \brief The PackedQualityValues class stores binned quality values, e.g.
+///        HiFi reads' 8-level qualities, at 4 bits per value.
+///
+/// Each value is the index into a table of up to 16 bins, 2 values per byte
+/// with the first in the high nibble.
+///
+class PackedQualityValues
+{
+public:
+    /// \name Constructors & Related Methods
+    /// \{
+
+    /// \brief Packs 'quals' losslessly.
+    ///
+    /// \throws std::invalid_argument if 'quals' has more than 16 distinct
+    ///         values
+    ///
+    explicit PackedQualityValues(std::span<const QualityValue> quals);
+
+    /// \brief Packs 'quals' into 'bins', each value becoming the highest bin
+    ///        not above it (or the lowest bin).
+    ///
+    /// \throws std::invalid_argument unless 'bins' has 1 - 16 strictly
+    ///         increasing values
+    ///
+    PackedQualityValues(std::span<const QualityValue> quals, std::span<const QualityValue> bins);
+
+    PackedQualityValues() = default;
+
+    /// \}
+
+public:
+    /// \name Accessors
+    /// \{
+
+    std::size_t Size() const noexcept { return size_; }
+    bool Empty() const noexcept { return size_ == 0; }
+
+    /// \returns bin index (0 - 15) of the i-th value
+    std::uint8_t Code(const std::size_t i) const noexcept
+    {
+        assert(i < size_);
+        return (data_[i / 2] >> (4 - 4 * (i % 2))) & 0x0F;
+    }
+
+    QualityValue operator[](const std::size_t i) const noexcept { return bins_[Code(i)]; }
+
+    std::span<const QualityValue> Bins() const noexcept { return {bins_.data(), numBins_}; }
+
+    /// \returns packed bin indices, (Size() + 1) / 2 bytes
+    std::span<const std::uint8_t> Data() const noexcept { return data_; }
+
+    /// \}
+
+public:
+    /// \name Conversion Methods
+    /// \{
+
+    /// \brief Unpacks all values into 'quals', which must hold Size() elements
+    void UnpackInto(std::span<QualityValue> quals) const;
+
+    QualityValues Unpack() const;
+
+    /// \returns the FASTQ-encoded string of the (binned) values
+    std::string Fastq() const;
+
+    /// \}
+
+public:
+    bool operator==(const PackedQualityValues& other) const noexcept;
+    bool operator!=(const PackedQualityValues& other) const noexcept;
+
+private:
+    std::array<QualityValue, 16> bins_{};
+    std::size_t numBins_ = 0;
+    std::vector<std::uint8_t> data_;
+    std::size_t size_ = 0;
+};
+
+/// \returns mean, min, and expected errors of the packed values, counting
+///          packed bytes rather than unpacking them
+QualityStats ComputeQualityStats(const PackedQualityValues& quals);
+
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_PACKEDQUALITYVALUES_H
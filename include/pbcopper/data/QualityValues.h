@@ -6,9 +6,12 @@
 #include <pbcopper/data/QualityValue.h>
 
 #include <iosfwd>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -121,6 +124,48 @@ public:
 
 std::ostream& operator<<(std::ostream& os, const QualityValues& qualityvalues);
 
+/// \brief Converts FASTQ-encoded 'fastq' into 'quals', 16 characters at a time,
+///        as QualityValue::FromFastq. 'quals' must hold fastq.size() elements.
+///
+void FromFastq(std::string_view fastq, std::span<QualityValue> quals);
+
+/// \brief Converts 'quals' into FASTQ-encoded 'fastq', 16 values at a time.
+///        'fastq' must hold quals.size() characters.
+///
+void ToFastq(std::span<const QualityValue> quals, std::span<char> fastq);
+
+/// \brief Summary of a sequence of quality values, e.g. for read filters.
+///
+/// All members are 0 for an empty sequence.
+///
+struct QualityStats
+{
+    /// mean Phred quality value
+    double Mean = 0.0;
+
+    /// lowest quality value
+    QualityValue Min;
+
+    /// sum of the Phred error probabilities, 10^(-QV/10)
+    double ExpectedErrors = 0.0;
+};
+
+/// \returns mean, min, and expected errors of 'quals', from a single pass
+///          counting each quality value
+QualityStats ComputeQualityStats(std::span<const QualityValue> quals);
+
+/// \returns mean quality value of 'quals', 0 if empty
+double MeanQuality(std::span<const QualityValue> quals);
+
+/// \returns lowest quality value of 'quals', 0 if empty
+QualityValue MinQuality(std::span<const QualityValue> quals);
+
+/// \returns sum of the Phred error probabilities of 'quals'
+double ExpectedErrors(std::span<const QualityValue> quals);
+
+/// \returns Phred error probability 10^(-QV/10), from a lookup table
+double PhredToErrorProbability(QualityValue qv) noexcept;
+
 }  // namespace Data
 }  // namespace PacBio
 
@@ -66,6 +66,12 @@ struct Read
 
 std::ostream& operator<<(std::ostream& os, const Read& read);
 
+///
+/// Clips 'read' to query positions [start, end), in place. Data is moved
+/// within the read's existing storage, without reallocating.
+///
+/// \sa ClipViewToQuery for a clip that leaves the read untouched
+///
 void ClipToQuery(Read& read, Position start, Position end);
 
 }  // namespace Data
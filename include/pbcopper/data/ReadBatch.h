@@ -0,0 +1,227 @@
+#ifndef PBCOPPER_DATA_READBATCH_H
+#define PBCOPPER_DATA_READBATCH_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/Accuracy.h>
+#include <pbcopper/data/CigarView.h>
+#include <pbcopper/data/LocalContextFlags.h>
+#include <pbcopper/data/MappedRead.h>
+#include <pbcopper/data/Position.h>
+#include <pbcopper/data/QualityValue.h>
+#include <pbcopper/data/Read.h>
+#include <pbcopper/data/ReadId.h>
+#include <pbcopper/data/SNR.h>
+#include <pbcopper/data/Strand.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Data {
+
+class ReadBatch;
+
+/// \brief The ReadView class is a lightweight, read-only accessor for one read
+///        of a ReadBatch.
+///
+/// Accessors mirror the fields of Read, returning views into the batch's
+/// columns. A view is invalidated by any change to its batch.
+///
+class ReadView
+{
+public:
+    ReadView(const ReadBatch& batch, std::size_t index) noexcept;
+
+public:
+    /// \returns read ID (allocates its strings)
+    ReadId Id() const;
+
+    std::string_view Seq() const;
+
+    /// \returns qualities, empty if the read had none
+    std::span<const QualityValue> Qualities() const;
+
+    std::optional<std::span<const std::uint16_t>> PulseWidth() const;
+    std::optional<std::span<const std::uint16_t>> IPD() const;
+
+    Position QueryStart() const;
+    Position QueryEnd() const;
+    LocalContextFlags Flags() const;
+    Accuracy ReadAccuracy() const;
+    const SNR& SignalToNoise() const;
+    std::string_view Model() const;
+    bool FullLength() const;
+
+    std::int32_t Length() const;
+
+    /// \returns a standalone copy of this read
+    Read ToRead() const;
+
+protected:
+    const ReadBatch* batch_;
+    std::size_t index_;
+};
+
+/// \brief The MappedReadView class adds the mapping fields of MappedRead to
+///        ReadView.
+///
+class MappedReadView : public ReadView
+{
+public:
+    MappedReadView(const ReadBatch& batch, std::size_t index) noexcept;
+
+public:
+    std::int32_t RefId() const;
+    Data::Strand Strand() const;
+    Position TemplateStart() const;
+    Position TemplateEnd() const;
+    bool PinStart() const;
+    bool PinEnd() const;
+    CigarView Cigar() const;
+    std::uint8_t MapQuality() const;
+
+    /// \name Same as the MappedRead methods
+    /// \{
+
+    Position AlignedStart() const;
+    Position AlignedEnd() const;
+    Data::Strand AlignedStrand() const;
+    Position ReferenceStart() const;
+    Position ReferenceEnd() const;
+    std::int32_t NumMismatches() const;
+
+    /// \}
+
+    /// \returns a standalone copy of this read
+    MappedRead ToMappedRead() const;
+};
+
+/// \brief The ReadBatch class stores many reads in columns: one contiguous
+///        buffer each for bases, qualities, pulse widths, IPDs, and CIGARs,
+///        indexed by offset arrays, plus one array per scalar field.
+///
+/// Movie names and models are interned, as most reads of a batch share them.
+/// Reads are added by copy and read back through ReadView/MappedReadView, or
+/// converted back to Read/MappedRead. Plain reads have default mapping fields
+/// (unmapped, no CIGAR).
+///
+class ReadBatch
+{
+public:
+    ReadBatch() = default;
+    explicit ReadBatch(const std::vector<Read>& reads);
+    explicit ReadBatch(const std::vector<MappedRead>& reads);
+
+public:
+    void Add(const Read& read);
+    void Add(const MappedRead& read);
+
+    /// Reserves storage for 'numReads' reads totalling 'numBases' bases, with
+    /// qualities & kinetics.
+    void Reserve(std::size_t numReads, std::size_t numBases);
+
+    /// Removes all reads, keeping allocated storage for reuse.
+    void Clear();
+
+    std::size_t Size() const;
+    bool Empty() const;
+
+    /// \returns total number of bases over all reads
+    std::size_t NumBases() const;
+
+    ReadView operator[](std::size_t i) const;
+    MappedReadView Mapped(std::size_t i) const;
+
+    Read ToRead(std::size_t i) const;
+    MappedRead ToMappedRead(std::size_t i) const;
+    std::vector<Read> ToReads() const;
+    std::vector<MappedRead> ToMappedReads() const;
+
+private:
+    friend class ReadView;
+    friend class MappedReadView;
+
+    // variable-length field of every read, stored back to back
+    template <typename T>
+    struct RaggedColumn
+    {
+        std::vector<T> Data;
+        std::vector<std::size_t> Offsets{0};
+
+        template <typename It>
+        void Add(It first, It last)
+        {
+            Data.insert(Data.end(), first, last);
+            Offsets.push_back(Data.size());
+        }
+
+        std::span<const T> Get(std::size_t i) const
+        {
+            return {Data.data() + Offsets[i], Offsets[i + 1] - Offsets[i]};
+        }
+
+        void Clear()
+        {
+            Data.clear();
+            Offsets.resize(1);
+        }
+    };
+
+    enum Bits : std::uint8_t
+    {
+        HAS_PULSE_WIDTH = 1,
+        HAS_IPD = 2,
+        HAS_ZMW_INTERVAL = 4,
+        FULL_LENGTH = 8,
+        PIN_START = 16,
+        PIN_END = 32,
+    };
+
+    std::uint32_t Intern(const std::string& s, const std::vector<std::uint32_t>& column);
+    void AddRead(const Read& read, std::uint8_t bits);
+
+    // base-level
+    RaggedColumn<char> seqs_;
+    RaggedColumn<QualityValue> qualities_;
+    RaggedColumn<std::uint16_t> pulseWidths_;
+    RaggedColumn<std::uint16_t> ipds_;
+
+    // per read
+    std::vector<std::uint8_t> bits_;
+    std::vector<std::uint32_t> movieNames_;  // into strings_
+    std::vector<std::size_t> holeNumbers_;
+    std::vector<Position> zmwStarts_;
+    std::vector<Position> zmwEnds_;
+    RaggedColumn<char> readNames_;
+    std::vector<Position> queryStarts_;
+    std::vector<Position> queryEnds_;
+    std::vector<LocalContextFlags> flags_;
+    std::vector<float> accuracies_;
+    std::vector<SNR> snrs_;
+    std::vector<std::uint32_t> models_;  // into strings_
+
+    // mapping
+    std::vector<std::int32_t> refIds_;
+    std::vector<Data::Strand> strands_;
+    std::vector<Position> templateStarts_;
+    std::vector<Position> templateEnds_;
+    std::vector<std::uint8_t> mapQualities_;
+    RaggedColumn<CigarOperation> cigars_;
+
+    // interned movie names & models
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, std::uint32_t> stringIndex_;
+};
+
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_READBATCH_H
@@ -5,6 +5,8 @@
 
 #include <pbcopper/data/Clipping.h>
 
+#include <utility>
+
 #include <cstddef>
 
 namespace PacBio {
@@ -15,6 +17,76 @@ struct MappedRead;
 
 namespace internal {
 
+///
+/// Position within a CIGAR, walking it in reference order. Seeks are cheapest
+/// when moving forward; seeking backward restarts from the beginning.
+///
+class CigarCursor
+{
+public:
+    explicit CigarCursor(const Cigar& cigar) noexcept;
+
+    // Moves to the first point at which 'refPos' reference positions have been
+    // consumed, before any following ops that don't consume the reference.
+    void SeekFirst(std::size_t refPos);
+
+    // Moves to the last such point, after any following ops that don't
+    // consume the reference.
+    void SeekLast(std::size_t refPos);
+
+    std::size_t Index = 0;   // CIGAR op
+    std::size_t Offset = 0;  // within op
+    std::size_t QueryPos = 0;
+    std::size_t RefPos = 0;
+
+private:
+    const Cigar* cigar_;
+};
+
+///
+/// Clips one CIGAR to reference windows, as ClipToReference. Clipping windows
+/// in order of start & end walks the CIGAR only once.
+///
+class ReferenceClipper
+{
+public:
+    ReferenceClipper(const Cigar& cigar, Strand strand, bool exciseFlankingInserts);
+
+    // 'read' must own the clipper's CIGAR
+    ClipSpan Clip(const MappedRead& read, Position start, Position end);
+
+    // Clips to reference positions [startOffset, endOffset) of the alignment,
+    // storing the CIGAR part of 'span'. Returns query positions removed from
+    // start & end of the query.
+    std::pair<std::size_t, std::size_t> Clip(std::size_t startOffset, std::size_t endOffset,
+                                             ClipSpan& span);
+
+    // Returns the end offset left after clipping 'endClipped' reference
+    // positions from the end of the alignment.
+    std::size_t EndOffset(std::size_t startOffset, std::size_t endClipped) const;
+
+private:
+    const Cigar& cigar_;
+    Strand strand_;
+    bool exciseFlankingInserts_;
+    std::size_t queryLength_;
+    std::size_t referenceLength_;
+    CigarCursor front_;
+    CigarCursor back_;
+};
+
+// Locate a clip without modifying 'read'. Query clips are limited to the
+// read's query range.
+ClipSpan QueryClipSpan(const Read& read, Position start, Position end);
+ClipSpan QueryClipSpan(const MappedRead& read, Position start, Position end);
+ClipSpan ReferenceClipSpan(const MappedRead& read, Position start, Position end,
+                           bool exciseFlankingInserts);
+
+// Trim to a clip in place, moving data within the existing storage
+void ClipCigar(Cigar& cigar, const ClipSpan& span);
+void ClipRead(Read& read, const ClipSpan& span);
+void ClipMappedRead(MappedRead& read, const ClipSpan& span);
+
 void ClipRead(Read& read, const ClipResult& result, std::size_t start, std::size_t end);
 
 // NOTE: 'result' is moved into here, so we can take the CIGAR
@@ -0,0 +1,90 @@
+#ifndef PBCOPPER_POA_BATCHCONSENSUS_H
+#define PBCOPPER_POA_BATCHCONSENSUS_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/align/AlignConfig.h>
+#include <pbcopper/poa/PoaConsensus.h>
+#include <pbcopper/poa/PoaGraph.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <climits>
+#include <cstddef>
+
+namespace PacBio {
+namespace Poa {
+
+struct BatchConsensusOptions
+{
+    Align::AlignConfig Config = DefaultPoaConfig();
+    int MinCoverage = -INT_MAX;
+
+    // 0: all hardware threads
+    unsigned int NumThreads = 0;
+
+    // Groups with at least this many reads (0: none) are drafted: the read of
+    // median length goes in first, and the others are aligned against the
+    // graph in rounds of DraftRoundSize reads, which run in parallel once two or
+    // more threads are left idle at the end of a batch, and are then threaded
+    // in input order.
+    std::size_t DraftMinReads = 0;
+    std::size_t DraftRoundSize = 8;
+};
+
+///
+/// \brief The BatchConsensus class computes the POA consensus of many
+///        independent read groups (e.g. the subreads of many ZMWs) on a
+///        thread pool.
+///
+/// Each worker thread reuses one PoaGraph across its groups. Results are
+/// handed back in input order, as soon as each one and all before it are
+/// done.
+///
+/// Without drafting, each group's consensus equals that of
+/// PoaConsensus::FindConsensus(reads, Config, MinCoverage). Drafted groups
+/// can differ slightly, as reads in a round don't see each other, but do not
+/// depend on the number of threads.
+///
+class BatchConsensus
+{
+public:
+    using ResultCallback =
+        std::function<void(std::size_t groupIndex, std::unique_ptr<const PoaConsensus>)>;
+
+public:
+    explicit BatchConsensus(BatchConsensusOptions options = {});
+    ~BatchConsensus();
+
+    ///
+    /// Computes the consensus of each group, calling \p callback on the
+    /// calling thread with each result, in input order.
+    ///
+    /// Exceptions from a group (e.g. std::invalid_argument for an empty read)
+    /// or from \p callback stop the batch and are rethrown.
+    ///
+    void Run(const std::vector<std::vector<std::string>>& groups, const ResultCallback& callback);
+
+    ///
+    /// \return consensus of each group
+    ///
+    std::vector<std::unique_ptr<const PoaConsensus>> FindConsensus(
+        const std::vector<std::vector<std::string>>& groups);
+
+    const BatchConsensusOptions& Options() const;
+
+private:
+    struct Workspace;
+
+    BatchConsensusOptions options_;
+    unsigned int numThreads_;
+    std::vector<std::unique_ptr<Workspace>> workspaces_;
+};
+
+}  // namespace Poa
+}  // namespace PacBio
+
+#endif  // PBCOPPER_POA_BATCHCONSENSUS_H
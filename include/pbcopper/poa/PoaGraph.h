@@ -47,6 +47,14 @@ public:
 
     static const Vertex NullVertex = std::numeric_limits<Vertex>::max();
 
+    // A read base threaded through the vertex at PathIndex of some path
+    struct ReadPointer
+    {
+        std::size_t PathIndex;
+        ReadId Read;
+        std::size_t ReadPosition;
+    };
+
 public:  // Flags enums for specifying GraphViz output features
     enum
     {
@@ -86,6 +94,26 @@ public:
 
     void PruneGraph(int minCoverage);
 
+    //
+    // Read pointers: the read bases threaded through each vertex. Off by
+    // default, as they take 12 bytes per read base; must be enabled before
+    // any reads are added.
+    //
+    void EnableReadPointers();
+    bool HasReadPointers() const;
+
+    //
+    // Read bases threaded through the vertices of 'path', ordered by path
+    // index, then by read. Answers extent and pileup queries in time
+    // proportional to the path and its coverage.
+    //
+    std::vector<ReadPointer> ReadPointersAlong(const std::vector<Vertex>& path) const;
+
+    //
+    // Removes all reads, keeping allocated storage for the next graph
+    //
+    void Clear();
+
     // ----------
 
     std::size_t NumReads() const;
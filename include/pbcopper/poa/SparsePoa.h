@@ -12,6 +12,8 @@
 #include <string>
 #include <vector>
 
+#include <cstddef>
+
 namespace PacBio {
 
 // fwd decls
@@ -120,10 +122,8 @@ private:
     void repCheck();
 
 private:
-    using Path = std::vector<PoaGraph::Vertex>;
-
     std::unique_ptr<PoaGraph> graph_;
-    std::vector<Path> readPaths_;
+    std::vector<std::size_t> readLengths_;
     std::vector<bool> reverseComplemented_;
     std::unique_ptr<SdpRangeFinder> rangeFinder_;
 };
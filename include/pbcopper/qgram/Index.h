@@ -44,12 +44,56 @@ public:
     ///
     Index(std::size_t q, std::vector<std::string> seqs);
 
+    ///
+    /// \brief Index
+    /// \param[in] q            q-gram size
+    /// \param[in] seq          construct index from this sequence
+    /// \param[in] numThreads   number of threads used for construction (0 = all
+    ///                         available), also used by Append
+    /// \throws std::runtime_error if q-gram == 0
+    ///
+    Index(std::size_t q, std::string seq, unsigned int numThreads);
+
+    ///
+    /// \brief Index
+    /// \param[in] q            q-gram size
+    /// \param[in] seqs         construct index from these sequences
+    /// \param[in] numThreads   number of threads used for construction (0 = all
+    ///                         available), also used by Append
+    /// \throws std::runtime_error if q-gram == 0
+    ///
+    Index(std::size_t q, std::vector<std::string> seqs, unsigned int numThreads);
+
     Index(const Index& other);
     Index(Index&&) noexcept;
     Index& operator=(const Index& other);
     Index& operator=(Index&&) noexcept;
     ~Index();
 
+public:
+    ///
+    /// \brief Append
+    ///
+    /// Adds a sequence to the index, with the next sequence id. Only the new
+    /// q-grams are hashed, existing hits are shifted in place. The result is
+    /// the same as building the index from all sequences at once.
+    ///
+    /// \param[in] seq  sequence to add
+    /// \throws std::invalid_argument if seq is shorter than q (index is unchanged)
+    ///
+    void Append(std::string seq);
+
+    ///
+    /// \brief Append
+    ///
+    /// Adds sequences to the index, with consecutive sequence ids.
+    ///
+    /// \param[in] seqs  sequences to add
+    /// \throws std::invalid_argument if any sequence is shorter than q (index
+    ///         is unchanged)
+    ///
+    void Append(std::vector<std::string> seqs);
+
 public:
     ///
     /// \brief Hits
@@ -0,0 +1,107 @@
+#ifndef PBCOPPER_QGRAM_MINIMIZERINDEX_H
+#define PBCOPPER_QGRAM_MINIMIZERINDEX_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/qgram/IndexHits.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace QGram {
+
+namespace internal {
+class MinimizerIndexImpl;
+}
+
+///
+/// \brief The MinimizerIndex class provides retrieval of the (w,k)-minimizer
+///        occurrences in the input sequence(s).
+///
+/// Only the smallest (hashed) k-mer of every window of w consecutive k-mers is
+/// stored, roughly 2/(w+1) of all positions. Queries are sampled the same way,
+/// so any shared stretch of at least (w + k - 1) bases yields at least one hit.
+/// Unlike Index, memory does not depend on 4^k, so k may be up to 32.
+///
+/// Minimizers occurring more than 'maxOccurrences' times across all input
+/// sequences are considered repeats and masked from the index.
+///
+/// Algorithm adapted from:
+///     Roberts et al., "Reducing storage requirements for biological
+///     sequence comparison", Bioinformatics 2004
+///
+class MinimizerIndex
+{
+public:
+    ///
+    /// \brief MinimizerIndex
+    /// \param[in] k                k-mer size
+    /// \param[in] w                window size, in k-mers
+    /// \param[in] seq              construct index from this sequence
+    /// \param[in] maxOccurrences   mask minimizers occurring more often than
+    ///                             this (0 disables masking)
+    /// \throws std::invalid_argument if k is not in [1,32] or w == 0
+    ///
+    MinimizerIndex(std::size_t k, std::size_t w, std::string seq, std::size_t maxOccurrences = 0);
+
+    ///
+    /// \brief MinimizerIndex
+    /// \param[in] k                k-mer size
+    /// \param[in] w                window size, in k-mers
+    /// \param[in] seqs             construct index from these sequences,
+    ///                             sequences shorter than k contribute no hits
+    /// \param[in] maxOccurrences   mask minimizers occurring more often than
+    ///                             this (0 disables masking)
+    /// \throws std::invalid_argument if k is not in [1,32] or w == 0
+    ///
+    MinimizerIndex(std::size_t k, std::size_t w, const std::vector<std::string>& seqs,
+                   std::size_t maxOccurrences = 0);
+
+    MinimizerIndex(const MinimizerIndex& other);
+    MinimizerIndex(MinimizerIndex&&) noexcept;
+    MinimizerIndex& operator=(const MinimizerIndex& other);
+    MinimizerIndex& operator=(MinimizerIndex&&) noexcept;
+    ~MinimizerIndex();
+
+public:
+    ///
+    /// \brief Hits
+    /// \param[in] seq                  query sequence
+    /// \param[in] filterHomopolymers   do not count hits on homopolymers (len == k)
+    /// \return a vector of IndexHits results, one per query minimizer found in
+    ///         the index
+    ///
+    std::vector<IndexHits> Hits(const std::string& seq, bool filterHomopolymers = false) const;
+
+    ///
+    /// \brief NumHits
+    /// \return total number of minimizer occurrences stored
+    ///
+    std::size_t NumHits() const;
+
+    ///
+    /// \brief Size
+    /// \return k-mer size
+    ///
+    std::size_t Size() const;
+
+    ///
+    /// \brief WindowSize
+    /// \return window size (in k-mers)
+    ///
+    std::size_t WindowSize() const;
+
+private:
+    std::unique_ptr<internal::MinimizerIndexImpl> d_;
+};
+
+}  // namespace QGram
+}  // namespace PacBio
+
+#include <pbcopper/qgram/internal/MinimizerIndex-inl.h>
+
+#endif  // PBCOPPER_QGRAM_MINIMIZERINDEX_H
@@ -3,12 +3,18 @@
 
 #include <pbcopper/PbcopperConfig.h>
 
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
 #include <pbcopper/qgram/Index.h>
 #include <pbcopper/qgram/internal/Hashing-inl.h>
 #include <pbcopper/utility/MoveAppend.h>
 #include <pbcopper/utility/SafeSubtract.h>
 
+#include <algorithm>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 
 #include <cstdint>
 
@@ -24,15 +30,19 @@ public:
 
 public:
     // ctor
-    IndexImpl(std::size_t q, std::vector<std::string> seqs);
+    IndexImpl(std::size_t q, std::vector<std::string> seqs, unsigned int numThreads = 1);
 
     // index lookup API
     IndexHit Hit(const Shape& shape) const;
     IndexHits Hits(const Shape& shape, std::size_t queryPos) const;
     std::vector<IndexHits> Hits(const std::string& seq, bool filterHomopolymers) const;
 
+    // index update API
+    void Append(std::vector<std::string> seqs);
+
     // "private" method(s) - index construction
     void Init();
+    void Insert(std::size_t firstSeq);
 
     // "private" method(s) - purely for testing access
     const HashLookup_t& HashLookup() const;
@@ -44,16 +54,35 @@ private:
     std::vector<std::string> seqs_;  // underlying text
     SuffixArray_t suffixArray_;      // suffix array sorted by the first q chars
     HashLookup_t hashLookup_;        // hash value -> SA index
+    unsigned int numThreads_;        // max threads used for (re-)building the index
 };
 
-inline IndexImpl::IndexImpl(std::size_t q, std::vector<std::string> seqs)
-    : q_{q}, seqs_{std::move(seqs)}
+inline IndexImpl::IndexImpl(std::size_t q, std::vector<std::string> seqs,
+                            const unsigned int numThreads)
+    : q_{q}, seqs_{std::move(seqs)}, numThreads_{numThreads}
 {
     Init();
 }
 
 inline const IndexImpl::HashLookup_t& IndexImpl::HashLookup() const { return hashLookup_; }
 
+inline void IndexImpl::Append(std::vector<std::string> seqs)
+{
+    const std::size_t firstSeq = seqs_.size();
+    seqs_.reserve(seqs_.size() + seqs.size());
+    for (auto& seq : seqs) {
+        seqs_.push_back(std::move(seq));
+    }
+
+    try {
+        Insert(firstSeq);
+    } catch (...) {
+        // leave index untouched on invalid input
+        seqs_.resize(firstSeq);
+        throw;
+    }
+}
+
 inline void IndexImpl::Init()
 {
     if (q_ == 0 || q_ > 16) {
@@ -61,52 +90,202 @@ inline void IndexImpl::Init()
                                     ") must be in the range [1,16]"};
     }
 
-    // init hash lookup (and calculate totalNumQGrams for later suffixArray)
-    const auto lookupSize = static_cast<std::size_t>(std::pow(4, q_) + 1);
-    hashLookup_.resize(lookupSize, 0);
-    std::uint32_t totalNumQGrams = 0;
-    for (const auto& seq : seqs_) {
+    // start from an empty index: hashLookup_[h] is the SA index of the first hit
+    // for hash value h, with a trailing sentinel holding the total hit count
+    const std::size_t lookupSize = (std::size_t{1} << (2 * q_)) + 1;
+    hashLookup_.assign(lookupSize, 0);
+    suffixArray_.clear();
+    Insert(0);
+}
+
+//
+// Adds the q-grams of seqs_[firstSeq, end) to the index, keeping hits within each
+// q-gram sorted by (sequence, position), i.e. the same result as a full rebuild.
+//
+// When the new hits take less memory than a histogram of all 4^q buckets (a
+// typical Append), they are sorted by hash and merged into the suffix array
+// back to front, which only touches the buckets from the smallest new hash on.
+//
+// Otherwise, the new q-grams are split into contiguous ranges, one per thread.
+// Each thread counts its range into a private histogram, the histograms are
+// merged into per-thread write offsets by a prefix sum over (bucket, thread),
+// existing buckets are shifted into their final place, and each thread then
+// scatters its range into the suffix array. Threads are limited so that their
+// histograms never outgrow the new suffix array entries. A single thread
+// filling an empty index counts straight into hashLookup_ instead.
+//
+inline void IndexImpl::Insert(const std::size_t firstSeq)
+{
+    constexpr std::uint64_t MIN_QGRAMS_PER_THREAD = 1 << 16;
 
-        const auto seqLength = seq.size();
+    // check input & locate each new sequence's first q-gram in the global range
+    std::vector<std::uint64_t> seqStarts;
+    std::uint64_t numNewQGrams = 0;
+    for (std::size_t i = firstSeq; i < seqs_.size(); ++i) {
+        const auto seqLength = seqs_[i].size();
         if (seqLength < q_) {
             throw std::invalid_argument{"[pbcopper] qgram ERROR: sequence size (" +
                                         std::to_string(seqLength) + ") must be >= q (" +
                                         std::to_string(q_)};
         }
+        seqStarts.push_back(numNewQGrams);
+        numNewQGrams += seqLength - q_ + 1;
+    }
+    if (numNewQGrams == 0) {
+        return;
+    }
 
-        const auto numQGrams = seqLength - q_ + 1;
-        Shape shape{q_, seq};
-        for (std::size_t i = 0; i < numQGrams; ++i) {
-            ++hashLookup_[shape.HashNext()];
+    const std::size_t numBuckets = hashLookup_.size() - 1;
+    const std::uint64_t hashMask = numBuckets - 1;
+
+    // calls 'callback' for new q-grams [begin, end), in (sequence, position) order
+    const auto forEachQGram = [&](std::uint64_t begin, const std::uint64_t end, auto&& callback) {
+        std::size_t s =
+            std::upper_bound(seqStarts.cbegin(), seqStarts.cend(), begin) - seqStarts.cbegin() - 1;
+        for (; begin < end; ++s) {
+            const std::string& seq = seqs_[firstSeq + s];
+            const std::uint64_t posEnd =
+                std::min<std::uint64_t>(seq.size() - q_ + 1, end - seqStarts[s]);
+            std::uint64_t pos = begin - seqStarts[s];
+            std::uint64_t hash = 0;
+            for (std::size_t k = 0; k + 1 < q_; ++k) {
+                hash = (hash << 2) | BaseCode(seq[pos + k]);
+            }
+            for (; pos < posEnd; ++pos) {
+                hash = ((hash << 2) | BaseCode(seq[pos + q_ - 1])) & hashMask;
+                callback(static_cast<std::uint32_t>(firstSeq + s), pos, hash);
+            }
+            begin = seqStarts[s] + posEnd;
+        }
+    };
+
+    const std::uint64_t oldTotal = hashLookup_[numBuckets];
+    suffixArray_.resize(oldTotal + numNewQGrams);
+    hashLookup_[numBuckets] = oldTotal + numNewQGrams;
+
+    using HashedHit = std::pair<std::uint64_t, IndexHit>;
+    if (numNewQGrams * sizeof(HashedHit) < numBuckets * sizeof(std::uint32_t)) {
+        std::vector<HashedHit> newHits;
+        newHits.reserve(numNewQGrams);
+        forEachQGram(0, numNewQGrams,
+                     [&newHits](const std::uint32_t seqNo, const std::uint64_t pos,
+                                const std::uint64_t hash) {
+                         newHits.emplace_back(hash, IndexHit{seqNo, pos});
+                     });
+        std::stable_sort(newHits.begin(), newHits.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        // each bucket is its existing hits followed by its new ones
+        std::size_t numNewLeft = newHits.size();
+        std::uint64_t write = oldTotal + numNewQGrams;
+        std::uint64_t oldEnd = oldTotal;
+        for (std::size_t h = numBuckets; h-- > 0;) {
+            if (numNewLeft == 0) {
+                break;  // buckets further left do not move
+            }
+            while ((numNewLeft > 0) && (newHits[numNewLeft - 1].first == h)) {
+                suffixArray_[--write] = newHits[--numNewLeft].second;
+            }
+            const std::uint64_t oldBegin = hashLookup_[h];
+            if (write > oldEnd) {
+                std::move_backward(suffixArray_.begin() + oldBegin, suffixArray_.begin() + oldEnd,
+                                   suffixArray_.begin() + write);
+            }
+            write -= oldEnd - oldBegin;
+            hashLookup_[h] = write;
+            oldEnd = oldBegin;
         }
-        totalNumQGrams += numQGrams;
+        return;
     }
 
-    // update hash lookup values (cumulative sum along the table)
-    std::uint64_t prevDiff = 0;
-    std::uint64_t prevDiff2 = 0;
-    std::uint64_t sum = 0;
-    for (auto& hash : hashLookup_) {
-        sum += prevDiff2;
-        prevDiff2 = prevDiff;
-        prevDiff = hash;
-        hash = sum;
+    const unsigned int maxThreads =
+        (numThreads_ == 0 ? ::PacBio::Parallel::NormalizedThreadCount(0) : numThreads_);
+    const std::uint64_t maxHistograms =
+        (numNewQGrams * sizeof(IndexHit)) / (numBuckets * sizeof(std::uint32_t));
+    const std::size_t numThreads = static_cast<std::size_t>(std::clamp<std::uint64_t>(
+        std::min(numNewQGrams / MIN_QGRAMS_PER_THREAD, maxHistograms), 1, maxThreads));
+
+    if ((numThreads == 1) && (oldTotal == 0)) {
+        // counts become bucket starts, then write cursors, which end up at the
+        // start of the following bucket
+        forEachQGram(0, numNewQGrams,
+                     [this](std::uint32_t, std::uint64_t, const std::uint64_t hash) {
+                         ++hashLookup_[hash];
+                     });
+        std::exclusive_scan(hashLookup_.begin(), hashLookup_.end() - 1, hashLookup_.begin(),
+                            std::uint64_t{0});
+        IndexHit* sa = suffixArray_.data();
+        forEachQGram(0, numNewQGrams,
+                     [this, sa](const std::uint32_t seqNo, const std::uint64_t pos,
+                                const std::uint64_t hash) {
+                         sa[hashLookup_[hash]++] = IndexHit{seqNo, pos};
+                     });
+        std::copy_backward(hashLookup_.begin(), hashLookup_.end() - 2, hashLookup_.end() - 1);
+        hashLookup_[0] = 0;
+        return;
     }
 
-    // init suffix array
-    suffixArray_.resize(totalNumQGrams);
-    std::uint32_t seqNo = 0;
-    for (const auto& seq : seqs_) {
-        const auto seqLength = seq.size();
+    const auto threadRange = [numNewQGrams, numThreads](const std::size_t thread) {
+        return std::pair{numNewQGrams * thread / numThreads,
+                         numNewQGrams * (thread + 1) / numThreads};
+    };
+    std::optional<Parallel::FireAndForget> faf;
+    if (numThreads > 1) {
+        faf.emplace(numThreads);
+    }
+    Parallel::FireAndForget* const pool = (faf ? &*faf : nullptr);
+
+    // count q-grams per bucket
+    std::vector<std::uint32_t> histograms(numThreads * numBuckets, 0);
+    Parallel::Dispatch(pool, static_cast<std::int32_t>(numThreads), [&](const std::int32_t thread) {
+        std::uint32_t* histogram = histograms.data() + (thread * numBuckets);
+        const auto [begin, end] = threadRange(thread);
+        forEachQGram(begin, end, [histogram](std::uint32_t, std::uint64_t, std::uint64_t hash) {
+            ++histogram[hash];
+        });
+    });
+
+    // turn counts into per-thread write offsets, shifting existing buckets
+    // (back to front, so nothing is overwritten before it moves)
+    std::uint64_t numNewBefore = numNewQGrams;
+    std::uint64_t oldEnd = oldTotal;
+    for (std::size_t h = numBuckets; h-- > 0;) {
+        std::uint64_t numNewInBucket = 0;
+        for (std::size_t t = 0; t < numThreads; ++t) {
+            numNewInBucket += histograms[(t * numBuckets) + h];
+        }
+        numNewBefore -= numNewInBucket;
 
-        Shape shape{q_, seq};
-        const auto numQGrams = seqLength - q_ + 1;
-        for (std::uint32_t i = 0; i < numQGrams; ++i) {
-            suffixArray_[hashLookup_[shape.HashNext() + 1]++] = IndexHit{seqNo, i};
+        const std::uint64_t oldBegin = hashLookup_[h];
+        const std::uint64_t newBegin = oldBegin + numNewBefore;
+        if (numNewBefore > 0 && oldEnd > oldBegin) {
+            std::move_backward(suffixArray_.begin() + oldBegin, suffixArray_.begin() + oldEnd,
+                               suffixArray_.begin() + newBegin + (oldEnd - oldBegin));
         }
 
-        ++seqNo;
+        auto offset = static_cast<std::uint32_t>(newBegin + (oldEnd - oldBegin));
+        for (std::size_t t = 0; t < numThreads; ++t) {
+            auto& count = histograms[(t * numBuckets) + h];
+            const auto n = count;
+            count = offset;
+            offset += n;
+        }
+
+        hashLookup_[h] = newBegin;
+        oldEnd = oldBegin;
     }
+
+    // scatter new hits
+    Parallel::Dispatch(pool, static_cast<std::int32_t>(numThreads), [&](const std::int32_t thread) {
+        std::uint32_t* offsets = histograms.data() + (thread * numBuckets);
+        IndexHit* sa = suffixArray_.data();
+        const auto [begin, end] = threadRange(thread);
+        forEachQGram(begin, end,
+                     [offsets, sa](const std::uint32_t seqNo, const std::uint64_t pos,
+                                   const std::uint64_t hash) {
+                         sa[offsets[hash]++] = IndexHit{seqNo, pos};
+                     });
+    });
 }
 
 inline IndexHit IndexImpl::Hit(const Shape& shape) const
@@ -164,6 +343,14 @@ inline Index::Index(std::size_t q, std::vector<std::string> seqs)
     : d_{std::make_unique<internal::IndexImpl>(q, std::move(seqs))}
 {}
 
+inline Index::Index(std::size_t q, std::string seq, unsigned int numThreads)
+    : Index{q, std::vector<std::string>{std::move(seq)}, numThreads}
+{}
+
+inline Index::Index(std::size_t q, std::vector<std::string> seqs, unsigned int numThreads)
+    : d_{std::make_unique<internal::IndexImpl>(q, std::move(seqs), numThreads)}
+{}
+
 inline Index::Index(const Index& other) : d_{std::make_unique<internal::IndexImpl>(*other.d_)} {}
 
 inline Index::Index(Index&&) noexcept = default;
@@ -180,6 +367,18 @@ inline Index& Index::operator=(Index&&) noexcept = default;
 
 inline Index::~Index() = default;
 
+inline void Index::Append(std::string seq)
+{
+    assert(d_);
+    d_->Append(std::vector<std::string>{std::move(seq)});
+}
+
+inline void Index::Append(std::vector<std::string> seqs)
+{
+    assert(d_);
+    d_->Append(std::move(seqs));
+}
+
 inline std::vector<IndexHits> Index::Hits(const std::string& seq,
                                           const bool filterHomopolymers) const
 {
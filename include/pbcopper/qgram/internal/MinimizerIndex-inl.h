@@ -0,0 +1,333 @@
+#ifndef PBCOPPER_QGRAM_MINIMIZERINDEX_INL_H
+#define PBCOPPER_QGRAM_MINIMIZERINDEX_INL_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/qgram/MinimizerIndex.h>
+#include <pbcopper/qgram/internal/Hashing-inl.h>
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace QGram {
+namespace internal {
+
+struct Minimizer
+{
+    std::uint64_t hash;
+    std::uint64_t position;
+};
+
+// Invertible integer hash on the low 2k bits (T. Wang), so that distinct k-mers
+// keep distinct hashes while lexicographically small (A-rich) k-mers are no
+// longer favored as minimizers.
+inline std::uint64_t MinimizerHash(std::uint64_t key, const std::uint64_t mask)
+{
+    key = (~key + (key << 21)) & mask;
+    key = key ^ (key >> 24);
+    key = ((key + (key << 3)) + (key << 8)) & mask;
+    key = key ^ (key >> 14);
+    key = ((key + (key << 2)) + (key << 4)) & mask;
+    key = key ^ (key >> 28);
+    key = (key + (key << 31)) & mask;
+    return key;
+}
+
+inline void ValidateMinimizerParameters(const std::size_t k, const std::size_t w)
+{
+    if (k == 0 || k > 32) {
+        throw std::invalid_argument{"[pbcopper] qgram ERROR: minimizer k-mer size (" +
+                                    std::to_string(k) + ") must be in the range [1,32]"};
+    }
+    if (w == 0) {
+        throw std::invalid_argument{"[pbcopper] qgram ERROR: minimizer window size must be > 0"};
+    }
+}
+
+///
+/// Calls 'callback(minimizer, kmer)' for each (w,k)-minimizer of 'seq', in
+/// order of position. Ties within a window resolve to the leftmost k-mer, and a
+/// k-mer shared by consecutive windows is reported once. Sequences with fewer
+/// than w k-mers yield their single smallest k-mer.
+///
+template <typename Callback>
+void ForEachMinimizer(const std::size_t k, const std::size_t w, const std::string& seq,
+                      Callback&& callback)
+{
+    if (seq.size() < k) {
+        return;
+    }
+
+    const std::uint64_t mask = (k == 32 ? ~0ULL : ((1ULL << (2 * k)) - 1));
+    const std::size_t numKmers = seq.size() - k + 1;
+
+    // (minimizer, k-mer) candidates, increasing by hash
+    std::deque<std::pair<Minimizer, std::uint64_t>> window;
+    std::uint64_t lastReported = UINT64_MAX;
+    std::uint64_t kmer = 0;
+    for (std::size_t i = 0; i < k - 1; ++i) {
+        kmer = ((kmer << 2) | BaseCode(seq[i])) & mask;
+    }
+
+    for (std::size_t pos = 0; pos < numKmers; ++pos) {
+        kmer = ((kmer << 2) | BaseCode(seq[pos + k - 1])) & mask;
+        const Minimizer current{MinimizerHash(kmer, mask), pos};
+
+        while (!window.empty() && window.back().first.hash > current.hash) {
+            window.pop_back();
+        }
+        window.emplace_back(current, kmer);
+        if (window.front().first.position + w <= pos) {
+            window.pop_front();
+        }
+
+        if (pos + 1 >= w && window.front().first.position != lastReported) {
+            lastReported = window.front().first.position;
+            callback(window.front().first, window.front().second);
+        }
+    }
+
+    // sequence shorter than a single window
+    if (numKmers < w) {
+        callback(window.front().first, window.front().second);
+    }
+}
+
+///
+/// \return (w,k)-minimizers of 'seq'
+///
+inline std::vector<Minimizer> Minimizers(const std::size_t k, const std::size_t w,
+                                         const std::string& seq)
+{
+    ValidateMinimizerParameters(k, w);
+
+    std::vector<Minimizer> result;
+    result.reserve(2 * seq.size() / (w + 1) + 1);
+    ForEachMinimizer(k, w, seq,
+                     [&result](const Minimizer& m, std::uint64_t) { result.push_back(m); });
+    return result;
+}
+
+class MinimizerIndexImpl
+{
+public:
+    using Hits_t = std::vector<IndexHit>;
+
+    ///
+    /// \brief The Bucket struct maps a minimizer hash to its run of hits.
+    ///        Buckets with count == 0 are empty.
+    ///
+    struct Bucket
+    {
+        std::uint64_t hash = 0;
+        std::uint64_t begin = 0;
+        std::uint64_t count = 0;
+    };
+
+public:
+    // ctor
+    MinimizerIndexImpl(std::size_t k, std::size_t w, const std::vector<std::string>& seqs,
+                       std::size_t maxOccurrences);
+
+    // index lookup API
+    std::vector<IndexHits> Hits(const std::string& seq, bool filterHomopolymers) const;
+
+    std::size_t NumHits() const;
+    std::size_t Size() const;
+    std::size_t WindowSize() const;
+
+private:
+    const Bucket* Find(std::uint64_t hash) const;
+    void Init(const std::vector<std::string>& seqs, std::size_t maxOccurrences);
+
+private:
+    std::size_t k_;
+    std::size_t w_;
+    Hits_t hits_;                  // occurrences, grouped by minimizer
+    std::vector<Bucket> buckets_;  // open-addressing table, size is a power of 2
+};
+
+inline MinimizerIndexImpl::MinimizerIndexImpl(const std::size_t k, const std::size_t w,
+                                              const std::vector<std::string>& seqs,
+                                              const std::size_t maxOccurrences)
+    : k_{k}, w_{w}
+{
+    ValidateMinimizerParameters(k_, w_);
+    Init(seqs, maxOccurrences);
+}
+
+inline const MinimizerIndexImpl::Bucket* MinimizerIndexImpl::Find(const std::uint64_t hash) const
+{
+    const std::size_t slotMask = buckets_.size() - 1;
+    for (std::size_t slot = hash & slotMask;; slot = (slot + 1) & slotMask) {
+        const auto& bucket = buckets_[slot];
+        if (bucket.count == 0) {
+            return nullptr;
+        }
+        if (bucket.hash == hash) {
+            return &bucket;
+        }
+    }
+}
+
+inline std::vector<IndexHits> MinimizerIndexImpl::Hits(const std::string& seq,
+                                                       const bool filterHomopolymers) const
+{
+    std::vector<IndexHits> result;
+    HpHasher isHomopolymer(k_);
+    ForEachMinimizer(k_, w_, seq, [&](const Minimizer& m, const std::uint64_t kmer) {
+        if (filterHomopolymers && isHomopolymer(kmer)) {
+            return;
+        }
+        if (const Bucket* bucket = Find(m.hash)) {
+            result.emplace_back(&hits_, bucket->begin, bucket->begin + bucket->count, m.position);
+        }
+    });
+    return result;
+}
+
+inline void MinimizerIndexImpl::Init(const std::vector<std::string>& seqs,
+                                     const std::size_t maxOccurrences)
+{
+    // collect all minimizers, tagged with their sequence
+    struct Occurrence
+    {
+        std::uint64_t hash;
+        IndexHit hit;
+    };
+    std::vector<Occurrence> occurrences;
+    std::size_t totalLength = 0;
+    for (const auto& seq : seqs) {
+        totalLength += seq.size();
+    }
+    occurrences.reserve(2 * totalLength / (w_ + 1) + seqs.size());
+
+    std::uint32_t seqNo = 0;
+    for (const auto& seq : seqs) {
+        ForEachMinimizer(k_, w_, seq, [&](const Minimizer& m, std::uint64_t) {
+            occurrences.push_back({m.hash, IndexHit{seqNo, m.position}});
+        });
+        ++seqNo;
+    }
+
+    // group by minimizer (input order is kept within a group)
+    std::stable_sort(
+        occurrences.begin(), occurrences.end(),
+        [](const Occurrence& lhs, const Occurrence& rhs) { return lhs.hash < rhs.hash; });
+
+    std::size_t numGroups = 0;
+    for (std::size_t i = 0; i < occurrences.size(); ++i) {
+        if (i == 0 || occurrences[i].hash != occurrences[i - 1].hash) {
+            ++numGroups;
+        }
+    }
+
+    // size table for a load factor <= 0.5
+    std::size_t numBuckets = 1;
+    while (numBuckets < 2 * numGroups) {
+        numBuckets <<= 1;
+    }
+    buckets_.assign(numBuckets, Bucket{});
+    const std::size_t slotMask = numBuckets - 1;
+
+    hits_.clear();
+    hits_.reserve(occurrences.size());
+    for (std::size_t begin = 0; begin < occurrences.size();) {
+        const auto hash = occurrences[begin].hash;
+        std::size_t end = begin + 1;
+        while (end < occurrences.size() && occurrences[end].hash == hash) {
+            ++end;
+        }
+
+        // mask repeats
+        const std::size_t count = end - begin;
+        if (maxOccurrences == 0 || count <= maxOccurrences) {
+            std::size_t slot = hash & slotMask;
+            while (buckets_[slot].count != 0) {
+                slot = (slot + 1) & slotMask;
+            }
+            buckets_[slot] = Bucket{hash, hits_.size(), count};
+            for (std::size_t i = begin; i < end; ++i) {
+                hits_.push_back(occurrences[i].hit);
+            }
+        }
+        begin = end;
+    }
+    hits_.shrink_to_fit();
+}
+
+inline std::size_t MinimizerIndexImpl::NumHits() const { return hits_.size(); }
+
+inline std::size_t MinimizerIndexImpl::Size() const { return k_; }
+
+inline std::size_t MinimizerIndexImpl::WindowSize() const { return w_; }
+
+}  // namespace internal
+
+inline MinimizerIndex::MinimizerIndex(std::size_t k, std::size_t w, std::string seq,
+                                      std::size_t maxOccurrences)
+    : MinimizerIndex{k, w, std::vector<std::string>{std::move(seq)}, maxOccurrences}
+{}
+
+inline MinimizerIndex::MinimizerIndex(std::size_t k, std::size_t w,
+                                      const std::vector<std::string>& seqs,
+                                      std::size_t maxOccurrences)
+    : d_{std::make_unique<internal::MinimizerIndexImpl>(k, w, seqs, maxOccurrences)}
+{}
+
+inline MinimizerIndex::MinimizerIndex(const MinimizerIndex& other)
+    : d_{std::make_unique<internal::MinimizerIndexImpl>(*other.d_)}
+{}
+
+inline MinimizerIndex::MinimizerIndex(MinimizerIndex&&) noexcept = default;
+
+inline MinimizerIndex& MinimizerIndex::operator=(const MinimizerIndex& other)
+{
+    if (this != &other) {
+        *this = MinimizerIndex{other};
+    }
+    return *this;
+}
+
+inline MinimizerIndex& MinimizerIndex::operator=(MinimizerIndex&&) noexcept = default;
+
+inline MinimizerIndex::~MinimizerIndex() = default;
+
+inline std::vector<IndexHits> MinimizerIndex::Hits(const std::string& seq,
+                                                   const bool filterHomopolymers) const
+{
+    assert(d_);
+    return d_->Hits(seq, filterHomopolymers);
+}
+
+inline std::size_t MinimizerIndex::NumHits() const
+{
+    assert(d_);
+    return d_->NumHits();
+}
+
+inline std::size_t MinimizerIndex::Size() const
+{
+    assert(d_);
+    return d_->Size();
+}
+
+inline std::size_t MinimizerIndex::WindowSize() const
+{
+    assert(d_);
+    return d_->WindowSize();
+}
+
+}  // namespace QGram
+}  // namespace PacBio
+
+#endif  // PBCOPPER_QGRAM_MINIMIZERINDEX_INL_H
@@ -7,11 +7,16 @@
 #include <array>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #if __cplusplus >= 201703L
 #include <string_view>
 #endif
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -88,11 +93,9 @@ T Reversed(const T& input)
     return result;
 }
 
-inline void ReverseComplement(std::string& seq)
-{
-    std::transform(seq.begin(), seq.end(), seq.begin(), Complement);
-    Reverse(seq);
-}
+/// Reverse complement a DNA sequence in place, upper-casing it. Throws
+/// std::invalid_argument on the first invalid base, as Complement().
+void ReverseComplement(std::string& seq);
 
 inline std::string MaybeReverseComplement(std::string&& seq, bool reverse)
 {
@@ -102,22 +105,9 @@ inline std::string MaybeReverseComplement(std::string&& seq, bool reverse)
     return std::move(seq);
 }
 
-/// Reverse complement a DNA sequence case-sensitive
-inline void ReverseComplementCaseSens(std::string& seq)
-{
-    const std::string original = seq;
-    constexpr std::array<char, 128> RC_TABLE = {
-        4,  4, 4, 4, 4, 4, 4,  4,  4, 4, 4, 4, 4,  4,  4, 4,  4,  4, 4, 4,   4, 4,   4, 4, 4, 4,
-        4,  4, 4, 4, 4, 4, 32, 4,  4, 4, 4, 4, 4,  4,  4, 4,  42, 4, 4, 45,  4, 4,   4, 4, 4, 4,
-        4,  4, 4, 4, 4, 4, 4,  4,  4, 4, 4, 4, 4,  84, 4, 71, 4,  4, 4, 67,  4, 4,   4, 4, 4, 4,
-        78, 4, 4, 4, 4, 4, 65, 65, 4, 4, 4, 4, 4,  4,  4, 4,  4,  4, 4, 116, 4, 103, 4, 4, 4, 99,
-        4,  4, 4, 4, 4, 4, 4,  4,  4, 4, 4, 4, 97, 97, 4, 4,  4,  4, 4, 4,   4, 4,   4, 4};
-    std::string reverseCompl(original.length(), 'N');
-    for (std::uint32_t i = 0; i < original.length(); ++i) {
-        reverseCompl[original.length() - i - 1] = RC_TABLE[static_cast<unsigned char>(original[i])];
-    }
-    seq = reverseCompl;
-}
+/// Reverse complement a DNA sequence case-sensitive. Only ACGTUN, acgtu, gaps,
+/// and spaces are complemented; any other character becomes '\x04'.
+void ReverseComplementCaseSens(std::string& seq);
 
 inline std::string MaybeReverseComplementCaseSens(std::string&& seq, bool reverse)
 {
@@ -134,15 +124,59 @@ inline std::string ReverseComplemented(const std::string& input)
     return result;
 }
 
+/// Upper-case ASCII letters in place
+void ToUpper(std::string& seq);
+
 #if __cplusplus >= 201703L
-inline std::string_view ReverseComplement(const std::string_view input, char* output)
+/// Reverse complement 'input' into 'output', which must hold input.size()
+/// characters.
+std::string_view ReverseComplement(std::string_view input, char* output);
+
+///
+/// \returns position of the first character not accepted by Complement()
+///          (IUPAC nucleotide codes of either case, '-', or '*'), or
+///          std::string_view::npos if all are valid
+///
+std::size_t FindInvalidBase(std::string_view seq);
+#endif
+
+#if __cplusplus >= 202002L
+///
+/// Reverse complement a DNA sequence and reverse its per-base 'quals' in a
+/// single pass. 'quals' may be empty, or must match the sequence length.
+///
+void ReverseComplement(std::string& seq, std::span<std::uint8_t> quals);
+
+template <typename T>
+requires(
+    sizeof(typename T::value_type) == 1 &&
+    std::is_trivially_copyable_v<typename T::value_type>) void ReverseComplement(std::string& seq,
+                                                                                 T& quals)
 {
-    const std::size_t strLen = input.length();
-    for (std::size_t i = 0; i < strLen; ++i) {
-        output[i] = Complement(input[strLen - 1 - i]);
-    }
-    return {output, strLen};
+    ReverseComplement(
+        seq, std::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(quals.data()), quals.size()});
 }
+
+///
+/// Packs ACGT (either case) into 2 bits per base as NCBI2na (A=0, C=1, G=2,
+/// T=3), the first base in the most significant bits. 'packed' must hold
+/// (seq.size() + 3) / 4 bytes. Throws std::invalid_argument on other bases.
+///
+void PackTwoBit(std::string_view seq, std::span<std::uint8_t> packed);
+
+/// Unpacks seq.size() bases packed by PackTwoBit, as upper case.
+void UnpackTwoBit(std::span<const std::uint8_t> packed, std::span<char> seq);
+
+///
+/// Packs IUPAC nucleotide codes (either case, U as T) and '=' into 4 bits per
+/// base as in BAM ("=ACMGRSVTWYHKDBN"), the first base in the high nibble.
+/// 'packed' must hold (seq.size() + 1) / 2 bytes. Throws
+/// std::invalid_argument on other characters.
+///
+void PackFourBit(std::string_view seq, std::span<std::uint8_t> packed);
+
+/// Unpacks seq.size() bases packed by PackFourBit, as upper case.
+void UnpackFourBit(std::span<const std::uint8_t> packed, std::span<char> seq);
 #endif
 
 }  // namespace Utility
@@ -2,15 +2,22 @@
 
 #include <pbcopper/algorithm/internal/HeteroduplexUtils.h>
 #include <pbcopper/math/FishersExact.h>
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
 #include <pbcopper/utility/Ssize.h>
 
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 
 #include <cassert>
 #include <cstddef>
 
+#include "../../third-party/simde/x86/sse4.1.h"
+
 namespace PacBio {
 namespace Algorithm {
 namespace {
@@ -29,13 +36,13 @@ constexpr std::array<std::uint8_t, 256> BASE_TABLE{
     255,0,  255,1,   255,255,255,2,   255,255,255,255, 255,255,255,255,  // 79
     //               T
     255,255,255,255, 3,  255,255,255, 255,255,255,255, 255,255,255,255,  // 95
-    255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 111
-    255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 127
-
     //  a       c                g
-    255,0,  255,1,   255,255,255,2,   255,255,255,255, 255,255,255,255,  // 143
+    255,0,  255,1,   255,255,255,2,   255,255,255,255, 255,255,255,255,  // 111
     //               t
-    255,255,255,255, 3,  255,255,255, 255,255,255,255, 255,255,255,255,  // 159
+    255,255,255,255, 3,  255,255,255, 255,255,255,255, 255,255,255,255,  // 127
+
+    255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 143
+    255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 159
     255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 175
     255,255,255,255, 255,255,255,255, 255,255,255,255, 255,255,255,255,  // 191
 
@@ -62,6 +69,214 @@ double CalculatePValue(const int fwdCoverageCount, const int fwdMismatchCount,
     return Math::FishersExact(n11, n12, n21, n22);
 }
 
+[[noreturn]] void ThrowUnsupportedCigarOp(const Data::CigarOperationType opType)
+{
+    std::ostringstream msg;
+    msg << "encountered unsupported CIGAR op: '" << Data::CigarOperation::TypeToChar(opType) << "'";
+    throw std::runtime_error{msg.str()};
+}
+
+///
+/// Increments column BASE_TABLE[seq[j]] of the byte counters at pos + j, for
+/// j in [0, length). 16 bases at a time, each column subtracts its 0/-1
+/// comparison mask. A short tail is masked if 'readable' (>= length) bytes
+/// of 'seq' and the columns can be accessed.
+///
+void CountBases(const char* seq, const int length, const int readable,
+                const std::array<std::uint8_t*, 5>& columns, const int pos)
+{
+    const simde__m128i toUpper = simde_mm_set1_epi8(static_cast<char>(0xDF));
+    const auto count16 = [&](const int j, const simde__m128i lanes) {
+        const simde__m128i raw =
+            simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(seq + j));
+        const simde__m128i upper = simde_mm_and_si128(raw, toUpper);
+        for (int b = 0; b < 5; ++b) {
+            const simde__m128i mask = simde_mm_and_si128(
+                lanes, simde_mm_cmpeq_epi8((b < 4) ? upper : raw, simde_mm_set1_epi8(BASES[b])));
+            simde__m128i* const counts = reinterpret_cast<simde__m128i*>(columns[b] + pos + j);
+            simde_mm_storeu_si128(counts, simde_mm_sub_epi8(simde_mm_loadu_si128(counts), mask));
+        }
+    };
+
+    int j = 0;
+    for (; j + 16 <= length; j += 16) {
+        count16(j, simde_mm_set1_epi8(-1));
+    }
+    if ((j < length) && (j + 16 <= readable)) {
+        const simde__m128i laneIndices =
+            simde_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        count16(j, simde_mm_cmpgt_epi8(simde_mm_set1_epi8(length - j), laneIndices));
+        return;
+    }
+    for (; j < length; ++j) {
+        const std::uint8_t b = BASE_TABLE[static_cast<unsigned char>(seq[j])];
+        if (b < 5) {
+            ++columns[b][pos + j];
+        }
+    }
+}
+
+struct InsertionEvent
+{
+    std::int32_t Position;
+    std::string_view Sequence;
+};
+
+///
+/// Sequence with its first 8 bytes packed big-endian, which order short
+/// sequences like the sequences themselves
+///
+struct SortableSequence
+{
+    SortableSequence() = default;
+
+    explicit SortableSequence(const std::string_view seq) : Sequence{seq}
+    {
+        for (std::size_t i = 0; i < 8; ++i) {
+            Prefix = (Prefix << 8) | ((i < seq.size()) ? static_cast<unsigned char>(seq[i]) : 0);
+        }
+    }
+
+    bool operator<(const SortableSequence& other) const noexcept
+    {
+        if (Prefix != other.Prefix) {
+            return Prefix < other.Prefix;
+        }
+        return ((Sequence.size() > 8) || (other.Sequence.size() > 8)) &&
+               (Sequence < other.Sequence);
+    }
+
+    std::uint64_t Prefix = 0;
+    std::string_view Sequence;
+};
+
+///
+/// Pileup of a subset of reads, summed into the final StrandPileup.
+///
+/// Each read adds at most 1 per position and column, so base counts go to byte
+/// counters first, which are flushed into the full counts every 255 reads.
+/// Coverage is kept as differences, since each read covers one range.
+///
+struct PartialPileup
+{
+    explicit PartialPileup(const std::size_t refLength)
+        : CoverageChanges(refLength + 1), PotentialMismatches(refLength)
+    {
+        for (int b = 0; b < 5; ++b) {
+            Counts[b].resize(refLength);
+            PendingCounts[b].resize(refLength);
+        }
+    }
+
+    void Add(const std::string& seq, const Data::Cigar& cigar, const std::int32_t startPos)
+    {
+        const std::array<std::uint8_t*, 5> columns{PendingCounts[0].data(), PendingCounts[1].data(),
+                                                   PendingCounts[2].data(), PendingCounts[3].data(),
+                                                   PendingCounts[4].data()};
+        const int refLength = Utility::Ssize(PotentialMismatches);
+        int targetPos = startPos;
+        int queryPos = 0;
+
+        for (const auto& op : cigar) {
+            const auto opType = op.Type();
+            const int opLength = op.Length();
+
+            switch (opType) {
+                case Data::CigarOperationType::SEQUENCE_MISMATCH:
+                    std::fill_n(PotentialMismatches.begin() + targetPos, opLength, 1);
+                    [[fallthrough]];
+                case Data::CigarOperationType::SEQUENCE_MATCH:
+                    assert(targetPos + opLength <= refLength);
+                    CountBases(seq.data() + queryPos, opLength,
+                               std::min<int>(Utility::Ssize(seq) - queryPos, refLength - targetPos),
+                               columns, targetPos);
+                    break;
+                case Data::CigarOperationType::DELETION:
+                    assert(targetPos + opLength <= refLength);
+                    std::for_each(columns[4] + targetPos, columns[4] + targetPos + opLength,
+                                  [](std::uint8_t& c) { ++c; });
+                    std::fill_n(PotentialMismatches.begin() + targetPos, opLength, 1);
+                    break;
+                case Data::CigarOperationType::INSERTION:
+                    if (targetPos < refLength) {
+                        Insertions.push_back(
+                            {targetPos, std::string_view{seq.data() + queryPos,
+                                                         static_cast<std::size_t>(opLength)}});
+                    }
+                    break;
+
+                // Full ignore
+                case Data::CigarOperationType::SOFT_CLIP:       // fallthrough
+                case Data::CigarOperationType::HARD_CLIP:       // .
+                case Data::CigarOperationType::REFERENCE_SKIP:  // .
+                case Data::CigarOperationType::PADDING:         // .
+                    break;
+                default:
+                    ThrowUnsupportedCigarOp(opType);
+            }
+
+            if (Data::ConsumesReference(opType)) {
+                targetPos += opLength;
+            }
+            if (Data::ConsumesQuery(opType)) {
+                queryPos += opLength;
+            }
+        }
+
+        if (targetPos > startPos) {
+            ++CoverageChanges[startPos];
+            --CoverageChanges[targetPos];
+            PendingBegin = std::min(PendingBegin, startPos);
+            PendingEnd = std::max(PendingEnd, targetPos);
+        }
+        if (++NumPendingReads == 255) {
+            Flush();
+        }
+    }
+
+    void Flush()
+    {
+        for (int b = 0; (b < 5) && (PendingBegin < PendingEnd); ++b) {
+            for (int i = PendingBegin; i < PendingEnd; ++i) {
+                Counts[b][i] += PendingCounts[b][i];
+            }
+            std::fill(PendingCounts[b].begin() + PendingBegin,
+                      PendingCounts[b].begin() + PendingEnd, 0);
+        }
+        NumPendingReads = 0;
+        PendingBegin = std::numeric_limits<int>::max();
+        PendingEnd = 0;
+    }
+
+    void Merge(const PartialPileup& other)
+    {
+        const auto sum = [](auto& lhs, const auto& rhs) {
+            std::transform(lhs.cbegin(), lhs.cend(), rhs.cbegin(), lhs.begin(), std::plus<>{});
+        };
+        sum(CoverageChanges, other.CoverageChanges);
+        for (int b = 0; b < 5; ++b) {
+            sum(Counts[b], other.Counts[b]);
+        }
+        std::transform(PotentialMismatches.cbegin(), PotentialMismatches.cend(),
+                       other.PotentialMismatches.cbegin(), PotentialMismatches.begin(),
+                       std::bit_or<>{});
+        Insertions.insert(Insertions.end(), other.Insertions.cbegin(), other.Insertions.cend());
+    }
+
+    std::array<std::vector<int>, 5> Counts;
+    std::vector<int> CoverageChanges;
+    std::vector<std::uint8_t> PotentialMismatches;
+    std::vector<InsertionEvent> Insertions;
+
+    std::array<std::vector<std::uint8_t>, 5> PendingCounts;
+    int NumPendingReads = 0;
+    int PendingBegin = std::numeric_limits<int>::max();
+    int PendingEnd = 0;
+};
+
+// smaller batches are not worth a thread
+constexpr int MIN_READS_PER_THREAD = 16;
+
 }  // namespace
 
 namespace internal {
@@ -106,11 +321,17 @@ StrandRawData::StrandRawData(const std::size_t refLength)
 }
 
 StrandRawData CalculateStrandRawData(const std::string& reference, const StrandInput& input)
+{
+    StrandRawData result{reference.size()};
+    AddStrandRawData(reference, input, result);
+    return result;
+}
+
+void AddStrandRawData(const std::string& reference, const StrandInput& input, StrandRawData& result)
 {
     assert(input.Sequences.size() == input.Cigars.size());
     assert(input.Sequences.size() == input.Positions.size());
-
-    StrandRawData result{reference.size()};
+    assert(reference.size() == result.NumReads.size());
 
     const int referenceSize = Utility::Ssize(reference);
     const int numSequences = Utility::Ssize(input.Sequences);
@@ -163,10 +384,7 @@ StrandRawData CalculateStrandRawData(const std::string& reference, const StrandI
                 case Data::CigarOperationType::PADDING:         // .
                     break;
                 default:
-                    std::ostringstream msg;
-                    msg << "encountered unsupported CIGAR op: '"
-                        << Data::CigarOperation::TypeToChar(opType) << "'";
-                    throw std::runtime_error{msg.str()};
+                    ThrowUnsupportedCigarOp(opType);
             }
 
             if (Data::ConsumesReference(opType)) {
@@ -180,8 +398,70 @@ StrandRawData CalculateStrandRawData(const std::string& reference, const StrandI
             }
         }
     }
+}
 
-    return result;
+StrandPileup::StrandPileup(const std::size_t refLength, const StrandInput& input,
+                           const unsigned int numThreads)
+{
+    assert(input.Sequences.size() == input.Cigars.size());
+    assert(input.Sequences.size() == input.Positions.size());
+
+    const int numSequences = Utility::Ssize(input.Sequences);
+    const int numChunks = std::max(1, std::min<int>(Parallel::NormalizedThreadCount(numThreads),
+                                                    numSequences / MIN_READS_PER_THREAD));
+
+    std::vector<PartialPileup> partials(numChunks, PartialPileup{refLength});
+    const auto addChunk = [&](const int c) {
+        const int first = static_cast<std::int64_t>(c) * numSequences / numChunks;
+        const int last = static_cast<std::int64_t>(c + 1) * numSequences / numChunks;
+        for (int i = first; i < last; ++i) {
+            partials[c].Add(input.Sequences[i], input.Cigars[i], input.Positions[i]);
+        }
+        partials[c].Flush();
+    };
+    std::optional<Parallel::FireAndForget> faf;
+    if (numChunks > 1) {
+        faf.emplace(numChunks);
+    }
+    Parallel::Dispatch((faf ? &*faf : nullptr), numChunks, addChunk);
+
+    PartialPileup& result = partials[0];
+    for (int c = 1; c < numChunks; ++c) {
+        result.Merge(partials[c]);
+    }
+    numReads_.resize(refLength);
+    std::partial_sum(result.CoverageChanges.cbegin(), result.CoverageChanges.cend() - 1,
+                     numReads_.begin());
+    counts_ = std::move(result.Counts);
+    potentialMismatches_ = std::move(result.PotentialMismatches);
+
+    // bucket insertions by position, then tally each bucket's sorted sequences
+    std::vector<std::uint32_t> bucketOffsets(refLength + 1, 0);
+    for (const auto& event : result.Insertions) {
+        ++bucketOffsets[event.Position + 1];
+    }
+    std::partial_sum(bucketOffsets.cbegin(), bucketOffsets.cend(), bucketOffsets.begin());
+    std::vector<SortableSequence> buckets(result.Insertions.size());
+    std::vector<std::uint32_t> next(bucketOffsets.cbegin(), bucketOffsets.cend() - 1);
+    for (const auto& event : result.Insertions) {
+        buckets[next[event.Position]++] = SortableSequence{event.Sequence};
+    }
+
+    insertionOffsets_.resize(refLength + 1);
+    insertionOffsets_[0] = 0;
+    for (std::size_t i = 0; i < refLength; ++i) {
+        const auto first = buckets.begin() + bucketOffsets[i];
+        const auto last = buckets.begin() + bucketOffsets[i + 1];
+        std::sort(first, last);
+        for (auto it = first; it != last;) {
+            const auto runEnd = std::find_if(it, last, [it](const SortableSequence& seq) {
+                return seq.Sequence != it->Sequence;
+            });
+            insertions_.push_back({it->Sequence, static_cast<int>(runEnd - it)});
+            it = runEnd;
+        }
+        insertionOffsets_[i + 1] = insertions_.size();
+    }
 }
 
 }  // namespace internal
@@ -205,39 +485,27 @@ HeteroduplexResults FindHeteroduplex(
         return HeteroduplexResults{};
     }
 
-    // combine fwd and rev input
-    std::vector<std::string> combinedSequences = fwdSequences;
-    combinedSequences.insert(combinedSequences.end(), revSequences.begin(), revSequences.end());
-    std::vector<Data::Cigar> combinedCigars = fwdCigars;
-    combinedCigars.insert(combinedCigars.end(), revCigars.begin(), revCigars.end());
-    std::vector<std::int32_t> combinedPositions = fwdPositions;
-    combinedPositions.insert(combinedPositions.end(), revPositions.begin(), revPositions.end());
-
-    // get data from CIGARs for base counts from combined strand input
-    const internal::StrandRawData& combinedStrands = internal::CalculateStrandRawData(
-        reference, internal::StrandInput{combinedSequences, combinedCigars, combinedPositions});
-
-    // get string of most common bases
-    const auto BaseCountsToMostCommonBasesString =
-        [](const std::vector<internal::BaseCount>& counts, const std::string_view& ref) {
-            std::string res;
-            res.reserve(counts.size());
-            for (int i = 0; i < Utility::Ssize(counts); ++i) {
-                res.push_back(internal::MostCommonBase(counts[i], ref[i]).first);
-            }
-            return res;
-        };
+    // gather pileup and potential mismatch sites from CIGARs for stranded
+    // input. The pileups only depend on the reference length.
+    const internal::StrandPileup fwdStrand{
+        reference.size(), internal::StrandInput{fwdSequences, fwdCigars, fwdPositions},
+        settings.NumThreads};
+    const internal::StrandPileup revStrand{
+        reference.size(), internal::StrandInput{revSequences, revCigars, revPositions},
+        settings.NumThreads};
 
     // recalculate reference by counting the most common base at each position
-    // since input reference does not represent the most common bases overall
-    const std::string& recalculatedReference =
-        BaseCountsToMostCommonBasesString(combinedStrands.BaseCounts, reference);
-
-    // gather pileup and potential mismatch sites from CIGARs for stranded input
-    const internal::StrandRawData fwdStrand = internal::CalculateStrandRawData(
-        recalculatedReference, internal::StrandInput{fwdSequences, fwdCigars, fwdPositions});
-    const internal::StrandRawData revStrand = internal::CalculateStrandRawData(
-        recalculatedReference, internal::StrandInput{revSequences, revCigars, revPositions});
+    // of both strands combined, since input reference does not represent the
+    // most common bases overall
+    std::string recalculatedReference;
+    recalculatedReference.reserve(reference.size());
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        internal::BaseCount combined = fwdStrand.BaseCounts(i);
+        const internal::BaseCount rev = revStrand.BaseCounts(i);
+        std::transform(combined.cbegin(), combined.cend(), rev.cbegin(), combined.begin(),
+                       std::plus<>{});
+        recalculatedReference.push_back(internal::MostCommonBase(combined, reference[i]).first);
+    }
 
     std::string fwdMostCommonBases = recalculatedReference;
     std::string revMostCommonBases = recalculatedReference;
@@ -255,13 +523,13 @@ HeteroduplexResults FindHeteroduplex(
     for (int i = start; i < end; ++i) {
 
         // nothing to see, carry on
-        if ((fwdStrand.PotentialMismatches[i] == 0) && (revStrand.PotentialMismatches[i] == 0)) {
+        if (!fwdStrand.PotentialMismatch(i) && !revStrand.PotentialMismatch(i)) {
             continue;
         }
 
         // sanity check: ensure some coverage on both strands
-        const int fwdCoverageCount = fwdStrand.NumReads[i];
-        const int revCoverageCount = revStrand.NumReads[i];
+        const int fwdCoverageCount = fwdStrand.NumReads(i);
+        const int revCoverageCount = revStrand.NumReads(i);
         if ((fwdCoverageCount == 0) || (revCoverageCount == 0)) {
             continue;
         }
@@ -270,12 +538,12 @@ HeteroduplexResults FindHeteroduplex(
         const char refBase = recalculatedReference[i];
 
         const auto fwdMostCommonBaseCount =
-            internal::MostCommonBase(fwdStrand.BaseCounts[i], refBase);
+            internal::MostCommonBase(fwdStrand.BaseCounts(i), refBase);
         const char fwdMostCommonBase = fwdMostCommonBaseCount.first;
         const int fwdMostCommonCount = fwdMostCommonBaseCount.second;
 
         const auto revMostCommonBaseCount =
-            internal::MostCommonBase(revStrand.BaseCounts[i], refBase);
+            internal::MostCommonBase(revStrand.BaseCounts(i), refBase);
         const char revMostCommonBase = revMostCommonBaseCount.first;
         const int revMostCommonCount = revMostCommonBaseCount.second;
         if (fwdMostCommonBase == revMostCommonBase) {
@@ -310,18 +578,18 @@ HeteroduplexResults FindHeteroduplex(
                    (ins.find(revMostCommonBase) != std::string::npos);
         };
 
-        const auto& fwdAdjacentInsertions = fwdStrand.Insertions[i + 1];
-        const int fwdRelevantInsertions = std::count_if(
-            fwdAdjacentInsertions.cbegin(), fwdAdjacentInsertions.cend(), HasMostCommonBase);
-        const auto& revAdjacentInsertions = revStrand.Insertions[i + 1];
-        const int revRelevantInsertions = std::count_if(
-            revAdjacentInsertions.cbegin(), revAdjacentInsertions.cend(), HasMostCommonBase);
-
-        const int numPositionInsertions =
-            Utility::Ssize(fwdAdjacentInsertions) + Utility::Ssize(revAdjacentInsertions);
+        int numRelevantInsertions = 0;
+        int numPositionInsertions = 0;
+        for (const auto* strand : {&fwdStrand, &revStrand}) {
+            for (const auto& tally : strand->Insertions(i + 1)) {
+                numPositionInsertions += tally.Count;
+                if (HasMostCommonBase(tally.Sequence)) {
+                    numRelevantInsertions += tally.Count;
+                }
+            }
+        }
         const double fractionAdjacentInsertions =
-            static_cast<double>(fwdRelevantInsertions + revRelevantInsertions) /
-            std::max(1, numPositionInsertions);
+            static_cast<double>(numRelevantInsertions) / std::max(1, numPositionInsertions);
         if (fractionAdjacentInsertions >= settings.AdjacentInsertionThreshold) {
             continue;
         }
@@ -5,6 +5,8 @@ namespace Align {
 
 AlignParams AlignParams::Default() { return {0, -1, -1, -1}; }
 
+AlignBand AlignBand::Default() { return {10, 0.01F}; }
+
 AlignConfig AlignConfig::Default() { return {AlignParams::Default(), AlignMode::GLOBAL}; }
 
 }  // namespace Align
@@ -2,6 +2,9 @@
 
 #include <cassert>
 #include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 
 #include <algorithm>
 #include <array>
@@ -14,26 +17,167 @@
 #include <pbcopper/align/internal/BCAlignImpl.h>
 #include <pbcopper/utility/MinMax.h>
 
+#include "../../third-party/simde/x86/sse4.1.h"
+
 namespace PacBio {
 namespace Align {
 namespace {
 
-float score(const char t, const char q, const BandedChainAlignConfig& config)
+void addAlignmentOp(std::string* transcript, const char c) { transcript->push_back(c); }
+
+// Stands in for -infinity in the DP matrices. For integer scores it is kept far
+// enough from INT32_MIN that adding a few penalties cannot overflow.
+//
+// The two engines differ only below this value: -FLT_MAX absorbs penalties,
+// so float cells derived from it tie, while integer ones keep drifting down.
+// Neither reaches a transcript: backtrace starts at a finite cell, and each
+// finite cell's best predecessor is finite. Finite scores are whole numbers,
+// exact in both types up to 2^24 (beyond that, only the integer engine is).
+template <typename Score>
+constexpr Score MinScore()
 {
-    return (t == q ? config.matchScore_ : config.mismatchPenalty_);
+    return std::numeric_limits<Score>::min() / 2;
 }
 
-void addAlignmentOp(std::string* transcript, const char c) { transcript->push_back(c); }
+template <>
+constexpr float MinScore<float>()
+{
+    return -FLT_MAX;
+}
+
+// Largest magnitude for any cell of a block handled by the integer engine.
+constexpr double MAX_INTEGER_BLOCK_SCORE = 1 << 28;
+
+//
+// Fills cells [0, n) of one DP row. Pointers are positioned at the row's first
+// cell (i,j): diagM/diagG at (i-1,j-1), upM/upG at (i-1,j), curM/curG at (i,j),
+// and target at the base for column j. Only the first nUp cells have a vertical
+// predecessor. leftM/leftG hold the scores of (i,j-1), or MinScore() if that
+// cell is out-of-band.
+//
+template <typename Score>
+void FillRow(const Internal::BlockScores<Score>& scores, const char queryBase, const char* target,
+             const std::size_t n, const std::size_t nUp, const Score* diagM, const Score* diagG,
+             const Score* upM, const Score* upG, const Score leftM, const Score leftG, Score* curM,
+             Score* curG)
+{
+    for (std::size_t k = 0; k < n; ++k) {
+        const Score s = (target[k] == queryBase ? scores.match : scores.mismatch);
+        curM[k] = std::max(diagM[k], diagG[k]) + s;
+    }
+
+    Score prevM = leftM;
+    Score prevG = leftG;
+    for (std::size_t k = 0; k < n; ++k) {
+        Score g = std::max(prevM + scores.gapOpen, prevG + scores.gapExtend);
+        if (k < nUp) {
+            g = Utility::Max(g, upM[k] + scores.gapOpen, upG[k] + scores.gapExtend);
+        }
+        curG[k] = g;
+        prevM = curM[k];
+        prevG = g;
+    }
+}
+
+//
+// Vectorized row fill for integer scores, 4 cells per step. The match matrix
+// only depends on the previous row. The gap matrix's horizontal dependency,
+// G[j] = max(A[j], G[j-1] + gapExtend), is resolved with an in-register prefix
+// scan followed by the carry-in from the previous step.
+//
+void FillRow(const Internal::BlockScores<std::int32_t>& scores, const char queryBase,
+             const char* target, const std::size_t n, const std::size_t nUp,
+             const std::int32_t* diagM, const std::int32_t* diagG, const std::int32_t* upM,
+             const std::int32_t* upG, const std::int32_t leftM, const std::int32_t leftG,
+             std::int32_t* curM, std::int32_t* curG)
+{
+    constexpr std::size_t LANES = 4;
+    const auto load = [](const std::int32_t* p) {
+        return simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(p));
+    };
+    const auto store = [](std::int32_t* p, const simde__m128i v) {
+        simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(p), v);
+    };
+
+    // match matrix
+    const simde__m128i vQuery = simde_mm_set1_epi32(static_cast<unsigned char>(queryBase));
+    const simde__m128i vMatch = simde_mm_set1_epi32(scores.match);
+    const simde__m128i vMismatch = simde_mm_set1_epi32(scores.mismatch);
+    std::size_t k = 0;
+    for (; k + LANES <= n; k += LANES) {
+        std::int32_t bases;
+        std::memcpy(&bases, target + k, sizeof(bases));
+        const simde__m128i t = simde_mm_cvtepu8_epi32(simde_mm_cvtsi32_si128(bases));
+        const simde__m128i s =
+            simde_mm_blendv_epi8(vMismatch, vMatch, simde_mm_cmpeq_epi32(t, vQuery));
+        const simde__m128i diag = simde_mm_max_epi32(load(diagM + k), load(diagG + k));
+        store(curM + k, simde_mm_add_epi32(diag, s));
+    }
+    for (; k < n; ++k) {
+        const std::int32_t s = (target[k] == queryBase ? scores.match : scores.mismatch);
+        curM[k] = std::max(diagM[k], diagG[k]) + s;
+    }
+
+    // gap matrix
+    const simde__m128i vMin = simde_mm_set1_epi32(MinScore<std::int32_t>());
+    const simde__m128i vOpen = simde_mm_set1_epi32(scores.gapOpen);
+    const simde__m128i vExtend = simde_mm_set1_epi32(scores.gapExtend);
+    const simde__m128i vExtend2 = simde_mm_set1_epi32(2 * scores.gapExtend);
+    const simde__m128i vExtendRamp = simde_mm_setr_epi32(
+        scores.gapExtend, 2 * scores.gapExtend, 3 * scores.gapExtend, 4 * scores.gapExtend);
+    simde__m128i prevM = simde_mm_set1_epi32(leftM);
+    std::int32_t prevG = leftG;
+    k = 0;
+    for (; k + LANES <= nUp; k += LANES) {
+        const simde__m128i m =
+            simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(curM + k));
+        const simde__m128i left = simde_mm_alignr_epi8(m, prevM, 12);
+        prevM = m;
+
+        simde__m128i g = simde_mm_max_epi32(simde_mm_add_epi32(load(upM + k), vOpen),
+                                            simde_mm_add_epi32(load(upG + k), vExtend));
+        g = simde_mm_max_epi32(g, simde_mm_add_epi32(left, vOpen));
+        g = simde_mm_max_epi32(g, simde_mm_add_epi32(simde_mm_alignr_epi8(g, vMin, 12), vExtend));
+        g = simde_mm_max_epi32(g, simde_mm_add_epi32(simde_mm_alignr_epi8(g, vMin, 8), vExtend2));
+        g = simde_mm_max_epi32(g, simde_mm_add_epi32(simde_mm_set1_epi32(prevG), vExtendRamp));
+        store(curG + k, g);
+        prevG = curG[k + LANES - 1];
+    }
+    std::int32_t prevMScalar = (k == 0 ? leftM : curM[k - 1]);
+    for (; k < n; ++k) {
+        std::int32_t g = std::max(prevMScalar + scores.gapOpen, prevG + scores.gapExtend);
+        if (k < nUp) {
+            g = Utility::Max(g, upM[k] + scores.gapOpen, upG[k] + scores.gapExtend);
+        }
+        curG[k] = g;
+        prevMScalar = curM[k];
+        prevG = g;
+    }
+}
 
 }  // namespace
 
 namespace Internal {
 
+// ------------------------
+// BlockScores
+// ------------------------
+
+template <typename Score>
+BlockScores<Score> BlockScores<Score>::FromConfig(const BandedChainAlignConfig& config)
+{
+    return BlockScores{
+        static_cast<Score>(config.matchScore_), static_cast<Score>(config.mismatchPenalty_),
+        static_cast<Score>(config.gapOpenPenalty_), static_cast<Score>(config.gapExtendPenalty_)};
+}
+
 // ------------------------
 // BandedGlobalAlignBlock
 // ------------------------
 
-std::string BandedGlobalAlignBlock::Align(const char* target, const char* query, Align::Seed seed)
+template <typename Score>
+std::string BandedGlobalAlignBlock<Score>::Align(const char* target, const char* query,
+                                                 Align::Seed seed)
 {
 
     // ensure horizontal sequence length is >= vertical
@@ -59,39 +203,32 @@ std::string BandedGlobalAlignBlock::Align(const char* target, const char* query,
     // Initialize space & scores
     Init(seq2Len, seq1Len);
 
-    // for each row
+    // for each row, fill all columns within band
     for (std::size_t i = 1; i <= seq1Len; ++i) {
-
-        // foreach column within band
         const auto& e = lookup_[i];
-        for (std::size_t j = e.jBegin_; j <= e.jEnd_; ++j) {
-
-            if (j == 0) {
-                continue;
-            }
-
-            const auto currentIdx = IndexFor(i, j);
-            const auto diagIdx = IndexFor(i - 1, j - 1);
-            const auto upIdx = IndexFor(i - 1, j);
-            const auto leftIdx = IndexFor(i, j - 1);
-            const bool upAllowed = (upIdx != std::string::npos);
-            const bool leftAllowed = (leftIdx != std::string::npos);
-
-            const auto s = score(seq2[j - 1], seq1[i - 1], config_);
-
-            matchScores_[currentIdx] = (std::max(matchScores_[diagIdx], gapScores_[diagIdx]) + s);
-
-            gapScores_[currentIdx] = Utility::Max(
-                (leftAllowed ? matchScores_[leftIdx] + config_.gapOpenPenalty_ : -FLT_MAX),
-                (leftAllowed ? gapScores_[leftIdx] + config_.gapExtendPenalty_ : -FLT_MAX),
-                (upAllowed ? matchScores_[upIdx] + config_.gapOpenPenalty_ : -FLT_MAX),
-                (upAllowed ? gapScores_[upIdx] + config_.gapExtendPenalty_ : -FLT_MAX));
-        }
+        const auto& prev = lookup_[i - 1];
+
+        // column 0 (if in band) holds the initial gap scores
+        const std::size_t jFirst = std::max<std::size_t>(e.jBegin_, 1);
+        const std::size_t n = e.jEnd_ - jFirst + 1;
+        const std::size_t nUp = (prev.jEnd_ >= jFirst ? std::min(n, prev.jEnd_ - jFirst + 1) : 0);
+
+        const auto currentIdx = IndexFor(i, jFirst);
+        const auto diagIdx = IndexFor(i - 1, jFirst - 1);
+        const auto upIdx = (nUp > 0 ? IndexFor(i - 1, jFirst) : diagIdx);
+        const bool leftAllowed = (jFirst > e.jBegin_);
+
+        FillRow(scores_, seq1[i - 1], seq2 + jFirst - 1, n, nUp, &matchScores_[diagIdx],
+                &gapScores_[diagIdx], &matchScores_[upIdx], &gapScores_[upIdx],
+                (leftAllowed ? matchScores_[currentIdx - 1] : MinScore<Score>()),
+                (leftAllowed ? gapScores_[currentIdx - 1] : MinScore<Score>()),
+                &matchScores_[currentIdx], &gapScores_[currentIdx]);
     }
 
     // Traceback
     const std::size_t MATCH_MATRIX = 1;
     const std::size_t GAP_MATRIX = 2;
+    constexpr Score NOT_ALLOWED = std::numeric_limits<Score>::lowest();
 
     // find traceback start
     const auto btStart = BacktraceStart(seq2Len, seq1Len);
@@ -138,13 +275,11 @@ std::string BandedGlobalAlignBlock::Align(const char* target, const char* query,
             const auto upAllowed = (upIdx != std::string::npos);
             const auto leftAllowed = (leftIdx != std::string::npos);
 
-            const std::array<float, 4> s{
-                {(j > 0 && leftAllowed ? matchScores_[leftIdx] + config_.gapOpenPenalty_
-                                       : -FLT_MAX),
-                 (j > 0 && leftAllowed ? gapScores_[leftIdx] + config_.gapExtendPenalty_
-                                       : -FLT_MAX),
-                 (i > 0 && upAllowed ? matchScores_[upIdx] + config_.gapOpenPenalty_ : -FLT_MAX),
-                 (i > 0 && upAllowed ? gapScores_[upIdx] + config_.gapExtendPenalty_ : -FLT_MAX)}};
+            const std::array<Score, 4> s{
+                {(j > 0 && leftAllowed ? matchScores_[leftIdx] + scores_.gapOpen : NOT_ALLOWED),
+                 (j > 0 && leftAllowed ? gapScores_[leftIdx] + scores_.gapExtend : NOT_ALLOWED),
+                 (i > 0 && upAllowed ? matchScores_[upIdx] + scores_.gapOpen : NOT_ALLOWED),
+                 (i > 0 && upAllowed ? gapScores_[upIdx] + scores_.gapExtend : NOT_ALLOWED)}};
             const auto argMax = std::distance(s.cbegin(), std::max_element(s.cbegin(), s.cend()));
 
             matPrev = ((argMax == 0 || argMax == 2) ? MATCH_MATRIX : GAP_MATRIX);
@@ -179,7 +314,8 @@ std::string BandedGlobalAlignBlock::Align(const char* target, const char* query,
     return result;
 }
 
-std::pair<std::size_t, std::size_t> BandedGlobalAlignBlock::BacktraceStart(
+template <typename Score>
+std::pair<std::size_t, std::size_t> BandedGlobalAlignBlock<Score>::BacktraceStart(
     const std::size_t tLen, const std::size_t qLen) const
 {
     // NOTE: Finding backtrace start this way allows us to not penalize end-gaps.
@@ -187,7 +323,7 @@ std::pair<std::size_t, std::size_t> BandedGlobalAlignBlock::BacktraceStart(
 
     // find max score in last column
     std::pair<std::size_t, std::size_t> maxCellRight{maxIndex, maxIndex};
-    float maxScoreRight = -FLT_MAX;
+    Score maxScoreRight = MinScore<Score>();
     {
         for (std::size_t i = 1; i <= maxIndex; ++i) {
             const auto& e = lookup_[i];
@@ -202,7 +338,7 @@ std::pair<std::size_t, std::size_t> BandedGlobalAlignBlock::BacktraceStart(
 
     // find max score in last row
     std::pair<std::size_t, std::size_t> maxCellBottom{maxIndex, maxIndex};
-    float maxScoreBottom = -FLT_MAX;
+    Score maxScoreBottom = MinScore<Score>();
     {
         const std::size_t lastRow = maxIndex;
         const auto& lookupElement = lookup_[lastRow];
@@ -218,7 +354,8 @@ std::pair<std::size_t, std::size_t> BandedGlobalAlignBlock::BacktraceStart(
     return (maxScoreBottom > maxScoreRight ? maxCellBottom : maxCellRight);
 }
 
-std::size_t BandedGlobalAlignBlock::IndexFor(const std::size_t i, const std::size_t j) const
+template <typename Score>
+std::size_t BandedGlobalAlignBlock<Score>::IndexFor(const std::size_t i, const std::size_t j) const
 {
     // if in matrix
     if (i != std::string::npos && j != std::string::npos) {
@@ -233,13 +370,16 @@ std::size_t BandedGlobalAlignBlock::IndexFor(const std::size_t i, const std::siz
     return std::string::npos;
 }
 
-void BandedGlobalAlignBlock::Init(const std::size_t tLen, const std::size_t qLen)
+template <typename Score>
+void BandedGlobalAlignBlock<Score>::Init(const std::size_t tLen, const std::size_t qLen)
 {
     const auto numElements = InitLookup(tLen, qLen);
     InitScores(tLen, qLen, numElements);
 }
 
-std::size_t BandedGlobalAlignBlock::InitLookup(const std::size_t tLen, const std::size_t qLen)
+template <typename Score>
+std::size_t BandedGlobalAlignBlock<Score>::InitLookup(const std::size_t tLen,
+                                                      const std::size_t qLen)
 {
     // ensure space
     lookup_.clear();
@@ -284,28 +424,29 @@ std::size_t BandedGlobalAlignBlock::InitLookup(const std::size_t tLen, const std
     return arrayStart;
 }
 
-void BandedGlobalAlignBlock::InitScores(const std::size_t tLen, const std::size_t qLen,
-                                        const std::size_t n)
+template <typename Score>
+void BandedGlobalAlignBlock<Score>::InitScores(const std::size_t tLen, const std::size_t qLen,
+                                               const std::size_t n)
 {
     matchScores_.resize(n);
     gapScores_.resize(n);
 
     matchScores_[0] = 0;
-    gapScores_[0] = -FLT_MAX;
+    gapScores_[0] = MinScore<Score>();
 
     const auto maxQ = std::min(qLen, config_.bandExtend_);
     const auto maxT = std::min(tLen, config_.bandExtend_);
 
     for (std::size_t i = 1; i <= maxQ; ++i) {
         const auto idx = IndexFor(i, 0);
-        matchScores_[idx] = -FLT_MAX;
-        gapScores_[idx] = config_.gapOpenPenalty_ + (i - 1) * config_.gapExtendPenalty_;
+        matchScores_[idx] = MinScore<Score>();
+        gapScores_[idx] = scores_.gapOpen + static_cast<Score>(i - 1) * scores_.gapExtend;
     }
 
     for (std::size_t j = 1; j <= maxT; ++j) {
         const auto idx = IndexFor(0, j);
-        matchScores_[idx] = -FLT_MAX;
-        gapScores_[idx] = config_.gapOpenPenalty_ + (j - 1) * config_.gapExtendPenalty_;
+        matchScores_[idx] = MinScore<Score>();
+        gapScores_[idx] = scores_.gapOpen + static_cast<Score>(j - 1) * scores_.gapExtend;
     }
 }
 
@@ -313,37 +454,35 @@ void BandedGlobalAlignBlock::InitScores(const std::size_t tLen, const std::size_
 // StandardGlobalAlignBlock
 // --------------------------
 
-std::string StandardGlobalAlignBlock::Align(const char* target, const std::size_t tLen,
-                                            const char* query, const std::size_t qLen)
+template <typename Score>
+std::string StandardGlobalAlignBlock<Score>::Align(const char* target, const std::size_t tLen,
+                                                   const char* query, const std::size_t qLen)
 {
     // Initialize space & scores
     Init(tLen, qLen);
 
     // Main loop
     for (std::size_t i = 1; i <= qLen; ++i) {
-        for (std::size_t j = 1; j <= tLen; ++j) {
-            const auto s = score(target[j - 1], query[i - 1], config_);
-            matchScores_[i][j] =
-                (std::max(matchScores_[i - 1][j - 1], gapScores_[i - 1][j - 1]) + s);
-            gapScores_[i][j] = Utility::Max(matchScores_[i][j - 1] + config_.gapOpenPenalty_,
-                                            gapScores_[i][j - 1] + config_.gapExtendPenalty_,
-                                            matchScores_[i - 1][j] + config_.gapOpenPenalty_,
-                                            gapScores_[i - 1][j] + config_.gapExtendPenalty_);
-        }
+        const auto prevRow = IndexFor(i - 1, 0);
+        const auto row = IndexFor(i, 0);
+        FillRow(scores_, query[i - 1], target, tLen, tLen, &matchScores_[prevRow],
+                &gapScores_[prevRow], &matchScores_[prevRow + 1], &gapScores_[prevRow + 1],
+                matchScores_[row], gapScores_[row], &matchScores_[row + 1], &gapScores_[row + 1]);
     }
 
     // Traceback
     const std::size_t MATCH_MATRIX = 1;
     const std::size_t GAP_MATRIX = 2;
+    constexpr Score NOT_ALLOWED = std::numeric_limits<Score>::lowest();
 
     // find traceback start
     const auto btStart = BacktraceStart(tLen, qLen);
     std::size_t i = btStart.first;
     std::size_t j = btStart.second;
+    const auto backtraceStartIdx = IndexFor(i, j);
     std::size_t mat =
-        (matchScores_[btStart.first][btStart.second] >= gapScores_[btStart.first][btStart.second]
-             ? MATCH_MATRIX
-             : GAP_MATRIX);
+        (matchScores_[backtraceStartIdx] >= gapScores_[backtraceStartIdx] ? MATCH_MATRIX
+                                                                          : GAP_MATRIX);
     std::size_t iPrev;
     std::size_t jPrev;
     std::size_t matPrev;
@@ -365,8 +504,8 @@ std::string StandardGlobalAlignBlock::Align(const char* target, const std::size_
     while (i > 0 || j > 0) {
 
         if (mat == MATCH_MATRIX) {
-            matPrev = (matchScores_[i - 1][j - 1] >= gapScores_[i - 1][j - 1] ? MATCH_MATRIX
-                                                                              : GAP_MATRIX);
+            const auto diagIdx = IndexFor(i - 1, j - 1);
+            matPrev = (matchScores_[diagIdx] >= gapScores_[diagIdx] ? MATCH_MATRIX : GAP_MATRIX);
             iPrev = i - 1;
             jPrev = j - 1;
             const auto op = (query[iPrev] == target[jPrev] ? 'M' : 'R');
@@ -375,11 +514,13 @@ std::string StandardGlobalAlignBlock::Align(const char* target, const std::size_
         } else {
             assert(mat == GAP_MATRIX);
 
-            const std::array<float, 4> s{
-                {(j > 0 ? matchScores_[i][j - 1] + config_.gapOpenPenalty_ : -FLT_MAX),
-                 (j > 0 ? gapScores_[i][j - 1] + config_.gapExtendPenalty_ : -FLT_MAX),
-                 (i > 0 ? matchScores_[i - 1][j] + config_.gapOpenPenalty_ : -FLT_MAX),
-                 (i > 0 ? gapScores_[i - 1][j] + config_.gapExtendPenalty_ : -FLT_MAX)}};
+            const auto leftIdx = (j > 0 ? IndexFor(i, j - 1) : 0);
+            const auto upIdx = (i > 0 ? IndexFor(i - 1, j) : 0);
+            const std::array<Score, 4> s{
+                {(j > 0 ? matchScores_[leftIdx] + scores_.gapOpen : NOT_ALLOWED),
+                 (j > 0 ? gapScores_[leftIdx] + scores_.gapExtend : NOT_ALLOWED),
+                 (i > 0 ? matchScores_[upIdx] + scores_.gapOpen : NOT_ALLOWED),
+                 (i > 0 ? gapScores_[upIdx] + scores_.gapExtend : NOT_ALLOWED)}};
             const auto argMax = std::distance(s.cbegin(), std::max_element(s.cbegin(), s.cend()));
 
             matPrev = ((argMax == 0 || argMax == 2) ? MATCH_MATRIX : GAP_MATRIX);
@@ -405,29 +546,32 @@ std::string StandardGlobalAlignBlock::Align(const char* target, const std::size_
     return result;
 }
 
-std::pair<std::size_t, std::size_t> StandardGlobalAlignBlock::BacktraceStart(
+template <typename Score>
+std::pair<std::size_t, std::size_t> StandardGlobalAlignBlock<Score>::BacktraceStart(
     const std::size_t tLen, const std::size_t qLen) const
 {
     // NOTE: Finding backtrace start this way allows us to not penalize end-gaps.
 
     // find max score in last column
     std::pair<std::size_t, std::size_t> maxCellRight{qLen, tLen};
-    float maxScoreRight = -FLT_MAX;
+    Score maxScoreRight = MinScore<Score>();
     const std::size_t lastColumn = tLen;
     for (std::size_t i = 1; i <= qLen; ++i) {
-        if (matchScores_[i][lastColumn] > maxScoreRight) {
-            maxScoreRight = matchScores_[i][lastColumn];
+        const auto score = matchScores_[IndexFor(i, lastColumn)];
+        if (score > maxScoreRight) {
+            maxScoreRight = score;
             maxCellRight = std::make_pair(i, lastColumn);
         }
     }
 
     // find max score in last row
     std::pair<std::size_t, std::size_t> maxCellBottom{qLen, tLen};
-    float maxScoreBottom = -FLT_MAX;
+    Score maxScoreBottom = MinScore<Score>();
     const std::size_t lastRow = qLen;
     for (std::size_t j = 1; j <= tLen; ++j) {
-        if (matchScores_[lastRow][j] > maxScoreBottom) {
-            maxScoreBottom = matchScores_[lastRow][j];
+        const auto score = matchScores_[IndexFor(lastRow, j)];
+        if (score > maxScoreBottom) {
+            maxScoreBottom = score;
             maxCellBottom = std::make_pair(lastRow, j);
         }
     }
@@ -435,33 +579,43 @@ std::pair<std::size_t, std::size_t> StandardGlobalAlignBlock::BacktraceStart(
     return (maxScoreBottom > maxScoreRight ? maxCellBottom : maxCellRight);
 }
 
-void StandardGlobalAlignBlock::Init(const std::size_t tLen, const std::size_t qLen)
+template <typename Score>
+std::size_t StandardGlobalAlignBlock<Score>::IndexFor(const std::size_t i,
+                                                      const std::size_t j) const
 {
-    // ensure space
-    matchScores_.resize(qLen + 1);
-    gapScores_.resize(qLen + 1);
-
-    assert(matchScores_.size() == qLen + 1);
-    assert(gapScores_.size() == qLen + 1);
+    return (i * stride_) + j;
+}
 
-    for (std::size_t i = 0; i < qLen + 1; ++i) {
-        matchScores_[i].resize(tLen + 1);
-        gapScores_[i].resize(tLen + 1);
-    }
+template <typename Score>
+void StandardGlobalAlignBlock<Score>::Init(const std::size_t tLen, const std::size_t qLen)
+{
+    // ensure space (capacity is retained between blocks)
+    stride_ = tLen + 1;
+    const std::size_t numElements = (qLen + 1) * stride_;
+    matchScores_.resize(numElements);
+    gapScores_.resize(numElements);
 
     // fill out initial scores
-    matchScores_[0][0] = 0;
-    gapScores_[0][0] = -FLT_MAX;
+    matchScores_[0] = 0;
+    gapScores_[0] = MinScore<Score>();
     for (std::size_t i = 1; i <= qLen; ++i) {
-        matchScores_[i][0] = -FLT_MAX;
-        gapScores_[i][0] = config_.gapOpenPenalty_ + (i - 1) * config_.gapExtendPenalty_;
+        const auto idx = IndexFor(i, 0);
+        matchScores_[idx] = MinScore<Score>();
+        gapScores_[idx] = scores_.gapOpen + static_cast<Score>(i - 1) * scores_.gapExtend;
     }
     for (std::size_t j = 1; j <= tLen; ++j) {
-        matchScores_[0][j] = -FLT_MAX;
-        gapScores_[0][j] = config_.gapOpenPenalty_ + (j - 1) * config_.gapExtendPenalty_;
+        matchScores_[j] = MinScore<Score>();
+        gapScores_[j] = scores_.gapOpen + static_cast<Score>(j - 1) * scores_.gapExtend;
     }
 }
 
+template struct BlockScores<float>;
+template struct BlockScores<std::int32_t>;
+template class BandedGlobalAlignBlock<float>;
+template class BandedGlobalAlignBlock<std::int32_t>;
+template class StandardGlobalAlignBlock<float>;
+template class StandardGlobalAlignBlock<std::int32_t>;
+
 // ------------------------
 // BandedChainAlignerImpl
 // ------------------------
@@ -487,7 +641,13 @@ static std::vector<Align::Seed>::const_iterator LastAnchorSeed(
 }
 
 BandedChainAlignerImpl::BandedChainAlignerImpl(const BandedChainAlignConfig& config)
-    : config_(config), gapBlock_(config), seedBlock_(config), gapBlockBeginH_(0), gapBlockBeginV_(0)
+    : config_(config)
+    , gapBlock_(config)
+    , seedBlock_(config)
+    , floatGapBlock_(config)
+    , floatSeedBlock_(config)
+    , gapBlockBeginH_(0)
+    , gapBlockBeginV_(0)
 {}
 
 BandedChainAlignment BandedChainAlignerImpl::Align(const char* target, const std::size_t targetLen,
@@ -522,8 +682,11 @@ BandedChainAlignment BandedChainAlignerImpl::Align(const char* target, const std
 void BandedChainAlignerImpl::AlignGapBlock(const std::size_t hLength, const std::size_t vLength)
 {
     // do 'standard' DP align
-    auto transcript = gapBlock_.Align(sequences_.target + gapBlockBeginH_, hLength,
-                                      sequences_.query + gapBlockBeginV_, vLength);
+    const char* target = sequences_.target + gapBlockBeginH_;
+    const char* query = sequences_.query + gapBlockBeginV_;
+    auto transcript = (UseIntegerBlocks(hLength, vLength)
+                           ? gapBlock_.Align(target, hLength, query, vLength)
+                           : floatGapBlock_.Align(target, hLength, query, vLength));
 
     // incorporate alignment into total result
     StitchTranscripts(&globalTranscript_, std::move(transcript));
@@ -546,7 +709,11 @@ void BandedChainAlignerImpl::AlignLastGapBlock()
 void BandedChainAlignerImpl::AlignSeedBlock(const Align::Seed& seed)
 {
     // do seed-guided, banded align
-    auto transcript = seedBlock_.Align(sequences_.target, sequences_.query, seed);
+    const std::size_t hLength = seed.EndPositionH() - seed.BeginPositionH();
+    const std::size_t vLength = seed.EndPositionV() - seed.BeginPositionV();
+    auto transcript = (UseIntegerBlocks(hLength, vLength)
+                           ? seedBlock_.Align(sequences_.target, sequences_.query, seed)
+                           : floatSeedBlock_.Align(sequences_.target, sequences_.query, seed));
 
     // incorporate alignment into total result
     StitchTranscripts(&globalTranscript_, std::move(transcript));
@@ -573,6 +740,24 @@ void BandedChainAlignerImpl::AlignSeedBlock(const Align::Seed& seed)
     gapBlockBeginV_ = seed.EndPositionV() - vOffset;
 }
 
+bool BandedChainAlignerImpl::UseIntegerBlocks(const std::size_t hLength,
+                                              const std::size_t vLength) const
+{
+    // integer blocks require whole-number scores, small enough that no cell of
+    // the block can overflow
+    float maxAbsScore = 0.0F;
+    for (const float s : {config_.matchScore_, config_.mismatchPenalty_, config_.gapOpenPenalty_,
+                          config_.gapExtendPenalty_}) {
+        if (std::trunc(s) != s) {
+            return false;
+        }
+        maxAbsScore = std::max(maxAbsScore, std::fabs(s));
+    }
+    const double maxBlockScore =
+        static_cast<double>(maxAbsScore) * static_cast<double>(hLength + vLength + 2);
+    return maxBlockScore < MAX_INTEGER_BLOCK_SCORE;
+}
+
 void BandedChainAlignerImpl::Initialize(const char* target, const std::size_t targetLen,
                                         const char* query, const std::size_t queryLen)
 {
@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <limits>
 #include <tuple>
+#include <type_traits>
+
+#include <cassert>
+#include <cstdint>
 
 namespace PacBio {
 namespace Align {
@@ -415,5 +419,194 @@ std::vector<std::pair<std::size_t, Seeds>> ChainSeeds(const std::map<std::size_t
     return chains;
 }
 
+namespace {
+
+// Bounded-lookback chaining (as in minimap2): sorts 'seeds' by HVCompare and
+// lets each seed extend the best-scoring chain ending at one of the
+// config.maxLookback seeds before it that lie strictly up-left of it and
+// within config.maxSeedGap query bases, scoring links with LinkScore. Chains
+// are then reported from the best-scoring end seed down, each seed belonging
+// to at most one chain: a chain reaching a seed already used by a better chain
+// is cut there, and kept only if its remaining score is still at least
+// config.minScore. 'chainPred' receives, for each sorted seed, the index of
+// its predecessor in the reported chain, or -1. Returns up to
+// config.numCandidates chain ends, best first.
+std::vector<ChainHit> ChainSeedsFlatImpl(std::vector<Seed>* seeds,
+                                         std::vector<std::ptrdiff_t>* chainPred,
+                                         const std::size_t seedSetIdx,
+                                         const ChainSeedsConfig& config)
+{
+    assert(seeds);
+    assert(chainPred);
+
+    std::sort(seeds->begin(), seeds->end(), HVCompare);
+    const auto& anchors = *seeds;
+    const std::size_t n = anchors.size();
+
+    // best chain score ending at each seed
+    std::vector<long> scores(n);
+    chainPred->assign(n, -1);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& current = anchors[i];
+        const auto h = current.BeginPositionH();
+        const auto v = current.BeginPositionV();
+        long bestScore = static_cast<long>(current.Size());
+        std::ptrdiff_t bestPred = -1;
+
+        const std::size_t first = (i > config.maxLookback ? i - config.maxLookback : 0);
+        for (std::size_t j = i; j-- > first;) {
+            const auto& pred = anchors[j];
+            const auto predH = pred.BeginPositionH();
+            if (h - predH > static_cast<std::uint64_t>(config.maxSeedGap) + pred.Size()) {
+                break;
+            }
+            if (predH >= h || pred.BeginPositionV() >= v) {
+                continue;
+            }
+            const long s = scores[j] + LinkScore(current, pred, config);
+            if (s > bestScore) {
+                bestScore = s;
+                bestPred = static_cast<std::ptrdiff_t>(j);
+            }
+        }
+        scores[i] = bestScore;
+        (*chainPred)[i] = bestPred;
+    }
+
+    // candidate chain ends, best first
+    std::vector<std::size_t> ends;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (scores[i] >= config.minScore) {
+            ends.push_back(i);
+        }
+    }
+    std::stable_sort(ends.begin(), ends.end(),
+                     [&scores](const std::size_t lhs, const std::size_t rhs) {
+                         return scores[lhs] > scores[rhs];
+                     });
+
+    // report non-overlapping chains, cutting each at the first seed already used
+    std::vector<ChainHit> chainHits;
+    std::vector<bool> used(n, false);
+    for (const std::size_t end : ends) {
+        if (chainHits.size() >= config.numCandidates) {
+            break;
+        }
+        if (used[end]) {
+            continue;
+        }
+
+        std::ptrdiff_t last = static_cast<std::ptrdiff_t>(end);
+        while ((*chainPred)[last] >= 0 && !used[(*chainPred)[last]]) {
+            last = (*chainPred)[last];
+        }
+        const std::ptrdiff_t cut = (*chainPred)[last];
+        const long score = scores[end] - (cut >= 0 ? scores[cut] : 0);
+        if (score < config.minScore) {
+            continue;
+        }
+
+        (*chainPred)[last] = -1;
+        for (std::ptrdiff_t i = static_cast<std::ptrdiff_t>(end); i >= 0; i = (*chainPred)[i]) {
+            used[i] = true;
+        }
+        chainHits.push_back(ChainHit{seedSetIdx, end, score});
+    }
+    return chainHits;
+}
+
+// chain each seed set, keeping the best numCandidates chains overall as
+// (reference, chained seeds)
+template <typename Chain>
+std::vector<std::pair<std::size_t, Chain>> ChainSeedSetsFlat(
+    const std::vector<std::size_t>& references, std::vector<std::vector<Seed>> seeds,
+    const ChainSeedsConfig& config)
+{
+    std::vector<std::vector<std::ptrdiff_t>> chainPred(seeds.size());
+    std::vector<ChainHit> chainHits;
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        auto hits = ChainSeedsFlatImpl(&seeds[i], &chainPred[i], i, config);
+        chainHits.insert(chainHits.end(), hits.begin(), hits.end());
+    }
+
+    std::stable_sort(
+        chainHits.begin(), chainHits.end(),
+        [](const ChainHit& lhs, const ChainHit& rhs) { return lhs.score > rhs.score; });
+    if (chainHits.size() > config.numCandidates) {
+        chainHits.resize(config.numCandidates);
+    }
+
+    std::vector<std::pair<std::size_t, Chain>> chains(chainHits.size());
+    for (std::size_t c = 0; c < chainHits.size(); ++c) {
+        const auto& hit = chainHits[c];
+        chains[c].first = references[hit.seedSetIdx];
+        std::vector<Seed> chain;
+        for (auto i = static_cast<std::ptrdiff_t>(hit.endIndex); i >= 0;
+             i = chainPred[hit.seedSetIdx][i]) {
+            chain.push_back(seeds[hit.seedSetIdx][i]);
+        }
+        if constexpr (std::is_same_v<Chain, Seeds>) {
+            for (const auto& seed : chain) {
+                chains[c].second.AddSeed(seed);
+            }
+        } else {
+            chains[c].second.assign(chain.rbegin(), chain.rend());
+        }
+    }
+    return chains;
+}
+
+}  // namespace
+
+std::vector<std::vector<Seed>> ChainSeedsFlat(std::vector<Seed> seeds,
+                                              const ChainSeedsConfig& config)
+{
+    std::vector<std::ptrdiff_t> chainPred;
+    const auto chainHits = ChainSeedsFlatImpl(&seeds, &chainPred, 0, config);
+
+    std::vector<std::vector<Seed>> chains(chainHits.size());
+    for (std::size_t c = 0; c < chainHits.size(); ++c) {
+        for (auto i = static_cast<std::ptrdiff_t>(chainHits[c].endIndex); i >= 0;
+             i = chainPred[i]) {
+            chains[c].push_back(seeds[i]);
+        }
+        std::reverse(chains[c].begin(), chains[c].end());
+    }
+    return chains;
+}
+
+std::vector<std::vector<Seed>> ChainSeedsFlat(const Seeds& seedSet, const ChainSeedsConfig& config)
+{
+    return ChainSeedsFlat(std::vector<Seed>(seedSet.begin(), seedSet.end()), config);
+}
+
+std::vector<std::pair<std::size_t, Seeds>> ChainSeedsFlat(
+    const std::map<std::size_t, Seeds>& seedSets, const ChainSeedsConfig& config)
+{
+    std::vector<std::size_t> references;
+    std::vector<std::vector<Seed>> seeds;
+    references.reserve(seedSets.size());
+    seeds.reserve(seedSets.size());
+    for (const auto& [reference, seedSet] : seedSets) {
+        references.push_back(reference);
+        seeds.emplace_back(seedSet.begin(), seedSet.end());
+    }
+    return ChainSeedSetsFlat<Seeds>(references, std::move(seeds), config);
+}
+
+std::vector<std::pair<std::size_t, std::vector<Seed>>> ChainSeedsFlat(
+    SeedArray* seeds, const ChainSeedsConfig& config)
+{
+    assert(seeds);
+
+    std::vector<std::size_t> references;
+    std::vector<std::vector<Seed>> seedSets;
+    for (const auto& range : seeds->ReferenceRanges()) {
+        references.push_back(range.referenceIdx);
+        seedSets.push_back(seeds->Slice(range));
+    }
+    return ChainSeedSetsFlat<std::vector<Seed>>(references, std::move(seedSets), config);
+}
+
 }  // namespace Align
 }  // namespace PacBio
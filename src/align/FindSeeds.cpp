@@ -1,15 +1,22 @@
 #include <pbcopper/align/FindSeeds.h>
 
 #include <pbcopper/qgram/Index.h>
+#include <pbcopper/qgram/MinimizerIndex.h>
 
 #include "FilterHomopolymers.h"
 
+#include <algorithm>
+
+#include <cassert>
+
 namespace PacBio {
 namespace Align {
+namespace {
 
-std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const std::string& seq,
-                                       const std::optional<std::size_t> qIdx,
-                                       const bool filterHomopolymers)
+template <typename IndexType>
+std::map<std::size_t, Seeds> FindSeedsImpl(const IndexType& index, const std::string& seq,
+                                           const std::optional<std::size_t> qIdx,
+                                           const bool filterHomopolymers)
 {
     std::map<std::size_t, Seeds> seeds;
 
@@ -35,6 +42,44 @@ std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const
     return seeds;
 }
 
+template <typename IndexType>
+void FindSeedsImpl(const IndexType& index, const std::string& seq, SeedArray* seeds,
+                   const std::optional<std::size_t> qIdx, const bool filterHomopolymers)
+{
+    assert(seeds);
+
+    const auto hits = index.Hits(seq, filterHomopolymers);
+    std::size_t numHits = 0;
+    for (const auto& queryHits : hits) {
+        numHits += queryHits.size();
+    }
+    // grow geometrically, a cleared array is typically reused for the next query
+    if (seeds->size() + numHits > seeds->capacity()) {
+        seeds->reserve(std::max(seeds->size() + numHits, 2 * seeds->capacity()));
+    }
+
+    const std::size_t seedSize = index.Size();
+    for (const auto& queryHits : hits) {
+        const auto queryPos = queryHits.QueryPosition();
+        for (const auto& hit : queryHits) {
+            const auto rIdx = hit.Id();
+            if (qIdx && rIdx == *qIdx) {
+                continue;
+            }
+            seeds->Add(rIdx, queryPos, hit.Position(), seedSize);
+        }
+    }
+}
+
+}  // namespace
+
+std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const std::string& seq,
+                                       const std::optional<std::size_t> qIdx,
+                                       const bool filterHomopolymers)
+{
+    return FindSeedsImpl(index, seq, qIdx, filterHomopolymers);
+}
+
 std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const std::string& seq,
                                        const std::optional<std::size_t> qIdx)
 {
@@ -52,6 +97,42 @@ std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::Index& index, const
     return FindSeeds(index, seq, std::nullopt, Default::FILTER_HOMOPOLYMERS);
 }
 
+std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::MinimizerIndex& index,
+                                       const std::string& seq,
+                                       const std::optional<std::size_t> qIdx,
+                                       const bool filterHomopolymers)
+{
+    return FindSeedsImpl(index, seq, qIdx, filterHomopolymers);
+}
+
+std::map<std::size_t, Seeds> FindSeeds(const PacBio::QGram::MinimizerIndex& index,
+                                       const std::string& seq)
+{
+    return FindSeedsImpl(index, seq, std::nullopt, Default::FILTER_HOMOPOLYMERS);
+}
+
+void FindSeeds(const PacBio::QGram::Index& index, const std::string& seq, SeedArray* seeds,
+               const std::optional<std::size_t> qIdx, const bool filterHomopolymers)
+{
+    FindSeedsImpl(index, seq, seeds, qIdx, filterHomopolymers);
+}
+
+void FindSeeds(const PacBio::QGram::Index& index, const std::string& seq, SeedArray* seeds)
+{
+    FindSeedsImpl(index, seq, seeds, std::nullopt, Default::FILTER_HOMOPOLYMERS);
+}
+
+void FindSeeds(const PacBio::QGram::MinimizerIndex& index, const std::string& seq, SeedArray* seeds,
+               const std::optional<std::size_t> qIdx, const bool filterHomopolymers)
+{
+    FindSeedsImpl(index, seq, seeds, qIdx, filterHomopolymers);
+}
+
+void FindSeeds(const PacBio::QGram::MinimizerIndex& index, const std::string& seq, SeedArray* seeds)
+{
+    FindSeedsImpl(index, seq, seeds, std::nullopt, Default::FILTER_HOMOPOLYMERS);
+}
+
 Seeds FindSeeds(const std::size_t qGramSize, const std::string& seq1, const std::string& seq2,
                 const bool filterHomopolymers)
 {
@@ -3,6 +3,7 @@
 #include <pbcopper/utility/Ssize.h>
 
 #include <algorithm>
+#include <limits>
 
 namespace PacBio {
 namespace Align {
@@ -16,6 +17,106 @@ GlobalLocalResult GlobalLocalLastRowMax(const std::vector<std::int32_t>& lastRow
     const std::int32_t maxElementPos = maxElementIt - std::cbegin(lastRow);
     return {*maxElementIt, maxElementPos};
 }
+
+/// \brief Determine whether the parameters are an affine transform of a
+///        unit-cost edit distance. With c = Match - Mismatch, the score D[i][j]
+///        equals alpha * i + beta * j - c * E[i][j], where E is the edit
+///        distance with free leading gaps. alpha = c + Deletion and
+///        beta = c + Insertion need to be either 0 or c, such that the
+///        boundary deltas of E are in {0, 1}.
+///        Return c, or 0 if the bit-parallel kernel cannot be used.
+std::int32_t BitParallelUnitCost(const GlobalLocalParameters& parameters) noexcept
+{
+    const std::int32_t c = parameters.MatchScore - parameters.MismatchPenalty;
+    const std::int32_t alpha = c + parameters.DeletionPenalty;
+    const std::int32_t beta = c + parameters.InsertionPenalty;
+
+    const bool noContext = (parameters.BranchPenalty == parameters.InsertionPenalty) &&
+                           (parameters.MergePenalty == parameters.DeletionPenalty);
+    const bool validBoundary = ((alpha == 0) || (alpha == c)) && ((beta == 0) || (beta == c));
+
+    if ((c > 0) && noContext && validBoundary && (alpha + beta == parameters.MatchScore)) {
+        return c;
+    }
+    return 0;
+}
+
+/// \brief Bit-parallel version of GlobalLocalAlign, using the block-based
+///        formulation of Myers' algorithm by Hyyro (2003). The query is split
+///        into blocks of 64 bases, each read base updates all blocks and
+///        the horizontal delta of the last query base tracks the last row.
+GlobalLocalResult GlobalLocalAlignBitParallel(const char* const query,
+                                              const std::int32_t queryLength,
+                                              const char* const read, const std::int32_t readLength,
+                                              const GlobalLocalParameters& parameters,
+                                              const std::int32_t unitCost,
+                                              GlobalLocalStorage& storage) noexcept
+{
+    constexpr std::int32_t WORD_SIZE = 64;
+    constexpr std::int32_t ALPHABET_SIZE = 256;
+    const std::int32_t numBlocks = (queryLength + WORD_SIZE - 1) / WORD_SIZE;
+    const std::int32_t lastBit = (queryLength - 1) % WORD_SIZE;
+
+    // Score increments per query and read base, see BitParallelUnitCost
+    const std::int32_t alpha = unitCost + parameters.DeletionPenalty;
+    const std::int32_t beta = unitCost + parameters.InsertionPenalty;
+
+    // One contiguous memory block, first the match bit vectors of every
+    // character for each query block, followed by Pv and Mv for each block.
+    storage.BitVectors.assign((ALPHABET_SIZE + 2) * numBlocks, 0);
+    std::uint64_t* const peq = storage.BitVectors.data();
+    std::uint64_t* const pv = peq + ALPHABET_SIZE * numBlocks;
+    std::uint64_t* const mv = pv + numBlocks;
+
+    for (std::int32_t i = 0; i < queryLength; ++i) {
+        const auto base = static_cast<unsigned char>(query[i]);
+        peq[base * numBlocks + i / WORD_SIZE] |= std::uint64_t{1} << (i % WORD_SIZE);
+    }
+
+    // Vertical deltas of the first column are alpha / unitCost
+    if (alpha != 0) {
+        std::fill_n(pv, numBlocks, ~std::uint64_t{0});
+    }
+    const std::int32_t topHin = (beta != 0);
+
+    std::int32_t lastRowDistance = (alpha != 0) * queryLength;
+    GlobalLocalResult result{std::numeric_limits<std::int32_t>::min(), 0};
+
+    for (std::int32_t j = 0; j < readLength; ++j) {
+        const std::uint64_t* const eq = peq + static_cast<unsigned char>(read[j]) * numBlocks;
+        std::int32_t hin = topHin;
+        for (std::int32_t b = 0; b < numBlocks; ++b) {
+            const std::uint64_t pvIn = pv[b];
+            const std::uint64_t mvIn = mv[b];
+            const std::uint64_t hinIsNeg = (hin < 0);
+            const std::uint64_t hinIsPos = (hin > 0);
+
+            const std::uint64_t xv = eq[b] | mvIn;
+            const std::uint64_t eqIn = eq[b] | hinIsNeg;
+            const std::uint64_t xh = (((eqIn & pvIn) + pvIn) ^ pvIn) | eqIn;
+            std::uint64_t ph = mvIn | ~(xh | pvIn);
+            std::uint64_t mh = pvIn & xh;
+
+            const std::int32_t outBit = (b + 1 == numBlocks) ? lastBit : (WORD_SIZE - 1);
+            hin = static_cast<std::int32_t>((ph >> outBit) & 1) -
+                  static_cast<std::int32_t>((mh >> outBit) & 1);
+
+            ph = (ph << 1) | hinIsPos;
+            mh = (mh << 1) | hinIsNeg;
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+        }
+        lastRowDistance += hin;
+
+        const std::int32_t score =
+            alpha * queryLength + beta * (j + 1) - unitCost * lastRowDistance;
+        if (score > result.MaxScore) {
+            result = {score, j};
+        }
+    }
+
+    return result;
+}
 }  // namespace
 
 GlobalLocalResult GlobalLocalAlign(const std::string& query, const std::string& read,
@@ -47,6 +148,14 @@ GlobalLocalResult GlobalLocalAlign(const char* const query, const std::int32_t q
                                    const GlobalLocalParameters& parameters,
                                    GlobalLocalStorage& storage) noexcept
 {
+    if ((queryLength > 0) && (readLength > 0)) {
+        const std::int32_t unitCost = BitParallelUnitCost(parameters);
+        if (unitCost > 0) {
+            return GlobalLocalAlignBitParallel(query, queryLength, read, readLength, parameters,
+                                               unitCost, storage);
+        }
+    }
+
     // The lastRow has m rows for the query and
     //                 n column for the read
     const std::int32_t m = queryLength + 1;
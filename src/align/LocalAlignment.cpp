@@ -39,6 +39,7 @@ LocalAlignment LocalAlign(const std::string& target, const std::string& query,
 {
     StripedSmithWaterman::Aligner aligner{config.MatchScore, config.MismatchPenalty,
                                           config.GapOpenPenalty, config.GapExtendPenalty};
+    aligner.SetSimdWidth(static_cast<int>(config.Simd));
     StripedSmithWaterman::Filter filter;
     StripedSmithWaterman::Alignment alignment;
 
@@ -52,6 +53,7 @@ std::vector<LocalAlignment> LocalAlign(const std::string& target,
 {
     StripedSmithWaterman::Aligner aligner{config.MatchScore, config.MismatchPenalty,
                                           config.GapOpenPenalty, config.GapExtendPenalty};
+    aligner.SetSimdWidth(static_cast<int>(config.Simd));
     StripedSmithWaterman::Filter filter;
     aligner.SetReferenceSequence(target.c_str(), target.size());
 
@@ -0,0 +1,224 @@
+#include <pbcopper/align/SeedArray.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <cassert>
+
+namespace PacBio {
+namespace Align {
+namespace {
+
+template <typename T>
+void PermuteArray(std::vector<T>* values, const std::vector<std::size_t>& order)
+{
+    std::vector<T> result(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        result[i] = (*values)[order[i]];
+    }
+    values->swap(result);
+}
+
+}  // namespace
+
+SeedArray::SeedArray(const bool mergeOnSort) : mergeOnSort_{mergeOnSort} {}
+
+void SeedArray::Add(const std::size_t referenceIdx, const std::uint64_t beginPosH,
+                    const std::uint64_t beginPosV, const std::uint64_t seedLength)
+{
+    referenceIdx_.push_back(static_cast<std::uint32_t>(referenceIdx));
+    beginH_.push_back(beginPosH);
+    beginV_.push_back(beginPosV);
+    endH_.push_back(beginPosH + seedLength);
+    endV_.push_back(beginPosV + seedLength);
+    sorted_ = false;
+}
+
+void SeedArray::Add(const std::size_t referenceIdx, const Seed& seed)
+{
+    referenceIdx_.push_back(static_cast<std::uint32_t>(referenceIdx));
+    beginH_.push_back(seed.BeginPositionH());
+    beginV_.push_back(seed.BeginPositionV());
+    endH_.push_back(seed.EndPositionH());
+    endV_.push_back(seed.EndPositionV());
+    sorted_ = false;
+}
+
+void SeedArray::Merge()
+{
+    // group seeds by diagonal, in order along it
+    std::vector<std::size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto diagonal = [this](const std::size_t i) {
+        return static_cast<std::int64_t>(beginH_[i] - beginV_[i]);
+    };
+    std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+        if (referenceIdx_[lhs] != referenceIdx_[rhs]) {
+            return referenceIdx_[lhs] < referenceIdx_[rhs];
+        }
+        const auto lhsDiagonal = diagonal(lhs);
+        const auto rhsDiagonal = diagonal(rhs);
+        if (lhsDiagonal != rhsDiagonal) {
+            return lhsDiagonal < rhsDiagonal;
+        }
+        return beginH_[lhs] < beginH_[rhs];
+    });
+    Permute(order);
+
+    // fold each seed into its predecessor on the same diagonal when they overlap
+    // or abut
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < size(); ++i) {
+        if (referenceIdx_[i] == referenceIdx_[last] && diagonal(i) == diagonal(last) &&
+            beginH_[i] <= endH_[last] && beginV_[i] <= endV_[last]) {
+            endH_[last] = std::max(endH_[last], endH_[i]);
+            endV_[last] = std::max(endV_[last], endV_[i]);
+        } else {
+            ++last;
+            referenceIdx_[last] = referenceIdx_[i];
+            beginH_[last] = beginH_[i];
+            beginV_[last] = beginV_[i];
+            endH_[last] = endH_[i];
+            endV_[last] = endV_[i];
+        }
+    }
+
+    const std::size_t newSize = (empty() ? 0 : last + 1);
+    referenceIdx_.resize(newSize);
+    beginH_.resize(newSize);
+    beginV_.resize(newSize);
+    endH_.resize(newSize);
+    endV_.resize(newSize);
+}
+
+void SeedArray::Permute(const std::vector<std::size_t>& order)
+{
+    assert(order.size() == size());
+    PermuteArray(&referenceIdx_, order);
+    PermuteArray(&beginH_, order);
+    PermuteArray(&beginV_, order);
+    PermuteArray(&endH_, order);
+    PermuteArray(&endV_, order);
+}
+
+void SeedArray::Sort()
+{
+    if (sorted_) {
+        return;
+    }
+    if (mergeOnSort_) {
+        Merge();
+    }
+
+    const auto less = [this](const std::size_t lhs, const std::size_t rhs) {
+        if (referenceIdx_[lhs] != referenceIdx_[rhs]) {
+            return referenceIdx_[lhs] < referenceIdx_[rhs];
+        }
+        if (beginH_[lhs] != beginH_[rhs]) {
+            return beginH_[lhs] < beginH_[rhs];
+        }
+        return beginV_[lhs] < beginV_[rhs];
+    };
+
+    // e.g. merged seeds that all lie on one diagonal
+    bool inOrder = true;
+    for (std::size_t i = 1; inOrder && (i < size()); ++i) {
+        inOrder = !less(i, i - 1);
+    }
+    if (!inOrder) {
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), less);
+        Permute(order);
+    }
+    sorted_ = true;
+}
+
+std::vector<SeedArray::Range> SeedArray::ReferenceRanges()
+{
+    Sort();
+
+    std::vector<Range> result;
+    for (std::size_t begin = 0; begin < size();) {
+        const auto referenceIdx = referenceIdx_[begin];
+        std::size_t end = begin + 1;
+        while (end < size() && referenceIdx_[end] == referenceIdx) {
+            ++end;
+        }
+        result.push_back(Range{referenceIdx, begin, end});
+        begin = end;
+    }
+    return result;
+}
+
+std::vector<Seed> SeedArray::Slice(const Range& range) const
+{
+    assert(range.begin <= range.end && range.end <= size());
+
+    std::vector<Seed> result;
+    result.reserve(range.end - range.begin);
+    for (std::size_t i = range.begin; i < range.end; ++i) {
+        result.emplace_back(beginH_[i], beginV_[i], endH_[i], endV_[i]);
+    }
+    return result;
+}
+
+std::map<std::size_t, Seeds> SeedArray::ToSeeds()
+{
+    std::map<std::size_t, Seeds> result;
+    for (const auto& range : ReferenceRanges()) {
+        auto& seeds = result[range.referenceIdx];
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            seeds.AddSeed((*this)[i]);
+        }
+    }
+    return result;
+}
+
+Seed SeedArray::operator[](const std::size_t i) const
+{
+    assert(i < size());
+    return Seed{beginH_[i], beginV_[i], endH_[i], endV_[i]};
+}
+
+std::size_t SeedArray::ReferenceIndex(const std::size_t i) const { return referenceIdx_[i]; }
+
+std::uint64_t SeedArray::BeginPositionH(const std::size_t i) const { return beginH_[i]; }
+
+std::uint64_t SeedArray::BeginPositionV(const std::size_t i) const { return beginV_[i]; }
+
+std::uint64_t SeedArray::EndPositionH(const std::size_t i) const { return endH_[i]; }
+
+std::uint64_t SeedArray::EndPositionV(const std::size_t i) const { return endV_[i]; }
+
+bool SeedArray::IsSorted() const { return sorted_; }
+
+bool SeedArray::MergeOnSort() const { return mergeOnSort_; }
+
+void SeedArray::clear()
+{
+    referenceIdx_.clear();
+    beginH_.clear();
+    beginV_.clear();
+    endH_.clear();
+    endV_.clear();
+    sorted_ = true;
+}
+
+void SeedArray::reserve(const std::size_t n)
+{
+    referenceIdx_.reserve(n);
+    beginH_.reserve(n);
+    beginV_.reserve(n);
+    endH_.reserve(n);
+    endV_.reserve(n);
+}
+
+std::size_t SeedArray::capacity() const { return referenceIdx_.capacity(); }
+
+bool SeedArray::empty() const { return referenceIdx_.empty(); }
+
+std::size_t SeedArray::size() const { return referenceIdx_.size(); }
+
+}  // namespace Align
+}  // namespace PacBio
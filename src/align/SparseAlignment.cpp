@@ -2,6 +2,7 @@
 
 #include <pbcopper/align/ChainSeeds.h>
 #include <pbcopper/align/FindSeeds.h>
+#include <pbcopper/qgram/MinimizerIndex.h>
 #include <pbcopper/utility/SequenceUtils.h>
 
 #include "FilterHomopolymers.h"
@@ -26,6 +27,27 @@ std::vector<Seed> SparseAlignSeeds(const std::size_t qGramSize, const std::strin
     return SparseAlignSeeds(qGramSize, seq1, seq2, Default::FILTER_HOMOPOLYMERS);
 }
 
+std::vector<Seed> SparseAlignSeeds(const QGram::MinimizerIndex& index, const std::size_t refIdx,
+                                   const std::string& seq1, const bool filterHomopolymers)
+{
+    const auto seeds = FindSeeds(index, seq1, std::nullopt, filterHomopolymers);
+    const auto refSeeds = seeds.find(refIdx);
+    if (refSeeds == seeds.cend()) {
+        return std::vector<Seed>{};
+    }
+    const auto chains = ChainSeeds(refSeeds->second, ChainSeedsConfig{});
+    if (chains.empty()) {
+        return std::vector<Seed>{};
+    }
+    return chains[0];
+}
+
+std::vector<Seed> SparseAlignSeeds(const QGram::MinimizerIndex& index, const std::size_t refIdx,
+                                   const std::string& seq1)
+{
+    return SparseAlignSeeds(index, refIdx, seq1, Default::FILTER_HOMOPOLYMERS);
+}
+
 std::pair<std::size_t, std::vector<Seed>> BestSparseAlign(const std::string& seq1,
                                                           const std::string& seq2,
                                                           const bool filterHomopolymers)
@@ -84,6 +84,7 @@ struct _profile{
 	int32_t readLen;
 	int32_t n;
 	uint8_t bias;
+	int32_t width;	// SIMD register width in bytes: 16 (SSE2), 32 (AVX2), 64 (AVX-512BW)
 };
 
 /* Generate query profile rearrange query sequence & calculate the weight of match/mismatch. */
@@ -91,13 +92,14 @@ static simde__m128i* qP_byte (const int8_t* read_num,
 				  const int8_t* mat,
 				  const int32_t readLen,
 				  const int32_t n,	/* the edge length of the squre matrix mat */
-				  uint8_t bias) {
+				  uint8_t bias,
+				  const int32_t width) {	/* SIMD register width in bytes */
 
-	int32_t segLen = (readLen + 15) / 16; /* Split the 128 bit register into 16 pieces.
-								     Each piece is 8 bit. Split the read into 16 segments.
-								     Calculat 16 segments in parallel.
+	int32_t segLen = (readLen + width - 1) / width; /* Split the register into width pieces.
+								     Each piece is 8 bit. Split the read into width segments.
+								     Calculat width segments in parallel.
 								   */
-	simde__m128i* vProfile = (simde__m128i*)malloc(n * segLen * sizeof(simde__m128i));
+	simde__m128i* vProfile = (simde__m128i*)malloc(n * segLen * width);
 	int8_t* t = (int8_t*)vProfile;
 	int32_t nt, i, j, segNum;
 
@@ -105,7 +107,7 @@ static simde__m128i* qP_byte (const int8_t* read_num,
 	for (nt = 0; LIKELY(nt < n); nt ++) {
 		for (i = 0; i < segLen; i ++) {
 			j = i;
-			for (segNum = 0; LIKELY(segNum < 16) ; segNum ++) {
+			for (segNum = 0; LIKELY(segNum < width) ; segNum ++) {
 				*t++ = j>= readLen ? bias : mat[nt * n + read_num[j]] + bias;
 				j += segLen;
 			}
@@ -331,10 +333,12 @@ static alignment_end* sw_sse2_byte (const int8_t* ref,
 static simde__m128i* qP_word (const int8_t* read_num,
 				  const int8_t* mat,
 				  const int32_t readLen,
-				  const int32_t n) {
+				  const int32_t n,
+				  const int32_t width) {	/* SIMD register width in bytes */
 
-	int32_t segLen = (readLen + 7) / 8;
-	simde__m128i* vProfile = (simde__m128i*)malloc(n * segLen * sizeof(simde__m128i));
+	const int32_t lanes = width / 2;
+	int32_t segLen = (readLen + lanes - 1) / lanes;
+	simde__m128i* vProfile = (simde__m128i*)malloc(n * segLen * width);
 	int16_t* t = (int16_t*)vProfile;
 	int32_t nt, i, j;
 	int32_t segNum;
@@ -343,7 +347,7 @@ static simde__m128i* qP_word (const int8_t* read_num,
 	for (nt = 0; LIKELY(nt < n); nt ++) {
 		for (i = 0; i < segLen; i ++) {
 			j = i;
-			for (segNum = 0; LIKELY(segNum < 8) ; segNum ++) {
+			for (segNum = 0; LIKELY(segNum < lanes) ; segNum ++) {
 				*t++ = j>= readLen ? 0 : mat[nt * n + read_num[j]];
 				j += segLen;
 			}
@@ -530,6 +534,191 @@ end:
 	return bests;
 }
 
+/* Wider striped kernels, selected at runtime.
+   The kernels are generated from ssw_striped.h with native intrinsics and
+   per-function target attributes, so the rest of the library does not need
+   to be compiled for AVX2 or AVX-512BW. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SSW_X86_DISPATCH 1
+#include <immintrin.h>
+
+/* AVX2 */
+#define SSW_TARGET __attribute__((target("avx2")))
+
+static SSW_TARGET inline uint8_t ssw_hmax_u8_avx2 (__m256i v) {
+	__m128i m = _mm_max_epu8(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+	m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+	return (uint8_t)_mm_extract_epi16(m, 0);
+}
+
+static SSW_TARGET inline int16_t ssw_hmax_i16_avx2 (__m256i v) {
+	__m128i m = _mm_max_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	m = _mm_max_epi16(m, _mm_srli_si128(m, 8));
+	m = _mm_max_epi16(m, _mm_srli_si128(m, 4));
+	m = _mm_max_epi16(m, _mm_srli_si128(m, 2));
+	return (int16_t)_mm_extract_epi16(m, 0);
+}
+
+#define SSW_NAME(x) x##_avx2
+#define SSW_VEC __m256i
+#define SSW_LANES8 32
+#define SSW_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define SSW_STORE(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define SSW_SET1_8(x) _mm256_set1_epi8((char)(x))
+#define SSW_SET1_16(x) _mm256_set1_epi16((short)(x))
+#define SSW_ZERO _mm256_setzero_si256()
+#define SSW_ADDS_U8 _mm256_adds_epu8
+#define SSW_SUBS_U8 _mm256_subs_epu8
+#define SSW_MAX_U8 _mm256_max_epu8
+#define SSW_ADDS_I16 _mm256_adds_epi16
+#define SSW_SUBS_U16 _mm256_subs_epu16
+#define SSW_MAX_I16 _mm256_max_epi16
+/* shift across the 128-bit lanes: bring the low lane up, then align */
+#define SSW_SHL8(v) _mm256_alignr_epi8((v), _mm256_permute2x128_si256((v), (v), 0x08), 15)
+#define SSW_SHL16(v) _mm256_alignr_epi8((v), _mm256_permute2x128_si256((v), (v), 0x08), 14)
+#define SSW_ALL_ZERO(v) _mm256_testz_si256((v), (v))
+#define SSW_EQUAL(a, b) SSW_ALL_ZERO(_mm256_xor_si256((a), (b)))
+#define SSW_ANY_GT_I16(a, b) (_mm256_movemask_epi8(_mm256_cmpgt_epi16((a), (b))) != 0)
+#define SSW_HMAX_U8(v) ssw_hmax_u8_avx2(v)
+#define SSW_HMAX_I16(v) ssw_hmax_i16_avx2(v)
+
+#include "ssw_striped.h"
+
+#undef SSW_TARGET
+#undef SSW_NAME
+#undef SSW_VEC
+#undef SSW_LANES8
+#undef SSW_LOAD
+#undef SSW_STORE
+#undef SSW_SET1_8
+#undef SSW_SET1_16
+#undef SSW_ZERO
+#undef SSW_ADDS_U8
+#undef SSW_SUBS_U8
+#undef SSW_MAX_U8
+#undef SSW_ADDS_I16
+#undef SSW_SUBS_U16
+#undef SSW_MAX_I16
+#undef SSW_SHL8
+#undef SSW_SHL16
+#undef SSW_ALL_ZERO
+#undef SSW_EQUAL
+#undef SSW_ANY_GT_I16
+#undef SSW_HMAX_U8
+#undef SSW_HMAX_I16
+
+/* AVX-512BW */
+#define SSW_TARGET __attribute__((target("avx512bw")))
+
+static SSW_TARGET inline uint8_t ssw_hmax_u8_avx512 (__m512i v) {
+	return ssw_hmax_u8_avx2(_mm256_max_epu8(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1)));
+}
+
+static SSW_TARGET inline int16_t ssw_hmax_i16_avx512 (__m512i v) {
+	return ssw_hmax_i16_avx2(_mm256_max_epi16(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1)));
+}
+
+#define SSW_NAME(x) x##_avx512
+#define SSW_VEC __m512i
+#define SSW_LANES8 64
+#define SSW_LOAD(p) _mm512_loadu_si512((const void*)(p))
+#define SSW_STORE(p, v) _mm512_storeu_si512((void*)(p), (v))
+#define SSW_SET1_8(x) _mm512_set1_epi8((char)(x))
+#define SSW_SET1_16(x) _mm512_set1_epi16((short)(x))
+#define SSW_ZERO _mm512_setzero_si512()
+#define SSW_ADDS_U8 _mm512_adds_epu8
+#define SSW_SUBS_U8 _mm512_subs_epu8
+#define SSW_MAX_U8 _mm512_max_epu8
+#define SSW_ADDS_I16 _mm512_adds_epi16
+#define SSW_SUBS_U16 _mm512_subs_epu16
+#define SSW_MAX_I16 _mm512_max_epi16
+/* shift across the 128-bit lanes: lanes {0, v0, v1, v2}, then align */
+#define SSW_SHL8(v) _mm512_alignr_epi8((v), _mm512_maskz_shuffle_i32x4(0xfff0, (v), (v), 0x90), 15)
+#define SSW_SHL16(v) _mm512_alignr_epi8((v), _mm512_maskz_shuffle_i32x4(0xfff0, (v), (v), 0x90), 14)
+#define SSW_ALL_ZERO(v) (_mm512_test_epi8_mask((v), (v)) == 0)
+#define SSW_EQUAL(a, b) (_mm512_cmpneq_epi8_mask((a), (b)) == 0)
+#define SSW_ANY_GT_I16(a, b) (_mm512_cmpgt_epi16_mask((a), (b)) != 0)
+#define SSW_HMAX_U8(v) ssw_hmax_u8_avx512(v)
+#define SSW_HMAX_I16(v) ssw_hmax_i16_avx512(v)
+
+#include "ssw_striped.h"
+
+#undef SSW_TARGET
+#undef SSW_NAME
+#undef SSW_VEC
+#undef SSW_LANES8
+#undef SSW_LOAD
+#undef SSW_STORE
+#undef SSW_SET1_8
+#undef SSW_SET1_16
+#undef SSW_ZERO
+#undef SSW_ADDS_U8
+#undef SSW_SUBS_U8
+#undef SSW_MAX_U8
+#undef SSW_ADDS_I16
+#undef SSW_SUBS_U16
+#undef SSW_MAX_I16
+#undef SSW_SHL8
+#undef SSW_SHL16
+#undef SSW_ALL_ZERO
+#undef SSW_EQUAL
+#undef SSW_ANY_GT_I16
+#undef SSW_HMAX_U8
+#undef SSW_HMAX_I16
+
+#endif	// x86 dispatch
+
+int32_t ssw_simd_width (void) {
+#ifdef SSW_X86_DISPATCH
+	if (__builtin_cpu_supports("avx512bw")) return 64;
+	if (__builtin_cpu_supports("avx2")) return 32;
+#endif
+	return 16;
+}
+
+/* Dispatch the byte/word kernels by profile width. */
+static alignment_end* sw_byte (int32_t width,
+							 const int8_t* ref,
+							 int8_t ref_dir,
+							 int32_t refLen,
+							 int32_t readLen,
+							 const uint8_t weight_gapO,
+							 const uint8_t weight_gapE,
+							 const simde__m128i* vProfile,
+							 uint8_t terminate,
+							 uint8_t bias,
+							 int32_t maskLen) {
+#ifdef SSW_X86_DISPATCH
+	if (width == 64) return sw_byte_avx512(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const int8_t*)vProfile, terminate, bias, maskLen);
+	if (width == 32) return sw_byte_avx2(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const int8_t*)vProfile, terminate, bias, maskLen);
+#else
+	(void)width;
+#endif
+	return sw_sse2_byte(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, vProfile, terminate, bias, maskLen);
+}
+
+static alignment_end* sw_word (int32_t width,
+							 const int8_t* ref,
+							 int8_t ref_dir,
+							 int32_t refLen,
+							 int32_t readLen,
+							 const uint8_t weight_gapO,
+							 const uint8_t weight_gapE,
+							 const simde__m128i* vProfile,
+							 uint16_t terminate,
+							 int32_t maskLen) {
+#ifdef SSW_X86_DISPATCH
+	if (width == 64) return sw_word_avx512(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const int16_t*)vProfile, terminate, maskLen);
+	if (width == 32) return sw_word_avx2(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, (const int16_t*)vProfile, terminate, maskLen);
+#else
+	(void)width;
+#endif
+	return sw_sse2_word(ref, ref_dir, refLen, readLen, weight_gapO, weight_gapE, vProfile, terminate, maskLen);
+}
+
 /*!     @function               Produce CIGAR 32-bit unsigned integer from CIGAR operation and CIGAR length
         @param  length          length of CIGAR
         @param  op_letter       CIGAR operation character ('M', 'I', etc)
@@ -763,10 +952,17 @@ static int8_t* seq_reverse(const int8_t* seq, int32_t end)	/* end is 0-based ali
 }
 
 s_profile* ssw_init (const int8_t* read, const int32_t readLen, const int8_t* mat, const int32_t n, const int8_t score_size) {
+	return ssw_init_simd(read, readLen, mat, n, score_size, 0);
+}
+
+s_profile* ssw_init_simd (const int8_t* read, const int32_t readLen, const int8_t* mat, const int32_t n, const int8_t score_size, int32_t simd_width) {
+	const int32_t max_width = ssw_simd_width();
 	s_profile* p = (s_profile*)calloc(1, sizeof(struct _profile));
 	p->profile_byte = 0;
 	p->profile_word = 0;
 	p->bias = 0;
+	if (simd_width <= 0 || simd_width > max_width) simd_width = max_width;
+	p->width = simd_width >= 64 ? 64 : simd_width >= 32 ? 32 : 16;
 
 	if (score_size == 0 || score_size == 2) {
 		/* Find the bias to use in the substitution matrix */
@@ -775,9 +971,9 @@ s_profile* ssw_init (const int8_t* read, const int32_t readLen, const int8_t* ma
 		bias = abs(bias);
 
 		p->bias = bias;
-		p->profile_byte = qP_byte (read, mat, readLen, n, bias);
+		p->profile_byte = qP_byte (read, mat, readLen, n, bias, p->width);
 	}
-	if (score_size == 1 || score_size == 2) p->profile_word = qP_word (read, mat, readLen, n);
+	if (score_size == 1 || score_size == 2) p->profile_word = qP_word (read, mat, readLen, n, p->width);
 	p->read = read;
 	p->mat = mat;
 	p->readLen = readLen;
@@ -817,10 +1013,10 @@ s_align* ssw_align (const s_profile* prof,
 
 	// Find the alignment scores and ending positions
 	if (prof->profile_byte) {
-		bests = sw_sse2_byte(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_byte, -1, prof->bias, maskLen);
+		bests = sw_byte(prof->width, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_byte, -1, prof->bias, maskLen);
 		if (prof->profile_word && bests[0].score == 255) {
 			free(bests);
-			bests = sw_sse2_word(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
+			bests = sw_word(prof->width, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
 			word = 1;
 		} else if (bests[0].score == 255) {
 			fprintf(stderr, "Please set 2 to the score_size parameter of the function ssw_init, otherwise the alignment results will be incorrect.\n");
@@ -828,7 +1024,7 @@ s_align* ssw_align (const s_profile* prof,
 			return NULL;
 		}
 	}else if (prof->profile_word) {
-		bests = sw_sse2_word(ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
+		bests = sw_word(prof->width, ref, 0, refLen, readLen, weight_gapO, weight_gapE, prof->profile_word, -1, maskLen);
 		word = 1;
 	}else {
 		fprintf(stderr, "Please call the function ssw_init before ssw_align.\n");
@@ -851,11 +1047,11 @@ s_align* ssw_align (const s_profile* prof,
 	// Find the beginning position of the best alignment.
 	read_reverse = seq_reverse(prof->read, r->read_end1);
 	if (word == 0) {
-		vP = qP_byte(read_reverse, prof->mat, r->read_end1 + 1, prof->n, prof->bias);
-		bests_reverse = sw_sse2_byte(ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, prof->bias, maskLen);
+		vP = qP_byte(read_reverse, prof->mat, r->read_end1 + 1, prof->n, prof->bias, prof->width);
+		bests_reverse = sw_byte(prof->width, ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, prof->bias, maskLen);
 	} else {
-		vP = qP_word(read_reverse, prof->mat, r->read_end1 + 1, prof->n);
-		bests_reverse = sw_sse2_word(ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, maskLen);
+		vP = qP_word(read_reverse, prof->mat, r->read_end1 + 1, prof->n, prof->width);
+		bests_reverse = sw_word(prof->width, ref, 1, r->ref_end1 + 1, r->read_end1 + 1, weight_gapO, weight_gapE, vP, r->score1, maskLen);
 	}
 	free(vP);
 	free(read_reverse);
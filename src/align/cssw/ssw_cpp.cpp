@@ -226,6 +226,7 @@ Aligner::Aligner(void)
     , gap_extending_penalty_(1)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , simd_width_(0)
 {
     BuildDefaultMatrix();
 }
@@ -242,6 +243,7 @@ Aligner::Aligner(const std::uint8_t& match_score, const std::uint8_t& mismatch_p
     , gap_extending_penalty_(gap_extending_penalty)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , simd_width_(0)
 {
     BuildDefaultMatrix();
 }
@@ -258,6 +260,7 @@ Aligner::Aligner(const std::int8_t* score_matrix, const int& score_matrix_size,
     , gap_extending_penalty_(1)
     , translated_reference_(NULL)
     , reference_length_(0)
+    , simd_width_(0)
 {
     score_matrix_ = new std::int8_t[score_matrix_size_ * score_matrix_size_];
     memcpy(score_matrix_, score_matrix,
@@ -317,8 +320,8 @@ bool Aligner::Align(const char* query, const Filter& filter, Alignment* alignmen
     TranslateBase(query, query_len, translated_query);
 
     const std::int8_t score_size = 2;
-    s_profile* profile =
-        ssw_init(translated_query, query_len, score_matrix_, score_matrix_size_, score_size);
+    s_profile* profile = ssw_init_simd(translated_query, query_len, score_matrix_,
+                                       score_matrix_size_, score_size, simd_width_);
 
     std::uint8_t flag = 0;
     SetFlag(filter, &flag);
@@ -359,8 +362,8 @@ bool Aligner::Align(const char* query, const char* ref, const int& ref_len, cons
     TranslateBase(ref, valid_ref_len, translated_ref);
 
     const std::int8_t score_size = 2;
-    s_profile* profile =
-        ssw_init(translated_query, query_len, score_matrix_, score_matrix_size_, score_size);
+    s_profile* profile = ssw_init_simd(translated_query, query_len, score_matrix_,
+                                       score_matrix_size_, score_size, simd_width_);
 
     std::uint8_t flag = 0;
     SetFlag(filter, &flag);
@@ -0,0 +1,305 @@
+/*
+ *  ssw_striped.h
+ *
+ *  Width-agnostic versions of sw_sse2_byte and sw_sse2_word from ssw.c.
+ *
+ *  This file is included by ssw.c once per instruction set, after defining
+ *    SSW_TARGET         function attribute enabling the instruction set
+ *    SSW_NAME(x)        name mangling of the generated functions
+ *    SSW_VEC            vector type
+ *    SSW_LANES8         number of 8-bit lanes in SSW_VEC
+ *    SSW_LOAD/STORE     unaligned load/store
+ *    SSW_SET1_8/16      broadcast
+ *    SSW_ZERO           all-zero vector
+ *    SSW_ADDS_U8, SSW_SUBS_U8, SSW_MAX_U8, SSW_ADDS_I16, SSW_SUBS_U16, SSW_MAX_I16
+ *    SSW_SHL8/16        shift the whole vector left by one 8-bit/16-bit lane
+ *    SSW_ALL_ZERO       true if all bits are zero
+ *    SSW_EQUAL          true if both vectors are bit-identical
+ *    SSW_ANY_GT_I16     true if any signed 16-bit lane of a is greater than in b
+ *    SSW_HMAX_U8/I16    horizontal maximum
+ *
+ *  The striped layout of the query profile is identical to the one in ssw.c,
+ *  with SSW_LANES8 (resp. SSW_LANES8 / 2) segments instead of 16 (resp. 8),
+ *  see qP_byte and qP_word. Results are identical to the SSE2 versions.
+ */
+
+static SSW_TARGET alignment_end* SSW_NAME(sw_byte)(const int8_t* ref, int8_t ref_dir,
+                                                   int32_t refLen, int32_t readLen,
+                                                   const uint8_t weight_gapO,
+                                                   const uint8_t weight_gapE, const int8_t* profile,
+                                                   uint8_t terminate, uint8_t bias, int32_t maskLen)
+{
+    const int32_t lanes = SSW_LANES8;
+    uint8_t max = 0;
+    int32_t end_read = readLen - 1;
+    int32_t end_ref = -1;
+    const int32_t segLen = (readLen + lanes - 1) / lanes;
+
+    uint8_t* maxColumn = (uint8_t*)calloc(refLen, 1);
+
+    SSW_VEC* pvHStore = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvHLoad = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvE = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvHmax = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+
+    const SSW_VEC vZero = SSW_ZERO;
+    const SSW_VEC vGapO = SSW_SET1_8(weight_gapO);
+    const SSW_VEC vGapE = SSW_SET1_8(weight_gapE);
+    const SSW_VEC vBias = SSW_SET1_8(bias);
+
+    SSW_VEC vMaxScore = vZero;
+    SSW_VEC vMaxMark = vZero;
+    int32_t i, j, edge, begin = 0, end = refLen, step = 1;
+
+    if (ref_dir == 1) {
+        begin = refLen - 1;
+        end = -1;
+        step = -1;
+    }
+    for (i = begin; LIKELY(i != end); i += step) {
+        SSW_VEC e, vF = vZero, vMaxColumn = vZero;
+        SSW_VEC vH = SSW_SHL8(SSW_LOAD(pvHStore + segLen - 1));
+        const int8_t* vP = profile + (size_t)ref[i] * segLen * lanes;
+
+        SSW_VEC* pv = pvHLoad;
+        pvHLoad = pvHStore;
+        pvHStore = pv;
+
+        for (j = 0; LIKELY(j < segLen); ++j) {
+            vH = SSW_ADDS_U8(vH, SSW_LOAD(vP + (size_t)j * lanes));
+            vH = SSW_SUBS_U8(vH, vBias);
+
+            e = SSW_LOAD(pvE + j);
+            vH = SSW_MAX_U8(vH, e);
+            vH = SSW_MAX_U8(vH, vF);
+            vMaxColumn = SSW_MAX_U8(vMaxColumn, vH);
+            SSW_STORE(pvHStore + j, vH);
+
+            vH = SSW_SUBS_U8(vH, vGapO);
+            e = SSW_SUBS_U8(e, vGapE);
+            e = SSW_MAX_U8(e, vH);
+            SSW_STORE(pvE + j, e);
+
+            vF = SSW_SUBS_U8(vF, vGapE);
+            vF = SSW_MAX_U8(vF, vH);
+
+            vH = SSW_LOAD(pvHLoad + j);
+        }
+
+        /* Lazy_F loop */
+        j = 0;
+        vH = SSW_LOAD(pvHStore + j);
+        vF = SSW_SHL8(vF);
+        while (!SSW_ALL_ZERO(SSW_SUBS_U8(vF, SSW_SUBS_U8(vH, vGapO)))) {
+            vH = SSW_MAX_U8(vH, vF);
+            vMaxColumn = SSW_MAX_U8(vMaxColumn, vH);
+            SSW_STORE(pvHStore + j, vH);
+            vF = SSW_SUBS_U8(vF, vGapE);
+            j++;
+            if (j >= segLen) {
+                j = 0;
+                vF = SSW_SHL8(vF);
+            }
+            vH = SSW_LOAD(pvHStore + j);
+        }
+
+        vMaxScore = SSW_MAX_U8(vMaxScore, vMaxColumn);
+        if (!SSW_EQUAL(vMaxMark, vMaxScore)) {
+            const uint8_t temp = SSW_HMAX_U8(vMaxScore);
+            vMaxMark = vMaxScore;
+
+            if (LIKELY(temp > max)) {
+                max = temp;
+                if (max + bias >= 255) break;  //overflow
+                end_ref = i;
+                for (j = 0; LIKELY(j < segLen); ++j)
+                    SSW_STORE(pvHmax + j, SSW_LOAD(pvHStore + j));
+            }
+        }
+
+        maxColumn[i] = SSW_HMAX_U8(vMaxColumn);
+        if (maxColumn[i] == terminate) break;
+    }
+
+    /* Trace the alignment ending position on read. */
+    {
+        const uint8_t* t = (const uint8_t*)pvHmax;
+        const int32_t column_len = segLen * lanes;
+        for (i = 0; LIKELY(i < column_len); ++i, ++t) {
+            if (*t == max) {
+                const int32_t temp = i / lanes + i % lanes * segLen;
+                if (temp < end_read) end_read = temp;
+            }
+        }
+    }
+
+    free(pvHmax);
+    free(pvE);
+    free(pvHLoad);
+    free(pvHStore);
+
+    /* Find the most possible 2nd best alignment. */
+    alignment_end* bests = (alignment_end*)calloc(2, sizeof(alignment_end));
+    bests[0].score = max + bias >= 255 ? 255 : max;
+    bests[0].ref = end_ref;
+    bests[0].read = end_read;
+
+    bests[1].score = 0;
+    bests[1].ref = 0;
+    bests[1].read = 0;
+
+    edge = (end_ref - maskLen) > 0 ? (end_ref - maskLen) : 0;
+    for (i = 0; i < edge; i++) {
+        if (maxColumn[i] > bests[1].score) {
+            bests[1].score = maxColumn[i];
+            bests[1].ref = i;
+        }
+    }
+    edge = (end_ref + maskLen) > refLen ? refLen : (end_ref + maskLen);
+    for (i = edge + 1; i < refLen; i++) {
+        if (maxColumn[i] > bests[1].score) {
+            bests[1].score = maxColumn[i];
+            bests[1].ref = i;
+        }
+    }
+
+    free(maxColumn);
+    return bests;
+}
+
+static SSW_TARGET alignment_end* SSW_NAME(sw_word)(
+    const int8_t* ref, int8_t ref_dir, int32_t refLen, int32_t readLen, const uint8_t weight_gapO,
+    const uint8_t weight_gapE, const int16_t* profile, uint16_t terminate, int32_t maskLen)
+{
+    const int32_t lanes = SSW_LANES8 / 2;
+    uint16_t max = 0;
+    int32_t end_read = readLen - 1;
+    int32_t end_ref = 0;
+    const int32_t segLen = (readLen + lanes - 1) / lanes;
+
+    uint16_t* maxColumn = (uint16_t*)calloc(refLen, 2);
+
+    SSW_VEC* pvHStore = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvHLoad = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvE = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+    SSW_VEC* pvHmax = (SSW_VEC*)calloc(segLen, sizeof(SSW_VEC));
+
+    const SSW_VEC vZero = SSW_ZERO;
+    const SSW_VEC vGapO = SSW_SET1_16(weight_gapO);
+    const SSW_VEC vGapE = SSW_SET1_16(weight_gapE);
+
+    SSW_VEC vMaxScore = vZero;
+    SSW_VEC vMaxMark = vZero;
+    int32_t i, j, k, edge, begin = 0, end = refLen, step = 1;
+
+    if (ref_dir == 1) {
+        begin = refLen - 1;
+        end = -1;
+        step = -1;
+    }
+    for (i = begin; LIKELY(i != end); i += step) {
+        SSW_VEC e, vF = vZero, vMaxColumn = vZero;
+        SSW_VEC vH = SSW_SHL16(SSW_LOAD(pvHStore + segLen - 1));
+        const int16_t* vP = profile + (size_t)ref[i] * segLen * lanes;
+
+        SSW_VEC* pv = pvHLoad;
+        pvHLoad = pvHStore;
+        pvHStore = pv;
+
+        for (j = 0; LIKELY(j < segLen); j++) {
+            vH = SSW_ADDS_I16(vH, SSW_LOAD(vP + (size_t)j * lanes));
+
+            e = SSW_LOAD(pvE + j);
+            vH = SSW_MAX_I16(vH, e);
+            vH = SSW_MAX_I16(vH, vF);
+            vMaxColumn = SSW_MAX_I16(vMaxColumn, vH);
+            SSW_STORE(pvHStore + j, vH);
+
+            vH = SSW_SUBS_U16(vH, vGapO);
+            e = SSW_SUBS_U16(e, vGapE);
+            e = SSW_MAX_I16(e, vH);
+            SSW_STORE(pvE + j, e);
+
+            vF = SSW_SUBS_U16(vF, vGapE);
+            vF = SSW_MAX_I16(vF, vH);
+
+            vH = SSW_LOAD(pvHLoad + j);
+        }
+
+        /* Lazy_F loop */
+        for (k = 0; LIKELY(k < lanes); ++k) {
+            vF = SSW_SHL16(vF);
+            for (j = 0; LIKELY(j < segLen); ++j) {
+                vH = SSW_LOAD(pvHStore + j);
+                vH = SSW_MAX_I16(vH, vF);
+                vMaxColumn = SSW_MAX_I16(vMaxColumn, vH);
+                SSW_STORE(pvHStore + j, vH);
+                vH = SSW_SUBS_U16(vH, vGapO);
+                vF = SSW_SUBS_U16(vF, vGapE);
+                if (UNLIKELY(!SSW_ANY_GT_I16(vF, vH))) goto end;
+            }
+        }
+
+    end:
+        vMaxScore = SSW_MAX_I16(vMaxScore, vMaxColumn);
+        if (!SSW_EQUAL(vMaxMark, vMaxScore)) {
+            const uint16_t temp = SSW_HMAX_I16(vMaxScore);
+            vMaxMark = vMaxScore;
+
+            if (LIKELY(temp > max)) {
+                max = temp;
+                end_ref = i;
+                for (j = 0; LIKELY(j < segLen); ++j)
+                    SSW_STORE(pvHmax + j, SSW_LOAD(pvHStore + j));
+            }
+        }
+
+        maxColumn[i] = SSW_HMAX_I16(vMaxColumn);
+        if (maxColumn[i] == terminate) break;
+    }
+
+    /* Trace the alignment ending position on read. */
+    {
+        const uint16_t* t = (const uint16_t*)pvHmax;
+        const int32_t column_len = segLen * lanes;
+        for (i = 0; LIKELY(i < column_len); ++i, ++t) {
+            if (*t == max) {
+                const int32_t temp = i / lanes + i % lanes * segLen;
+                if (temp < end_read) end_read = temp;
+            }
+        }
+    }
+
+    free(pvHmax);
+    free(pvE);
+    free(pvHLoad);
+    free(pvHStore);
+
+    /* Find the most possible 2nd best alignment. */
+    alignment_end* bests = (alignment_end*)calloc(2, sizeof(alignment_end));
+    bests[0].score = max;
+    bests[0].ref = end_ref;
+    bests[0].read = end_read;
+
+    bests[1].score = 0;
+    bests[1].ref = 0;
+    bests[1].read = 0;
+
+    edge = (end_ref - maskLen) > 0 ? (end_ref - maskLen) : 0;
+    for (i = 0; i < edge; i++) {
+        if (maxColumn[i] > bests[1].score) {
+            bests[1].score = maxColumn[i];
+            bests[1].ref = i;
+        }
+    }
+    edge = (end_ref + maskLen) > refLen ? refLen : (end_ref + maskLen);
+    for (i = edge; i < refLen; i++) {
+        if (maxColumn[i] > bests[1].score) {
+            bests[1].score = maxColumn[i];
+            bests[1].ref = i;
+        }
+    }
+
+    free(maxColumn);
+    return bests;
+}
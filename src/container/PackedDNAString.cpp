@@ -0,0 +1,357 @@
+#include <pbcopper/container/PackedDNAString.h>
+
+#include <pbcopper/utility/SequenceUtils.h>
+
+#include <bit>
+#include <cstring>
+
+namespace PacBio {
+namespace Container {
+namespace {
+
+std::uint64_t ByteSwap(const std::uint64_t word) noexcept { return __builtin_bswap64(word); }
+
+// most significant byte first, zero-filled past the end of 'data'
+std::uint64_t LoadBigEndian(const std::vector<std::uint8_t>& data, const std::size_t pos) noexcept
+{
+    std::uint64_t word = 0;
+    if (pos + 8 <= data.size()) {
+        std::memcpy(&word, data.data() + pos, 8);
+        if constexpr (std::endian::native == std::endian::little) {
+            word = ByteSwap(word);
+        }
+        return word;
+    }
+    for (std::size_t i = 0; i < 8; ++i) {
+        word = (word << 8) | (pos + i < data.size() ? data[pos + i] : 0);
+    }
+    return word;
+}
+
+// reverses the order of the GroupBits-wide groups within each byte
+template <int GroupBits>
+std::uint64_t ReverseGroupsInBytes(std::uint64_t word) noexcept
+{
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+    if constexpr (GroupBits == 1) {
+        word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+    }
+    return word;
+}
+
+///
+/// Reverses 'data' byte-wise, mapping bases with 'reverseComplement', which
+/// reverse-complements the 8 bytes of a word. Words are swapped from both
+/// ends, the remaining middle bytes one at a time.
+///
+template <typename ReverseComplementWord>
+void ReverseComplementBytes(std::vector<std::uint8_t>& data,
+                            const ReverseComplementWord& reverseComplement) noexcept
+{
+    std::size_t lo = 0;
+    std::size_t hi = data.size();
+    for (; hi - lo >= 16; lo += 8, hi -= 8) {
+        std::uint64_t front;
+        std::uint64_t back;
+        std::memcpy(&front, data.data() + lo, 8);
+        std::memcpy(&back, data.data() + hi - 8, 8);
+        front = reverseComplement(front);
+        back = reverseComplement(back);
+        std::memcpy(data.data() + lo, &back, 8);
+        std::memcpy(data.data() + hi - 8, &front, 8);
+    }
+
+    // a single byte ends up in the most significant byte of the word
+    const auto reverseComplementByte = [&](const std::uint8_t byte) {
+        return static_cast<std::uint8_t>(reverseComplement(std::uint64_t{byte}) >> 56);
+    };
+    for (; hi - lo >= 2; ++lo, --hi) {
+        const std::uint8_t front = data[lo];
+        data[lo] = reverseComplementByte(data[hi - 1]);
+        data[hi - 1] = reverseComplementByte(front);
+    }
+    if (hi - lo == 1) {
+        data[lo] = reverseComplementByte(data[lo]);
+    }
+}
+
+// shifts all of 'data' towards the front by 'bits' (1 - 7), zero-filling
+void ShiftLeft(std::vector<std::uint8_t>& data, const int bits) noexcept
+{
+    assert(bits > 0 && bits < 8);
+    for (std::size_t i = 0; i + 1 < data.size(); ++i) {
+        data[i] = (data[i] << bits) | (data[i + 1] >> (8 - bits));
+    }
+    if (!data.empty()) {
+        data.back() <<= bits;
+    }
+}
+
+bool IsN(const char base) noexcept { return (base == 'N') || (base == 'n'); }
+
+}  // namespace
+
+// ---------------------
+// PackedDNA2bitString
+// ---------------------
+
+PackedDNA2bitString::PackedDNA2bitString(const std::string_view seq) { Append(seq); }
+
+bool PackedDNA2bitString::IsN(const std::size_t i) const noexcept
+{
+    assert(i < size_);
+    auto it =
+        std::upper_bound(nRuns_.cbegin(), nRuns_.cend(), i,
+                         [](const std::size_t pos, const NRun& run) { return pos < run.Start; });
+    if (it == nRuns_.cbegin()) {
+        return false;
+    }
+    --it;
+    return i < it->Start + it->Length;
+}
+
+std::uint64_t PackedDNA2bitString::KMer(const std::size_t pos, const std::int32_t k) const noexcept
+{
+    assert(k > 0 && k <= 32);
+    assert(pos + k <= size_);
+
+    // up to 32 bases from the word at 'pos', plus the rest of the next byte
+    const std::size_t first = pos / 4;
+    const int shift = 2 * (pos % 4);
+    std::uint64_t word = LoadBigEndian(data_, first);
+    if (shift) {
+        word <<= shift;
+        if (first + 8 < data_.size()) {
+            word |= data_[first + 8] >> (8 - shift);
+        }
+    }
+    return word >> (64 - 2 * k);
+}
+
+std::string PackedDNA2bitString::ToString(const std::size_t pos, const std::size_t len) const
+{
+    assert(pos + len <= size_);
+
+    std::string result(len, 'A');
+    std::size_t i = 0;
+    for (; (i < len) && ((pos + i) % 4); ++i) {
+        result[i] = Convert2bitToAscii(Code(pos + i));
+    }
+    if (i < len) {
+        Utility::UnpackTwoBit(std::span{data_}.subspan((pos + i) / 4, (len - i + 3) / 4),
+                              std::span{result}.subspan(i));
+    }
+
+    auto it = std::upper_bound(nRuns_.cbegin(), nRuns_.cend(), pos,
+                               [](const std::size_t p, const NRun& run) { return p < run.Start; });
+    if (it != nRuns_.cbegin()) {
+        --it;
+    }
+    for (; (it != nRuns_.cend()) && (it->Start < pos + len); ++it) {
+        const std::size_t start = std::max(it->Start, pos);
+        const std::size_t end = std::min(it->Start + it->Length, pos + len);
+        if (start < end) {
+            std::fill(result.begin() + (start - pos), result.begin() + (end - pos), 'N');
+        }
+    }
+    return result;
+}
+
+void PackedDNA2bitString::Append(const std::string_view seq)
+{
+    const std::size_t oldSize = size_;
+    const std::size_t oldNumRuns = nRuns_.size();
+    const std::size_t oldLastRunLength = nRuns_.empty() ? 0 : nRuns_.back().Length;
+
+    try {
+        std::size_t i = 0;
+        while (i < seq.size()) {
+            // bases up to the next run of N
+            const std::size_t nStart = std::min(seq.find_first_of("Nn", i), seq.size());
+            for (; (i < nStart) && (size_ % 4); ++i) {
+                PushBack(seq[i]);
+            }
+            if (i < nStart) {
+                const std::string_view bases = seq.substr(i, nStart - i);
+                data_.resize((size_ + bases.size() + 3) / 4);
+                Utility::PackTwoBit(bases, std::span{data_}.subspan(size_ / 4));
+                size_ += bases.size();
+            }
+
+            i = nStart;
+            while ((i < seq.size()) && Container::IsN(seq[i])) {
+                ++i;
+            }
+            AppendN(i - nStart);
+        }
+    } catch (...) {
+        size_ = oldSize;
+        data_.resize((size_ + 3) / 4);
+        if (size_ % 4) {
+            data_.back() &= 0xFF << (8 - 2 * (size_ % 4));
+        }
+        nRuns_.resize(oldNumRuns);
+        if (!nRuns_.empty()) {
+            nRuns_.back().Length = oldLastRunLength;
+        }
+        throw;
+    }
+}
+
+void PackedDNA2bitString::AppendN(const std::size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+    if (!nRuns_.empty() && (nRuns_.back().Start + nRuns_.back().Length == size_)) {
+        nRuns_.back().Length += length;
+    } else {
+        nRuns_.push_back({size_, length});
+    }
+
+    // packed as A
+    size_ += length;
+    data_.resize((size_ + 3) / 4);
+}
+
+void PackedDNA2bitString::PushBack(const char base)
+{
+    if (Container::IsN(base)) {
+        AppendN(1);
+        return;
+    }
+
+    std::uint8_t code = 0;
+    Utility::PackTwoBit({&base, 1}, {&code, 1});
+    if (size_ % 4) {
+        data_.back() |= code >> (2 * (size_ % 4));
+    } else {
+        data_.push_back(code);
+    }
+    ++size_;
+}
+
+void PackedDNA2bitString::Reserve(const std::size_t size) { data_.reserve((size + 3) / 4); }
+
+void PackedDNA2bitString::Clear() noexcept
+{
+    data_.clear();
+    size_ = 0;
+    nRuns_.clear();
+}
+
+void PackedDNA2bitString::ReverseComplement() noexcept
+{
+    // NCBI2na complements by negation
+    ReverseComplementBytes(
+        data_, [](const std::uint64_t word) { return ~ReverseGroupsInBytes<2>(ByteSwap(word)); });
+
+    // the unused bases of the last byte are now in front of the first one
+    const std::size_t unused = 4 * data_.size() - size_;
+    if (unused) {
+        ShiftLeft(data_, 2 * unused);
+    }
+
+    // Ns complemented to T, packed as A again
+    for (auto& run : nRuns_) {
+        run.Start = size_ - run.Start - run.Length;
+        for (std::size_t i = run.Start; i < run.Start + run.Length; ++i) {
+            data_[i / 4] &= ~(0b11 << (6 - 2 * (i % 4)));
+        }
+    }
+    std::reverse(nRuns_.begin(), nRuns_.end());
+}
+
+// ---------------------
+// PackedDNA4bitString
+// ---------------------
+
+PackedDNA4bitString::PackedDNA4bitString(const std::string_view seq) { Append(seq); }
+
+std::uint64_t PackedDNA4bitString::KMer(const std::size_t pos, const std::int32_t k) const noexcept
+{
+    assert(k > 0 && k <= 16);
+    assert(pos + k <= size_);
+
+    const std::size_t first = pos / 2;
+    std::uint64_t word = LoadBigEndian(data_, first);
+    if (pos % 2) {
+        word <<= 4;
+        if (first + 8 < data_.size()) {
+            word |= data_[first + 8] >> 4;
+        }
+    }
+    return word >> (64 - 4 * k);
+}
+
+std::string PackedDNA4bitString::ToString(const std::size_t pos, const std::size_t len) const
+{
+    assert(pos + len <= size_);
+
+    std::string result(len, 'N');
+    std::size_t i = 0;
+    if ((len > 0) && (pos % 2)) {
+        result[i++] = (*this)[pos];
+    }
+    if (i < len) {
+        Utility::UnpackFourBit(std::span{data_}.subspan((pos + i) / 2, (len - i + 1) / 2),
+                               std::span{result}.subspan(i));
+    }
+    return result;
+}
+
+void PackedDNA4bitString::Append(const std::string_view seq)
+{
+    const std::size_t oldSize = size_;
+    try {
+        std::size_t i = 0;
+        if ((size_ % 2) && !seq.empty()) {
+            PushBack(seq[i++]);
+        }
+        const std::string_view bases = seq.substr(i);
+        data_.resize((size_ + bases.size() + 1) / 2);
+        Utility::PackFourBit(bases, std::span{data_}.subspan(size_ / 2));
+        size_ += bases.size();
+    } catch (...) {
+        size_ = oldSize;
+        data_.resize((size_ + 1) / 2);
+        if (size_ % 2) {
+            data_.back() &= 0xF0;
+        }
+        throw;
+    }
+}
+
+void PackedDNA4bitString::PushBack(const char base)
+{
+    std::uint8_t code = 0;
+    Utility::PackFourBit({&base, 1}, {&code, 1});
+    if (size_ % 2) {
+        data_.back() |= code >> 4;
+    } else {
+        data_.push_back(code);
+    }
+    ++size_;
+}
+
+void PackedDNA4bitString::Reserve(const std::size_t size) { data_.reserve((size + 1) / 2); }
+
+void PackedDNA4bitString::Clear() noexcept
+{
+    data_.clear();
+    size_ = 0;
+}
+
+void PackedDNA4bitString::ReverseComplement() noexcept
+{
+    // the BAM codes are bit sets of ACGT, complemented by reversing their bits
+    ReverseComplementBytes(
+        data_, [](const std::uint64_t word) { return ReverseGroupsInBytes<1>(ByteSwap(word)); });
+    if (size_ % 2) {
+        ShiftLeft(data_, 4);
+    }
+}
+
+}  // namespace Container
+}  // namespace PacBio
@@ -1,14 +1,22 @@
 #include <pbcopper/dagcon/AlignmentGraph.h>
 
+#include "AlignmentPath.h"
+
 #include <pbcopper/dagcon/Alignment.h>
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
 #include <pbcopper/utility/Ssize.h>
 
 #include <boost/range/iterator_range.hpp>
 #include <boost/utility/value_init.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <map>
+#include <optional>
 #include <queue>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -18,6 +26,128 @@
 
 namespace PacBio {
 namespace Dagcon {
+namespace {
+
+// Batch build: AddAlignment's effect on the graph, accumulated per backbone
+// position without touching the graph.
+//
+// Vertices 0 .. L+1 are enter, backbone, and exit. Every inserted query base
+// becomes a vertex of its own, numbered after those in alignment order, so an
+// edge into or out of one is only ever added once. Edges between the other
+// vertices are counted in the column of their target, or of their source for
+// edges into the exit vertex. Each edge carries the (alignment, column) that
+// first added it, so adding them in that order reproduces the in- and
+// out-edge order that the sequential build would have.
+
+struct CountedEdge
+{
+    std::uint64_t Key;  // (alignment << 32) | column that added it first
+    std::uint32_t Source;
+    std::uint32_t Target;
+    std::uint32_t Count;
+};
+
+struct BackboneColumn
+{
+    std::uint32_t Coverage = 0;
+    std::uint32_t Weight = 0;
+    char Base = '\0';  // last target base seen, if any
+
+    // edges from enter or backbone vertices
+    std::vector<CountedEdge> InEdges;
+
+    // edge from this vertex to the exit vertex
+    std::uint32_t ExitCount = 0;
+    std::uint64_t ExitKey = 0;
+};
+
+struct InsertionVertex
+{
+    char Base;
+    std::uint32_t BackbonePosition;
+};
+
+// Position while walking an alignment. 'Previous' insertion vertices are
+// numbered per alignment, starting at L+2.
+struct WalkState
+{
+    std::uint32_t Column;
+    std::uint32_t BackbonePosition;
+    std::uint32_t NumInsertions;
+    std::uint32_t Previous;
+};
+
+struct AlignmentWalk
+{
+    // state at the first column in each window the alignment reaches
+    std::vector<WalkState> Checkpoints;
+    WalkState End;
+    bool Valid;
+};
+
+std::uint64_t EdgeKey(const std::size_t alignment, const std::uint32_t column)
+{
+    return (static_cast<std::uint64_t>(alignment) << 32) | column;
+}
+
+// Mirrors AlignmentGraph::AddAlignment, recording where the walk enters each
+// window and where it ends.
+AlignmentWalk WalkAlignment(const Alignment& alignment, const std::uint32_t backboneLength,
+                            const std::size_t windowSize, const bool useLocalMerge)
+{
+    AlignmentWalk walk;
+    walk.Valid = false;
+    if (alignment.Start == 0 || alignment.Start > backboneLength + 1 ||
+        alignment.Query.length() != alignment.Target.length() ||
+        alignment.Query.length() >= std::numeric_limits<std::uint32_t>::max()) {
+        return walk;
+    }
+
+    const std::uint32_t firstInsertion = backboneLength + 2;
+    WalkState state{0, alignment.Start, 0,
+                    (useLocalMerge && alignment.Start > 1) ? alignment.Start - 1 : 0};
+    std::size_t window = std::numeric_limits<std::size_t>::max();
+    for (; state.Column < alignment.Query.length(); ++state.Column) {
+        if ((state.BackbonePosition - 1) / windowSize != window) {
+            window = (state.BackbonePosition - 1) / windowSize;
+            walk.Checkpoints.push_back(state);
+        }
+
+        const char queryBase = alignment.Query[state.Column];
+        const char targetBase = alignment.Target[state.Column];
+        if (queryBase == targetBase) {
+            if (state.BackbonePosition > backboneLength) {
+                return walk;
+            }
+            state.Previous = state.BackbonePosition++;
+        } else if (queryBase == '-' && targetBase != '-') {
+            if (state.BackbonePosition > backboneLength) {
+                return walk;
+            }
+            ++state.BackbonePosition;
+        } else if (queryBase != '-' && targetBase == '-') {
+            state.Previous = firstInsertion + state.NumInsertions++;
+        }
+    }
+
+    walk.End = state;
+    walk.Valid = true;
+    return walk;
+}
+
+void AddCountedEdge(std::vector<CountedEdge>& edges, const std::uint32_t source,
+                    const std::uint32_t target, const std::uint64_t key)
+{
+    for (auto& edge : edges) {
+        if (edge.Source == source) {
+            ++edge.Count;
+            return;
+        }
+    }
+    edges.push_back(CountedEdge{key, source, target, 1});
+}
+
+}  // namespace
 
 AlignmentGraph::AlignmentGraph(const std::string& backbone) : backboneLength_{backbone.length()}
 {
@@ -57,6 +187,184 @@ AlignmentGraph::AlignmentGraph(const std::size_t backboneLength)
     : AlignmentGraph{std::string(backboneLength, 'N')}
 {}
 
+AlignmentGraph::AlignmentGraph(const std::string& backbone,
+                               const std::vector<Alignment>& alignments,
+                               const AlignmentGraphBuildOptions& options)
+    : AlignmentGraph{backbone}
+{
+    if (options.WindowSize == 0) {
+        throw std::invalid_argument{"[pbcopper] dagcon ERROR: window size must be positive"};
+    }
+    if (backboneLength_ + 2 >= std::numeric_limits<std::uint32_t>::max() ||
+        alignments.size() >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error{"[pbcopper] dagcon ERROR: too many alignments for batch build"};
+    }
+
+    const auto backboneLength = static_cast<std::uint32_t>(backboneLength_);
+    const std::uint32_t exitVertex = backboneLength + 1;
+    const std::uint32_t firstInsertion = backboneLength + 2;
+    const std::size_t windowSize = options.WindowSize;
+    const std::size_t numWindows = (backboneLength / windowSize) + 1;
+    const unsigned int numThreads = Parallel::NormalizedThreadCount(options.NumThreads);
+    std::optional<Parallel::FireAndForget> faf;
+    if (numThreads > 1) {
+        faf.emplace(numThreads);
+    }
+    Parallel::FireAndForget* const pool = (faf ? &*faf : nullptr);
+
+    // find where each alignment enters each window
+    std::vector<AlignmentWalk> walks(alignments.size());
+    std::atomic<std::size_t> nextAlignment{0};
+    const auto numWalkTasks =
+        static_cast<std::int32_t>(std::min<std::size_t>(numThreads, alignments.size()));
+    Parallel::Dispatch(pool, numWalkTasks, [&](std::int32_t) {
+        for (std::size_t i = nextAlignment++; i < alignments.size(); i = nextAlignment++) {
+            walks[i] =
+                WalkAlignment(alignments[i], backboneLength, windowSize, options.UseLocalMerge);
+        }
+    });
+
+    // number insertion vertices in alignment order & index checkpoints by window
+    std::vector<std::uint32_t> insertionOffsets(alignments.size());
+    std::vector<std::vector<std::pair<std::uint32_t, WalkState>>> windowCheckpoints(numWindows);
+    std::uint64_t numInsertions = 0;
+    for (std::size_t i = 0; i < alignments.size(); ++i) {
+        const auto& walk = walks[i];
+        if (!walk.Valid) {
+            throw std::invalid_argument{"[pbcopper] dagcon ERROR: alignment " + std::to_string(i) +
+                                        " does not fit the backbone"};
+        }
+        insertionOffsets[i] = static_cast<std::uint32_t>(numInsertions);
+        numInsertions += walk.End.NumInsertions;
+        if (firstInsertion + numInsertions >= std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error{"[pbcopper] dagcon ERROR: too many alignments for batch build"};
+        }
+        for (const auto& checkpoint : walk.Checkpoints) {
+            windowCheckpoints[(checkpoint.BackbonePosition - 1) / windowSize].emplace_back(
+                static_cast<std::uint32_t>(i), checkpoint);
+        }
+    }
+
+    // accumulate columns, one window at a time per thread
+    std::vector<BackboneColumn> columns(backboneLength + 2);
+    std::vector<InsertionVertex> insertions(numInsertions);
+    std::vector<std::vector<CountedEdge>> windowEdges(numWindows);
+    std::atomic<std::size_t> nextWindow{0};
+    const auto numWindowTasks =
+        static_cast<std::int32_t>(std::min<std::size_t>(numThreads, numWindows));
+    Parallel::Dispatch(pool, numWindowTasks, [&](std::int32_t) {
+        for (std::size_t w = nextWindow++; w < numWindows; w = nextWindow++) {
+            auto& edges = windowEdges[w];
+            const auto addEdge = [&](const std::uint32_t u, const std::uint32_t v,
+                                     const std::uint64_t key) {
+                if (u < firstInsertion && v < firstInsertion) {
+                    AddCountedEdge(columns[v].InEdges, u, v, key);
+                } else {
+                    edges.push_back(CountedEdge{key, u, v, 1});
+                }
+            };
+
+            for (const auto& [i, checkpoint] : windowCheckpoints[w]) {
+                const Alignment& alignment = alignments[i];
+                const std::uint32_t offset = insertionOffsets[i];
+                std::uint32_t bbPos = checkpoint.BackbonePosition;
+                std::uint32_t prevVtx = checkpoint.Previous < firstInsertion
+                                            ? checkpoint.Previous
+                                            : checkpoint.Previous + offset;
+                std::uint32_t newVtx = firstInsertion + offset + checkpoint.NumInsertions;
+                for (std::uint32_t c = checkpoint.Column; c < alignment.Query.length(); ++c) {
+                    if ((bbPos - 1) / windowSize != w) {
+                        break;
+                    }
+
+                    const char queryBase = alignment.Query[c];
+                    const char targetBase = alignment.Target[c];
+                    if (queryBase == targetBase) {
+                        auto& column = columns[bbPos];
+                        ++column.Coverage;
+                        column.Base = targetBase;
+                        ++column.Weight;
+                        addEdge(prevVtx, bbPos, EdgeKey(i, c));
+                        prevVtx = bbPos++;
+                    } else if (queryBase == '-' && targetBase != '-') {
+                        auto& column = columns[bbPos];
+                        ++column.Coverage;
+                        column.Base = targetBase;
+                        ++bbPos;
+                    } else if (queryBase != '-' && targetBase == '-') {
+                        insertions[newVtx - firstInsertion] = InsertionVertex{queryBase, bbPos};
+                        addEdge(prevVtx, newVtx, EdgeKey(i, c));
+                        prevVtx = newVtx++;
+                    }
+                }
+            }
+        }
+    });
+
+    // edges into the exit vertex
+    std::vector<CountedEdge> newEdges;
+    for (std::size_t i = 0; i < alignments.size(); ++i) {
+        const auto& end = walks[i].End;
+        const std::uint64_t key = EdgeKey(i, end.Column);
+        if (end.Previous < firstInsertion) {
+            auto& column = columns[end.Previous];
+            if (column.ExitCount++ == 0) {
+                column.ExitKey = key;
+            }
+        } else {
+            newEdges.push_back(CountedEdge{key, end.Previous + insertionOffsets[i], exitVertex, 1});
+        }
+    }
+
+    // materialize: vertices, then edges in the order they were first added
+    for (std::size_t i = 0; i < insertions.size(); ++i) {
+        const VertexIndex v = boost::add_vertex(graph_);
+        assert(v == firstInsertion + i);
+        graph_[v].Base = insertions[i].Base;
+        graph_[v].Weight = 1;
+        bbMap_.emplace_hint(bbMap_.end(), v, insertions[i].BackbonePosition);
+    }
+
+    const auto countChainEdge = [this](const std::uint32_t u, const std::uint32_t count) {
+        const auto chainEdge = boost::edge(u, u + 1, graph_);
+        assert(chainEdge.second);
+        graph_[chainEdge.first].Count += count;
+    };
+    for (std::uint32_t v = 0; v < columns.size(); ++v) {
+        const auto& column = columns[v];
+        if (column.Base != '\0') {
+            graph_[v].Base = column.Base;
+        }
+        graph_[v].Coverage += column.Coverage;
+        graph_[v].Weight += column.Weight;
+
+        for (const auto& edge : column.InEdges) {
+            if (edge.Source + 1 == v) {
+                countChainEdge(edge.Source, edge.Count);
+            } else {
+                newEdges.push_back(edge);
+            }
+        }
+        if (column.ExitCount > 0) {
+            if (v + 1 == exitVertex) {
+                countChainEdge(v, column.ExitCount);
+            } else {
+                newEdges.push_back(CountedEdge{column.ExitKey, v, exitVertex, column.ExitCount});
+            }
+        }
+    }
+    for (const auto& edges : windowEdges) {
+        newEdges.insert(newEdges.end(), edges.cbegin(), edges.cend());
+    }
+
+    std::sort(newEdges.begin(), newEdges.end(),
+              [](const CountedEdge& lhs, const CountedEdge& rhs) { return lhs.Key < rhs.Key; });
+    for (const auto& edge : newEdges) {
+        const auto p = boost::add_edge(edge.Source, edge.Target, graph_);
+        graph_[p.first].Count = edge.Count;
+    }
+}
+
 void AlignmentGraph::AddAlignment(Alignment& alignment, bool useLocalMerge)
 {
     const IndexMap index = boost::get(boost::vertex_index, graph_);
@@ -323,164 +631,30 @@ void AlignmentGraph::ReapNodes()
 
 std::string AlignmentGraph::Consensus(int minWeight)
 {
-    // consensus sequence
-    std::string cns;
-
-    // track the longest consensus path meeting minimum weight
-    int offs = 0;
-    int bestOffs = 0;
-    int length = 0;
-    int idx = 0;
-    bool metWeight = false;
-    for (const auto& n : BestPath()) {
-        if (n.Base == graph_[enterVertex_].Base || n.Base == graph_[exitVertex_].Base) {
-            continue;
-        }
-
-        cns += n.Base;
-
-        // initial beginning of minimum weight section
-        if (!metWeight && n.Weight >= minWeight) {
-            offs = idx;
-            metWeight = true;
-        } else if (metWeight && n.Weight < minWeight) {
-            // concluded minimum weight section, update if longest seen so far
-            if ((idx - offs) > length) {
-                bestOffs = offs;
-                length = idx - offs;
-            }
-            metWeight = false;
-        }
-        idx++;
-    }
-
-    // include end of sequence
-    if (metWeight && (idx - offs) > length) {
-        bestOffs = offs;
-        length = idx - offs;
-    }
-
-    return cns.substr(bestOffs, length);
+    return internal::LongestConsensus(BestPath(), minWeight);
 }
 
 void AlignmentGraph::Consensus(std::vector<ConsensusResult>& seqs, int minWeight,
                                std::size_t minLen)
 {
-    seqs.clear();
-
-    // consensus sequence
-    std::string cns;
-
-    // track the longest consensus path meeting minimum weight
-    int offs = 0;
-    int idx = 0;
-    bool metWeight = false;
-    for (const auto& n : BestPath()) {
-        if (n.Base == graph_[enterVertex_].Base || n.Base == graph_[exitVertex_].Base) {
-            continue;
-        }
-
-        cns += n.Base;
-
-        // initial beginning of minimum weight section
-        if (!metWeight && n.Weight >= minWeight) {
-            offs = idx;
-            metWeight = true;
-        } else if (metWeight && n.Weight < minWeight) {
-            // concluded minimum weight section, add sequence to supplied vector
-            metWeight = false;
-            const std::size_t length = idx - offs;
-            if (length >= minLen) {
-                seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
-            }
-        }
-        idx++;
-    }
-
-    // include end of sequence
-    if (metWeight) {
-        const std::size_t length = idx - offs;
-        if (length >= minLen) {
-            seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
-        }
-    }
+    internal::ConsensusSections(BestPath(), seqs, minWeight, minLen);
 }
 
 void AlignmentGraph::ConsensusWithMinFlankCoverage(std::vector<ConsensusResult>& seqs,
                                                    int minWeight, int minFlankCoverage,
                                                    std::size_t minLen)
 {
-    seqs.clear();
-
-    // get the best scoring path
-    const auto path = BestPath();
-    const auto pathLength = Utility::Ssize(path);
-    if (pathLength == 0) {
-        return;
-    }
-
-    std::int64_t numClippedFront = 0;
-    auto startNode = path.begin();
-    for (; startNode != path.end(); ++startNode, ++numClippedFront) {
-        const AlignmentNode& n = *startNode;
-        if (n.Coverage >= minFlankCoverage) {
-            break;
-        }
-    }
-
-    auto endNode = path.end();
-    std::int64_t numClippedBack = 0;
-    for (std::int64_t i = pathLength - 1; i >= 0; --i, ++numClippedBack) {
-        if (path[i].Coverage >= minFlankCoverage) {
-            break;
-        }
-        --endNode;
-    }
-
-    if (numClippedFront >= (pathLength - numClippedBack)) {
-        return;
-    }
-
-    // consensus sequence
-    std::string cns;
-
-    // track the longest consensus path meeting minimum weight
-    int offs = 0;
-    int idx = 0;
-    bool metWeight = false;
-    auto curr = startNode;
-    for (; curr != endNode; ++curr) {
-        const AlignmentNode& n = *curr;
-        if (n.Base == graph_[enterVertex_].Base || n.Base == graph_[exitVertex_].Base) {
-            continue;
-        }
-
-        cns += n.Base;
-
-        // initial beginning of minimum weight section
-        if (!metWeight && n.Weight >= minWeight) {
-            offs = idx;
-            metWeight = true;
-        } else if (metWeight && n.Weight < minWeight) {
-            // concluded minimum weight section, add sequence to supplied vector
-            metWeight = false;
-            const std::size_t length = idx - offs;
-            if (length >= minLen) {
-                seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
-            }
-        }
-        idx++;
-    }
-    // include end of sequence
-    if (metWeight) {
-        const std::size_t length = idx - offs;
-        if (length >= minLen) {
-            seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
-        }
-    }
+    internal::ConsensusSectionsWithMinFlankCoverage(BestPath(), seqs, minWeight, minFlankCoverage,
+                                                    minLen);
 }
 
 std::vector<AlignmentNode> AlignmentGraph::BestPath()
+{
+    std::vector<std::size_t> backbonePositions;
+    return BestPath(backbonePositions);
+}
+
+std::vector<AlignmentNode> AlignmentGraph::BestPath(std::vector<std::size_t>& backbonePositions)
 {
     for (const auto edge : boost::make_iterator_range(edges(graph_))) {
         graph_[edge].Visited = false;
@@ -555,8 +729,10 @@ std::vector<AlignmentNode> AlignmentGraph::BestPath()
     VertexIndex prev = enterVertex_;
     VertexIndex next;
     std::vector<AlignmentNode> bpath;
+    backbonePositions.clear();
     while (true) {
         bpath.push_back(graph_[prev]);
+        backbonePositions.push_back(graph_[prev].Backbone ? prev : bbMap_.at(prev));
         if (bestNodeScoreEdge.count(prev) == 0) {
             break;
         } else {
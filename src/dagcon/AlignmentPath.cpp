@@ -0,0 +1,178 @@
+#include "AlignmentPath.h"
+
+#include <pbcopper/utility/Ssize.h>
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace Dagcon {
+namespace internal {
+namespace {
+
+bool IsTerminal(const AlignmentNode& n) { return n.Base == '^' || n.Base == '$'; }
+
+}  // namespace
+
+std::string LongestConsensus(const std::vector<AlignmentNode>& path, const int minWeight)
+{
+    // consensus sequence
+    std::string cns;
+
+    // track the longest consensus path meeting minimum weight
+    int offs = 0;
+    int bestOffs = 0;
+    int length = 0;
+    int idx = 0;
+    bool metWeight = false;
+    for (const auto& n : path) {
+        if (IsTerminal(n)) {
+            continue;
+        }
+
+        cns += n.Base;
+
+        // initial beginning of minimum weight section
+        if (!metWeight && n.Weight >= minWeight) {
+            offs = idx;
+            metWeight = true;
+        } else if (metWeight && n.Weight < minWeight) {
+            // concluded minimum weight section, update if longest seen so far
+            if ((idx - offs) > length) {
+                bestOffs = offs;
+                length = idx - offs;
+            }
+            metWeight = false;
+        }
+        idx++;
+    }
+
+    // include end of sequence
+    if (metWeight && (idx - offs) > length) {
+        bestOffs = offs;
+        length = idx - offs;
+    }
+
+    return cns.substr(bestOffs, length);
+}
+
+void ConsensusSections(const std::vector<AlignmentNode>& path, std::vector<ConsensusResult>& seqs,
+                       const int minWeight, const std::size_t minLen)
+{
+    seqs.clear();
+
+    // consensus sequence
+    std::string cns;
+
+    // track the longest consensus path meeting minimum weight
+    int offs = 0;
+    int idx = 0;
+    bool metWeight = false;
+    for (const auto& n : path) {
+        if (IsTerminal(n)) {
+            continue;
+        }
+
+        cns += n.Base;
+
+        // initial beginning of minimum weight section
+        if (!metWeight && n.Weight >= minWeight) {
+            offs = idx;
+            metWeight = true;
+        } else if (metWeight && n.Weight < minWeight) {
+            // concluded minimum weight section, add sequence to supplied vector
+            metWeight = false;
+            const std::size_t length = idx - offs;
+            if (length >= minLen) {
+                seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
+            }
+        }
+        idx++;
+    }
+
+    // include end of sequence
+    if (metWeight) {
+        const std::size_t length = idx - offs;
+        if (length >= minLen) {
+            seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
+        }
+    }
+}
+
+void ConsensusSectionsWithMinFlankCoverage(const std::vector<AlignmentNode>& path,
+                                           std::vector<ConsensusResult>& seqs, const int minWeight,
+                                           const int minFlankCoverage, const std::size_t minLen)
+{
+    seqs.clear();
+
+    const auto pathLength = Utility::Ssize(path);
+    if (pathLength == 0) {
+        return;
+    }
+
+    std::int64_t numClippedFront = 0;
+    auto startNode = path.begin();
+    for (; startNode != path.end(); ++startNode, ++numClippedFront) {
+        const AlignmentNode& n = *startNode;
+        if (n.Coverage >= minFlankCoverage) {
+            break;
+        }
+    }
+
+    auto endNode = path.end();
+    std::int64_t numClippedBack = 0;
+    for (std::int64_t i = pathLength - 1; i >= 0; --i, ++numClippedBack) {
+        if (path[i].Coverage >= minFlankCoverage) {
+            break;
+        }
+        --endNode;
+    }
+
+    if (numClippedFront >= (pathLength - numClippedBack)) {
+        return;
+    }
+
+    // consensus sequence
+    std::string cns;
+
+    // track the longest consensus path meeting minimum weight
+    int offs = 0;
+    int idx = 0;
+    bool metWeight = false;
+    auto curr = startNode;
+    for (; curr != endNode; ++curr) {
+        const AlignmentNode& n = *curr;
+        if (IsTerminal(n)) {
+            continue;
+        }
+
+        cns += n.Base;
+
+        // initial beginning of minimum weight section
+        if (!metWeight && n.Weight >= minWeight) {
+            offs = idx;
+            metWeight = true;
+        } else if (metWeight && n.Weight < minWeight) {
+            // concluded minimum weight section, add sequence to supplied vector
+            metWeight = false;
+            const std::size_t length = idx - offs;
+            if (length >= minLen) {
+                seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
+            }
+        }
+        idx++;
+    }
+    // include end of sequence
+    if (metWeight) {
+        const std::size_t length = idx - offs;
+        if (length >= minLen) {
+            seqs.emplace_back(ConsensusResult{{offs, idx}, cns.substr(offs, length)});
+        }
+    }
+}
+
+}  // namespace internal
+}  // namespace Dagcon
+}  // namespace PacBio
@@ -0,0 +1,40 @@
+#ifndef PBCOPPER_DAGCON_ALIGNMENTPATH_H
+#define PBCOPPER_DAGCON_ALIGNMENTPATH_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/dagcon/AlignmentGraph.h>
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace Dagcon {
+namespace internal {
+
+//
+// Consensus calls on a best path through an alignment graph, shared by
+// AlignmentGraph and WindowedAlignmentGraph. Enter & exit nodes on the path
+// are skipped.
+//
+
+/// \returns the longest run of path bases meeting \p minWeight
+std::string LongestConsensus(const std::vector<AlignmentNode>& path, int minWeight);
+
+/// Fills \p seqs with all runs of path bases meeting \p minWeight
+void ConsensusSections(const std::vector<AlignmentNode>& path, std::vector<ConsensusResult>& seqs,
+                       int minWeight, std::size_t minLen);
+
+/// Same as ConsensusSections, after clipping path ends with coverage below
+/// \p minFlankCoverage
+void ConsensusSectionsWithMinFlankCoverage(const std::vector<AlignmentNode>& path,
+                                           std::vector<ConsensusResult>& seqs, int minWeight,
+                                           int minFlankCoverage, std::size_t minLen);
+
+}  // namespace internal
+}  // namespace Dagcon
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DAGCON_ALIGNMENTPATH_H
@@ -0,0 +1,220 @@
+#include <pbcopper/dagcon/WindowedAlignmentGraph.h>
+
+#include "AlignmentPath.h"
+
+#include <pbcopper/dagcon/Alignment.h>
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace Dagcon {
+namespace {
+
+// Backbone positions [Begin, End) of one window. The enter & exit nodes are at
+// positions 0 and backbone length + 1.
+struct BackboneRange
+{
+    std::size_t Begin;
+    std::size_t End;
+};
+
+struct Window
+{
+    BackboneRange Graph;      // backbone bases in the window's graph
+    BackboneRange Consensus;  // path nodes kept from it
+};
+
+std::vector<Window> MakeWindows(const std::size_t backboneLength,
+                                const WindowedAlignmentGraphOptions& options)
+{
+    const std::size_t numWindows =
+        std::max<std::size_t>(1, (backboneLength + options.WindowSize - 1) / options.WindowSize);
+    std::vector<Window> windows(numWindows);
+    for (std::size_t i = 0; i < numWindows; ++i) {
+        const std::size_t begin = 1 + (i * options.WindowSize);
+        const std::size_t end = std::min(backboneLength + 1, begin + options.WindowSize);
+        windows[i].Graph.Begin = begin - std::min(begin - 1, options.Overlap);
+        windows[i].Graph.End = std::min(backboneLength + 1, end + options.Overlap);
+        windows[i].Consensus.Begin = (i == 0) ? 0 : begin;
+        windows[i].Consensus.End = (i + 1 == numWindows) ? backboneLength + 2 : end;
+    }
+    return windows;
+}
+
+// Backbone position following the alignment, as AlignmentGraph::AddAlignment
+// counts them.
+std::size_t AlignmentEnd(const Alignment& alignment)
+{
+    std::size_t bbPos = alignment.Start;
+    for (std::size_t i = 0; i < alignment.Query.length(); ++i) {
+        const char queryBase = alignment.Query[i];
+        const char targetBase = alignment.Target[i];
+        if (queryBase == targetBase || (queryBase == '-' && targetBase != '-')) {
+            ++bbPos;
+        }
+    }
+    return bbPos;
+}
+
+// The columns of 'alignment' at backbone positions in 'range', relative to its
+// first base. Insertions belong to the backbone position following them.
+Alignment ClipAlignment(const Alignment& alignment, const BackboneRange& range)
+{
+    std::size_t bbPos = alignment.Start;
+    std::size_t begin = 0;
+    for (; begin < alignment.Query.length() && bbPos < range.Begin; ++begin) {
+        const char queryBase = alignment.Query[begin];
+        const char targetBase = alignment.Target[begin];
+        if (queryBase == targetBase || (queryBase == '-' && targetBase != '-')) {
+            ++bbPos;
+        }
+    }
+
+    Alignment result;
+    result.TargetLength = alignment.TargetLength;
+    result.Start = bbPos - range.Begin + 1;
+    result.Id = alignment.Id;
+    result.SId = alignment.SId;
+    result.Strand = alignment.Strand;
+
+    std::size_t end = begin;
+    for (; end < alignment.Query.length() && bbPos < range.End; ++end) {
+        const char queryBase = alignment.Query[end];
+        const char targetBase = alignment.Target[end];
+        if (queryBase == targetBase || (queryBase == '-' && targetBase != '-')) {
+            ++bbPos;
+        }
+    }
+    result.Query = alignment.Query.substr(begin, end - begin);
+    result.Target = alignment.Target.substr(begin, end - begin);
+    return result;
+}
+
+}  // namespace
+
+WindowedAlignmentGraph::WindowedAlignmentGraph(const std::string& backbone,
+                                               const std::vector<Alignment>& alignments,
+                                               const WindowedAlignmentGraphOptions& options)
+{
+    if (options.WindowSize == 0) {
+        throw std::invalid_argument{"[pbcopper] dagcon ERROR: window size must be positive"};
+    }
+
+    const std::size_t backboneLength = backbone.length();
+    const auto windows = MakeWindows(backboneLength, options);
+
+    // assign alignments to the windows they overlap
+    std::vector<std::vector<std::size_t>> windowAlignments(windows.size());
+    for (std::size_t i = 0; i < alignments.size(); ++i) {
+        const Alignment& alignment = alignments[i];
+        if (alignment.Start == 0 || alignment.Query.length() != alignment.Target.length()) {
+            throw std::invalid_argument{"[pbcopper] dagcon ERROR: alignment " + std::to_string(i) +
+                                        " does not fit the backbone"};
+        }
+        const std::size_t end = AlignmentEnd(alignment);
+        if (end > backboneLength + 1) {
+            throw std::invalid_argument{"[pbcopper] dagcon ERROR: alignment " + std::to_string(i) +
+                                        " does not fit the backbone"};
+        }
+
+        // trailing insertions belong to the base after the alignment
+        auto window = std::partition_point(
+            windows.cbegin(), windows.cend(),
+            [&alignment](const Window& w) { return w.Graph.End <= alignment.Start; });
+        for (; window != windows.cend() && window->Graph.Begin <= end; ++window) {
+            windowAlignments[window - windows.cbegin()].push_back(i);
+        }
+    }
+
+    // resolve windows, freeing each graph once done
+    std::vector<std::vector<AlignmentNode>> windowPaths(windows.size());
+    std::atomic<std::size_t> nextWindow{0};
+    const unsigned int numThreads = Parallel::NormalizedThreadCount(options.NumThreads);
+    std::optional<Parallel::FireAndForget> faf;
+    if (numThreads > 1) {
+        faf.emplace(numThreads);
+    }
+    Parallel::FireAndForget* const pool = (faf ? &*faf : nullptr);
+    const auto numWindowTasks =
+        static_cast<std::int32_t>(std::min<std::size_t>(numThreads, windows.size()));
+    Parallel::Dispatch(pool, numWindowTasks, [&](std::int32_t) {
+        for (std::size_t w = nextWindow++; w < windows.size(); w = nextWindow++) {
+            const Window& window = windows[w];
+
+            // the last window also takes insertions after the backbone
+            BackboneRange clipRange = window.Graph;
+            if (clipRange.End == backboneLength + 1) {
+                ++clipRange.End;
+            }
+            std::vector<Alignment> clipped;
+            clipped.reserve(windowAlignments[w].size());
+            for (const std::size_t i : windowAlignments[w]) {
+                auto alignment = ClipAlignment(alignments[i], clipRange);
+                if (!alignment.Query.empty()) {
+                    clipped.push_back(std::move(alignment));
+                }
+            }
+            windowAlignments[w] = std::vector<std::size_t>{};
+
+            AlignmentGraphBuildOptions buildOptions;
+            buildOptions.NumThreads = 1;
+            buildOptions.UseLocalMerge = options.UseLocalMerge;
+            AlignmentGraph graph{
+                backbone.substr(window.Graph.Begin - 1, window.Graph.End - window.Graph.Begin),
+                clipped, buildOptions};
+            clipped = std::vector<Alignment>{};
+            graph.MergeNodes();
+
+            std::vector<std::size_t> backbonePositions;
+            const auto path = graph.BestPath(backbonePositions);
+            auto& windowPath = windowPaths[w];
+            for (std::size_t i = 0; i < path.size(); ++i) {
+                const std::size_t bbPos = backbonePositions[i] + window.Graph.Begin - 1;
+                if (bbPos >= window.Consensus.Begin && bbPos < window.Consensus.End) {
+                    windowPath.push_back(path[i]);
+                    windowPath.back().BestInEdge = EdgeIndex{};
+                    windowPath.back().BestOutEdge = EdgeIndex{};
+                }
+            }
+        }
+    });
+
+    // stitch
+    for (auto& windowPath : windowPaths) {
+        path_.insert(path_.end(), windowPath.cbegin(), windowPath.cend());
+        windowPath = std::vector<AlignmentNode>{};
+    }
+}
+
+const std::vector<AlignmentNode>& WindowedAlignmentGraph::BestPath() const { return path_; }
+
+std::string WindowedAlignmentGraph::Consensus(int minWeight) const
+{
+    return internal::LongestConsensus(path_, minWeight);
+}
+
+void WindowedAlignmentGraph::Consensus(std::vector<ConsensusResult>& seqs, int minWeight,
+                                       std::size_t minLength) const
+{
+    internal::ConsensusSections(path_, seqs, minWeight, minLength);
+}
+
+void WindowedAlignmentGraph::ConsensusWithMinFlankCoverage(std::vector<ConsensusResult>& seqs,
+                                                           int minWeight, int minFlankCoverage,
+                                                           std::size_t minLen) const
+{
+    internal::ConsensusSectionsWithMinFlankCoverage(path_, seqs, minWeight, minFlankCoverage,
+                                                    minLen);
+}
+
+}  // namespace Dagcon
+}  // namespace PacBio
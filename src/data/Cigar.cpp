@@ -3,6 +3,8 @@
 #include <pbcopper/utility/SequenceUtils.h>
 #include <pbcopper/utility/Ssize.h>
 
+#include <algorithm>
+#include <charconv>
 #include <iterator>
 #include <ostream>
 #include <sstream>
@@ -17,19 +19,7 @@
 namespace PacBio {
 namespace Data {
 
-Cigar::Cigar(const char* str) : std::vector<CigarOperation>{}
-{
-    std::size_t numberStart = 0;
-    std::size_t i = 0;
-    for (const char* c = str; *c; ++i, ++c) {
-        if (!std::isdigit(*c)) {
-            const std::size_t distance = i - numberStart;
-            const std::uint32_t length = std::stoul(std::string{str, numberStart, distance});
-            push_back(CigarOperation(*c, length));
-            numberStart = i + 1;
-        }
-    }
-}
+Cigar::Cigar(const char* str) : std::vector<CigarOperation>{} { ParseCigar(str, *this); }
 
 Cigar::Cigar(const std::string& cigarString) : Cigar{cigarString.c_str()} {}
 
@@ -39,18 +29,84 @@ Cigar Cigar::FromStdString(const std::string& stdString) { return Cigar(stdStrin
 
 Cigar Cigar::FromCStr(const char* str) { return Cigar(str); }
 
-std::string Cigar::ToStdString() const
+std::string Cigar::ToStdString() const { return CigarView{*this}.ToStdString(); }
+
+std::string CigarView::ToStdString() const
+{
+    std::string result;
+    AppendCigarString(*this, result);
+    return result;
+}
+
+Cigar CigarView::ToCigar() const { return Cigar(cbegin(), cend()); }
+
+bool operator==(const CigarView lhs, const CigarView rhs) noexcept
+{
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+bool operator!=(const CigarView lhs, const CigarView rhs) noexcept { return !(lhs == rhs); }
+
+void ParseCigar(const std::string_view str, Cigar& cigar)
 {
-    std::ostringstream s;
-    const auto endIt = this->cend();
-    for (auto iter = this->cbegin(); iter != endIt; ++iter) {
-        const CigarOperation& cigar = (*iter);
-        s << cigar.Length() << cigar.Char();
+    // one operation per non-digit
+    std::size_t numOps = 0;
+    for (const char c : str) {
+        numOps += static_cast<unsigned char>(c - '0') > 9;
     }
-    return s.str();
+    cigar.clear();
+    cigar.reserve(numOps);
+
+    constexpr std::uint32_t MAX_LENGTH = (1U << 28) - 1;
+    std::uint32_t length = 0;
+    bool hasLength = false;
+    for (const char c : str) {
+        const auto digit = static_cast<unsigned char>(c - '0');
+        if (digit <= 9) {
+            length = (length * 10) + digit;
+            if (length > MAX_LENGTH) {
+                throw std::out_of_range{"[pbcopper] CIGAR ERROR: operation length too large in '" +
+                                        std::string{str} + "'"};
+            }
+            hasLength = true;
+        } else {
+            if (!hasLength) {
+                throw std::invalid_argument{"[pbcopper] CIGAR ERROR: operation '" +
+                                            std::string(1, c) + "' has no length in '" +
+                                            std::string{str} + "'"};
+            }
+            cigar.push_back(CigarOperation(c, length));
+            length = 0;
+            hasLength = false;
+        }
+    }
+}
+
+void AppendCigarString(const CigarView cigar, std::string& out)
+{
+    // max 9 digits (28 bits) + op
+    char buffer[16];
+    for (const auto& op : cigar) {
+        char* end = std::to_chars(buffer, buffer + sizeof(buffer), op.Length()).ptr;
+        *end++ = op.Char();
+        out.append(buffer, end);
+    }
+}
+
+Cigar CigarFromPacked(const std::uint32_t* packed, const std::size_t numOps)
+{
+    Cigar result(numOps);
+    std::transform(packed, packed + numOps, result.begin(), CigarOperation::FromPacked);
+    return result;
+}
+
+void CigarToPacked(const CigarView cigar, std::uint32_t* packed)
+{
+    std::transform(cigar.cbegin(), cigar.cend(), packed,
+                   [](const CigarOperation op) { return op.Packed(); });
 }
 
-std::size_t ReferenceLength(const Cigar& cigar)
+std::size_t ReferenceLength(const CigarView cigar)
 {
     std::size_t length = 0;
     for (const auto& op : cigar) {
@@ -67,7 +123,7 @@ std::ostream& operator<<(std::ostream& os, const Cigar& cigar)
 }
 
 /// http://bitbucket.pacificbiosciences.com:7990/projects/SAT/repos/pbmm2/browse/src/MM2Helper.cpp#980
-CigarBaseCounts CigarOpsCalculator(const Cigar& cigar)
+CigarBaseCounts CigarOpsCalculator(const CigarView cigar)
 {
 
     CigarBaseCounts results = {};
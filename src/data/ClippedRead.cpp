@@ -0,0 +1,181 @@
+#include <pbcopper/data/ClippedRead.h>
+
+#include <pbcopper/data/internal/ClippingImpl.h>
+
+#include <cassert>
+
+namespace PacBio {
+namespace Data {
+namespace {
+
+template <typename T>
+std::span<const T> ClipData(const std::vector<T>& data, const ClipSpan& span)
+{
+    // missing data (e.g. qualities) stays empty
+    if (data.empty()) {
+        return {};
+    }
+    assert(data.size() >= span.Offset + span.Length);
+    return {data.data() + span.Offset, span.Length};
+}
+
+std::optional<std::span<const std::uint16_t>> ClipFrames(const std::optional<Frames>& frames,
+                                                         const ClipSpan& span)
+{
+    if (frames) {
+        return ClipData(frames->Data(), span);
+    }
+    return std::nullopt;
+}
+
+std::optional<Frames> ToFrames(const std::optional<std::span<const std::uint16_t>>& frames)
+{
+    if (frames) {
+        return Frames(frames->begin(), frames->end());
+    }
+    return std::nullopt;
+}
+
+}  // namespace
+
+// -----------------
+// ClippedReadView
+// -----------------
+
+ClippedReadView::ClippedReadView(const Read& read, const ClipSpan& span) noexcept
+    : read_{&read}, span_{span}
+{}
+
+const Read& ClippedReadView::Source() const noexcept { return *read_; }
+
+const ClipSpan& ClippedReadView::Span() const noexcept { return span_; }
+
+std::string_view ClippedReadView::Seq() const
+{
+    return std::string_view{read_->Seq}.substr(span_.Offset, span_.Length);
+}
+
+std::span<const QualityValue> ClippedReadView::Qualities() const
+{
+    return ClipData<QualityValue>(read_->Qualities, span_);
+}
+
+std::optional<std::span<const std::uint16_t>> ClippedReadView::PulseWidth() const
+{
+    return ClipFrames(read_->PulseWidth, span_);
+}
+
+std::optional<std::span<const std::uint16_t>> ClippedReadView::IPD() const
+{
+    return ClipFrames(read_->IPD, span_);
+}
+
+Position ClippedReadView::QueryStart() const noexcept { return span_.QueryStart; }
+
+Position ClippedReadView::QueryEnd() const noexcept { return span_.QueryEnd; }
+
+std::int32_t ClippedReadView::Length() const noexcept { return span_.Length; }
+
+Read ClippedReadView::ToRead() const
+{
+    // NOTE: this constructor derives query start/end & full-length from its
+    //       inputs, so they are restored below
+    Read read{read_->Id,    std::string{Seq()},  ToFrames(PulseWidth()), ToFrames(IPD()),
+              read_->Flags, read_->ReadAccuracy, read_->SignalToNoise,   read_->Model};
+    const auto qualities = Qualities();
+    read.Qualities.assign(qualities.begin(), qualities.end());
+    read.QueryStart = QueryStart();
+    read.QueryEnd = QueryEnd();
+    read.FullLength = read_->FullLength;
+    return read;
+}
+
+// -----------------------
+// ClippedMappedReadView
+// -----------------------
+
+ClippedMappedReadView::ClippedMappedReadView(const MappedRead& read, const ClipSpan& span) noexcept
+    : ClippedReadView{read, span}
+{}
+
+const MappedRead& ClippedMappedReadView::Source() const noexcept
+{
+    return static_cast<const MappedRead&>(*read_);
+}
+
+Position ClippedMappedReadView::TemplateStart() const noexcept { return span_.TemplateStart; }
+
+Position ClippedMappedReadView::TemplateEnd() const noexcept { return span_.TemplateEnd; }
+
+std::size_t ClippedMappedReadView::NumCigarOperations() const noexcept
+{
+    return span_.CigarEnd - span_.CigarBegin;
+}
+
+CigarOperation ClippedMappedReadView::CigarOperationAt(const std::size_t i) const
+{
+    assert(i < NumCigarOperations());
+    CigarOperation op = Source().Cigar[span_.CigarBegin + i];
+    if (i == 0) {
+        op.Length(op.Length() - span_.FrontTrim);
+    }
+    if (i + 1 == NumCigarOperations()) {
+        op.Length(op.Length() - span_.BackTrim);
+    }
+    return op;
+}
+
+Data::Cigar ClippedMappedReadView::Cigar() const
+{
+    Data::Cigar cigar;
+    cigar.reserve(NumCigarOperations());
+    for (std::size_t i = 0; i < NumCigarOperations(); ++i) {
+        cigar.push_back(CigarOperationAt(i));
+    }
+    return cigar;
+}
+
+MappedRead ClippedMappedReadView::ToMappedRead() const
+{
+    const MappedRead& source = Source();
+    MappedRead read{ToRead(),        source.Strand,
+                    TemplateStart(), TemplateEnd(),
+                    Cigar(),         span_.Disjoint ? std::uint8_t{255} : source.MapQuality};
+    read.RefId = source.RefId;
+    read.PinStart = source.PinStart;
+    read.PinEnd = source.PinEnd;
+    return read;
+}
+
+ClippedReadView ClipViewToQuery(const Read& read, const Position start, const Position end)
+{
+    return {read, internal::QueryClipSpan(read, start, end)};
+}
+
+ClippedMappedReadView ClipViewToQuery(const MappedRead& read, const Position start,
+                                      const Position end)
+{
+    return {read, internal::QueryClipSpan(read, start, end)};
+}
+
+ClippedMappedReadView ClipViewToReference(const MappedRead& read, const Position start,
+                                          const Position end, const bool exciseFlankingInserts)
+{
+    return {read, internal::ReferenceClipSpan(read, start, end, exciseFlankingInserts)};
+}
+
+std::vector<ClippedMappedReadView> ClipViewsToReference(const MappedRead& read,
+                                                        const std::span<const Interval> windows,
+                                                        const bool exciseFlankingInserts)
+{
+    internal::ReferenceClipper clipper{read.Cigar, read.Strand, exciseFlankingInserts};
+    std::vector<ClippedMappedReadView> result;
+    result.reserve(windows.size());
+    for (const auto& window : windows) {
+        result.emplace_back(read, clipper.Clip(read, window.Start(), window.End()));
+    }
+    return result;
+}
+
+}  // namespace Data
+}  // namespace PacBio
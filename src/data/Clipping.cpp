@@ -1,10 +1,12 @@
 #include <pbcopper/data/Clipping.h>
 
+#include <pbcopper/data/CigarView.h>
 #include <pbcopper/data/MappedRead.h>
 #include <pbcopper/data/Read.h>
 #include <pbcopper/data/internal/ClippingImpl.h>
 
 #include <algorithm>
+#include <utility>
 
 #include <cassert>
 
@@ -12,31 +14,101 @@ namespace PacBio {
 namespace Data {
 namespace {
 
+// Trims 'data' to [pos, pos + len) in place. Empty data (e.g. missing
+// qualities) stays empty.
 template <typename T>
-T clipContainer(const T& input, const std::size_t pos, const std::size_t len)
+void ClipContainer(T& data, const std::size_t pos, const std::size_t len)
 {
-    if (input.empty()) {
-        return {};
+    if (data.empty()) {
+        return;
     }
-    assert(input.size() >= pos + len);
-    return T{input.cbegin() + pos, input.cbegin() + pos + len};
+    assert(data.size() >= pos + len);
+    data.erase(data.begin() + pos + len, data.end());
+    data.erase(data.begin(), data.begin() + pos);
 }
 
-// returns reference positions removed from beginning
-std::size_t ClipToQueryImpl(Cigar& cigar, std::size_t startOffset, std::size_t endOffset)
+///
+/// CIGAR operations [first, last) of a CIGAR being clipped, the first shortened
+/// by 'frontTrim' and the last by 'backTrim'. Clipping only moves these bounds,
+/// leaving the CIGAR itself untouched. 'front' selects which end to clip.
+///
+class CigarSlice
 {
-    std::size_t refPosRemoved = 0;
-    std::size_t remaining = startOffset;
+public:
+    explicit CigarSlice(const Cigar& cigar) : cigar_{cigar}, last_{cigar.size()} {}
 
-    // clip CIGAR ops from beginning of query sequence
-    while ((remaining > 0) && !cigar.empty()) {
-        CigarOperation& op = cigar.front();
-        const auto opLength = op.Length();
-        const bool consumesQuery = ConsumesQuery(op.Type());
-        const bool consumesRef = ConsumesReference(op.Type());
+    bool Empty() const { return first_ == last_; }
+
+    CigarOperationType Type(const bool front) const { return cigar_[Index(front)].Type(); }
+
+    std::size_t Length(const bool front) const { return LengthAt(Index(front)); }
+
+    void Drop(const bool front)
+    {
+        if (front) {
+            ++first_;
+            frontTrim_ = 0;
+        } else {
+            --last_;
+            backTrim_ = 0;
+        }
+    }
+
+    void Trim(const bool front, const std::size_t n) { (front ? frontTrim_ : backTrim_) += n; }
+
+    std::size_t ReferenceLength() const
+    {
+        std::size_t result = 0;
+        for (std::size_t i = first_; i < last_; ++i) {
+            if (ConsumesReference(cigar_[i].Type())) {
+                result += LengthAt(i);
+            }
+        }
+        return result;
+    }
+
+    void Store(ClipSpan& span) const
+    {
+        span.CigarBegin = first_;
+        span.CigarEnd = last_;
+        span.FrontTrim = static_cast<std::uint32_t>(frontTrim_);
+        span.BackTrim = static_cast<std::uint32_t>(backTrim_);
+    }
+
+private:
+    std::size_t Index(const bool front) const { return front ? first_ : last_ - 1; }
+
+    std::size_t LengthAt(const std::size_t i) const
+    {
+        std::size_t length = cigar_[i].Length();
+        if (i == first_) {
+            length -= frontTrim_;
+        }
+        if (i + 1 == last_) {
+            length -= backTrim_;
+        }
+        return length;
+    }
+
+    CigarView cigar_;
+    std::size_t first_ = 0;
+    std::size_t last_;
+    std::size_t frontTrim_ = 0;
+    std::size_t backTrim_ = 0;
+};
+
+// Clips 'remaining' query positions from one end. Returns reference positions
+// removed.
+std::size_t ClipQueryEnd(CigarSlice& cigar, const bool front, std::size_t remaining)
+{
+    std::size_t refPosRemoved = 0;
+    while ((remaining > 0) && !cigar.Empty()) {
+        const auto opLength = cigar.Length(front);
+        const bool consumesQuery = ConsumesQuery(cigar.Type(front));
+        const bool consumesRef = ConsumesReference(cigar.Type(front));
 
         if (opLength <= remaining) {
-            cigar.erase(cigar.begin());
+            cigar.Drop(front);
             if (consumesQuery) {
                 remaining -= opLength;
             }
@@ -44,173 +116,281 @@ std::size_t ClipToQueryImpl(Cigar& cigar, std::size_t startOffset, std::size_t e
                 refPosRemoved += opLength;
             }
         } else {
-            op.Length(opLength - remaining);
+            cigar.Trim(front, remaining);
             if (consumesRef) {
                 refPosRemoved += remaining;
             }
             remaining = 0;
         }
     }
+    return refPosRemoved;
+}
 
-    // clip CIGAR ops from end of query sequence
-    remaining = endOffset;
-    while ((remaining > 0) && !cigar.empty()) {
-        CigarOperation& op = cigar.back();
-        const auto opLength = op.Length();
-        const bool consumesQuery = ConsumesQuery(op.Type());
+// returns reference positions removed from beginning
+std::size_t ClipQueryImpl(CigarSlice& cigar, const Strand strand, const std::size_t startOffset,
+                          const std::size_t endOffset)
+{
+    // start of the query is at the end of a reverse strand CIGAR
+    const bool queryFront = (strand != Strand::REVERSE);
+    const std::size_t refPosRemoved = ClipQueryEnd(cigar, queryFront, startOffset);
+    ClipQueryEnd(cigar, !queryFront, endOffset);
+    return refPosRemoved;
+}
 
-        if (opLength <= remaining) {
-            cigar.pop_back();
-            if (consumesQuery) {
-                remaining -= opLength;
-            }
-        } else {
-            op.Length(opLength - remaining);
-            remaining = 0;
+std::size_t QueryLength(const Cigar& cigar)
+{
+    std::size_t result = 0;
+    for (const auto& op : cigar) {
+        if (ConsumesQuery(op.Type())) {
+            result += op.Length();
         }
     }
-
-    return refPosRemoved;
+    return result;
 }
 
-void ClipToReferenceImpl(ClipToReferenceConfig& config, std::size_t* queryPosRemovedFront,
-                         std::size_t* queryPosRemovedBack)
-{
+}  // namespace
 
-    const Position newTStart = std::max(config.original_tStart_, config.target_tStart_);
-    const Position newTEnd = std::min(config.original_tEnd_, config.target_tEnd_);
+namespace internal {
 
-    // fetch a 'working copy' of CIGAR data
-    Cigar& cigar = config.cigar_;
+CigarCursor::CigarCursor(const Cigar& cigar) noexcept : cigar_{&cigar} {}
 
-    // ------------------------
-    // clip leading CIGAR ops
-    // ------------------------
+void CigarCursor::SeekFirst(const std::size_t refPos)
+{
+    if (refPos < RefPos) {
+        *this = CigarCursor{*cigar_};
+    }
 
-    std::size_t remaining = newTStart - config.original_tStart_;
-    while (remaining > 0 && !cigar.empty()) {
-        CigarOperation& firstOp = cigar.front();
-        const auto firstOpLength = firstOp.Length();
-        const bool consumesQuery = ConsumesQuery(firstOp.Type());
-        const bool consumesRef = ConsumesReference(firstOp.Type());
+    const Cigar& cigar = *cigar_;
+    while (RefPos < refPos && Index < cigar.size()) {
+        const auto& op = cigar[Index];
+        const std::size_t opRemaining = op.Length() - Offset;
+        const bool consumesQuery = ConsumesQuery(op.Type());
 
-        if (!consumesRef) {
+        if (!ConsumesReference(op.Type())) {
+            QueryPos += (consumesQuery ? opRemaining : 0);
+            ++Index;
+            Offset = 0;
+            continue;
+        }
 
-            // e.g. softclip - just pop it completely
-            cigar.erase(cigar.begin());
-            if (consumesQuery) {
-                *queryPosRemovedFront += firstOpLength;
-            }
+        const std::size_t step = std::min(opRemaining, refPos - RefPos);
+        RefPos += step;
+        QueryPos += (consumesQuery ? step : 0);
+        Offset += step;
+        if (Offset == op.Length()) {
+            ++Index;
+            Offset = 0;
+        }
+    }
+}
 
-        } else {
-            assert(consumesRef);
-
-            // CIGAR ends at or before clip
-            if (firstOpLength <= remaining) {
-                cigar.erase(cigar.begin());
-                if (consumesQuery) {
-                    *queryPosRemovedFront += firstOpLength;
-                }
-                if (consumesRef) {
-                    remaining -= firstOpLength;
-                }
-            }
+void CigarCursor::SeekLast(const std::size_t refPos)
+{
+    SeekFirst(refPos);
 
-            // CIGAR straddles clip
-            else {
-                assert(firstOpLength > remaining);
-                firstOp.Length(firstOpLength - remaining);
-                if (consumesQuery) {
-                    *queryPosRemovedFront += remaining;
-                }
-                remaining = 0;
-            }
+    const Cigar& cigar = *cigar_;
+    while (Offset == 0 && Index < cigar.size() && !ConsumesReference(cigar[Index].Type())) {
+        if (ConsumesQuery(cigar[Index].Type())) {
+            QueryPos += cigar[Index].Length();
+        }
+        ++Index;
+    }
+}
+
+ReferenceClipper::ReferenceClipper(const Cigar& cigar, const Strand strand,
+                                   const bool exciseFlankingInserts)
+    : cigar_{cigar}
+    , strand_{strand}
+    , exciseFlankingInserts_{exciseFlankingInserts}
+    , queryLength_{QueryLength(cigar)}
+    , referenceLength_{ReferenceLength(cigar)}
+    , front_{cigar}
+    , back_{cigar}
+{}
+
+std::pair<std::size_t, std::size_t> ReferenceClipper::Clip(const std::size_t startOffset,
+                                                           const std::size_t endOffset,
+                                                           ClipSpan& span)
+{
+    // Clipping ops up to the start leaves any that don't consume the reference
+    // (e.g. insertions) after it, while clipping ops from the end leaves those
+    // before it. So the clip spans from the first CIGAR point at the start to
+    // the last one at the end.
+    front_.SeekFirst(startOffset);
+    back_.SeekLast(endOffset);
+
+    std::size_t begin = front_.Index;
+    std::size_t frontTrim = front_.Offset;
+    std::size_t end = back_.Index + (back_.Offset > 0 ? 1 : 0);
+    std::size_t backTrim = (back_.Offset > 0 ? cigar_[back_.Index].Length() - back_.Offset : 0);
+    std::size_t removedFront = front_.QueryPos;
+    std::size_t removedBack = queryLength_ - back_.QueryPos;
+
+    if (exciseFlankingInserts_) {
+        if (begin < end && cigar_[begin].Type() == CigarOperationType::INSERTION) {
+            removedFront += cigar_[begin].Length();
+            ++begin;
+            frontTrim = 0;
+        }
+        if (begin < end && cigar_[end - 1].Type() == CigarOperationType::INSERTION) {
+            removedBack += cigar_[end - 1].Length();
+            --end;
+            backTrim = 0;
         }
     }
 
-    // -------------------------
-    // clip trailing CIGAR ops
-    // -------------------------
+    span.CigarBegin = begin;
+    span.CigarEnd = end;
+    span.FrontTrim = static_cast<std::uint32_t>(frontTrim);
+    span.BackTrim = static_cast<std::uint32_t>(backTrim);
 
-    remaining = config.original_tEnd_ - newTEnd;
-    while (remaining > 0 && !cigar.empty()) {
-        CigarOperation& lastOp = cigar.back();
-        const auto lastOpLength = lastOp.Length();
-        const bool consumesQuery = ConsumesQuery(lastOp.Type());
-        const bool consumesRef = ConsumesReference(lastOp.Type());
+    if (strand_ == Strand::FORWARD) {
+        return {removedFront, removedBack};
+    }
+    return {removedBack, removedFront};
+}
 
-        if (!consumesRef) {
+ClipSpan ReferenceClipper::Clip(const MappedRead& read, const Position start, const Position end)
+{
+    assert(&read.Cigar == &cigar_);
+    ClipSpan span;
 
-            // e.g. softclip - just pop it completely
-            cigar.pop_back();
-            if (consumesQuery) {
-                *queryPosRemovedBack += lastOpLength;
-            }
+    // return emptied read if clip region is disjoint from alignment
+    if (end <= read.TemplateStart || start >= read.TemplateEnd) {
+        span.Disjoint = true;
+        return span;
+    }
 
-        } else {
-            assert(consumesRef);
-
-            // CIGAR ends at or after clip
-            if (lastOpLength <= remaining) {
-                cigar.pop_back();
-                if (consumesQuery) {
-                    *queryPosRemovedBack += lastOpLength;
-                }
-                if (consumesRef) {
-                    remaining -= lastOpLength;
-                }
-            }
+    span.Length = read.Seq.size();
+    span.QueryStart = read.QueryStart;
+    span.QueryEnd = read.QueryEnd;
+    span.TemplateStart = read.TemplateStart;
+    span.TemplateEnd = read.TemplateEnd;
+    span.CigarEnd = read.Cigar.size();
 
-            // CIGAR straddles clip
-            else {
-                assert(lastOpLength > remaining);
-                lastOp.Length(lastOpLength - remaining);
-                if (consumesQuery) {
-                    *queryPosRemovedBack += remaining;
-                }
-                remaining = 0;
-            }
-        }
+    // skip out if clip region covers aligned region (no clip needed)
+    if (start <= read.TemplateStart && end >= read.TemplateEnd) {
+        return span;
     }
 
-    if (config.exciseFlankingInserts_) {
-        // check for leading insertion
-        if (!cigar.empty()) {
-            const CigarOperation& op = cigar.front();
-            if (op.Type() == CigarOperationType::INSERTION) {
-                *queryPosRemovedFront += op.Length();
-                cigar.erase(cigar.begin());
-            }
-        }
+    const Position newTStart = std::max(read.TemplateStart, start);
+    const Position newTEnd = std::min(read.TemplateEnd, end);
+    const std::size_t startOffset = newTStart - read.TemplateStart;
+    const std::size_t endOffset = EndOffset(startOffset, read.TemplateEnd - newTEnd);
+    const auto [removedFront, removedBack] = Clip(startOffset, endOffset, span);
+
+    span.QueryStart = read.QueryStart + removedFront;
+    span.QueryEnd = read.QueryEnd - removedBack;
+    span.Offset = removedFront;
+    span.Length = span.QueryEnd - span.QueryStart;
+    span.TemplateStart = newTStart;
+    span.TemplateEnd = newTStart + (endOffset - startOffset);
+    return span;
+}
 
-        // check for trailing insertion
-        if (!cigar.empty()) {
-            const CigarOperation& op = cigar.back();
-            if (op.Type() == CigarOperationType::INSERTION) {
-                *queryPosRemovedBack += op.Length();
-                cigar.pop_back();
-            }
-        }
+std::size_t ReferenceClipper::EndOffset(const std::size_t startOffset,
+                                        const std::size_t endClipped) const
+{
+    // NOTE: the end clip is measured back from the original template end,
+    //       which may disagree with the CIGAR's reference length
+    return std::max(startOffset, referenceLength_ - std::min(referenceLength_, endClipped));
+}
+
+ClipSpan QueryClipSpan(const Read& read, Position start, Position end)
+{
+    ClipSpan span;
+    span.Length = read.Seq.size();
+    span.QueryStart = read.QueryStart;
+    span.QueryEnd = read.QueryEnd;
+
+    // skip out if clip not needed
+    if (start <= read.QueryStart && end >= read.QueryEnd) {
+        return span;
     }
+
+    start = std::clamp(start, read.QueryStart, read.QueryEnd);
+    end = std::clamp(end, start, read.QueryEnd);
+    span.Offset = start - read.QueryStart;
+    span.Length = end - start;
+    span.QueryStart = start;
+    span.QueryEnd = end;
+    return span;
 }
 
-}  // namespace
+ClipSpan QueryClipSpan(const MappedRead& read, const Position start, const Position end)
+{
+    ClipSpan span = QueryClipSpan(static_cast<const Read&>(read), start, end);
+    span.TemplateStart = read.TemplateStart;
+    span.TemplateEnd = read.TemplateEnd;
+    span.CigarEnd = read.Cigar.size();
+    if (start <= read.QueryStart && end >= read.QueryEnd) {
+        return span;
+    }
 
-namespace internal {
+    CigarSlice cigar{read.Cigar};
+    const std::size_t refPosRemoved =
+        ClipQueryImpl(cigar, read.Strand, span.Offset, read.QueryEnd - span.QueryEnd);
+    cigar.Store(span);
+    span.TemplateStart = read.TemplateStart + refPosRemoved;
+    span.TemplateEnd = span.TemplateStart + cigar.ReferenceLength();
+    return span;
+}
+
+ClipSpan ReferenceClipSpan(const MappedRead& read, const Position start, const Position end,
+                           const bool exciseFlankingInserts)
+{
+    ReferenceClipper clipper{read.Cigar, read.Strand, exciseFlankingInserts};
+    return clipper.Clip(read, start, end);
+}
+
+void ClipCigar(Cigar& cigar, const ClipSpan& span)
+{
+    cigar.erase(cigar.begin() + span.CigarEnd, cigar.end());
+    cigar.erase(cigar.begin(), cigar.begin() + span.CigarBegin);
+    if (!cigar.empty()) {
+        cigar.front().Length(cigar.front().Length() - span.FrontTrim);
+        cigar.back().Length(cigar.back().Length() - span.BackTrim);
+    }
+}
+
+void ClipRead(Read& read, const ClipSpan& span)
+{
+    ClipContainer(read.Seq, span.Offset, span.Length);
+    ClipContainer(read.Qualities, span.Offset, span.Length);
+    if (read.PulseWidth) {
+        ClipContainer(read.PulseWidth->Data(), span.Offset, span.Length);
+    }
+    if (read.IPD) {
+        ClipContainer(read.IPD->Data(), span.Offset, span.Length);
+    }
+    read.QueryStart = span.QueryStart;
+    read.QueryEnd = span.QueryEnd;
+}
+
+void ClipMappedRead(MappedRead& read, const ClipSpan& span)
+{
+    ClipRead(read, span);
+    ClipCigar(read.Cigar, span);
+    read.TemplateStart = span.TemplateStart;
+    read.TemplateEnd = span.TemplateEnd;
+    if (span.Disjoint) {
+        read.MapQuality = 255;
+    }
+}
 
 void ClipRead(Read& read, const ClipResult& result, std::size_t start, std::size_t end)
 {
     const auto clipFrom = result.clipOffset_;
     const auto clipLength = (end - start);
-    read.Seq = clipContainer(read.Seq, clipFrom, clipLength);
-    read.Qualities = clipContainer(read.Qualities, clipFrom, clipLength);
+    ClipContainer(read.Seq, clipFrom, clipLength);
+    ClipContainer(read.Qualities, clipFrom, clipLength);
     read.QueryStart = result.qStart_;
     read.QueryEnd = result.qEnd_;
     if (read.PulseWidth) {
-        read.PulseWidth = clipContainer(read.PulseWidth->Data(), clipFrom, clipLength);
+        ClipContainer(read.PulseWidth->Data(), clipFrom, clipLength);
     }
     if (read.IPD) {
-        read.IPD = clipContainer(read.IPD->Data(), clipFrom, clipLength);
+        ClipContainer(read.IPD->Data(), clipFrom, clipLength);
     }
 }
 
@@ -259,20 +439,15 @@ ClipResult ClipToQuery(ClipToQueryConfig& config)
         return ClipResult{startOffset, config.target_qStart_, config.target_qEnd_};
     }
 
-    // fetch CIGAR (in query orientation)
-    Cigar cigar = std::move(config.cigar_);
-    if (config.strand_ == Strand::REVERSE) {
-        std::reverse(cigar.begin(), cigar.end());
-    }
-
     // do main clipping
     const std::size_t endOffset = config.original_qEnd_ - config.target_qEnd_;
-    const std::size_t refPosRemoved = ClipToQueryImpl(cigar, startOffset, endOffset);
+    CigarSlice slice{config.cigar_};
+    const std::size_t refPosRemoved = ClipQueryImpl(slice, config.strand_, startOffset, endOffset);
 
-    // maybe restore CIGAR
-    if (config.strand_ == Strand::REVERSE) {
-        std::reverse(cigar.begin(), cigar.end());
-    }
+    ClipSpan span;
+    slice.Store(span);
+    Cigar cigar = std::move(config.cigar_);
+    internal::ClipCigar(cigar, span);
 
     // return result
     const Position newPosition = (config.original_tStart_ + refPosRemoved);
@@ -284,19 +459,23 @@ ClipResult ClipToReference(ClipToReferenceConfig& config)
 {
     assert(config.isMapped_);
 
-    std::size_t queryPosRemovedFront = 0;
-    std::size_t queryPosRemovedBack = 0;
-    if (config.strand_ == Strand::FORWARD) {
-        ClipToReferenceImpl(config, &queryPosRemovedFront, &queryPosRemovedBack);
-    } else {
-        ClipToReferenceImpl(config, &queryPosRemovedBack, &queryPosRemovedFront);
-    }
+    const Position newTStart = std::max(config.original_tStart_, config.target_tStart_);
+    const Position newTEnd = std::min(config.original_tEnd_, config.target_tEnd_);
+    internal::ReferenceClipper clipper{config.cigar_, config.strand_,
+                                       config.exciseFlankingInserts_};
+    const std::size_t startOffset = newTStart - config.original_tStart_;
+    const std::size_t endOffset = clipper.EndOffset(startOffset, config.original_tEnd_ - newTEnd);
+
+    ClipSpan span;
+    const auto [queryPosRemovedFront, queryPosRemovedBack] =
+        clipper.Clip(startOffset, endOffset, span);
+    Cigar cigar = std::move(config.cigar_);
+    internal::ClipCigar(cigar, span);
 
     const std::size_t clipOffset = queryPosRemovedFront;
     const Position qStart = config.original_qStart_ + queryPosRemovedFront;
     const Position qEnd = config.original_qEnd_ - queryPosRemovedBack;
-    const Position newPos = std::max(config.original_tStart_, config.target_tStart_);
-    return ClipResult{clipOffset, qStart, qEnd, newPos, config.cigar_};
+    return ClipResult{clipOffset, qStart, qEnd, newTStart, std::move(cigar)};
 }
 
 }  // namespace Data
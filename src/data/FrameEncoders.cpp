@@ -4,13 +4,17 @@
 #include <boost/range/adaptor/transformed.hpp>
 
 #include <algorithm>
+#include <bit>
 #include <limits>
+#include <stdexcept>
 
 #include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 
+#include "../../third-party/simde/x86/sse4.1.h"
+
 namespace PacBio {
 namespace Data {
 namespace {
@@ -78,6 +82,91 @@ static int InitIpdDownsampling()
 
 static const int initV1Frames = InitIpdDownsampling();
 
+void CheckFrameSizes(const std::size_t inputSize, const std::size_t outputSize)
+{
+    if (inputSize != outputSize) {
+        throw std::invalid_argument{"[pbcopper] frame encoding ERROR: output size (" +
+                                    std::to_string(outputSize) + ") does not match input size (" +
+                                    std::to_string(inputSize) + ')'};
+    }
+}
+
+// base * (2^exponent - 1) + 2^exponent * mantissa, saturated to 16 bits
+std::uint16_t V2DecodedValue(const int code, const int mantissaBits)
+{
+    const std::uint32_t base = 1U << mantissaBits;
+    const std::uint32_t mantissa = code & (base - 1);
+    const int exponent = code >> mantissaBits;
+    if (exponent >= 16) {
+        return std::numeric_limits<std::uint16_t>::max();
+    }
+    const std::uint32_t value = ((base + mantissa) << exponent) - base;
+    return std::min<std::uint32_t>(value, std::numeric_limits<std::uint16_t>::max());
+}
+
+//
+// Encodes 8 frames at a time. Frames are first clamped to the largest
+// decodable value, then each lane's exponent is the number of exponent
+// thresholds, base * (2^e - 1), it reaches. The mantissa is the remainder
+// shifted right by that exponent, done with a high multiply by 2^(16 - e) as
+// SSE has no per-lane shifts.
+//
+// Returns the number of frames encoded; the caller handles the tail.
+//
+std::size_t EncodeV2Simd(const std::uint16_t* rawFrames, const std::size_t n,
+                         std::uint8_t* encodedFrames, const int mantissaBits,
+                         const std::uint16_t maxFrame)
+{
+    constexpr std::size_t LANES = 8;
+    constexpr int MAX_THRESHOLDS = 15;
+
+    const std::uint32_t base = 1U << mantissaBits;
+    simde__m128i thresholds[MAX_THRESHOLDS];
+    simde__m128i multipliers[MAX_THRESHOLDS];
+    int numThresholds = 0;
+    for (int e = 1; e <= MAX_THRESHOLDS; ++e) {
+        const std::uint32_t threshold = base * ((1U << e) - 1);
+        if (threshold > maxFrame) {
+            break;
+        }
+        thresholds[numThresholds] = simde_mm_set1_epi16(static_cast<std::int16_t>(threshold));
+        multipliers[numThresholds] = simde_mm_set1_epi16(static_cast<std::int16_t>(1U << (16 - e)));
+        ++numThresholds;
+    }
+
+    const simde__m128i vMaxFrame = simde_mm_set1_epi16(static_cast<std::int16_t>(maxFrame));
+    const simde__m128i vZero = simde_mm_setzero_si128();
+    const simde__m128i vMantissaBits = simde_mm_cvtsi32_si128(mantissaBits);
+
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        const simde__m128i x = simde_mm_min_epu16(
+            simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(rawFrames + i)), vMaxFrame);
+
+        simde__m128i exponent = vZero;
+        simde__m128i threshold = vZero;
+        simde__m128i multiplier = vZero;
+        for (int k = 0; k < numThresholds; ++k) {
+            // thresholds increase, so the last one reached wins
+            const simde__m128i reached =
+                simde_mm_cmpeq_epi16(simde_mm_max_epu16(x, thresholds[k]), x);
+            exponent = simde_mm_sub_epi16(exponent, reached);
+            threshold = simde_mm_blendv_epi8(threshold, thresholds[k], reached);
+            multiplier = simde_mm_blendv_epi8(multiplier, multipliers[k], reached);
+        }
+
+        const simde__m128i remainder = simde_mm_sub_epi16(x, threshold);
+        const simde__m128i mantissa =
+            simde_mm_blendv_epi8(simde_mm_mulhi_epu16(remainder, multiplier), remainder,
+                                 simde_mm_cmpeq_epi16(exponent, vZero));
+        const simde__m128i code =
+            simde_mm_or_si128(simde_mm_sll_epi16(exponent, vMantissaBits), mantissa);
+        simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(encodedFrames + i),
+                              simde_mm_packus_epi16(code, code));
+    }
+    return i;
+}
+
 }  // namespace
 
 // ----------------
@@ -86,23 +175,38 @@ static const int initV1Frames = InitIpdDownsampling();
 
 Frames V1FrameEncoder::Decode(const std::vector<std::uint8_t>& encodedFrames) const
 {
-    std::vector<std::uint16_t> rawFrames;
-    rawFrames.reserve(encodedFrames.size());
-    std::transform(encodedFrames.cbegin(), encodedFrames.cend(), std::back_inserter(rawFrames),
-                   [&](std::uint8_t code) { return framepoints[code]; });
+    Frames rawFrames(encodedFrames.size());
+    DecodeInto(encodedFrames, rawFrames.Data());
     return rawFrames;
 }
 
 std::vector<std::uint8_t> V1FrameEncoder::Encode(const std::vector<std::uint16_t>& rawFrames) const
 {
-    std::vector<std::uint8_t> encoded;
-    encoded.reserve(rawFrames.size());
-    std::transform(
-        rawFrames.cbegin(), rawFrames.cend(), std::back_inserter(encoded),
-        [&](std::uint16_t frame) { return frameToCode[std::min(maxFramepoint, frame)]; });
+    std::vector<std::uint8_t> encoded(rawFrames.size());
+    EncodeInto(rawFrames, encoded);
     return encoded;
 }
 
+void V1FrameEncoder::DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                                std::span<std::uint16_t> rawFrames) const
+{
+    CheckFrameSizes(encodedFrames.size(), rawFrames.size());
+    const std::uint16_t* table = framepoints.data();
+    std::transform(encodedFrames.begin(), encodedFrames.end(), rawFrames.begin(),
+                   [table](std::uint8_t code) { return table[code]; });
+}
+
+void V1FrameEncoder::EncodeInto(std::span<const std::uint16_t> rawFrames,
+                                std::span<std::uint8_t> encodedFrames) const
+{
+    CheckFrameSizes(rawFrames.size(), encodedFrames.size());
+    const std::uint8_t* table = frameToCode.data();
+    const std::uint16_t maxFrame = maxFramepoint;
+    std::transform(
+        rawFrames.begin(), rawFrames.end(), encodedFrames.begin(),
+        [table, maxFrame](std::uint16_t frame) { return table[std::min(maxFrame, frame)]; });
+}
+
 std::string V1FrameEncoder::Name() const { return "CodecV1"; }
 
 // ----------------
@@ -110,48 +214,89 @@ std::string V1FrameEncoder::Name() const { return "CodecV1"; }
 // ----------------
 
 V2FrameEncoder::V2FrameEncoder(int exponentBits, int mantissaBits)
-    : exponentBits_{exponentBits}
-    , mantissaBits_{mantissaBits}
-    , base_(std::pow(2, mantissaBits_))
-    , max_((1 << (exponentBits_ + mantissaBits_)) - 1)
-{}
+    : exponentBits_{exponentBits}, mantissaBits_{mantissaBits}, base_{1}, max_{0}, decodeTable_{}
+{
+    if (exponentBits_ < 1 || mantissaBits_ < 0 || exponentBits_ + mantissaBits_ > 8) {
+        throw std::invalid_argument{"[pbcopper] frame encoding ERROR: unsupported V2 codec (" +
+                                    std::to_string(exponentBits_) + " exponent bits, " +
+                                    std::to_string(mantissaBits_) + " mantissa bits)"};
+    }
+    base_ = 1 << mantissaBits_;
+    max_ = (1 << (exponentBits_ + mantissaBits_)) - 1;
+    for (int code = 0; code <= max_; ++code) {
+        decodeTable_[code] = V2DecodedValue(code, mantissaBits_);
+    }
+}
 
 Frames V2FrameEncoder::Decode(const std::vector<std::uint8_t>& encodedFrames) const
 {
-    std::vector<std::uint16_t> decoded;
-    decoded.reserve(encodedFrames.size());
-    std::transform(encodedFrames.cbegin(), encodedFrames.cend(), std::back_inserter(decoded),
-                   [&](std::uint8_t x) -> std::uint16_t {
-                       if (x > max_) {
-                           throw std::runtime_error{
-                               "[pbcopper] invalid frame encoding ERROR: " + std::to_string(x) +
-                               " is out of range [0," + std::to_string(max_) + ']'};
-                       }
-                       const std::uint8_t mantissa = x & static_cast<std::uint8_t>((base_ - 1));
-                       const std::uint8_t exponent = (x ^ mantissa) >> mantissaBits_;
-                       return (base_ * (std::pow(2, exponent) - 1)) +
-                              ((std::pow(2, exponent)) * mantissa);
-                   });
-    return Frames{decoded};
+    Frames decoded(encodedFrames.size());
+    DecodeInto(encodedFrames, decoded.Data());
+    return decoded;
+}
+
+void V2FrameEncoder::DecodeInto(std::span<const std::uint8_t> encodedFrames,
+                                std::span<std::uint16_t> rawFrames) const
+{
+    CheckFrameSizes(encodedFrames.size(), rawFrames.size());
+
+    // single pass: look codes up unconditionally, and report any out of range
+    // afterwards (entries past max_ are zero)
+    const std::uint16_t* table = decodeTable_.data();
+    const std::uint8_t maxCode = max_;
+    bool outOfRange = false;
+    for (std::size_t i = 0; i < encodedFrames.size(); ++i) {
+        const std::uint8_t code = encodedFrames[i];
+        rawFrames[i] = table[code];
+        outOfRange |= (code > maxCode);
+    }
+    if (outOfRange) {
+        const auto bad = *std::find_if(encodedFrames.begin(), encodedFrames.end(),
+                                       [maxCode](std::uint8_t code) { return code > maxCode; });
+        throw std::runtime_error{"[pbcopper] invalid frame encoding ERROR: " + std::to_string(bad) +
+                                 " is out of range [0," + std::to_string(max_) + ']'};
+    }
 }
 
 std::vector<std::uint8_t> V2FrameEncoder::Encode(const std::vector<std::uint16_t>& rawFrames) const
 {
     // NOTE: nothing compressed here yet in output bytes, regardless of bitsPerPulse
 
-    std::vector<std::uint8_t> encoded;
-    encoded.reserve(rawFrames.size());
-    std::transform(
-        rawFrames.cbegin(), rawFrames.cend(), std::back_inserter(encoded), [&](std::uint16_t x) {
-            const int exponent = std::log2(x / base_ + 1);
-            const int mantissa =
-                (x - base_ * (static_cast<std::uint8_t>(std::pow(2, exponent)) - 1)) >> exponent;
-            const std::uint8_t result = (exponent << mantissaBits_) | mantissa;
-            return std::min(result, max_);
-        });
+    std::vector<std::uint8_t> encoded(rawFrames.size());
+    EncodeInto(rawFrames, encoded);
     return encoded;
 }
 
+void V2FrameEncoder::EncodeInto(std::span<const std::uint16_t> rawFrames,
+                                std::span<std::uint8_t> encodedFrames) const
+{
+    CheckFrameSizes(rawFrames.size(), encodedFrames.size());
+
+    std::size_t i = 0;
+    if (mantissaBits_ > 0) {
+        // with no mantissa, exponents run past what fits in 16-bit lanes
+        i = EncodeV2Simd(rawFrames.data(), rawFrames.size(), encodedFrames.data(), mantissaBits_,
+                         decodeTable_[max_]);
+    }
+    for (; i < rawFrames.size(); ++i) {
+        encodedFrames[i] = EncodeFrame(rawFrames[i]);
+    }
+}
+
+std::uint8_t V2FrameEncoder::EncodeFrame(const std::uint16_t frame) const
+{
+    const int maxExponent = max_ >> mantissaBits_;
+    const int exponent = std::bit_width((static_cast<unsigned>(frame) >> mantissaBits_) + 1) - 1;
+    if (exponent > maxExponent) {
+        return max_;
+    }
+    // (frame - base * (2^exponent - 1)) >> exponent
+    const int mantissa = ((frame + base_) >> exponent) - base_;
+    return std::min<int>((exponent << mantissaBits_) | mantissa, max_);
+}
+
+int V2FrameEncoder::ExponentBits() const { return exponentBits_; }
+
 int V2FrameEncoder::MantissaBits() const { return mantissaBits_; }
 
 std::string V2FrameEncoder::Name() const
@@ -159,5 +304,14 @@ std::string V2FrameEncoder::Name() const
     return "CodecV2/" + std::to_string(exponentBits_) + '/' + std::to_string(mantissaBits_);
 }
 
+// ---------------------
+// Type-erased encoder
+// ---------------------
+
+void FrameEncoder::CheckSizes(const std::size_t inputSize, const std::size_t outputSize)
+{
+    CheckFrameSizes(inputSize, outputSize);
+}
+
 }  // namespace Data
 }  // namespace PacBio
@@ -31,6 +31,16 @@ std::vector<std::uint8_t> Frames::Encode(const std::vector<std::uint16_t>& frame
     return Encode(frames, V1FrameEncoder{});
 }
 
+void Frames::DecodeInto(std::span<const std::uint8_t> codedData, Frames& frames)
+{
+    DecodeInto(codedData, frames, V1FrameEncoder{});
+}
+
+void Frames::EncodeInto(std::span<const std::uint16_t> frames, std::vector<std::uint8_t>& codedData)
+{
+    EncodeInto(frames, codedData, V1FrameEncoder{});
+}
+
 std::vector<std::uint8_t> Frames::Encode(FrameCodec /*unused*/) const { return Encode(*this); }
 
 Frames& Frames::Data(std::vector<std::uint16_t> frames)
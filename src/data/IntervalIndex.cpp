@@ -0,0 +1,155 @@
+#include <pbcopper/data/IntervalIndex.h>
+
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace PacBio {
+namespace Data {
+namespace {
+
+struct Entry
+{
+    Position Start;
+    Position End;
+    std::uint32_t Input;
+};
+
+bool EntryLess(const Entry& lhs, const Entry& rhs) noexcept
+{
+    return (lhs.Start < rhs.Start) || ((lhs.Start == rhs.Start) && (lhs.End < rhs.End));
+}
+
+// smaller chunks are not worth a thread
+constexpr std::size_t MIN_ENTRIES_PER_THREAD = 1 << 16;
+
+///
+/// Sorts chunks of 'entries' on separate threads, then merges neighbouring
+/// runs pairwise, in parallel, until one remains.
+///
+void SortEntries(std::vector<Entry>& entries, const unsigned int numThreads)
+{
+    const std::size_t numChunks =
+        std::min<std::size_t>(numThreads, entries.size() / MIN_ENTRIES_PER_THREAD + 1);
+    if (numChunks <= 1) {
+        std::stable_sort(entries.begin(), entries.end(), EntryLess);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(numChunks + 1);
+    for (std::size_t c = 0; c <= numChunks; ++c) {
+        bounds[c] = c * entries.size() / numChunks;
+    }
+    const auto at = [&entries](const std::size_t i) { return entries.begin() + i; };
+
+    Parallel::FireAndForget faf{numChunks};
+    Parallel::Dispatch(&faf, static_cast<std::int32_t>(numChunks), [&](const std::int32_t c) {
+        std::stable_sort(at(bounds[c]), at(bounds[c + 1]), EntryLess);
+    });
+
+    for (std::size_t width = 1; width < numChunks; width *= 2) {
+        // runs [c, c + width) and [c + width, c + 2 * width) for c = 0, 2 * width, ...
+        const std::size_t numMerges = (numChunks - width + 2 * width - 1) / (2 * width);
+        Parallel::Dispatch(&faf, static_cast<std::int32_t>(numMerges), [&](const std::int32_t m) {
+            const std::size_t c = 2 * width * m;
+            const std::size_t last = bounds[std::min(c + 2 * width, numChunks)];
+            std::inplace_merge(at(bounds[c]), at(bounds[c + width]), at(last), EntryLess);
+        });
+    }
+}
+
+}  // namespace
+
+IntervalIndex::IntervalIndex(const std::vector<Interval>& intervals, const unsigned int numThreads)
+{
+    if (intervals.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument{"[pbcopper] interval index ERROR: too many intervals (" +
+                                    std::to_string(intervals.size()) + ")"};
+    }
+
+    // empty intervals contain no position, they never overlap anything
+    std::vector<Entry> entries;
+    entries.reserve(intervals.size());
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        const Interval& interval = intervals[i];
+        if (interval.Start() < interval.End()) {
+            entries.push_back({interval.Start(), interval.End(), static_cast<std::uint32_t>(i)});
+        }
+    }
+    SortEntries(entries, Parallel::NormalizedThreadCount(numThreads));
+
+    const std::size_t n = entries.size();
+    starts_.resize(n);
+    ends_.resize(n);
+    inputIndices_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        starts_[i] = entries[i].Start;
+        ends_[i] = entries[i].End;
+        inputIndices_[i] = entries[i].Input;
+        if ((i > 0) && (starts_[i] < ends_[i - 1])) {
+            disjoint_ = false;
+        }
+    }
+    if (n == 0) {
+        return;
+    }
+
+    // Augment the implicit tree bottom-up. A node's right subtree may lie
+    // (partly) past the end; it then contributes the maximum end of the last
+    // existing node at the level below, tracked in lastMax.
+    maxEnds_ = ends_;
+    std::size_t lastNode = (n - 1) & ~std::size_t{1};
+    Position lastMax = maxEnds_[lastNode];
+    std::int32_t level = 1;
+    for (; (std::size_t{1} << level) <= n; ++level) {
+        const std::size_t halfSpan = std::size_t{1} << (level - 1);
+        for (std::size_t i = 2 * halfSpan - 1; i < n; i += 4 * halfSpan) {
+            const Position left = maxEnds_[i - halfSpan];
+            const Position right = (i + halfSpan < n) ? maxEnds_[i + halfSpan] : lastMax;
+            maxEnds_[i] = std::max({ends_[i], left, right});
+        }
+        lastNode = ((lastNode >> level) & 1) ? lastNode - halfSpan : lastNode + halfSpan;
+        if ((lastNode < n) && (maxEnds_[lastNode] > lastMax)) {
+            lastMax = maxEnds_[lastNode];
+        }
+    }
+    maxLevel_ = level - 1;
+}
+
+bool IntervalIndex::Contains(const Position value) const
+{
+    // stops at the first hit
+    return !Visit(value, value + 1, [](std::size_t) { return false; });
+}
+
+std::vector<std::size_t> IntervalIndex::Overlapping(const Interval& query) const
+{
+    std::vector<std::size_t> result;
+    ForEachOverlap(query, [&result](const std::size_t i) { result.push_back(i); });
+    return result;
+}
+
+std::vector<std::size_t> IntervalIndex::Stabbing(const Position value) const
+{
+    return Overlapping(Interval{value, value + 1});
+}
+
+IntervalIndex IntervalIndex::Merged() const
+{
+    std::vector<Interval> merged;
+    for (std::size_t i = 0; i < Size(); ++i) {
+        // IntervalTree merges touching intervals, too
+        if (!merged.empty() && (starts_[i] <= merged.back().End())) {
+            merged.back().End(std::max(merged.back().End(), ends_[i]));
+        } else {
+            merged.emplace_back(starts_[i], ends_[i]);
+        }
+    }
+    return IntervalIndex{merged};
+}
+
+}  // namespace Data
+}  // namespace PacBio
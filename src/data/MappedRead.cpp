@@ -1,14 +1,19 @@
 #include <pbcopper/data/MappedRead.h>
 
+#include "MappedReadImpl.h"
+
 #include <pbcopper/data/Clipping.h>
 #include <pbcopper/data/internal/ClippingImpl.h>
 #include <pbcopper/utility/SequenceUtils.h>
 
 #include <algorithm>
+#include <iterator>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace PacBio {
 namespace Data {
@@ -21,112 +26,156 @@ struct InvalidMappedReadException : public std::runtime_error
     {}
 };
 
-template <class InputIt, class Size, class OutputIt>
-OutputIt Move_N(InputIt first, Size count, OutputIt result)
+// Writes one field (bases, qualities, ...) of the aligned output, given where
+// each CIGAR operation's query bases, in genomic orientation, land in it.
+//
+// On the reverse strand, genomic position g is native position L - 1 - g.
+// Output in native orientation is the genomic output reversed, so its
+// positions are mirrored too and query runs stay in native order.
+template <typename T>
+class AlignedWriter
 {
-    return std::move(first, first + count, result);
-}
-
-template <typename F, typename N>
-void ClipAndGapify(F* seq, const Cigar& cigar, const GapBehavior gapBehavior,
-                   const SoftClipBehavior softClipBehavior, N paddingNullValue, N deletionNullValue)
-{
-    assert(seq);
-    assert((gapBehavior == GapBehavior::SHOW) || (softClipBehavior == SoftClipBehavior::REMOVE));
-
-    const bool showGaps = (gapBehavior == GapBehavior::SHOW);
-    const bool removeSoftClips = (softClipBehavior == SoftClipBehavior::REMOVE);
-
-    // clang-format off
-    // determine output container's length
-    const std::size_t outputLength = std::accumulate(cigar.cbegin(), cigar.cend(), 0,
-        [&](std::size_t totalLength, const CigarOperation& op) {
-            const auto opLength = op.Length();
-            switch (op.Type())
-            {
-                // these operations never increment output length
-                case CigarOperationType::HARD_CLIP:
-                case CigarOperationType::REFERENCE_SKIP:
-                    return totalLength;
-
-                // if we're removing soft clip, do not increment output length
-                case CigarOperationType::SOFT_CLIP:
-                    return totalLength + (removeSoftClips ? 0 : opLength);
+public:
+    AlignedWriter(const T* src, const std::size_t srcLength, T* dst, const std::size_t dstLength,
+                  const bool reverseStrand, const bool nativeOutput, const T deletion,
+                  const T padding)
+        : src_{src}
+        , srcLength_{srcLength}
+        , dst_{dst}
+        , dstLength_{dstLength}
+        , reverseStrand_{reverseStrand}
+        , nativeOutput_{nativeOutput}
+        , deletion_{deletion}
+        , padding_{padding}
+    {}
 
-                // increase output length only if we're adding deletion/padding chars
-                case CigarOperationType::DELETION:
-                case CigarOperationType::PADDING:
-                    return totalLength + (showGaps ? opLength : 0);
+    void Copy(const std::size_t srcIndex, const std::size_t dstIndex, const std::size_t n) const
+    {
+        if (!reverseStrand_) {
+            std::copy_n(src_ + srcIndex, n, dst_ + dstIndex);
+            return;
+        }
 
-                // otherwise, all operations contribute to output length
-                default:
-                    return totalLength + opLength;
+        const T* first = src_ + (srcLength_ - srcIndex - n);
+        if (nativeOutput_) {
+            // bases are complemented twice, normalizing them as before
+            T* out = dst_ + (dstLength_ - dstIndex - n);
+            if constexpr (std::is_same_v<T, char>) {
+                std::transform(first, first + n, out,
+                               [](char c) { return Utility::Complement(Utility::Complement(c)); });
+            } else {
+                std::copy_n(first, n, out);
             }
-        });
-    // clang-format on
+        } else {
+            T* out = dst_ + dstIndex;
+            if constexpr (std::is_same_v<T, char>) {
+                std::transform(std::make_reverse_iterator(first + n),
+                               std::make_reverse_iterator(first), out, Utility::Complement);
+            } else {
+                std::reverse_copy(first, first + n, out);
+            }
+        }
+    }
 
-    // move original data to temp, prep output container size
-    F originalSeq = std::move(*seq);
-    seq->resize(outputLength);
+    void Fill(const std::size_t dstIndex, const std::size_t n, const bool isDeletion) const
+    {
+        const std::size_t start =
+            (reverseStrand_ && nativeOutput_) ? (dstLength_ - dstIndex - n) : dstIndex;
+        std::fill_n(dst_ + start, n, isDeletion ? deletion_ : padding_);
+    }
 
-    // apply CIGAR ops
-    std::size_t srcIndex = 0;
-    std::size_t dstIndex = 0;
+private:
+    const T* src_;
+    std::size_t srcLength_;
+    T* dst_;
+    std::size_t dstLength_;
+    bool reverseStrand_;
+    bool nativeOutput_;
+    T deletion_;
+    T padding_;
+};
+
+std::size_t AlignedLength(const Cigar& cigar, const bool showGaps, const bool removeSoftClips)
+{
+    std::size_t result = 0;
     for (const auto& op : cigar) {
         const auto opLength = op.Length();
-        const auto opType = op.Type();
-
-        // nothing to do for hard-clipped & ref-skipped positions
-        if (opType == CigarOperationType::HARD_CLIP ||
-            opType == CigarOperationType::REFERENCE_SKIP) {
-            continue;
-        }
-
-        // maybe skip soft-clipped positions
-        else if (opType == CigarOperationType::SOFT_CLIP && removeSoftClips) {
-            srcIndex += opLength;
+        switch (op.Type()) {
+            // these operations never increment output length
+            case CigarOperationType::HARD_CLIP:
+            case CigarOperationType::REFERENCE_SKIP:
+                break;
 
-            // maybe add deletions
-        } else if (opType == CigarOperationType::DELETION && showGaps) {
-            for (std::size_t i = 0; i < opLength; ++i) {
-                (*seq)[dstIndex] = deletionNullValue;
-                ++dstIndex;
-            }
-        }
+            // if we're removing soft clip, do not increment output length
+            case CigarOperationType::SOFT_CLIP:
+                result += (removeSoftClips ? 0 : opLength);
+                break;
 
-        // maybe add padding
-        else if (opType == CigarOperationType::PADDING && showGaps) {
-            for (std::size_t i = 0; i < opLength; ++i) {
-                (*seq)[dstIndex] = paddingNullValue;
-                ++dstIndex;
-            }
-        }
+            // increase output length only if we're adding deletion/padding chars
+            case CigarOperationType::DELETION:
+            case CigarOperationType::PADDING:
+                result += (showGaps ? opLength : 0);
+                break;
 
-        // otherwise move input sequence to output
-        else {
-            Move_N(originalSeq.begin() + srcIndex, opLength, seq->begin() + dstIndex);
-            srcIndex += opLength;
-            dstIndex += opLength;
+            // otherwise, all operations contribute to output length
+            default:
+                result += opLength;
         }
     }
+    return result;
 }
 
-template <typename Container>
-void OrientData(Container* data, Orientation currentOrientation, Orientation targetOrientation,
-                enum Strand strand)
+// Calls copy(srcIndex, dstIndex, n) & fill(dstIndex, n, isDeletion) for each
+// CIGAR operation that contributes to the aligned output.
+template <typename Copy, typename Fill>
+void WalkAlignedCigar(const Cigar& cigar, const bool showGaps, const bool removeSoftClips,
+                      Copy&& copy, Fill&& fill)
 {
-    if ((currentOrientation != targetOrientation) && (strand == Strand::REVERSE)) {
-        std::reverse(data->begin(), data->end());
+    std::size_t srcIndex = 0;
+    std::size_t dstIndex = 0;
+    for (const auto& op : cigar) {
+        const std::size_t opLength = op.Length();
+        switch (op.Type()) {
+            // nothing to do for hard-clipped & ref-skipped positions
+            case CigarOperationType::HARD_CLIP:
+            case CigarOperationType::REFERENCE_SKIP:
+                break;
+
+            // maybe add deletions/padding
+            case CigarOperationType::DELETION:
+            case CigarOperationType::PADDING:
+                if (showGaps) {
+                    fill(dstIndex, opLength, op.Type() == CigarOperationType::DELETION);
+                    dstIndex += opLength;
+                }
+                break;
+
+            // maybe skip soft-clipped positions
+            case CigarOperationType::SOFT_CLIP:
+                if (removeSoftClips) {
+                    srcIndex += opLength;
+                    break;
+                }
+                [[fallthrough]];
+
+            // otherwise copy input to output
+            default:
+                copy(srcIndex, dstIndex, opLength);
+                srcIndex += opLength;
+                dstIndex += opLength;
+        }
     }
 }
 
-template <>
-void OrientData(std::string* data, Orientation currentOrientation, Orientation targetOrientation,
-                enum Strand strand)
+std::size_t QueryLength(const Cigar& cigar)
 {
-    if ((currentOrientation != targetOrientation) && (strand == Strand::REVERSE)) {
-        Utility::ReverseComplement(*data);
+    std::size_t result = 0;
+    for (const auto& op : cigar) {
+        if (ConsumesQuery(op.Type())) {
+            result += op.Length();
+        }
     }
+    return result;
 }
 
 }  // namespace
@@ -184,76 +233,143 @@ MappedRead::MappedRead(Read read, PacBio::Data::Strand strand, Position template
     , MapQuality{mapQV}
 {}
 
-std::string MappedRead::AlignedSequence(Orientation orientation, GapBehavior gapBehavior,
-                                        SoftClipBehavior softClipBehavior) const
+void MappedRead::ProjectAligned(const AlignedProjection& outputs, const Orientation orientation,
+                                const GapBehavior gapBehavior,
+                                const SoftClipBehavior softClipBehavior) const
 {
-    if (Strand == Strand::UNMAPPED || Cigar.empty()) {
-        return Seq;
+    const bool mapped = (Strand != Strand::UNMAPPED) && !Cigar.empty();
+    const bool showGaps = (gapBehavior == GapBehavior::SHOW);
+    const bool removeSoftClips = (softClipBehavior == SoftClipBehavior::REMOVE);
+
+    // only gaps & clipping need the CIGAR, otherwise data is just oriented
+    const bool walkCigar = mapped && (showGaps || removeSoftClips);
+    const bool reverseStrand =
+        mapped && (Strand == Strand::REVERSE) && (walkCigar || orientation == Orientation::GENOMIC);
+    const bool nativeOutput = (orientation == Orientation::NATIVE);
+    const std::size_t alignedLength =
+        walkCigar ? AlignedLength(Cigar, showGaps, removeSoftClips) : 0;
+    const std::size_t queryLength = walkCigar ? QueryLength(Cigar) : 0;
+
+    // Sizes an output, returning its writer unless the input is missing (e.g.
+    // no qualities), in which case the output is empty too.
+    const auto makeWriter = [&](const auto& input, auto& output, const auto deletion,
+                                const auto padding) {
+        using T = std::decay_t<decltype(deletion)>;
+        if (input.empty() && (!walkCigar || queryLength > 0)) {
+            output.clear();
+            return std::optional<AlignedWriter<T>>{};
+        }
+        std::size_t outputLength = input.size();
+        if (walkCigar) {
+            if (input.size() < queryLength) {
+                throw InvalidMappedReadException{"CIGAR is longer than the read data"};
+            }
+            outputLength = alignedLength;
+        }
+        output.resize(outputLength);
+        return std::optional<AlignedWriter<T>>{std::in_place, input.data(), input.size(),
+                                               output.data(), outputLength, reverseStrand,
+                                               nativeOutput,  deletion,     padding};
+    };
+
+    std::optional<AlignedWriter<char>> seq;
+    std::optional<AlignedWriter<QualityValue>> quals;
+    std::optional<AlignedWriter<std::uint16_t>> ipd;
+    std::optional<AlignedWriter<std::uint16_t>> pw;
+
+    if (outputs.Sequence) {
+        seq = makeWriter(Seq, *outputs.Sequence, '-', '*');
     }
+    if (outputs.Qualities) {
+        quals = makeWriter(Qualities, *outputs.Qualities, QualityValue{0}, QualityValue{0});
+    }
+    const auto makeFramesWriter = [&](const std::optional<Frames>& input,
+                                      std::optional<Frames>* output,
+                                      std::optional<AlignedWriter<std::uint16_t>>& writer) {
+        if (!output) {
+            return;
+        }
+        if (!input) {
+            output->reset();
+            return;
+        }
+        if (!*output) {
+            output->emplace();
+        }
+        writer = makeWriter(input->Data(), (*output)->Data(), std::uint16_t{0}, std::uint16_t{0});
+    };
+    makeFramesWriter(IPD, outputs.IPD, ipd);
+    makeFramesWriter(PulseWidth, outputs.PulseWidth, pw);
+
+    const auto copy = [&](const std::size_t srcIndex, const std::size_t dstIndex,
+                          const std::size_t n) {
+        for (const auto* writer : {&ipd, &pw}) {
+            if (*writer) {
+                (*writer)->Copy(srcIndex, dstIndex, n);
+            }
+        }
+        if (seq) {
+            seq->Copy(srcIndex, dstIndex, n);
+        }
+        if (quals) {
+            quals->Copy(srcIndex, dstIndex, n);
+        }
+    };
+    const auto fill = [&](const std::size_t dstIndex, const std::size_t n, const bool isDeletion) {
+        for (const auto* writer : {&ipd, &pw}) {
+            if (*writer) {
+                (*writer)->Fill(dstIndex, n, isDeletion);
+            }
+        }
+        if (seq) {
+            seq->Fill(dstIndex, n, isDeletion);
+        }
+        if (quals) {
+            quals->Fill(dstIndex, n, isDeletion);
+        }
+    };
 
-    std::string bases = Seq;  // native orientation
-    Orientation currentOrientation = Orientation::NATIVE;
+    if (walkCigar) {
+        WalkAlignedCigar(Cigar, showGaps, removeSoftClips, copy, fill);
+        return;
+    }
 
-    // if we need to touch CIGAR, force into genomic orientation (for mapping to CIGAR),
-    // then apply gaps and/or remove soft clips
-    if ((gapBehavior == GapBehavior::SHOW) || (softClipBehavior == SoftClipBehavior::REMOVE)) {
-        OrientData(&bases, currentOrientation, Orientation::GENOMIC, AlignedStrand());
-        currentOrientation = Orientation::GENOMIC;
-        ClipAndGapify(&bases, Cigar, gapBehavior, softClipBehavior, '*', '-');
+    // whole fields, oriented
+    if (seq) {
+        seq->Copy(0, 0, Seq.size());
     }
+    if (quals) {
+        quals->Copy(0, 0, Qualities.size());
+    }
+    if (ipd) {
+        ipd->Copy(0, 0, IPD->size());
+    }
+    if (pw) {
+        pw->Copy(0, 0, PulseWidth->size());
+    }
+}
 
-    // place back in requested orientation
-    OrientData(&bases, currentOrientation, orientation, AlignedStrand());
+std::string MappedRead::AlignedSequence(Orientation orientation, GapBehavior gapBehavior,
+                                        SoftClipBehavior softClipBehavior) const
+{
+    std::string bases;
+    ProjectAligned({.Sequence = &bases}, orientation, gapBehavior, softClipBehavior);
     return bases;
 }
 
 QualityValues MappedRead::AlignedQualities(Orientation orientation, GapBehavior gapBehavior,
                                            SoftClipBehavior softClipBehavior) const
 {
-    if (Strand == Strand::UNMAPPED || Cigar.empty()) {
-        return Qualities;
-    }
-
-    QualityValues quals = Qualities;  // native orientation
-    Orientation currentOrientation = Orientation::NATIVE;
-
-    // if we need to touch CIGAR, force into genomic orientation (for mapping to CIGAR),
-    // then apply gaps and/or remove soft clips
-    if ((gapBehavior == GapBehavior::SHOW) || (softClipBehavior == SoftClipBehavior::REMOVE)) {
-        OrientData(&quals, currentOrientation, Orientation::GENOMIC, AlignedStrand());
-        currentOrientation = Orientation::GENOMIC;
-        ClipAndGapify(&quals, Cigar, gapBehavior, softClipBehavior, QualityValue{0},
-                      QualityValue{0});
-    }
-
-    // place back in requested orientation
-    OrientData(&quals, currentOrientation, orientation, AlignedStrand());
+    QualityValues quals;
+    ProjectAligned({.Qualities = &quals}, orientation, gapBehavior, softClipBehavior);
     return quals;
 }
 
 std::optional<Frames> MappedRead::AlignedIPD(Orientation orientation, GapBehavior gapBehavior,
                                              SoftClipBehavior softClipBehavior) const
 {
-    if (!IPD) {
-        return {};
-    }
-    if (Strand == Strand::UNMAPPED || Cigar.empty()) {
-        return IPD;
-    }
-
-    Frames ipd = *IPD;  // native orientation
-    Orientation currentOrientation = Orientation::NATIVE;
-
-    // if we need to touch CIGAR, force into genomic orientation (for mapping to CIGAR),
-    // then apply gaps and/or remove soft clips
-    if ((gapBehavior == GapBehavior::SHOW) || (softClipBehavior == SoftClipBehavior::REMOVE)) {
-        OrientData(&ipd, currentOrientation, Orientation::GENOMIC, AlignedStrand());
-        currentOrientation = Orientation::GENOMIC;
-        ClipAndGapify(&ipd, Cigar, gapBehavior, softClipBehavior, 0, 0);
-    }
-
-    // place back in requested orientation
-    OrientData(&ipd, currentOrientation, orientation, AlignedStrand());
+    std::optional<Frames> ipd;
+    ProjectAligned({.IPD = &ipd}, orientation, gapBehavior, softClipBehavior);
     return ipd;
 }
 
@@ -261,40 +377,24 @@ std::optional<Frames> MappedRead::AlignedPulseWidth(Orientation orientation,
                                                     GapBehavior gapBehavior,
                                                     SoftClipBehavior softClipBehavior) const
 {
-    if (!PulseWidth) {
-        return {};
-    }
-    if (Strand == Strand::UNMAPPED || Cigar.empty()) {
-        return PulseWidth;
-    }
-
-    Frames pw = *PulseWidth;  // native orientation
-    Orientation currentOrientation = Orientation::NATIVE;
-
-    // if we need to touch CIGAR, force into genomic orientation (for mapping to CIGAR),
-    // then apply gaps and/or remove soft clips
-    if ((gapBehavior == GapBehavior::SHOW) || (softClipBehavior == SoftClipBehavior::REMOVE)) {
-        OrientData(&pw, currentOrientation, Orientation::GENOMIC, AlignedStrand());
-        currentOrientation = Orientation::GENOMIC;
-        ClipAndGapify(&pw, Cigar, gapBehavior, softClipBehavior, 0, 0);
-    }
-
-    // place back in requested orientation
-    OrientData(&pw, currentOrientation, orientation, AlignedStrand());
+    std::optional<Frames> pw;
+    ProjectAligned({.PulseWidth = &pw}, orientation, gapBehavior, softClipBehavior);
     return pw;
 }
 
-Position MappedRead::AlignedStart() const
+namespace internal {
+
+Position AlignedStart(const Position queryStart, const Position seqLength, const enum Strand strand,
+                      const CigarView cigar)
 {
-    if (QueryStart == UNMAPPED_POSITION) {
+    if (queryStart == UNMAPPED_POSITION) {
         throw InvalidMappedReadException{"contains unmapped query start position"};
     }
-    if (Strand == Strand::UNMAPPED) {
+    if (strand == Strand::UNMAPPED) {
         throw InvalidMappedReadException{"contains unmapped strand"};
     }
 
-    Position startOffset = QueryStart;
-    const Position seqLength = Seq.length();
+    Position startOffset = queryStart;
     const auto findAlignedStart = [&startOffset, seqLength](auto it, const auto end) {
         for (; it != end; ++it) {
             const auto type = it->Type();
@@ -312,26 +412,27 @@ Position MappedRead::AlignedStart() const
         }
     };
 
-    if (Strand == Strand::FORWARD) {
-        findAlignedStart(Cigar.cbegin(), Cigar.cend());
+    if (strand == Strand::FORWARD) {
+        findAlignedStart(cigar.cbegin(), cigar.cend());
     } else {
-        findAlignedStart(Cigar.crbegin(), Cigar.crend());
+        findAlignedStart(std::make_reverse_iterator(cigar.cend()),
+                         std::make_reverse_iterator(cigar.cbegin()));
     }
 
     return startOffset;
 }
 
-Position MappedRead::AlignedEnd() const
+Position AlignedEnd(const Position queryEnd, const Position seqLength, const enum Strand strand,
+                    const CigarView cigar)
 {
-    if (QueryEnd == UNMAPPED_POSITION) {
+    if (queryEnd == UNMAPPED_POSITION) {
         throw InvalidMappedReadException{"contains unmapped query end position"};
     }
-    if (Strand == Strand::UNMAPPED) {
+    if (strand == Strand::UNMAPPED) {
         throw InvalidMappedReadException{"contains unmapped strand"};
     }
 
-    Position endOffset = QueryEnd;
-    const Position seqLength = Seq.length();
+    Position endOffset = queryEnd;
     const auto findAlignedEnd = [&endOffset, seqLength](auto it, const auto end) {
         for (; it != end; ++it) {
             const auto type = it->Type();
@@ -349,38 +450,37 @@ Position MappedRead::AlignedEnd() const
         }
     };
 
-    if (Strand == Strand::FORWARD) {
-        findAlignedEnd(Cigar.crbegin(), Cigar.crend());
+    if (strand == Strand::FORWARD) {
+        findAlignedEnd(std::make_reverse_iterator(cigar.cend()),
+                       std::make_reverse_iterator(cigar.cbegin()));
     } else {
-        findAlignedEnd(Cigar.cbegin(), Cigar.cend());
+        findAlignedEnd(cigar.cbegin(), cigar.cend());
     }
 
     return endOffset;
 }
 
-Position MappedRead::ReferenceStart() const
+Position ReferenceStart(const Position templateStart)
 {
-    if (TemplateStart == UNMAPPED_POSITION) {
+    if (templateStart == UNMAPPED_POSITION) {
         throw InvalidMappedReadException{"contains unmapped template start position"};
     }
-    return TemplateStart;
+    return templateStart;
 }
 
-Position MappedRead::ReferenceEnd() const
+Position ReferenceEnd(const Position templateEnd)
 {
-    if (TemplateEnd == UNMAPPED_POSITION) {
+    if (templateEnd == UNMAPPED_POSITION) {
         throw InvalidMappedReadException{"contains unmapped template end position"};
     }
-    return TemplateEnd;
+    return templateEnd;
 }
 
-Strand MappedRead::AlignedStrand() const { return Strand; }
-
-int32_t MappedRead::NumMismatches() const
+std::int32_t NumMismatches(const CigarView cigar)
 {
     std::int32_t result = 0;
 
-    for (const auto& op : Cigar) {
+    for (const auto& op : cigar) {
         const auto type = op.Type();
         const auto len = op.Length();
         result += (type == CigarOperationType::SEQUENCE_MISMATCH) * len;
@@ -389,6 +489,26 @@ int32_t MappedRead::NumMismatches() const
     return result;
 }
 
+}  // namespace internal
+
+Position MappedRead::AlignedStart() const
+{
+    return internal::AlignedStart(QueryStart, Seq.length(), Strand, Cigar);
+}
+
+Position MappedRead::AlignedEnd() const
+{
+    return internal::AlignedEnd(QueryEnd, Seq.length(), Strand, Cigar);
+}
+
+Position MappedRead::ReferenceStart() const { return internal::ReferenceStart(TemplateStart); }
+
+Position MappedRead::ReferenceEnd() const { return internal::ReferenceEnd(TemplateEnd); }
+
+Strand MappedRead::AlignedStrand() const { return Strand; }
+
+int32_t MappedRead::NumMismatches() const { return internal::NumMismatches(Cigar); }
+
 std::ostream& operator<<(std::ostream& os, const MappedRead& mr)
 {
     os << "MappedRead(" << static_cast<const Read&>(mr) << ", RefId=" << mr.RefId << ", Strand=";
@@ -413,64 +533,13 @@ std::ostream& operator<<(std::ostream& os, const MappedRead& mr)
 
 void ClipToQuery(MappedRead& read, Position start, Position end)
 {
-    // skip out if clip not needed
-    if (start <= read.QueryStart && end >= read.QueryEnd) {
-        return;
-    }
-
-    // calculate clipping
-    ClipToQueryConfig clipConfig{read.Seq.size(),
-                                 read.QueryStart,
-                                 read.QueryEnd,
-                                 start,
-                                 end,
-                                 read.TemplateStart,
-                                 read.Strand,
-                                 std::move(read.Cigar),  // we'll get this back
-                                 true};
-    auto result = ClipToQuery(clipConfig);
-
-    // apply clipping
-    internal::ClipMappedRead(read, std::move(result));
+    internal::ClipMappedRead(read, internal::QueryClipSpan(read, start, end));
 }
 
 void ClipToReference(MappedRead& read, Position start, Position end, bool exciseFlankingInserts)
 {
-    // return emptied read if clip region is disjoint from
-    if (end <= read.TemplateStart || start >= read.TemplateEnd) {
-        read.Seq.clear();
-        read.Qualities.clear();
-        read.QueryStart = -1;
-        read.QueryEnd = -1;
-        if (read.PulseWidth) {
-            read.PulseWidth->clear();
-        }
-        if (read.IPD) {
-            read.IPD->clear();
-        }
-        read.TemplateStart = -1;
-        read.TemplateEnd = -1;
-        read.Cigar.clear();
-        read.MapQuality = 255;
-        return;
-    }
-
-    // skip out if clip region covers aligned region (no clip needed)
-    if (start <= read.TemplateStart && end >= read.TemplateEnd) {
-        return;
-    }
-
-    // calculate clipping
-    ClipToReferenceConfig clipConfig{
-        ClipToQueryConfig{read.Seq.size(), read.QueryStart, read.QueryEnd, start, end,
-                          read.TemplateStart, read.Strand,
-                          std::move(read.Cigar),  // we'll get this back
-                          true},
-        read.TemplateEnd, start, end, exciseFlankingInserts};
-    auto result = ClipToReference(clipConfig);
-
-    // apply clipping
-    internal::ClipMappedRead(read, std::move(result));
+    internal::ClipMappedRead(read,
+                             internal::ReferenceClipSpan(read, start, end, exciseFlankingInserts));
 }
 
 }  // namespace Data
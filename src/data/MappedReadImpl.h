@@ -0,0 +1,32 @@
+#ifndef PBCOPPER_DATA_MAPPEDREADIMPL_H
+#define PBCOPPER_DATA_MAPPEDREADIMPL_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/data/CigarView.h>
+#include <pbcopper/data/Position.h>
+#include <pbcopper/data/Strand.h>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace Data {
+namespace internal {
+
+// MappedRead accessors over plain fields, shared with MappedReadView
+
+Position AlignedStart(Position queryStart, Position seqLength, Strand strand, CigarView cigar);
+
+Position AlignedEnd(Position queryEnd, Position seqLength, Strand strand, CigarView cigar);
+
+Position ReferenceStart(Position templateStart);
+
+Position ReferenceEnd(Position templateEnd);
+
+std::int32_t NumMismatches(CigarView cigar);
+
+}  // namespace internal
+}  // namespace Data
+}  // namespace PacBio
+
+#endif  // PBCOPPER_DATA_MAPPEDREADIMPL_H
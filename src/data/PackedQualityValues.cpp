@@ -0,0 +1,215 @@
+#include <pbcopper/data/PackedQualityValues.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "../../third-party/simde/x86/sse4.1.h"
+
+namespace PacBio {
+namespace Data {
+namespace {
+
+static_assert(sizeof(QualityValue) == 1);
+
+// QualityValue::MAX + 1, which is not a constant expression
+constexpr std::size_t NUM_QUALITY_VALUES = 94;
+
+// bin index of each quality value
+using BinLookup = std::array<std::uint8_t, NUM_QUALITY_VALUES>;
+
+BinLookup MakeBinLookup(const std::span<const QualityValue> bins)
+{
+    if (bins.empty() || (bins.size() > 16)) {
+        throw std::invalid_argument{"[pbcopper] packed quality values ERROR: " +
+                                    std::to_string(bins.size()) + " bins, expected 1 to 16"};
+    }
+    for (std::size_t i = 1; i < bins.size(); ++i) {
+        if (bins[i - 1] >= bins[i]) {
+            throw std::invalid_argument{
+                "[pbcopper] packed quality values ERROR: bins must be strictly increasing"};
+        }
+    }
+
+    BinLookup result;
+    std::size_t bin = 0;
+    for (std::size_t qv = 0; qv < result.size(); ++qv) {
+        while ((bin + 1 < bins.size()) && (bins[bin + 1] <= qv)) {
+            ++bin;
+        }
+        result[qv] = bin;
+    }
+    return result;
+}
+
+// the sorted, distinct values of 'quals'
+std::vector<QualityValue> DistinctValues(const std::span<const QualityValue> quals)
+{
+    std::array<bool, NUM_QUALITY_VALUES> seen{};
+    for (const auto qv : quals) {
+        seen[qv] = true;
+    }
+
+    std::vector<QualityValue> result;
+    for (std::size_t qv = 0; qv < seen.size(); ++qv) {
+        if (seen[qv]) {
+            result.emplace_back(qv);
+        }
+    }
+    if (result.size() > 16) {
+        throw std::invalid_argument{
+            "[pbcopper] packed quality values ERROR: " + std::to_string(result.size()) +
+            " distinct quality values, at most 16 can be packed"};
+    }
+    if (result.empty()) {
+        result.emplace_back(0);
+    }
+    return result;
+}
+
+///
+/// Writes (bins[code] + offset) of each packed value to 'out', 16 at a time:
+/// the nibbles of 8 bytes are interleaved into 16 indices for pshufb.
+///
+void UnpackBins(const std::vector<std::uint8_t>& data, const std::size_t size,
+                const std::array<QualityValue, 16>& bins, const std::uint8_t offset,
+                std::uint8_t* out)
+{
+    const simde__m128i table =
+        simde_mm_add_epi8(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(bins.data())),
+                          simde_mm_set1_epi8(offset));
+    const simde__m128i lowNibble = simde_mm_set1_epi8(0x0F);
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const simde__m128i packed =
+            simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(data.data() + i / 2));
+        const simde__m128i high = simde_mm_and_si128(simde_mm_srli_epi16(packed, 4), lowNibble);
+        const simde__m128i low = simde_mm_and_si128(packed, lowNibble);
+        const simde__m128i codes = simde_mm_unpacklo_epi8(high, low);
+        simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(out + i),
+                              simde_mm_shuffle_epi8(table, codes));
+    }
+    for (; i < size; ++i) {
+        const std::uint8_t code = (data[i / 2] >> (4 - 4 * (i % 2))) & 0x0F;
+        out[i] = bins[code] + offset;
+    }
+}
+
+void CheckSize(const std::size_t actual, const std::size_t expected)
+{
+    if (actual != expected) {
+        throw std::invalid_argument{"[pbcopper] packed quality values ERROR: output holds " +
+                                    std::to_string(actual) + " elements, expected " +
+                                    std::to_string(expected)};
+    }
+}
+
+}  // namespace
+
+PackedQualityValues::PackedQualityValues(const std::span<const QualityValue> quals)
+    : PackedQualityValues{quals, DistinctValues(quals)}
+{}
+
+PackedQualityValues::PackedQualityValues(const std::span<const QualityValue> quals,
+                                         const std::span<const QualityValue> bins)
+    : numBins_{bins.size()}, data_((quals.size() + 1) / 2), size_{quals.size()}
+{
+    const BinLookup lookup = MakeBinLookup(bins);
+    std::copy(bins.begin(), bins.end(), bins_.begin());
+
+    std::size_t i = 0;
+    for (; i + 2 <= size_; i += 2) {
+        data_[i / 2] = (lookup[quals[i]] << 4) | lookup[quals[i + 1]];
+    }
+    if (i < size_) {
+        data_[i / 2] = lookup[quals[i]] << 4;
+    }
+}
+
+void PackedQualityValues::UnpackInto(const std::span<QualityValue> quals) const
+{
+    CheckSize(quals.size(), size_);
+    UnpackBins(data_, size_, bins_, 0, reinterpret_cast<std::uint8_t*>(quals.data()));
+}
+
+QualityValues PackedQualityValues::Unpack() const
+{
+    QualityValues result;
+    result.resize(size_);
+    UnpackInto(result);
+    return result;
+}
+
+std::string PackedQualityValues::Fastq() const
+{
+    std::string result(size_, '!');
+    UnpackBins(data_, size_, bins_, 33, reinterpret_cast<std::uint8_t*>(result.data()));
+    return result;
+}
+
+bool PackedQualityValues::operator==(const PackedQualityValues& other) const noexcept
+{
+    return (size_ == other.size_) && std::ranges::equal(Bins(), other.Bins()) &&
+           (data_ == other.data_);
+}
+
+bool PackedQualityValues::operator!=(const PackedQualityValues& other) const noexcept
+{
+    return !(*this == other);
+}
+
+QualityStats ComputeQualityStats(const PackedQualityValues& quals)
+{
+    QualityStats result;
+    if (quals.Empty()) {
+        return result;
+    }
+
+    // count packed bytes, 4 interleaved histograms
+    std::array<std::array<std::uint64_t, 256>, 4> byteCounts{};
+    const auto data = quals.Data();
+    std::size_t i = 0;
+    for (; i + 4 <= data.size(); i += 4) {
+        ++byteCounts[0][data[i]];
+        ++byteCounts[1][data[i + 1]];
+        ++byteCounts[2][data[i + 2]];
+        ++byteCounts[3][data[i + 3]];
+    }
+    for (; i < data.size(); ++i) {
+        ++byteCounts[0][data[i]];
+    }
+
+    std::array<std::uint64_t, 16> codeCounts{};
+    for (std::size_t byte = 0; byte < 256; ++byte) {
+        const std::uint64_t count =
+            byteCounts[0][byte] + byteCounts[1][byte] + byteCounts[2][byte] + byteCounts[3][byte];
+        codeCounts[byte >> 4] += count;
+        codeCounts[byte & 0x0F] += count;
+    }
+    // the unused low nibble of an odd-sized last byte
+    if (quals.Size() % 2) {
+        --codeCounts[0];
+    }
+
+    // bins are sorted, so the first one in use is the minimum
+    const auto bins = quals.Bins();
+    std::uint64_t sum = 0;
+    bool foundMin = false;
+    for (std::size_t code = 0; code < bins.size(); ++code) {
+        if (codeCounts[code] == 0) {
+            continue;
+        }
+        if (!foundMin) {
+            result.Min = bins[code];
+            foundMin = true;
+        }
+        sum += codeCounts[code] * static_cast<std::uint8_t>(bins[code]);
+        result.ExpectedErrors += codeCounts[code] * PhredToErrorProbability(bins[code]);
+    }
+    result.Mean = static_cast<double>(sum) / quals.Size();
+    return result;
+}
+
+}  // namespace Data
+}  // namespace PacBio
@@ -3,19 +3,93 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <array>
 #include <ostream>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include <cmath>
+
+#include "../../third-party/simde/x86/sse4.1.h"
+
 namespace PacBio {
 namespace Data {
+namespace {
+
+// QualityValue is a plain byte, processed 16 at a time
+static_assert(sizeof(QualityValue) == 1);
+static_assert(std::is_trivially_copyable_v<QualityValue>);
+
+constexpr std::size_t BLOCK = 16;
+
+// QualityValue::MAX + 1, which is not a constant expression
+constexpr std::size_t NUM_QUALITY_VALUES = 94;
+
+simde__m128i Load(const void* p) noexcept
+{
+    return simde_mm_loadu_si128(static_cast<const simde__m128i*>(p));
+}
+
+void Store(void* p, const simde__m128i v) noexcept
+{
+    simde_mm_storeu_si128(static_cast<simde__m128i*>(p), v);
+}
+
+void CheckSize(const std::size_t actual, const std::size_t expected)
+{
+    if (actual != expected) {
+        throw std::invalid_argument{"[pbcopper] quality values ERROR: output holds " +
+                                    std::to_string(actual) + " elements, expected " +
+                                    std::to_string(expected)};
+    }
+}
+
+const std::array<double, NUM_QUALITY_VALUES>& PhredErrorTable()
+{
+    static const std::array<double, NUM_QUALITY_VALUES> table = []() {
+        std::array<double, NUM_QUALITY_VALUES> result;
+        for (std::size_t qv = 0; qv < result.size(); ++qv) {
+            result[qv] = std::pow(10.0, -static_cast<double>(qv) / 10.0);
+        }
+        return result;
+    }();
+    return table;
+}
+
+// number of occurrences of each quality value
+using QualityHistogram = std::array<std::uint64_t, NUM_QUALITY_VALUES>;
+
+QualityHistogram CountQualities(const std::span<const QualityValue> quals)
+{
+    // 4 interleaved histograms, to not stall on runs of the same value
+    std::array<std::array<std::uint64_t, 256>, 4> counts{};
+    const auto* data = reinterpret_cast<const std::uint8_t*>(quals.data());
+    std::size_t i = 0;
+    for (; i + 4 <= quals.size(); i += 4) {
+        ++counts[0][data[i]];
+        ++counts[1][data[i + 1]];
+        ++counts[2][data[i + 2]];
+        ++counts[3][data[i + 3]];
+    }
+    for (; i < quals.size(); ++i) {
+        ++counts[0][data[i]];
+    }
+
+    QualityHistogram result;
+    for (std::size_t qv = 0; qv < result.size(); ++qv) {
+        result[qv] = counts[0][qv] + counts[1][qv] + counts[2][qv] + counts[3][qv];
+    }
+    return result;
+}
+
+}  // namespace
 
 QualityValues::QualityValues(std::string fastqString) : std::vector<QualityValue>{}
 {
     boost::algorithm::trim(fastqString);
     resize(fastqString.size());
-    std::transform(std::cbegin(fastqString), std::cend(fastqString), begin(),
-                   QualityValue::FromFastq);
+    Data::FromFastq(fastqString, *this);
 }
 
 QualityValues::QualityValues(std::vector<QualityValue> quals)
@@ -82,10 +156,7 @@ std::string QualityValues::Fastq() const
 {
     std::string result;
     result.resize(size());
-    std::int32_t counter = 0;
-    for (const auto& qv : *this) {
-        result[counter++] = qv.Fastq();
-    }
+    ToFastq(*this, result);
     return result;
 }
 
@@ -104,5 +175,113 @@ std::ostream& operator<<(std::ostream& os, const QualityValues& qualityvalues)
     return os << "QualityValues(Fastq=" << qualityvalues.Fastq() << ')';
 }
 
+void FromFastq(const std::string_view fastq, const std::span<QualityValue> quals)
+{
+    CheckSize(quals.size(), fastq.size());
+
+    // (c - 33) wraps around below '!', then clamps as QualityValue does
+    const simde__m128i offset = simde_mm_set1_epi8(33);
+    const simde__m128i max = simde_mm_set1_epi8(QualityValue::MAX);
+    std::size_t i = 0;
+    for (; i + BLOCK <= fastq.size(); i += BLOCK) {
+        const simde__m128i v = simde_mm_sub_epi8(Load(fastq.data() + i), offset);
+        Store(quals.data() + i, simde_mm_min_epu8(v, max));
+    }
+    for (; i < fastq.size(); ++i) {
+        quals[i] = QualityValue::FromFastq(fastq[i]);
+    }
+}
+
+void ToFastq(const std::span<const QualityValue> quals, const std::span<char> fastq)
+{
+    CheckSize(fastq.size(), quals.size());
+
+    const simde__m128i offset = simde_mm_set1_epi8(33);
+    std::size_t i = 0;
+    for (; i + BLOCK <= quals.size(); i += BLOCK) {
+        Store(fastq.data() + i, simde_mm_add_epi8(Load(quals.data() + i), offset));
+    }
+    for (; i < quals.size(); ++i) {
+        fastq[i] = quals[i].Fastq();
+    }
+}
+
+QualityStats ComputeQualityStats(const std::span<const QualityValue> quals)
+{
+    QualityStats result;
+    if (quals.empty()) {
+        return result;
+    }
+
+    const QualityHistogram counts = CountQualities(quals);
+    const auto& errorTable = PhredErrorTable();
+    std::uint64_t sum = 0;
+    bool foundMin = false;
+    for (std::size_t qv = 0; qv < counts.size(); ++qv) {
+        if (counts[qv] == 0) {
+            continue;
+        }
+        if (!foundMin) {
+            result.Min = static_cast<std::uint8_t>(qv);
+            foundMin = true;
+        }
+        sum += qv * counts[qv];
+        result.ExpectedErrors += counts[qv] * errorTable[qv];
+    }
+    result.Mean = static_cast<double>(sum) / quals.size();
+    return result;
+}
+
+double MeanQuality(const std::span<const QualityValue> quals)
+{
+    if (quals.empty()) {
+        return 0.0;
+    }
+
+    // byte sums of each 8-byte half, accumulated in 64 bits
+    const simde__m128i zero = simde_mm_setzero_si128();
+    simde__m128i sums = zero;
+    std::size_t i = 0;
+    for (; i + BLOCK <= quals.size(); i += BLOCK) {
+        sums = simde_mm_add_epi64(sums, simde_mm_sad_epu8(Load(quals.data() + i), zero));
+    }
+    std::uint64_t sum = static_cast<std::uint64_t>(simde_mm_cvtsi128_si64(sums)) +
+                        static_cast<std::uint64_t>(simde_mm_extract_epi64(sums, 1));
+    for (; i < quals.size(); ++i) {
+        sum += quals[i];
+    }
+    return static_cast<double>(sum) / quals.size();
+}
+
+QualityValue MinQuality(const std::span<const QualityValue> quals)
+{
+    if (quals.empty()) {
+        return {};
+    }
+
+    simde__m128i mins = simde_mm_set1_epi8(static_cast<char>(0xFF));
+    std::size_t i = 0;
+    for (; i + BLOCK <= quals.size(); i += BLOCK) {
+        mins = simde_mm_min_epu8(mins, Load(quals.data() + i));
+    }
+    std::array<std::uint8_t, BLOCK> lanes;
+    Store(lanes.data(), mins);
+    std::uint8_t result = *std::min_element(lanes.cbegin(), lanes.cend());
+    for (; i < quals.size(); ++i) {
+        result = std::min<std::uint8_t>(result, quals[i]);
+    }
+    return result;
+}
+
+double ExpectedErrors(const std::span<const QualityValue> quals)
+{
+    return ComputeQualityStats(quals).ExpectedErrors;
+}
+
+double PhredToErrorProbability(const QualityValue qv) noexcept
+{
+    return PhredErrorTable()[static_cast<std::uint8_t>(qv)];
+}
+
 }  // namespace Data
 }  // namespace PacBio
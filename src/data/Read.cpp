@@ -128,26 +128,7 @@ std::ostream& operator<<(std::ostream& os, const Read& read)
 
 void ClipToQuery(Read& read, Position start, Position end)
 {
-    // skip out if clip not needed
-    if (start <= read.QueryStart && end >= read.QueryEnd) {
-        return;
-    }
-
-    // calculate clipping
-    ClipToQueryConfig clipConfig{read.Seq.size(),
-                                 read.QueryStart,
-                                 read.QueryEnd,
-                                 start,
-                                 end,
-                                 // TODO: these next are unused for unmapped clip-to-query
-                                 UNMAPPED_POSITION,
-                                 Strand::FORWARD,
-                                 {},
-                                 false};
-    auto result = ClipToQuery(clipConfig);
-
-    // apply clipping
-    internal::ClipRead(read, std::move(result), start, end);
+    internal::ClipRead(read, internal::QueryClipSpan(read, start, end));
 }
 
 }  // namespace Data
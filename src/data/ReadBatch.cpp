@@ -0,0 +1,354 @@
+#include <pbcopper/data/ReadBatch.h>
+
+#include "MappedReadImpl.h"
+
+#include <pbcopper/data/Interval.h>
+
+#include <cassert>
+
+namespace PacBio {
+namespace Data {
+
+// ----------
+// ReadView
+// ----------
+
+ReadView::ReadView(const ReadBatch& batch, const std::size_t index) noexcept
+    : batch_{&batch}, index_{index}
+{
+    assert(index_ < batch_->Size());
+}
+
+ReadId ReadView::Id() const
+{
+    const auto& b = *batch_;
+    ReadId id{b.strings_[b.movieNames_[index_]], b.holeNumbers_[index_]};
+    if (b.bits_[index_] & ReadBatch::HAS_ZMW_INTERVAL) {
+        id.ZmwInterval = Interval{b.zmwStarts_[index_], b.zmwEnds_[index_]};
+    }
+    const auto readName = b.readNames_.Get(index_);
+    id.ReadName.assign(readName.begin(), readName.end());
+    return id;
+}
+
+std::string_view ReadView::Seq() const
+{
+    const auto seq = batch_->seqs_.Get(index_);
+    return {seq.data(), seq.size()};
+}
+
+std::span<const QualityValue> ReadView::Qualities() const { return batch_->qualities_.Get(index_); }
+
+std::optional<std::span<const std::uint16_t>> ReadView::PulseWidth() const
+{
+    if (batch_->bits_[index_] & ReadBatch::HAS_PULSE_WIDTH) {
+        return batch_->pulseWidths_.Get(index_);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::span<const std::uint16_t>> ReadView::IPD() const
+{
+    if (batch_->bits_[index_] & ReadBatch::HAS_IPD) {
+        return batch_->ipds_.Get(index_);
+    }
+    return std::nullopt;
+}
+
+Position ReadView::QueryStart() const { return batch_->queryStarts_[index_]; }
+
+Position ReadView::QueryEnd() const { return batch_->queryEnds_[index_]; }
+
+LocalContextFlags ReadView::Flags() const { return batch_->flags_[index_]; }
+
+Accuracy ReadView::ReadAccuracy() const { return batch_->accuracies_[index_]; }
+
+const SNR& ReadView::SignalToNoise() const { return batch_->snrs_[index_]; }
+
+std::string_view ReadView::Model() const { return batch_->strings_[batch_->models_[index_]]; }
+
+bool ReadView::FullLength() const { return batch_->bits_[index_] & ReadBatch::FULL_LENGTH; }
+
+std::int32_t ReadView::Length() const { return Seq().size(); }
+
+Read ReadView::ToRead() const
+{
+    const auto toFrames = [](const std::optional<std::span<const std::uint16_t>>& frames) {
+        return frames ? std::optional<Frames>{Frames(frames->begin(), frames->end())}
+                      : std::nullopt;
+    };
+
+    // NOTE: this constructor derives query start/end & full-length from its
+    //       inputs, so they are restored below
+    Read read{Id(),    std::string{Seq()}, toFrames(PulseWidth()), toFrames(IPD()),
+              Flags(), ReadAccuracy(),     SignalToNoise(),        std::string{Model()}};
+    const auto qualities = Qualities();
+    read.Qualities.assign(qualities.begin(), qualities.end());
+    read.QueryStart = QueryStart();
+    read.QueryEnd = QueryEnd();
+    read.FullLength = FullLength();
+    return read;
+}
+
+// ----------------
+// MappedReadView
+// ----------------
+
+MappedReadView::MappedReadView(const ReadBatch& batch, const std::size_t index) noexcept
+    : ReadView{batch, index}
+{}
+
+std::int32_t MappedReadView::RefId() const { return batch_->refIds_[index_]; }
+
+Strand MappedReadView::Strand() const { return batch_->strands_[index_]; }
+
+Position MappedReadView::TemplateStart() const { return batch_->templateStarts_[index_]; }
+
+Position MappedReadView::TemplateEnd() const { return batch_->templateEnds_[index_]; }
+
+bool MappedReadView::PinStart() const { return batch_->bits_[index_] & ReadBatch::PIN_START; }
+
+bool MappedReadView::PinEnd() const { return batch_->bits_[index_] & ReadBatch::PIN_END; }
+
+CigarView MappedReadView::Cigar() const
+{
+    const auto ops = batch_->cigars_.Get(index_);
+    return {ops.data(), ops.size()};
+}
+
+std::uint8_t MappedReadView::MapQuality() const { return batch_->mapQualities_[index_]; }
+
+Position MappedReadView::AlignedStart() const
+{
+    return internal::AlignedStart(QueryStart(), Length(), Strand(), Cigar());
+}
+
+Position MappedReadView::AlignedEnd() const
+{
+    return internal::AlignedEnd(QueryEnd(), Length(), Strand(), Cigar());
+}
+
+Strand MappedReadView::AlignedStrand() const { return Strand(); }
+
+Position MappedReadView::ReferenceStart() const
+{
+    return internal::ReferenceStart(TemplateStart());
+}
+
+Position MappedReadView::ReferenceEnd() const { return internal::ReferenceEnd(TemplateEnd()); }
+
+std::int32_t MappedReadView::NumMismatches() const { return internal::NumMismatches(Cigar()); }
+
+MappedRead MappedReadView::ToMappedRead() const
+{
+    MappedRead read{ToRead(),      Strand(),          TemplateStart(),
+                    TemplateEnd(), Cigar().ToCigar(), MapQuality()};
+    read.RefId = RefId();
+    read.PinStart = PinStart();
+    read.PinEnd = PinEnd();
+    return read;
+}
+
+// -----------
+// ReadBatch
+// -----------
+
+ReadBatch::ReadBatch(const std::vector<Read>& reads)
+{
+    std::size_t numBases = 0;
+    for (const auto& read : reads) {
+        numBases += read.Seq.size();
+    }
+    Reserve(reads.size(), numBases);
+    for (const auto& read : reads) {
+        Add(read);
+    }
+}
+
+ReadBatch::ReadBatch(const std::vector<MappedRead>& reads)
+{
+    std::size_t numBases = 0;
+    for (const auto& read : reads) {
+        numBases += read.Seq.size();
+    }
+    Reserve(reads.size(), numBases);
+    for (const auto& read : reads) {
+        Add(read);
+    }
+}
+
+void ReadBatch::Add(const Read& read)
+{
+    AddRead(read, 0);
+
+    refIds_.push_back(0);
+    strands_.push_back(Strand::UNMAPPED);
+    templateStarts_.push_back(UNMAPPED_POSITION);
+    templateEnds_.push_back(UNMAPPED_POSITION);
+    mapQualities_.push_back(0);
+    cigars_.Offsets.push_back(cigars_.Data.size());
+}
+
+void ReadBatch::Add(const MappedRead& read)
+{
+    AddRead(read, (read.PinStart ? PIN_START : 0) | (read.PinEnd ? PIN_END : 0));
+
+    refIds_.push_back(read.RefId);
+    strands_.push_back(read.Strand);
+    templateStarts_.push_back(read.TemplateStart);
+    templateEnds_.push_back(read.TemplateEnd);
+    mapQualities_.push_back(read.MapQuality);
+    cigars_.Add(read.Cigar.cbegin(), read.Cigar.cend());
+}
+
+void ReadBatch::AddRead(const Read& read, std::uint8_t bits)
+{
+    seqs_.Add(read.Seq.cbegin(), read.Seq.cend());
+    qualities_.Add(read.Qualities.cbegin(), read.Qualities.cend());
+    if (read.PulseWidth) {
+        pulseWidths_.Add(read.PulseWidth->cbegin(), read.PulseWidth->cend());
+        bits |= HAS_PULSE_WIDTH;
+    } else {
+        pulseWidths_.Offsets.push_back(pulseWidths_.Data.size());
+    }
+    if (read.IPD) {
+        ipds_.Add(read.IPD->cbegin(), read.IPD->cend());
+        bits |= HAS_IPD;
+    } else {
+        ipds_.Offsets.push_back(ipds_.Data.size());
+    }
+
+    movieNames_.push_back(Intern(read.Id.MovieName, movieNames_));
+    holeNumbers_.push_back(read.Id.HoleNumber);
+    if (read.Id.ZmwInterval) {
+        zmwStarts_.push_back(read.Id.ZmwInterval->Start());
+        zmwEnds_.push_back(read.Id.ZmwInterval->End());
+        bits |= HAS_ZMW_INTERVAL;
+    } else {
+        zmwStarts_.push_back(UNMAPPED_POSITION);
+        zmwEnds_.push_back(UNMAPPED_POSITION);
+    }
+    readNames_.Add(read.Id.ReadName.cbegin(), read.Id.ReadName.cend());
+
+    queryStarts_.push_back(read.QueryStart);
+    queryEnds_.push_back(read.QueryEnd);
+    flags_.push_back(read.Flags);
+    accuracies_.push_back(read.ReadAccuracy);
+    snrs_.push_back(read.SignalToNoise);
+    models_.push_back(Intern(read.Model, models_));
+    if (read.FullLength) {
+        bits |= FULL_LENGTH;
+    }
+    bits_.push_back(bits);
+}
+
+std::uint32_t ReadBatch::Intern(const std::string& s, const std::vector<std::uint32_t>& column)
+{
+    // most reads share the previous read's movie name or model
+    if (!column.empty() && strings_[column.back()] == s) {
+        return column.back();
+    }
+    const auto [it, added] = stringIndex_.try_emplace(s, strings_.size());
+    if (added) {
+        strings_.push_back(s);
+    }
+    return it->second;
+}
+
+void ReadBatch::Reserve(const std::size_t numReads, const std::size_t numBases)
+{
+    seqs_.Data.reserve(numBases);
+    qualities_.Data.reserve(numBases);
+    pulseWidths_.Data.reserve(numBases);
+    ipds_.Data.reserve(numBases);
+    for (auto* offsets : {&seqs_.Offsets, &qualities_.Offsets, &pulseWidths_.Offsets,
+                          &ipds_.Offsets, &readNames_.Offsets, &cigars_.Offsets}) {
+        offsets->reserve(numReads + 1);
+    }
+
+    bits_.reserve(numReads);
+    movieNames_.reserve(numReads);
+    holeNumbers_.reserve(numReads);
+    zmwStarts_.reserve(numReads);
+    zmwEnds_.reserve(numReads);
+    queryStarts_.reserve(numReads);
+    queryEnds_.reserve(numReads);
+    flags_.reserve(numReads);
+    accuracies_.reserve(numReads);
+    snrs_.reserve(numReads);
+    models_.reserve(numReads);
+
+    refIds_.reserve(numReads);
+    strands_.reserve(numReads);
+    templateStarts_.reserve(numReads);
+    templateEnds_.reserve(numReads);
+    mapQualities_.reserve(numReads);
+}
+
+void ReadBatch::Clear()
+{
+    seqs_.Clear();
+    qualities_.Clear();
+    pulseWidths_.Clear();
+    ipds_.Clear();
+
+    bits_.clear();
+    movieNames_.clear();
+    holeNumbers_.clear();
+    zmwStarts_.clear();
+    zmwEnds_.clear();
+    readNames_.Clear();
+    queryStarts_.clear();
+    queryEnds_.clear();
+    flags_.clear();
+    accuracies_.clear();
+    snrs_.clear();
+    models_.clear();
+
+    refIds_.clear();
+    strands_.clear();
+    templateStarts_.clear();
+    templateEnds_.clear();
+    mapQualities_.clear();
+    cigars_.Clear();
+
+    strings_.clear();
+    stringIndex_.clear();
+}
+
+std::size_t ReadBatch::Size() const { return bits_.size(); }
+
+bool ReadBatch::Empty() const { return bits_.empty(); }
+
+std::size_t ReadBatch::NumBases() const { return seqs_.Data.size(); }
+
+ReadView ReadBatch::operator[](const std::size_t i) const { return ReadView{*this, i}; }
+
+MappedReadView ReadBatch::Mapped(const std::size_t i) const { return MappedReadView{*this, i}; }
+
+Read ReadBatch::ToRead(const std::size_t i) const { return (*this)[i].ToRead(); }
+
+MappedRead ReadBatch::ToMappedRead(const std::size_t i) const { return Mapped(i).ToMappedRead(); }
+
+std::vector<Read> ReadBatch::ToReads() const
+{
+    std::vector<Read> result;
+    result.reserve(Size());
+    for (std::size_t i = 0; i < Size(); ++i) {
+        result.push_back(ToRead(i));
+    }
+    return result;
+}
+
+std::vector<MappedRead> ReadBatch::ToMappedReads() const
+{
+    std::vector<MappedRead> result;
+    result.reserve(Size());
+    for (std::size_t i = 0; i < Size(); ++i) {
+        result.push_back(ToMappedRead(i));
+    }
+    return result;
+}
+
+}  // namespace Data
+}  // namespace PacBio
@@ -0,0 +1,189 @@
+#include <pbcopper/poa/BatchConsensus.h>
+
+#include <pbcopper/parallel/FireAndForget.h>
+#include <pbcopper/parallel/ThreadCount.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace Poa {
+namespace {
+
+// index of the read whose length is the (lower) median
+std::size_t DraftRead(const std::vector<std::string>& reads)
+{
+    std::vector<std::size_t> order(reads.size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto median = order.begin() + (order.size() - 1) / 2;
+    std::nth_element(order.begin(), median, order.end(), [&](std::size_t a, std::size_t b) {
+        return std::make_pair(reads[a].size(), a) < std::make_pair(reads[b].size(), b);
+    });
+    return *median;
+}
+
+}  // namespace
+
+struct BatchConsensus::Workspace
+{
+    PoaGraph Graph;
+    std::vector<std::unique_ptr<PoaAlignmentMatrix>> Matrices;
+};
+
+BatchConsensus::BatchConsensus(BatchConsensusOptions options)
+    : options_{std::move(options)}
+    , numThreads_{Parallel::NormalizedThreadCount(options_.NumThreads)}
+{
+    if (options_.DraftRoundSize == 0) {
+        throw std::invalid_argument{"[pbcopper] poa ERROR: DraftRoundSize must be positive"};
+    }
+    for (unsigned int i = 0; i < numThreads_; ++i) {
+        workspaces_.push_back(std::make_unique<Workspace>());
+    }
+}
+
+BatchConsensus::~BatchConsensus() = default;
+
+const BatchConsensusOptions& BatchConsensus::Options() const { return options_; }
+
+void BatchConsensus::Run(const std::vector<std::vector<std::string>>& groups,
+                         const ResultCallback& callback)
+{
+    const std::size_t numGroups = groups.size();
+    const Align::AlignConfig& config = options_.Config;
+
+    std::mutex m;
+    std::condition_variable done;
+    std::vector<std::unique_ptr<const PoaConsensus>> results(numGroups);
+    std::vector<bool> ready(numGroups, false);
+    std::exception_ptr exc;
+    std::atomic_bool stop{false};
+    std::atomic<std::size_t> nextGroup{0};
+
+    const unsigned int numWorkers =
+        static_cast<unsigned int>(std::min<std::size_t>(numThreads_, numGroups));
+
+    // pool threads without a group of their own help with rounds of drafted
+    // groups; the drafting worker waits for its round, so this only pays off
+    // once two or more of them are idle
+    Parallel::FireAndForget pool{numThreads_};
+    std::atomic<unsigned int> numIdle{numThreads_ - numWorkers};
+
+    const auto consensus = [&](const std::vector<std::string>& reads, Workspace& ws) {
+        for (const std::string& read : reads) {
+            if (read.empty()) {
+                throw std::invalid_argument("input sequences must have nonzero length.");
+            }
+        }
+
+        PoaGraph& graph = ws.Graph;
+        graph.Clear();
+        if (options_.DraftMinReads == 0 || reads.size() < options_.DraftMinReads) {
+            for (const std::string& read : reads) {
+                graph.AddRead(read, config);
+            }
+        } else {
+            const std::size_t draft = DraftRead(reads);
+            graph.AddFirstRead(reads[draft]);
+
+            std::vector<std::size_t> rest;
+            for (std::size_t i = 0; i < reads.size(); ++i) {
+                if (i != draft) {
+                    rest.push_back(i);
+                }
+            }
+            for (std::size_t begin = 0; begin < rest.size(); begin += options_.DraftRoundSize) {
+                const std::size_t n = std::min(options_.DraftRoundSize, rest.size() - begin);
+                ws.Matrices.resize(n);
+                Parallel::Dispatch(
+                    (numIdle >= 2 ? &pool : nullptr), static_cast<std::int32_t>(n),
+                    [&](const std::int32_t k) {
+                        ws.Matrices[k].reset(graph.TryAddRead(reads[rest[begin + k]], config));
+                    });
+                // the graph only grows, so alignments to it remain valid paths
+                for (std::size_t k = 0; k < n; ++k) {
+                    graph.CommitAdd(ws.Matrices[k].get());
+                    ws.Matrices[k].reset();
+                }
+            }
+        }
+        return std::unique_ptr<const PoaConsensus>{
+            graph.FindConsensus(config, options_.MinCoverage)};
+    };
+
+    const auto worker = [&](Workspace& ws) {
+        while (!stop) {
+            const std::size_t i = nextGroup++;
+            if (i >= numGroups) {
+                break;
+            }
+            try {
+                auto result = consensus(groups[i], ws);
+                {
+                    std::lock_guard<std::mutex> lk(m);
+                    results[i] = std::move(result);
+                    ready[i] = true;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lk(m);
+                if (!exc) {
+                    exc = std::current_exception();
+                }
+                stop = true;
+            }
+            done.notify_one();
+        }
+        ++numIdle;
+    };
+
+    for (unsigned int t = 0; t < numWorkers; ++t) {
+        pool.ProduceWith(worker, std::ref(*workspaces_[t]));
+    }
+
+    // hand back results in input order
+    try {
+        for (std::size_t i = 0; i < numGroups; ++i) {
+            std::unique_ptr<const PoaConsensus> result;
+            {
+                std::unique_lock<std::mutex> lk(m);
+                done.wait(lk, [&]() { return ready[i] || stop; });
+                if (!ready[i]) {
+                    break;
+                }
+                result = std::move(results[i]);
+            }
+            callback(i, std::move(result));
+        }
+    } catch (...) {
+        stop = true;
+        pool.Finalize();
+        throw;
+    }
+    pool.Finalize();
+
+    if (exc) {
+        std::rethrow_exception(exc);
+    }
+}
+
+std::vector<std::unique_ptr<const PoaConsensus>> BatchConsensus::FindConsensus(
+    const std::vector<std::vector<std::string>>& groups)
+{
+    std::vector<std::unique_ptr<const PoaConsensus>> result(groups.size());
+    Run(groups, [&result](const std::size_t i, std::unique_ptr<const PoaConsensus> consensus) {
+        result[i] = std::move(consensus);
+    });
+    return result;
+}
+
+}  // namespace Poa
+}  // namespace PacBio
@@ -5,10 +5,12 @@
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <cfloat>
 #include <cstddef>
 
 namespace PacBio {
@@ -72,7 +74,7 @@ void PoaAlignmentMatrixImpl::Print() const
             if (col.HasRow(j)) {
                 float score = col.Score[j];
                 std::string scoreFmt = score == -FLT_MAX ? "-inf" : std::to_string(int(score));
-                std::string cellFmt = scoreFmt + moveCode.at(col.ReachingMove[j]);
+                std::string cellFmt = scoreFmt + moveCode.at(col.Move(j));
                 outputRows[j] << std::setw(COL_WIDTH) << std::right << cellFmt;
             } else {
                 outputRows[j] << std::setw(COL_WIDTH) << std::right << "";
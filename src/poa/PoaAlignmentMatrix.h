@@ -8,15 +8,21 @@
 #include <pbcopper/PbcopperConfig.h>
 
 #include <pbcopper/poa/PoaGraph.h>
-#include "BoostGraph.h"
+#include "PoaArena.h"
+#include "PoaDag.h"
 #include "VectorL.h"
 
 #include <boost/utility.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <vector>
 
+#include <cassert>
 #include <cfloat>
 #include <cstddef>
+#include <cstdint>
 
 namespace PacBio {
 namespace Poa {
@@ -34,43 +40,65 @@ enum MoveType
     ExtraMove
 };
 
+//
+// One column of the read-vs-graph DP matrix. The traceback is stored
+// compactly: a byte per row for the reaching move and, for moves from
+// another column, that column's index in Predecessors.
+//
+// Columns and their rows are allocated in the matrix's PoaArena.
+//
 class AlignmentColumn : boost::noncopyable
 {
 public:
+    // most Predecessors a column can refer to
+    static constexpr std::size_t MaxPredecessors = std::numeric_limits<std::uint16_t>::max();
+
     VD CurrentVertex;
     VectorL<float> Score;
-    VectorL<MoveType> ReachingMove;
-    VectorL<VD> PreviousVertex;
+    VectorL<std::uint8_t> ReachingMove;
+    VectorL<std::uint16_t> PreviousIndex;
+    VD* Predecessors;  // to be filled in by the caller
+    std::size_t NumPredecessors;
 
-    explicit AlignmentColumn(VD vertex, int beginRow, int endRow)
+    explicit AlignmentColumn(PoaArena* arena, VD vertex, int beginRow, int endRow,
+                             std::size_t numPredecessors)
         : CurrentVertex(vertex)
-        , Score(beginRow, endRow, -FLT_MAX)
-        , ReachingMove(beginRow, endRow, InvalidMove)
-        , PreviousVertex(beginRow, endRow, null_vertex)
+        , Score(arena, beginRow, endRow, -FLT_MAX)
+        , ReachingMove(arena, beginRow, endRow, InvalidMove)
+        , PreviousIndex(arena, beginRow, endRow, 0)
+        , Predecessors(arena->Allocate<VD>(numPredecessors))
+        , NumPredecessors(numPredecessors)
     {}
 
-    AlignmentColumn(AlignmentColumn&& other) noexcept
-        : CurrentVertex(std::move(other.CurrentVertex))
-        , Score(std::move(other.Score))
-        , ReachingMove(std::move(other.ReachingMove))
-        , PreviousVertex(std::move(other.PreviousVertex))
-    {}
+    std::size_t BeginRow() const { return Score.BeginRow(); }
+    std::size_t EndRow() const { return Score.EndRow(); }
+    bool HasRow(std::size_t i) const { return (BeginRow() <= i) && (i < EndRow()); }
+
+    MoveType Move(std::size_t i) const { return static_cast<MoveType>(ReachingMove[i]); }
 
-    AlignmentColumn& operator=(AlignmentColumn&& other) noexcept
+    VD PreviousVertex(std::size_t i) const
     {
-        CurrentVertex = std::move(other.CurrentVertex);
-        Score = std::move(other.Score);
-        ReachingMove = std::move(other.ReachingMove);
-        PreviousVertex = std::move(other.PreviousVertex);
-        return *this;
+        switch (Move(i)) {
+            case InvalidMove:
+                return null_vertex;
+            case ExtraMove:
+                return CurrentVertex;
+            default:
+                assert(PreviousIndex[i] < NumPredecessors);
+                return Predecessors[PreviousIndex[i]];
+        }
     }
 
-    std::size_t BeginRow() const { return Score.BeginRow(); }
-    std::size_t EndRow() const { return Score.EndRow(); }
-    bool HasRow(std::size_t i) const { return (BeginRow() <= i) && (i < EndRow()); }
+    void SetTraceback(std::size_t i, MoveType move, std::size_t previousIndex)
+    {
+        assert(previousIndex <= MaxPredecessors);
+        ReachingMove[i] = static_cast<std::uint8_t>(move);
+        PreviousIndex[i] = static_cast<std::uint16_t>(previousIndex);
+    }
 };
 
-using AlignmentColumnMap = std::unordered_map<VD, std::unique_ptr<const AlignmentColumn>>;
+// Alignment columns, indexed by vertex; null for vertices without a column
+using AlignmentColumnMap = std::vector<const AlignmentColumn*>;
 
 class PoaAlignmentMatrixImpl : public PoaAlignmentMatrix
 {
@@ -79,12 +107,17 @@ public:
 
     virtual float Score() const { return score_; }
     std::size_t NumRows() const { return readSequence_.length() + 1; }
-    std::size_t NumCols() const { return columns_.size(); }
+    std::size_t NumCols() const
+    {
+        return std::count_if(columns_.cbegin(), columns_.cend(),
+                             [](const auto& col) { return col != nullptr; });
+    }
     void Print() const;
 
     // TODO: why did I leave these public?  why is there no
     // constructor?
     const PoaGraphImpl* graph_;
+    PoaArena arena_;  // owns the columns
     AlignmentColumnMap columns_;
     std::string readSequence_;
     Align::AlignMode mode_;
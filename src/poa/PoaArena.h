@@ -0,0 +1,114 @@
+#ifndef PBCOPPER_POA_POAARENA_H
+#define PBCOPPER_POA_POAARENA_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <boost/utility.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+namespace PacBio {
+namespace Poa {
+namespace detail {
+
+///
+/// \brief The PoaArena class is a bump allocator for the columns of one
+///        alignment matrix.
+///
+/// Storage is carved out of a few large blocks, each at least twice the size
+/// of the one before, and is only released when the arena is destroyed.
+/// Reset rewinds the arena so that its blocks are reused.
+///
+/// Only trivially destructible objects may live in an arena, as their
+/// destructors are never run.
+///
+class PoaArena : boost::noncopyable
+{
+public:
+    explicit PoaArena(std::size_t firstBlockBytes = 64 * 1024) : nextBlockBytes_{firstBlockBytes} {}
+
+    ///
+    /// \return uninitialized storage for 'n' objects of type T
+    ///
+    template <typename T>
+    T* Allocate(std::size_t n)
+    {
+        static_assert(std::is_trivially_destructible_v<T>);
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    template <typename T, typename... Args>
+    T* Create(Args&&... args)
+    {
+        return new (Allocate<T>(1)) T(std::forward<Args>(args)...);
+    }
+
+    ///
+    /// Makes the next block allocated hold at least 'bytes'.
+    ///
+    void Reserve(std::size_t bytes) { nextBlockBytes_ = std::max(nextBlockBytes_, bytes); }
+
+    ///
+    /// Makes all storage available again. Objects allocated before are
+    /// invalidated.
+    ///
+    void Reset()
+    {
+        current_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t NumBlocks() const { return blocks_.size(); }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> Data;
+        std::size_t Size;
+    };
+
+    void* allocate(const std::size_t bytes, const std::size_t align)
+    {
+        if (current_ < blocks_.size()) {
+            const std::size_t offset = (used_ + align - 1) & ~(align - 1);
+            if (offset + bytes <= blocks_[current_].Size) {
+                used_ = offset + bytes;
+                return blocks_[current_].Data.get() + offset;
+            }
+            ++current_;
+        }
+
+        // move on to the next block large enough, or add one
+        while (current_ < blocks_.size() && blocks_[current_].Size < bytes) {
+            ++current_;
+        }
+        if (current_ == blocks_.size()) {
+            const std::size_t size = std::max(bytes, nextBlockBytes_);
+            // NB: not value-initialized
+            blocks_.push_back(Block{std::unique_ptr<std::byte[]>{new std::byte[size]}, size});
+            nextBlockBytes_ = 2 * size;
+        }
+        used_ = bytes;
+        return blocks_[current_].Data.get();
+    }
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;  // block being filled
+    std::size_t used_ = 0;     // bytes used in it
+    std::size_t nextBlockBytes_;
+};
+
+}  // namespace detail
+}  // namespace Poa
+}  // namespace PacBio
+
+#endif  // PBCOPPER_POA_POAARENA_H
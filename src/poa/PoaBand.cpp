@@ -0,0 +1,110 @@
+#include "PoaBand.h"
+
+#include <algorithm>
+
+#include <cassert>
+#include <cstdint>
+
+namespace PacBio {
+namespace Poa {
+namespace detail {
+
+PoaBand::PoaBand(const PoaDag& g, const VD exitVertex, const int readLength,
+                 const Align::AlignConfig& config)
+    : g_{g}
+    , exitVertex_{exitVertex}
+    , readLength_{readLength}
+    , width_{config.Band.Width + static_cast<int>(config.Band.WidthFraction * readLength)}
+    , global_{config.Mode == Align::AlignMode::GLOBAL}
+    , bestRow_(g.NumSlots(), 0)
+{
+    assert(config.Band.IsEnabled());
+    if (!global_) {
+        return;
+    }
+
+    // expected read position: proportional to the longest path from ^
+    std::vector<int> depth(g.NumSlots(), 0);
+    for (const VD v : g.TopologicalOrder()) {
+        for (const VD u : g.InVertices(v)) {
+            depth[v] = std::max(depth[v], depth[u] + 1);
+        }
+    }
+    const std::int64_t totalDepth = std::max(depth[exitVertex_], 1);
+    expectedRow_.resize(g.NumSlots());
+    for (const VD v : g.TopologicalOrder()) {
+        expectedRow_[v] = static_cast<int>(std::int64_t{depth[v]} * readLength_ / totalDepth);
+    }
+}
+
+std::pair<int, int> PoaBand::Rows(
+    const VD v, const std::vector<const AlignmentColumn*>& predecessorColumns) const
+{
+    if (predecessorColumns.empty()) {
+        return {0, std::min(width_, readLength_) + 1};
+    }
+
+    // centre on the predecessors' best rows, widening a side where one of
+    // them peaked near its own band edge
+    const int margin = std::max(1, width_ / 4);
+    int begin = readLength_;
+    int end = 0;
+    bool widenBegin = false;
+    bool widenEnd = false;
+    for (const AlignmentColumn* col : predecessorColumns) {
+        const int best = bestRow_[col->CurrentVertex];
+        const int colBegin = col->BeginRow();
+        const int colEnd = col->EndRow();
+        begin = std::min(begin, best + 1);
+        end = std::max(end, best + 1);
+        widenBegin |= (colBegin > 0 && best - colBegin < margin);
+        widenEnd |= (colEnd <= readLength_ && colEnd - 1 - best < margin);
+    }
+    begin -= (widenBegin ? 2 : 1) * width_;
+    end += (widenEnd ? 2 : 1) * width_;
+
+    if (global_) {
+        begin = std::min(begin, expectedRow_[v] - width_);
+        end = std::max(end, expectedRow_[v] + width_);
+        const auto& successors = g_.OutVertices(v);
+        if (std::binary_search(successors.cbegin(), successors.cend(), exitVertex_)) {
+            end = readLength_;
+        }
+    }
+
+    // start at a row reached from some predecessor: one whose rows include
+    // 'begin' or 'begin - 1', or else the nearest such row below
+    int lowestRow = readLength_;
+    for (const AlignmentColumn* col : predecessorColumns) {
+        lowestRow = std::min(lowestRow, static_cast<int>(col->BeginRow()));
+    }
+    begin = std::clamp(begin, lowestRow, readLength_);
+    bool reachable = false;
+    int below = lowestRow;
+    for (const AlignmentColumn* col : predecessorColumns) {
+        const int colBegin = col->BeginRow();
+        const int colEnd = col->EndRow();
+        if (colBegin <= begin && begin <= colEnd) {
+            reachable = true;
+            break;
+        }
+        if (colEnd < begin) {
+            below = std::max(below, colEnd);
+        }
+    }
+    if (!reachable) {
+        begin = below;
+    }
+
+    end = std::clamp(end, begin, readLength_);
+    return {begin, end + 1};
+}
+
+void PoaBand::Update(const AlignmentColumn& col)
+{
+    bestRow_[col.CurrentVertex] = static_cast<int>(ArgMax(col.Score));
+}
+
+}  // namespace detail
+}  // namespace Poa
+}  // namespace PacBio
@@ -0,0 +1,62 @@
+#ifndef PBCOPPER_POA_POABAND_H
+#define PBCOPPER_POA_POABAND_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/align/AlignConfig.h>
+#include "PoaAlignmentMatrix.h"
+#include "PoaDag.h"
+
+#include <utility>
+#include <vector>
+
+namespace PacBio {
+namespace Poa {
+namespace detail {
+
+///
+/// \brief The PoaBand class picks the rows of each alignment column for one
+///        read, following Align::AlignBand.
+///
+/// Columns are visited in topological order; each one's band is centred on
+/// the rows where its predecessors scored best (abPOA-style), so the band
+/// follows the alignment through the graph without a range finder. Under
+/// global alignment it also covers the read position expected from the
+/// vertex's depth in the graph, and reaches the end of the read at the
+/// predecessors of $.
+///
+/// Bands always start at a row some predecessor reaches, so under global
+/// alignment every cell has a valid reaching move.
+///
+class PoaBand
+{
+public:
+    PoaBand(const PoaDag& g, VD exitVertex, int readLength, const Align::AlignConfig& config);
+
+    ///
+    /// \return rows [begin, end) to align against 'v', whose predecessors'
+    ///         columns have been recorded with Update
+    ///
+    std::pair<int, int> Rows(VD v,
+                             const std::vector<const AlignmentColumn*>& predecessorColumns) const;
+
+    ///
+    /// Records where a finished column scored best.
+    ///
+    void Update(const AlignmentColumn& col);
+
+private:
+    const PoaDag& g_;
+    VD exitVertex_;
+    int readLength_;
+    int width_;
+    bool global_;
+    std::vector<int> bestRow_;
+    std::vector<int> expectedRow_;
+};
+
+}  // namespace detail
+}  // namespace Poa
+}  // namespace PacBio
+
+#endif  // PBCOPPER_POA_POABAND_H
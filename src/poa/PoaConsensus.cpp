@@ -15,7 +15,7 @@ namespace Poa {
 Align::AlignConfig DefaultPoaConfig(Align::AlignMode mode)
 {
     Align::AlignParams params{3, -5, -4, -4};
-    Align::AlignConfig config{params, mode};
+    Align::AlignConfig config{params, mode, Align::AlignKernel::SIMD};
     return config;
 }
 
@@ -0,0 +1,264 @@
+#ifndef PBCOPPER_POA_POADAG_H
+#define PBCOPPER_POA_POADAG_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include <pbcopper/poa/PoaGraph.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+namespace PacBio {
+namespace Poa {
+namespace detail {
+
+// Internal vertex descriptor: the vertex's slot in the PoaDag. Slots are
+// handed out in creation order and never reused, so a descriptor doubles as
+// the external PoaGraph::Vertex id and as a stable ordering key.
+using VD = std::size_t;
+constexpr VD null_vertex = std::numeric_limits<VD>::max();
+
+class PoaNode
+{
+public:
+    PoaGraph::Vertex Id;
+    char Base;
+    int Reads;
+    // move the below out of here?
+    int SpanningReads;
+    // scratch space for consensusPath, which runs on const graphs
+    mutable float Score;
+    mutable float ReachingScore;
+
+    PoaNode() : PoaNode(0, 'N', 0, 0) {}
+    explicit PoaNode(std::size_t id, char base) : PoaNode(id, base, 1, 0) {}
+    explicit PoaNode(std::size_t id, char base, int reads) : PoaNode(id, base, reads, 0) {}
+    explicit PoaNode(std::size_t id, char base, int reads, int spanning)
+        : Id{id}, Base{base}, Reads{reads}, SpanningReads{spanning}, Score{0}, ReachingScore{0}
+    {}
+};
+
+///
+/// \brief The PoaDag class is the contiguous directed acyclic graph backing
+///        PoaGraphImpl.
+///
+/// Vertices live in a single array indexed by VD; each keeps its in- and
+/// out-neighbors in small arrays sorted by VD, so iteration order is
+/// deterministic (unlike BGL's pointer-ordered edge sets) and predecessor
+/// lookups are array sweeps. Edges are unique, as with a set-based edge list,
+/// and are also recorded in insertion order for output.
+///
+/// A topological order of the live vertices is maintained incrementally:
+/// each new vertex is placed immediately before a given successor, which is
+/// how reads are threaded into the graph, and the pending placements are
+/// spliced into the order in a single linear pass by UpdateTopologicalOrder.
+///
+class PoaDag
+{
+public:
+    ///
+    /// Adds a vertex, to be placed immediately before 'successor' in the
+    /// topological order, which must be updated before it is next used.
+    ///
+    VD AddVertex(const PoaNode& node, const VD successor)
+    {
+        const VD v = nodes_.size();
+        nodes_.push_back(node);
+        live_.push_back(true);
+        // neighbor lists left over from Clear are empty, and are reused
+        if (in_.size() == v) {
+            in_.emplace_back();
+            out_.emplace_back();
+        }
+        assert(in_[v].empty() && out_[v].empty());
+        ++numLive_;
+
+        firstPending_.push_back(null_vertex);
+        lastPending_.push_back(null_vertex);
+        nextPending_.push_back(null_vertex);
+        if (successor == null_vertex) {
+            order_.push_back(v);
+        } else {
+            // children of 'successor' are emitted in creation order, so the
+            // newest sits immediately before it
+            assert(successor < v);
+            if (firstPending_[successor] == null_vertex) {
+                firstPending_[successor] = v;
+            } else {
+                nextPending_[lastPending_[successor]] = v;
+            }
+            lastPending_[successor] = v;
+            hasPending_ = true;
+        }
+        return v;
+    }
+
+    ///
+    /// Adds edge u -> v, unless already present.
+    ///
+    /// \return true if the edge was added
+    ///
+    bool AddEdge(const VD u, const VD v)
+    {
+        assert(IsLive(u) && IsLive(v));
+        auto& out = out_[u];
+        const auto it = std::lower_bound(out.begin(), out.end(), v);
+        if (it != out.end() && *it == v) {
+            return false;
+        }
+        out.insert(it, v);
+        auto& in = in_[v];
+        in.insert(std::lower_bound(in.begin(), in.end(), u), u);
+        edges_.emplace_back(u, v);
+        return true;
+    }
+
+    ///
+    /// Removes 'v' and its edges. Its slot is not reused.
+    ///
+    void RemoveVertex(const VD v)
+    {
+        assert(IsLive(v));
+        for (const VD u : in_[v]) {
+            auto& out = out_[u];
+            out.erase(std::lower_bound(out.begin(), out.end(), v));
+        }
+        for (const VD w : out_[v]) {
+            auto& in = in_[w];
+            in.erase(std::lower_bound(in.begin(), in.end(), v));
+        }
+        in_[v] = std::vector<VD>{};
+        out_[v] = std::vector<VD>{};
+        live_[v] = false;
+        --numLive_;
+        hasRemoved_ = true;
+    }
+
+    ///
+    /// Removes all vertices and edges, keeping allocated storage for reuse.
+    ///
+    void Clear()
+    {
+        for (VD v = 0; v < nodes_.size(); ++v) {
+            in_[v].clear();
+            out_[v].clear();
+        }
+        nodes_.clear();
+        live_.clear();
+        edges_.clear();
+        numLive_ = 0;
+        order_.clear();
+        firstPending_.clear();
+        lastPending_.clear();
+        nextPending_.clear();
+        hasPending_ = false;
+        hasRemoved_ = false;
+    }
+
+    ///
+    /// Splices vertices added since the last call into the topological
+    /// order, and drops removed vertices from it, in O(V).
+    ///
+    void UpdateTopologicalOrder()
+    {
+        if (!hasPending_ && !hasRemoved_) {
+            return;
+        }
+
+        std::vector<VD> order;
+        order.reserve(numLive_);
+        std::vector<VD> stack;
+        for (const VD root : order_) {
+            // emit each pending subtree (post-order), then the vertex itself
+            stack.push_back(root);
+            while (!stack.empty()) {
+                const VD v = stack.back();
+                if (firstPending_[v] != null_vertex) {
+                    // descend into the next child, detaching it from 'v'
+                    const VD child = firstPending_[v];
+                    firstPending_[v] = nextPending_[child];
+                    stack.push_back(child);
+                } else {
+                    stack.pop_back();
+                    lastPending_[v] = null_vertex;
+                    nextPending_[v] = null_vertex;
+                    if (live_[v]) {
+                        order.push_back(v);
+                    }
+                }
+            }
+        }
+        order_.swap(order);
+        hasPending_ = false;
+        hasRemoved_ = false;
+        assert(order_.size() == numLive_);
+    }
+
+    ///
+    /// \return live vertices in topological order
+    ///
+    const std::vector<VD>& TopologicalOrder() const
+    {
+        assert(!hasPending_ && !hasRemoved_);
+        return order_;
+    }
+
+    ///
+    /// \return edges between live vertices, in insertion order
+    ///
+    std::vector<std::pair<VD, VD>> Edges() const
+    {
+        std::vector<std::pair<VD, VD>> result;
+        result.reserve(edges_.size());
+        for (const auto& e : edges_) {
+            if (live_[e.first] && live_[e.second]) {
+                result.push_back(e);
+            }
+        }
+        return result;
+    }
+
+    const std::vector<VD>& InVertices(const VD v) const { return in_[v]; }
+    const std::vector<VD>& OutVertices(const VD v) const { return out_[v]; }
+    std::size_t InDegree(const VD v) const { return in_[v].size(); }
+    std::size_t OutDegree(const VD v) const { return out_[v].size(); }
+
+    PoaNode& Node(const VD v) { return nodes_[v]; }
+    const PoaNode& Node(const VD v) const { return nodes_[v]; }
+
+    bool IsLive(const VD v) const { return v < live_.size() && live_[v]; }
+
+    // number of live vertices
+    std::size_t NumVertices() const { return numLive_; }
+
+    // number of vertex slots ever allocated, VDs are in [0, NumSlots())
+    std::size_t NumSlots() const { return nodes_.size(); }
+
+private:
+    std::vector<PoaNode> nodes_;
+    std::vector<bool> live_;
+    std::vector<std::vector<VD>> in_;
+    std::vector<std::vector<VD>> out_;
+    std::vector<std::pair<VD, VD>> edges_;
+    std::size_t numLive_ = 0;
+
+    std::vector<VD> order_;
+    // vertices awaiting placement, as a tree of "immediately before" links:
+    // children of each vertex, in creation order
+    std::vector<VD> firstPending_;
+    std::vector<VD> lastPending_;
+    std::vector<VD> nextPending_;
+    bool hasPending_ = false;
+    bool hasRemoved_ = false;
+};
+
+}  // namespace detail
+}  // namespace Poa
+}  // namespace PacBio
+
+#endif  // PBCOPPER_POA_POADAG_H
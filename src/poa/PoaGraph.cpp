@@ -37,6 +37,18 @@ void PoaGraph::CommitAdd(PoaAlignmentMatrix* mat, std::vector<Vertex>* readPathO
 
 void PoaGraph::PruneGraph(const int minCoverage) { impl_->PruneGraph(minCoverage); }
 
+void PoaGraph::Clear() { impl_->Clear(); }
+
+void PoaGraph::EnableReadPointers() { impl_->EnableReadPointers(); }
+
+bool PoaGraph::HasReadPointers() const { return impl_->HasReadPointers(); }
+
+std::vector<PoaGraph::ReadPointer> PoaGraph::ReadPointersAlong(
+    const std::vector<Vertex>& path) const
+{
+    return impl_->ReadPointersAlong(path);
+}
+
 std::size_t PoaGraph::NumReads() const { return impl_->NumReads(); }
 
 const PoaConsensus* PoaGraph::FindConsensus(const Align::AlignConfig& config, int minCoverage) const
@@ -1,124 +1,94 @@
 #include "PoaGraphImpl.h"
 
+#include "PoaBand.h"
+
 #include <pbcopper/align/AlignConfig.h>
 #include <pbcopper/poa/PoaConsensus.h>
 #include <pbcopper/poa/PoaGraph.h>
 #include <pbcopper/poa/RangeFinder.h>
 
-#include <boost/foreach.hpp>
-#include <boost/graph/copy.hpp>
-#include <boost/graph/graphviz.hpp>
-#include <boost/graph/topological_sort.hpp>
+#include <boost/format.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <sstream>
 
-namespace boost {
-
-class my_label_writer
-{
-public:
-    explicit my_label_writer(PacBio::Poa::detail::VertexInfoMap map, bool color, bool verbose,
-                             const PacBio::Poa::PoaConsensus* pc = nullptr)
-        : map_(map), cssVtxs_(), color_(color), verbose_(verbose)
-    {
-        if (pc != nullptr) {
-            cssVtxs_.insert(pc->Path.begin(), pc->Path.end());
-        }
-    }
-
-    template <class descriptor>
-    void operator()(std::ostream& out, const descriptor& v) const
-    {
-        PacBio::Poa::PoaGraph::Vertex vertexId = map_[v].Id;
+#include <cstdint>
+#include <cstring>
 
-        std::string nodeColoringAttribute =
-            (color_ && isInConsensus(vertexId) ? R"( style="filled", fillcolor="lightblue" ,)"
-                                               : "");
-
-        if (!verbose_) {
-            out << format("[shape=Mrecord,%s label=\"{ %c | %d }\"]") % nodeColoringAttribute %
-                       map_[v].Base % map_[v].Reads;
-        } else {
-            out << format(
-                       "[shape=Mrecord,%s label=\"{ "
-                       "{ %d | %c } | "
-                       "{ %d | %d } | "
-                       "{ %0.2f | %0.2f } }\"]") %
-                       nodeColoringAttribute % vertexId % map_[v].Base % map_[v].Reads %
-                       map_[v].SpanningReads % map_[v].Score % map_[v].ReachingScore;
-        }
-    }
+#include "../../third-party/simde/x86/sse4.1.h"
 
-private:
-    bool isInConsensus(PacBio::Poa::PoaGraph::Vertex v) const
-    {
-        return cssVtxs_.find(v) != cssVtxs_.end();
-    }
-    PacBio::Poa::detail::VertexInfoMap map_;
-    std::set<PacBio::Poa::PoaGraph::Vertex> cssVtxs_;
-    bool color_;
-    bool verbose_;
-};
+namespace PacBio {
+namespace Poa {
+namespace detail {
+namespace {
 
-class my_graph_writer
+void WriteGraphVizVertex(std::ostream& out, const PoaNode& node, bool color, bool verbose,
+                         const std::set<PoaGraph::Vertex>& cssVtxs)
 {
-public:
-    explicit my_graph_writer(bool leftToRight = false) : leftToRight_(leftToRight) {}
-    void operator()(std::ostream& out) const
-    {
-        if (leftToRight_) {
-            out << "rankdir=\"LR\";" << std::endl;
-        }
-    }
-
-private:
-    bool leftToRight_;
-};
+    const bool isInConsensus = cssVtxs.find(node.Id) != cssVtxs.end();
+    std::string nodeColoringAttribute =
+        (color && isInConsensus ? R"( style="filled", fillcolor="lightblue" ,)" : "");
 
-}  // namespace boost
+    if (!verbose) {
+        out << boost::format("[shape=Mrecord,%s label=\"{ %c | %d }\"]") % nodeColoringAttribute %
+                   node.Base % node.Reads;
+    } else {
+        out << boost::format(
+                   "[shape=Mrecord,%s label=\"{ "
+                   "{ %d | %c } | "
+                   "{ %d | %d } | "
+                   "{ %0.2f | %0.2f } }\"]") %
+                   nodeColoringAttribute % node.Id % node.Base % node.Reads % node.SpanningReads %
+                   node.Score % node.ReachingScore;
+    }
+}
 
-namespace PacBio {
-namespace Poa {
-namespace detail {
+}  // namespace
 
 // ----------------- PoaGraphImpl ---------------------
 
-PoaGraphImpl::PoaGraphImpl()
-    : g_()
-    , vertexInfoMap_(get(boost::vertex_info, g_))
-    , numReads_(0)
-    , totalVertices_(0)
-    , liveVertices_(0)
+PoaGraphImpl::PoaGraphImpl() : g_(), numReads_(0)
 {
-    enterVertex_ = addVertex('^', 0);
-    exitVertex_ = addVertex('$', 0);
+    enterVertex_ = addVertex('^', null_vertex, 0);
+    exitVertex_ = addVertex('$', null_vertex, 0);
 }
 
-PoaGraphImpl::PoaGraphImpl(const PoaGraphImpl& other)
-    : g_(other.g_)
-    , vertexInfoMap_(get(boost::vertex_info, g_))
-    , enterVertex_(other.enterVertex_)
-    , exitVertex_(other.exitVertex_)
-    , numReads_(other.numReads_)
-{}
+void PoaGraphImpl::Clear()
+{
+    g_.Clear();
+    numReads_ = 0;
+    if (readPointers_) {
+        readPointers_->Clear();
+    }
+    enterVertex_ = addVertex('^', null_vertex, 0);
+    exitVertex_ = addVertex('$', null_vertex, 0);
+}
 
 void PoaGraphImpl::repCheck() const
 {
 #ifndef NDEBUG
     // assert the representation invariant for the object
-    BOOST_FOREACH (const VD v, vertices(g_)) {
+    std::vector<std::size_t> rank(g_.NumSlots());
+    for (std::size_t i = 0; i < g_.TopologicalOrder().size(); ++i) {
+        rank[g_.TopologicalOrder()[i]] = i;
+    }
+    for (const VD v : g_.TopologicalOrder()) {
         if (v == enterVertex_) {
-            assert(in_degree(v, g_) == 0);
-            assert(out_degree(v, g_) > 0 || NumReads() == 0);
+            assert(g_.InDegree(v) == 0);
+            assert(g_.OutDegree(v) > 0 || NumReads() == 0);
         } else if (v == exitVertex_) {
-            assert(in_degree(v, g_) > 0 || NumReads() == 0);
-            assert(out_degree(v, g_) == 0);
+            assert(g_.InDegree(v) > 0 || NumReads() == 0);
+            assert(g_.OutDegree(v) == 0);
         } else {
-            assert(in_degree(v, g_) > 0);
-            assert(out_degree(v, g_) > 0);
+            assert(g_.InDegree(v) > 0);
+            assert(g_.OutDegree(v) > 0);
+        }
+        for (const VD u : g_.InVertices(v)) {
+            assert(rank[u] < rank[v]);
         }
     }
 #endif
@@ -126,17 +96,209 @@ void PoaGraphImpl::repCheck() const
 
 namespace {
 
-std::vector<const AlignmentColumn*> getPredecessorColumns(const BoostGraph& g, VD v,
-                                                          const AlignmentColumnMap& colMap)
+void getPredecessorColumns(const PoaDag& g, VD v, const AlignmentColumnMap& colMap,
+                           std::vector<const AlignmentColumn*>* predecessorColumns)
 {
-    std::vector<const AlignmentColumn*> predecessorColumns;
-    for (auto e : inEdges(v, g)) {
-        VD u = source(e, g);
-        const AlignmentColumn* const predCol = colMap.at(u).get();
+    predecessorColumns->clear();
+    for (const VD u : g.InVertices(v)) {
+        const AlignmentColumn* const predCol = colMap[u];
         assert(predCol != nullptr);
-        predecessorColumns.push_back(predCol);
+        predecessorColumns->push_back(predCol);
+    }
+    if (predecessorColumns->size() >= AlignmentColumn::MaxPredecessors) {
+        throw std::runtime_error{"[pbcopper] poa ERROR: too many predecessors for vertex " +
+                                 std::to_string(v)};
+    }
+}
+
+//
+// Fills row i > 0 of 'curCol' from its predecessor columns and the row above.
+// Candidates are tried in a fixed order (per predecessor: match/mismatch then
+// delete; then extra) and only a strictly better one is taken, which fixes
+// the tie-breaking that FillRowsSimd reproduces.
+//
+void FillRow(AlignmentColumn* curCol, const std::vector<const AlignmentColumn*>& predecessorColumns,
+             const std::string& sequence, const char base, const Align::AlignConfig& config,
+             const int i)
+{
+    assert(i > 0 && curCol->HasRow(i));
+
+    float candidateScore;
+    float bestScore;
+    std::size_t prevIndex;
+    MoveType reachingMove;
+
+    if (config.Mode == Align::AlignMode::LOCAL) {
+        bestScore = 0;
+        prevIndex = predecessorColumns.size();
+        reachingMove = StartMove;
+    } else {
+        bestScore = -FLT_MAX;
+        prevIndex = 0;
+        reachingMove = InvalidMove;
+    }
+
+    const bool isMatch = sequence[i - 1] == base;
+    for (std::size_t k = 0; k < predecessorColumns.size(); ++k) {
+        const AlignmentColumn* const prevCol = predecessorColumns[k];
+        // Incorporate (Match or Mismatch)
+        if (prevCol->HasRow(i - 1)) {
+            candidateScore =
+                prevCol->Score[i - 1] + (isMatch ? config.Params.Match : config.Params.Mismatch);
+            if (candidateScore > bestScore) {
+                bestScore = candidateScore;
+                prevIndex = k;
+                reachingMove = (isMatch ? MatchMove : MismatchMove);
+            }
+        }
+        // Delete
+        if (prevCol->HasRow(i)) {
+            candidateScore = prevCol->Score[i] + config.Params.Delete;
+            if (candidateScore > bestScore) {
+                bestScore = candidateScore;
+                prevIndex = k;
+                reachingMove = DeleteMove;
+            }
+        }
+    }
+    // Extra
+    if (curCol->HasRow(i - 1)) {
+        candidateScore = curCol->Score[i - 1] + config.Params.Insert;
+        if (candidateScore > bestScore) {
+            bestScore = candidateScore;
+            reachingMove = ExtraMove;
+        }
+    }
+    assert(reachingMove != InvalidMove);
+    curCol->Score[i] = bestScore;
+    curCol->SetTraceback(i, reachingMove, prevIndex);
+}
+
+//
+// Loads scores [row, row + 4) of 'col', with -FLT_MAX for rows it lacks.
+// -FLT_MAX absorbs any penalty added to it, so such lanes never win a
+// comparison, just as FillRow skips the rows.
+//
+simde__m128 LoadScores(const AlignmentColumn& col, const std::size_t row)
+{
+    if (col.BeginRow() <= row && row + 4 <= col.EndRow()) {
+        return simde_mm_loadu_ps(&col.Score[row]);
+    }
+    float scores[4] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (std::size_t k = 0; k < 4; ++k) {
+        if (col.HasRow(row + k)) {
+            scores[k] = col.Score[row + k];
+        }
+    }
+    return simde_mm_loadu_ps(scores);
+}
+
+//
+// Fills rows [beginRow, endRow), beginRow > 0, of 'curCol' four at a time,
+// with the same results as FillRow. Scores stay in single precision: the
+// alignment parameters are integral, so lanes are exact.
+//
+// Predecessor moves only depend on the previous column(s); the extra (read
+// insertion) chain within the column is resolved by an in-register prefix
+// max-scan, seeded with the row above the block.
+//
+void FillRowsSimd(AlignmentColumn* curCol,
+                  const std::vector<const AlignmentColumn*>& predecessorColumns,
+                  const std::string& sequence, const char base, const Align::AlignConfig& config,
+                  const int beginRow, const int endRow)
+{
+    assert(beginRow > 0);
+
+    const float insert = config.Params.Insert;
+    const simde__m128 vNegInf = simde_mm_set1_ps(-FLT_MAX);
+    const simde__m128 vMatch = simde_mm_set1_ps(config.Params.Match);
+    const simde__m128 vMismatch = simde_mm_set1_ps(config.Params.Mismatch);
+    const simde__m128 vDelete = simde_mm_set1_ps(config.Params.Delete);
+    const simde__m128 vInsert = simde_mm_set1_ps(insert);
+    const simde__m128 vInsert2 = simde_mm_set1_ps(2 * insert);
+    const simde__m128 vInsertRamp = simde_mm_setr_ps(insert, 2 * insert, 3 * insert, 4 * insert);
+    const simde__m128i vBase = simde_mm_set1_epi32(static_cast<unsigned char>(base));
+    const simde__m128i vMatchMove = simde_mm_set1_epi32(MatchMove);
+    const simde__m128i vMismatchMove = simde_mm_set1_epi32(MismatchMove);
+    const simde__m128i vDeleteMove = simde_mm_set1_epi32(DeleteMove);
+    const simde__m128i vExtraMove = simde_mm_set1_epi32(ExtraMove);
+
+    const bool isLocal = config.Mode == Align::AlignMode::LOCAL;
+    const simde__m128 vInitScore = (isLocal ? simde_mm_setzero_ps() : vNegInf);
+    const simde__m128i vInitMove = simde_mm_set1_epi32(isLocal ? StartMove : InvalidMove);
+    const simde__m128i vInitIndex =
+        simde_mm_set1_epi32(isLocal ? static_cast<int>(predecessorColumns.size()) : 0);
+
+    const auto select = [](const simde__m128i a, const simde__m128i b, const simde__m128 mask) {
+        return simde_mm_blendv_epi8(a, b, simde_mm_castps_si128(mask));
+    };
+
+    int i = beginRow;
+    for (; i + 4 <= endRow; i += 4) {
+        // read bases for rows [i, i + 4)
+        std::int32_t packedBases;
+        std::memcpy(&packedBases, sequence.data() + i - 1, sizeof(packedBases));
+        const simde__m128i isMatch = simde_mm_cmpeq_epi32(
+            simde_mm_cvtepu8_epi32(simde_mm_cvtsi32_si128(packedBases)), vBase);
+        const simde__m128 vSubstitution =
+            simde_mm_blendv_ps(vMismatch, vMatch, simde_mm_castsi128_ps(isMatch));
+        const simde__m128i vSubstitutionMove =
+            simde_mm_blendv_epi8(vMismatchMove, vMatchMove, isMatch);
+
+        simde__m128 best = vInitScore;
+        simde__m128i move = vInitMove;
+        simde__m128i index = vInitIndex;
+        for (std::size_t k = 0; k < predecessorColumns.size(); ++k) {
+            const AlignmentColumn& prevCol = *predecessorColumns[k];
+            if (prevCol.EndRow() < static_cast<std::size_t>(i) ||
+                prevCol.BeginRow() >= static_cast<std::size_t>(i + 4)) {
+                continue;
+            }
+            const simde__m128i vIndex = simde_mm_set1_epi32(static_cast<int>(k));
+
+            // Incorporate (Match or Mismatch)
+            simde__m128 candidate = simde_mm_add_ps(LoadScores(prevCol, i - 1), vSubstitution);
+            simde__m128 better = simde_mm_cmpgt_ps(candidate, best);
+            best = simde_mm_blendv_ps(best, candidate, better);
+            move = select(move, vSubstitutionMove, better);
+            index = select(index, vIndex, better);
+
+            // Delete
+            candidate = simde_mm_add_ps(LoadScores(prevCol, i), vDelete);
+            better = simde_mm_cmpgt_ps(candidate, best);
+            best = simde_mm_blendv_ps(best, candidate, better);
+            move = select(move, vDeleteMove, better);
+            index = select(index, vIndex, better);
+        }
+
+        // Extra: score[r] = max(best[r], score[r - 1] + insert)
+        simde__m128 score = best;
+        score = simde_mm_max_ps(
+            score,
+            simde_mm_add_ps(simde_mm_castsi128_ps(simde_mm_alignr_epi8(
+                                simde_mm_castps_si128(score), simde_mm_castps_si128(vNegInf), 12)),
+                            vInsert));
+        score = simde_mm_max_ps(
+            score,
+            simde_mm_add_ps(simde_mm_castsi128_ps(simde_mm_alignr_epi8(
+                                simde_mm_castps_si128(score), simde_mm_castps_si128(vNegInf), 8)),
+                            vInsert2));
+        const float above = (curCol->HasRow(i - 1) ? curCol->Score[i - 1] : -FLT_MAX);
+        score = simde_mm_max_ps(score, simde_mm_add_ps(simde_mm_set1_ps(above), vInsertRamp));
+        move = select(move, vExtraMove, simde_mm_cmpgt_ps(score, best));
+
+        simde_mm_storeu_ps(&curCol->Score[i], score);
+        const simde__m128i packedMoves =
+            simde_mm_packus_epi16(simde_mm_packus_epi32(move, move), simde_mm_setzero_si128());
+        const std::int32_t moves = simde_mm_cvtsi128_si32(packedMoves);
+        std::memcpy(&curCol->ReachingMove[i], &moves, sizeof(moves));
+        simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(&curCol->PreviousIndex[i]),
+                              simde_mm_packus_epi32(index, index));
+    }
+
+    for (; i < endRow; ++i) {
+        FillRow(curCol, predecessorColumns, sequence, base, config, i);
     }
-    return predecessorColumns;
 }
 
 }  // namespace
@@ -145,15 +307,15 @@ std::unique_ptr<PoaConsensus> PoaGraphImpl::FindConsensus(const Align::AlignConf
                                                           int minCoverage)
 {
     std::vector<VD> bestPath = consensusPath(config.Mode, minCoverage);
-    std::string consensusSequence = sequenceAlongPath(g_, vertexInfoMap_, bestPath);
+    std::string consensusSequence = sequenceAlongPath(g_, bestPath);
     return std::make_unique<PoaConsensus>(consensusSequence, *this, externalizePath(bestPath));
 }
 
-std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumnForExit(
-    VD v, const AlignmentColumnMap& colMap, const std::string& sequence,
+const AlignmentColumn* PoaGraphImpl::makeAlignmentColumnForExit(
+    PoaArena* arena, VD v, const AlignmentColumnMap& colMap, const std::string& sequence,
     const Align::AlignConfig& config) const
 {
-    assert(out_degree(v, g_) == 0);
+    assert(g_.OutDegree(v) == 0);
 
     // this is kind of unnecessary as we are only actually using one entry in
     // this column
@@ -168,9 +330,10 @@ std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumnForExit(
     // the graph.  In local alignment, it may have been from any
     // row, not necessarily I.
     if (config.Mode == Align::AlignMode::SEMIGLOBAL || config.Mode == Align::AlignMode::LOCAL) {
-        BOOST_FOREACH (const VD u, vertices(g_)) {
-            if (u != exitVertex_) {
-                const AlignmentColumn* const predCol = colMap.at(u).get();
+        // visit in creation order, so that ties resolve as they always have
+        for (VD u = 0; u < g_.NumSlots(); ++u) {
+            if (g_.IsLive(u) && u != exitVertex_) {
+                const AlignmentColumn* const predCol = colMap[u];
                 int prevRow = (config.Mode == Align::AlignMode::LOCAL ? ArgMax(predCol->Score) : I);
                 if (predCol->HasRow(prevRow) && predCol->Score[prevRow] > bestScore) {
                     bestScore = predCol->Score[prevRow];
@@ -180,8 +343,8 @@ std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumnForExit(
         }
     } else {
         // regular predecessors
-        std::vector<const AlignmentColumn*> predecessorColumns =
-            getPredecessorColumns(g_, v, colMap);
+        std::vector<const AlignmentColumn*> predecessorColumns;
+        getPredecessorColumns(g_, v, colMap, &predecessorColumns);
         for (const AlignmentColumn* predCol : predecessorColumns) {
             if (predCol->HasRow(I) && predCol->Score[I] > bestScore) {
                 bestScore = predCol->Score[I];
@@ -190,17 +353,18 @@ std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumnForExit(
         }
     }
 
+    // only the last row is used
     assert(prevVertex != null_vertex);
-    AlignmentColumn curCol{v, 0, I + 1};
-    curCol.Score[I] = bestScore;
-    curCol.PreviousVertex[I] = prevVertex;
-    curCol.ReachingMove[I] = EndMove;
-    return std::make_unique<const AlignmentColumn>(std::move(curCol));
+    AlignmentColumn* curCol = arena->Create<AlignmentColumn>(arena, v, I, I + 1, 1);
+    curCol->Predecessors[0] = prevVertex;
+    curCol->Score[I] = bestScore;
+    curCol->SetTraceback(I, EndMove, 0);
+    return curCol;
 }
 
-std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumn(
-    VD v, const AlignmentColumnMap& colMap, const std::string& sequence,
-    const Align::AlignConfig& config, int beginRow, int endRow) const
+const AlignmentColumn* PoaGraphImpl::makeAlignmentColumn(
+    PoaArena* arena, VD v, const std::vector<const AlignmentColumn*>& predecessorColumns,
+    const std::string& sequence, const Align::AlignConfig& config, int beginRow, int endRow) const
 {
     if (beginRow > endRow) {
         // This happens when there are no anchors in the read.  We
@@ -209,111 +373,80 @@ std::unique_ptr<const AlignmentColumn> PoaGraphImpl::makeAlignmentColumn(
 
         // This is only going to work in LOCAL aln, assert on that
 
-        AlignmentColumn col{v, 0, 1};
-        col.ReachingMove[0] = StartMove;
-        col.PreviousVertex[0] = enterVertex_;
-        col.Score[0] = 0;  // > -FLT_MAX;
-        return std::make_unique<const AlignmentColumn>(std::move(col));
+        AlignmentColumn* col = arena->Create<AlignmentColumn>(arena, v, 0, 1, 1);
+        col->Predecessors[0] = enterVertex_;
+        col->SetTraceback(0, StartMove, 0);
+        col->Score[0] = 0;  // > -FLT_MAX;
+        return col;
     }
 
     assert(beginRow < endRow || beginRow == 0 || beginRow == static_cast<int>(sequence.length()));
 
-    AlignmentColumn curCol{v, beginRow, endRow};
-
-    const PoaNode& vertexInfo = vertexInfoMap_[v];
-    std::vector<const AlignmentColumn*> predecessorColumns = getPredecessorColumns(g_, v, colMap);
-
-    // i represents position in array
-    // readPos=i-1 represents position in read
-    for (int i = beginRow; i < endRow; i++) {
-        assert(curCol.HasRow(i));
+    // traceback indices: predecessors in order, then ^ for Start moves
+    const std::size_t numPredecessors = predecessorColumns.size();
+    AlignmentColumn* curCol =
+        arena->Create<AlignmentColumn>(arena, v, beginRow, endRow, numPredecessors + 1);
+    for (std::size_t k = 0; k < numPredecessors; ++k) {
+        curCol->Predecessors[k] = predecessorColumns[k]->CurrentVertex;
+    }
+    curCol->Predecessors[numPredecessors] = enterVertex_;
 
-        float candidateScore;
-        float bestScore;
-        VD prevVertex;
-        MoveType reachingMove;
+    if (beginRow == 0 && endRow > 0) {
+        fillFirstRow(curCol, predecessorColumns, config);
+    }
 
-        if (config.Mode == Align::AlignMode::LOCAL) {
-            bestScore = 0;
-            prevVertex = enterVertex_;
-            reachingMove = StartMove;
-        } else {
-            bestScore = -FLT_MAX;
-            prevVertex = null_vertex;
-            reachingMove = InvalidMove;
+    const char base = g_.Node(v).Base;
+    const int firstRow = std::max(beginRow, 1);
+    if (config.Kernel == Align::AlignKernel::SIMD) {
+        FillRowsSimd(curCol, predecessorColumns, sequence, base, config, firstRow, endRow);
+    } else {
+        for (int i = firstRow; i < endRow; ++i) {
+            FillRow(curCol, predecessorColumns, sequence, base, config, i);
         }
+    }
 
-        // Special-case the first row, this could probably be factored
-        // more cleanly
-        if (i == 0) {
-            if (predecessorColumns.size() == 0) {
-                // if this vertex doesn't have any in-edges it is ^; has
-                // no reaching move
-                assert(v == enterVertex_);
-                curCol.Score[0] = 0;
-                curCol.ReachingMove[0] = InvalidMove;
-                curCol.PreviousVertex[0] = null_vertex;
-            } else if (config.Mode == Align::AlignMode::SEMIGLOBAL ||
-                       config.Mode == Align::AlignMode::LOCAL) {
-                // under semiglobal or local alignment, we use the Start move
-                curCol.Score[0] = 0;
-                curCol.ReachingMove[0] = StartMove;
-                curCol.PreviousVertex[0] = enterVertex_;
-            } else {
-                // otherwise it's a deletion
-                for (const AlignmentColumn* prevCol : predecessorColumns) {
-                    candidateScore = prevCol->Score[0] + config.Params.Delete;
-                    if (candidateScore > bestScore) {
-                        bestScore = candidateScore;
-                        prevVertex = prevCol->CurrentVertex;
-                        reachingMove = DeleteMove;
-                    }
-                }
-                assert(reachingMove != InvalidMove);
-                curCol.Score[0] = bestScore;
-                curCol.ReachingMove[0] = reachingMove;
-                curCol.PreviousVertex[0] = prevVertex;
-            }
-        } else {
-            for (const AlignmentColumn* prevCol : predecessorColumns) {
-                // Incorporate (Match or Mismatch)
-                if (prevCol->HasRow(i - 1)) {
-                    bool isMatch = sequence[i - 1] == vertexInfo.Base;
-                    candidateScore = prevCol->Score[i - 1] +
-                                     (isMatch ? config.Params.Match : config.Params.Mismatch);
-                    if (candidateScore > bestScore) {
-                        bestScore = candidateScore;
-                        prevVertex = prevCol->CurrentVertex;
-                        reachingMove = (isMatch ? MatchMove : MismatchMove);
-                    }
-                }
-                // Delete
-                if (prevCol->HasRow(i)) {
-                    candidateScore = prevCol->Score[i] + config.Params.Delete;
-                    if (candidateScore > bestScore) {
-                        bestScore = candidateScore;
-                        prevVertex = prevCol->CurrentVertex;
-                        reachingMove = DeleteMove;
-                    }
-                }
+    return curCol;
+}
+
+void PoaGraphImpl::fillFirstRow(AlignmentColumn* curCol,
+                                const std::vector<const AlignmentColumn*>& predecessorColumns,
+                                const Align::AlignConfig& config) const
+{
+    assert(curCol->HasRow(0));
+    const std::size_t enterIndex = predecessorColumns.size();
+
+    if (predecessorColumns.size() == 0) {
+        // if this vertex doesn't have any in-edges it is ^; has
+        // no reaching move
+        assert(curCol->CurrentVertex == enterVertex_);
+        curCol->Score[0] = 0;
+        curCol->SetTraceback(0, InvalidMove, 0);
+    } else if (config.Mode == Align::AlignMode::SEMIGLOBAL ||
+               config.Mode == Align::AlignMode::LOCAL) {
+        // under semiglobal or local alignment, we use the Start move
+        curCol->Score[0] = 0;
+        curCol->SetTraceback(0, StartMove, enterIndex);
+    } else {
+        // otherwise it's a deletion
+        float bestScore = -FLT_MAX;
+        std::size_t prevIndex = 0;
+        MoveType reachingMove = InvalidMove;
+        for (std::size_t k = 0; k < predecessorColumns.size(); ++k) {
+            // banded predecessors may not start at row 0
+            if (!predecessorColumns[k]->HasRow(0)) {
+                continue;
             }
-            // Extra
-            if (curCol.HasRow(i - 1)) {
-                candidateScore = curCol.Score[i - 1] + config.Params.Insert;
-                if (candidateScore > bestScore) {
-                    bestScore = candidateScore;
-                    prevVertex = v;
-                    reachingMove = ExtraMove;
-                }
+            const float candidateScore = predecessorColumns[k]->Score[0] + config.Params.Delete;
+            if (candidateScore > bestScore) {
+                bestScore = candidateScore;
+                prevIndex = k;
+                reachingMove = DeleteMove;
             }
-            assert(reachingMove != InvalidMove);
-            curCol.Score[i] = bestScore;
-            curCol.ReachingMove[i] = reachingMove;
-            curCol.PreviousVertex[i] = prevVertex;
         }
+        assert(reachingMove != InvalidMove);
+        curCol->Score[0] = bestScore;
+        curCol->SetTraceback(0, reachingMove, prevIndex);
     }
-
-    return std::make_unique<const AlignmentColumn>(std::move(curCol));
 }
 
 void PoaGraphImpl::AddRead(const std::string& readSeq, const Align::AlignConfig& config,
@@ -352,22 +485,54 @@ std::unique_ptr<PoaAlignmentMatrix> PoaGraphImpl::TryAddRead(
         // "intermediate" consensus may include extra sequence
         // at either end
         std::vector<VD> cssPath = consensusPath(config.Mode);
-        std::string cssSeq = sequenceAlongPath(g_, vertexInfoMap_, cssPath);
+        std::string cssSeq = sequenceAlongPath(g_, cssPath);
         rangeFinder->InitRangeFinder(*this, externalizePath(cssPath), cssSeq, readSeq);
     }
 
     // Calculate alignment columns of sequence vs. graph, using sparsity if
-    // we have a range finder.
+    // we have a range finder, or else the built-in band if requested.
     auto mat = std::make_unique<PoaAlignmentMatrixImpl>();
     mat->readSequence_ = readSeq;
     mat->mode_ = config.Mode;
     mat->graph_ = this;
 
-    std::vector<VD> sortedVerticesLocal(num_vertices(g_));
-    topological_sort(g_, sortedVerticesLocal.rbegin());
-    std::unique_ptr<const AlignmentColumn> curCol;
-    for (const auto& v : sortedVerticesLocal) {
+    std::optional<PoaBand> band;
+    if (rangeFinder == nullptr && config.Band.IsEnabled()) {
+        band.emplace(g_, exitVertex_, readSeq.size(), config);
+    }
+    if (rangeFinder == nullptr && !band) {
+        // full columns, so size the arena for all of them up front
+        const std::size_t rows = readSeq.size() + 1;
+        const std::size_t columnBytes =
+            sizeof(AlignmentColumn) + rows * (sizeof(float) + 3) + 4 * sizeof(VD) + 16;
+        mat->arena_.Reserve(g_.NumVertices() * columnBytes);
+    }
+    if (!alignColumns(mat.get(), config, rangeFinder, band ? &*band : nullptr)) {
+        // the band never reached the end of the read, fall back to full columns
+        alignColumns(mat.get(), config, nullptr, nullptr);
+    }
+    repCheck();
+
+    PoaAlignmentMatrix* base = mat.release();
+    std::unique_ptr<PoaAlignmentMatrix> result;
+    result.reset(base);
+    return result;
+}
+
+bool PoaGraphImpl::alignColumns(PoaAlignmentMatrixImpl* mat, const Align::AlignConfig& config,
+                                SdpRangeFinder* const rangeFinder, PoaBand* const band) const
+{
+    const std::string& readSeq = mat->readSequence_;
+    bool reachesReadEnd = false;
+
+    // a single sweep over the vertices in topological order
+    mat->arena_.Reset();
+    mat->columns_.assign(g_.NumSlots(), nullptr);
+    std::vector<const AlignmentColumn*> predecessorColumns;
+    const AlignmentColumn* curCol;
+    for (const VD v : g_.TopologicalOrder()) {
         if (v != exitVertex_) {
+            getPredecessorColumns(g_, v, mat->columns_, &predecessorColumns);
             std::size_t startRow = 0;
             std::size_t endRow = readSeq.size() + 1;
             if (rangeFinder) {
@@ -378,22 +543,27 @@ std::unique_ptr<PoaAlignmentMatrix> PoaGraphImpl::TryAddRead(
                 std::tie(startRange, endRange) = rangeFinder->FindAlignableRange(externalize(v));
                 startRow = startRange;
                 endRow = (endRange == -INT_MAX / 2 ? endRange : endRange + 1);
+            } else if (band) {
+                std::tie(startRow, endRow) = band->Rows(v, predecessorColumns);
             }
-            /* Vertex vExt = */ externalize(v);  // DEBUGGING
-            curCol = makeAlignmentColumn(v, mat->columns_, readSeq, config, startRow, endRow);
+            curCol = makeAlignmentColumn(&mat->arena_, v, predecessorColumns, readSeq, config,
+                                         startRow, endRow);
+            if (band) {
+                band->Update(*curCol);
+            }
+            reachesReadEnd |= curCol->HasRow(readSeq.size());
         } else {
-            curCol = makeAlignmentColumnForExit(v, mat->columns_, readSeq, config);
+            // semiglobal alignment must end at the last row of some column
+            if (band && config.Mode == Align::AlignMode::SEMIGLOBAL && !reachesReadEnd) {
+                return false;
+            }
+            curCol = makeAlignmentColumnForExit(&mat->arena_, v, mat->columns_, readSeq, config);
         }
-        mat->columns_[v] = std::move(curCol);
+        mat->columns_[v] = curCol;
     }
 
     mat->score_ = mat->columns_[exitVertex_]->Score[readSeq.size()];
-    repCheck();
-
-    PoaAlignmentMatrix* base = mat.release();
-    std::unique_ptr<PoaAlignmentMatrix> result;
-    result.reset(base);
-    return result;
+    return true;
 }
 
 void PoaGraphImpl::CommitAdd(const PoaAlignmentMatrix* const mat_,
@@ -408,67 +578,78 @@ void PoaGraphImpl::CommitAdd(const PoaAlignmentMatrix* const mat_,
     repCheck();
 }
 
-class VertexComparator
-{
-public:
-    explicit VertexComparator(const BoostGraph& g) : g_(g) {}
-
-    // Use existing indices to provide a stable memory-agnostic ordering
-    bool operator()(VD v1, VD v2) const
-    {
-        const int vi1 = get(boost::vertex_index, g_, v1);
-        const int vi2 = get(boost::vertex_index, g_, v2);
-        return (vi1 < vi2);
-    }
-
-private:
-    const BoostGraph& g_;
-};
-
 void PoaGraphImpl::PruneGraph(const int minCoverage)
 {
-    // We have to use an iterator since we're modifying the graph as we go
-    boost::graph_traits<BoostGraph>::vertex_iterator vi, vi_end, next;
-    std::tie(vi, vi_end) = vertices(g_);
-    for (next = vi; vi != vi_end; vi = next) {
-        ++next;
-        if (vertexInfoMap_[*vi].Reads < minCoverage) {
-            clear_vertex(*vi, g_);
-            remove_vertex(*vi, g_);
+    for (VD v = 0; v < g_.NumSlots(); ++v) {
+        if (g_.IsLive(v) && g_.Node(v).Reads < minCoverage) {
+            g_.RemoveVertex(v);
         }
     }
+    g_.UpdateTopologicalOrder();
+}
 
-    // This is a workaround for the non-deterministic order of iteration
-    // from BGL's vertices, which like edges also appear to be ordered
-    // by memory address (see: http://stackoverflow.com/questions/30968690/)
+void PoaGraphImpl::EnableReadPointers()
+{
+    if (numReads_ > 0) {
+        throw std::runtime_error{
+            "[pbcopper] poa ERROR: read pointers must be enabled before adding reads"};
+    }
+    if (!readPointers_) {
+        readPointers_.emplace();
+    }
+}
 
-    // We can't use topological sort here, since having a vertex index greater
-    // than num_vertices(g_) causes a crash. Instead we sort the vertices by
-    // their existing index.  This should still be very fast, as the underlying
-    // collection should be mostly sorted already.
-    std::vector<VD> sortedVerticesLocal;
-    BGL_FORALL_VERTICES(v, g_, BoostGraph) sortedVerticesLocal.push_back(v);
-    std::sort(sortedVerticesLocal.begin(), sortedVerticesLocal.end(), VertexComparator(g_));
+bool PoaGraphImpl::HasReadPointers() const { return readPointers_.has_value(); }
 
-    // Finally, re-index all vertices to the range [0, num_vertices(g_)]
-    boost::graph_traits<BoostGraph>::vertices_size_type current_index = 0;
-    index_map_t index_map = get(boost::vertex_index, g_);
-    for (const VD& v : sortedVerticesLocal) {
-        index_map[v] = current_index++;
+std::vector<PoaGraph::ReadPointer> PoaGraphImpl::ReadPointersAlong(
+    const std::vector<Vertex>& path) const
+{
+    if (!readPointers_) {
+        throw std::runtime_error{"[pbcopper] poa ERROR: read pointers are not enabled"};
+    }
+    std::vector<PoaGraph::ReadPointer> result;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        readPointers_->ForEach(internalize(path[i]),
+                               [&](const std::size_t readId, const std::size_t readPos) {
+                                   result.push_back({i, readId, readPos});
+                               });
     }
+    return result;
 }
 
 std::size_t PoaGraphImpl::NumReads() const { return numReads_; }
 
 std::string PoaGraphImpl::ToGraphViz(int flags, const PoaConsensus* pc) const
 {
-    std::ostringstream ss;
-    write_graphviz(ss, g_,
-                   boost::my_label_writer(vertexInfoMap_, flags & PoaGraph::COLOR_NODES,
-                                          flags & PoaGraph::VERBOSE_NODES, pc),
-                   boost::default_writer(),  // edge writer
-                   boost::my_graph_writer(true));
+    std::set<PoaGraph::Vertex> cssVtxs;
+    if (pc != nullptr) {
+        cssVtxs.insert(pc->Path.begin(), pc->Path.end());
+    }
 
+    // vertices are numbered by creation order, skipping any pruned ones
+    std::vector<std::size_t> index(g_.NumSlots());
+    std::size_t currentIndex = 0;
+    for (VD v = 0; v < g_.NumSlots(); ++v) {
+        if (g_.IsLive(v)) {
+            index[v] = currentIndex++;
+        }
+    }
+
+    std::ostringstream ss;
+    ss << "digraph G {" << std::endl;
+    ss << "rankdir=\"LR\";" << std::endl;
+    for (VD v = 0; v < g_.NumSlots(); ++v) {
+        if (g_.IsLive(v)) {
+            ss << index[v];
+            WriteGraphVizVertex(ss, g_.Node(v), flags & PoaGraph::COLOR_NODES,
+                                flags & PoaGraph::VERBOSE_NODES, cssVtxs);
+            ss << ';' << std::endl;
+        }
+    }
+    for (const auto& [u, v] : g_.Edges()) {
+        ss << index[u] << "->" << index[v] << " ;" << std::endl;
+    }
+    ss << '}' << std::endl;
     return ss.str();
 }
 
@@ -483,12 +664,9 @@ void PoaGraphImpl::WriteGraphCsvFile(const std::filesystem::path& filename) cons
 {
     std::ofstream outfile{filename};
 
-    std::list<VD> sortedVerticesLocal(num_vertices(g_));
-    topological_sort(g_, sortedVerticesLocal.rbegin());
-
     outfile << "Id,Base,Reads,SpanningReads,Score,ReachingScore" << std::endl;
-    for (const VD v : sortedVerticesLocal) {
-        PoaNode& vi = vertexInfoMap_[v];
+    for (const VD v : g_.TopologicalOrder()) {
+        const PoaNode& vi = g_.Node(v);
         outfile << vi.Id << ',' << vi.Base << ',' << vi.Reads << ',' << vi.SpanningReads << ','
                 << vi.Score << ',' << vi.ReachingScore << std::endl;
     }
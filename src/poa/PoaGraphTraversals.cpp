@@ -3,10 +3,7 @@
 #include "PoaGraphImpl.h"
 #include "VectorL.h"
 
-#include <boost/foreach.hpp>
-#include <boost/graph/topological_sort.hpp>
-#include <boost/unordered_set.hpp>
-
+#include <algorithm>
 #include <limits>
 #include <sstream>
 
@@ -16,21 +13,22 @@ namespace PacBio {
 namespace Poa {
 namespace detail {
 
-std::string sequenceAlongPath(const BoostGraph& /*unused*/, const VertexInfoMap& vertexInfoMap,
-                              const std::vector<VD>& path)
+std::string sequenceAlongPath(const PoaDag& g, const std::vector<VD>& path)
 {
     std::ostringstream ss;
     for (const VD v : path) {
-        ss << vertexInfoMap[v].Base;
+        ss << g.Node(v).Base;
     }
     return ss.str();
 }
 
-boost::unordered_set<VD> SpanningDFS(const VD start, const VD end, const BoostGraph& g)
+// vertices on some path from start to end
+std::vector<VD> SpanningDFS(const VD start, const VD end, const PoaDag& g)
 {
     std::vector<VD> stack;
-    boost::unordered_set<VD> fwd;
-    boost::unordered_set<VD> rev;
+    std::vector<bool> fwd(g.NumSlots(), false);
+    std::vector<bool> rev(g.NumSlots(), false);
+    std::vector<VD> result;
     // find all vertices reachable from start
     stack.push_back(start);
     do {
@@ -38,12 +36,12 @@ boost::unordered_set<VD> SpanningDFS(const VD start, const VD end, const BoostGr
         stack.pop_back();
         // mark those we've already visited,
         //   if so, skip
-        if (fwd.find(v) != fwd.end()) {
+        if (fwd[v]) {
             continue;
         }
-        fwd.insert(v);
-        BOOST_FOREACH (const ED& e, out_edges(v, g)) {
-            stack.push_back(target(e, g));
+        fwd[v] = true;
+        for (const VD w : g.OutVertices(v)) {
+            stack.push_back(w);
         }
     } while (!stack.empty());
     // find all vertices that can reach end
@@ -54,29 +52,24 @@ boost::unordered_set<VD> SpanningDFS(const VD start, const VD end, const BoostGr
         stack.pop_back();
         // if it's not been visited in the forward pass,
         //   or we've already visited it here, skip
-        if (fwd.find(v) == fwd.end() || rev.find(v) != rev.end()) {
+        if (!fwd[v] || rev[v]) {
             continue;
         }
-        rev.insert(v);
-        BOOST_FOREACH (const ED& e, in_edges(v, g)) {
-            stack.push_back(source(e, g));
+        rev[v] = true;
+        result.push_back(v);
+        for (const VD u : g.InVertices(v)) {
+            stack.push_back(u);
         }
     } while (!stack.empty());
-    return rev;
+    return result;
 }
 
-std::vector<VD> PoaGraphImpl::sortedVertices() const
-{
-    std::vector<VD> sv(num_vertices(g_));
-    topological_sort(g_, sv.rbegin());
-    return sv;
-}
+const std::vector<VD>& PoaGraphImpl::sortedVertices() const { return g_.TopologicalOrder(); }
 
 void PoaGraphImpl::tagSpan(VD start, VD end)
 {
-    boost::unordered_set<VD> vertices = SpanningDFS(start, end, g_);
-    for (const VD v : vertices) {
-        vertexInfoMap_[v].SpanningReads++;
+    for (const VD v : SpanningDFS(start, end, g_)) {
+        g_.Node(v).SpanningReads++;
     }
 }
 
@@ -98,21 +91,19 @@ std::vector<VD> PoaGraphImpl::consensusPath(Align::AlignMode mode, int minCovera
     // against inclusion in the consensus.
     int totalReads = NumReads();
 
-    std::list<VD> path;
-    std::list<VD> sortedVerticesLocal(num_vertices(g_));
-    topological_sort(g_, sortedVerticesLocal.rbegin());
-    boost::unordered_map<VD, VD> bestPrevVertex;
+    std::vector<VD> path;
+    const std::vector<VD>& sortedVerticesLocal = g_.TopologicalOrder();
+    std::vector<VD> bestPrevVertex(g_.NumSlots(), null_vertex);
 
     // ignore ^ and $
     // TODO(dalexander): find a cleaner way to do this
-    vertexInfoMap_[sortedVerticesLocal.front()].ReachingScore = 0;
-    sortedVerticesLocal.pop_back();
-    sortedVerticesLocal.pop_front();
+    g_.Node(sortedVerticesLocal.front()).ReachingScore = 0;
 
     VD bestVertex = null_vertex;
     float bestReachingScore = -FLT_MAX;
-    for (const VD v : sortedVerticesLocal) {
-        PoaNode& vInfo = vertexInfoMap_[v];
+    for (std::size_t k = 1; k + 1 < sortedVerticesLocal.size(); ++k) {
+        const VD v = sortedVerticesLocal[k];
+        const PoaNode& vInfo = g_.Node(v);
         int containingReads = vInfo.Reads;
         int spanningReads = vInfo.SpanningReads;
         float score =
@@ -121,10 +112,8 @@ std::vector<VD> PoaGraphImpl::consensusPath(Align::AlignMode mode, int minCovera
                 : (2 * containingReads - 1 * totalReads - 0.0001F);
         vInfo.Score = score;
         vInfo.ReachingScore = score;
-        bestPrevVertex[v] = null_vertex;
-        for (const ED& e : inEdges(v, g_)) {
-            VD sourceVertex = source(e, g_);
-            float rsc = score + vertexInfoMap_[sourceVertex].ReachingScore;
+        for (const VD sourceVertex : g_.InVertices(v)) {
+            float rsc = score + g_.Node(sourceVertex).ReachingScore;
             if (rsc > vInfo.ReachingScore) {
                 vInfo.ReachingScore = rsc;
                 bestPrevVertex[v] = sourceVertex;
@@ -135,9 +124,8 @@ std::vector<VD> PoaGraphImpl::consensusPath(Align::AlignMode mode, int minCovera
             }
             // if the score is the same, the order we've encountered vertices
             //   might not be deterministic. Fix this by comparing on
-            //   vertex_index
-            else if ((rsc == bestReachingScore) &&
-                     (get(boost::vertex_index, g_, v) < get(boost::vertex_index, g_, bestVertex))) {
+            //   vertex creation order
+            else if ((rsc == bestReachingScore) && (v < bestVertex)) {
                 bestVertex = v;
             }
         }
@@ -147,10 +135,11 @@ std::vector<VD> PoaGraphImpl::consensusPath(Align::AlignMode mode, int minCovera
     // trace back from best-scoring vertex
     VD v = bestVertex;
     while (v != null_vertex) {
-        path.push_front(v);
+        path.push_back(v);
         v = bestPrevVertex[v];
     }
-    return std::vector<VD>(path.begin(), path.end());
+    std::reverse(path.begin(), path.end());
+    return path;
 }
 
 void PoaGraphImpl::threadFirstRead(std::string sequence, std::vector<Vertex>* outputPath)
@@ -167,15 +156,18 @@ void PoaGraphImpl::threadFirstRead(std::string sequence, std::vector<Vertex>* ou
     }
 
     for (const char base : sequence) {
-        v = addVertex(base);
+        v = addVertex(base, exitVertex_);
         if (outputPath) {
             outputPath->push_back(externalize(v));
         }
+        if (readPointers_) {
+            readPointers_->Add(v, numReads_, readPos);
+        }
         if (readPos == 0) {
-            add_edge(enterVertex_, v, g_);
+            g_.AddEdge(enterVertex_, v);
             startSpanVertex = v;
         } else {
-            add_edge(u, v, g_);
+            g_.AddEdge(u, v);
         }
         u = v;
         readPos++;
@@ -183,7 +175,8 @@ void PoaGraphImpl::threadFirstRead(std::string sequence, std::vector<Vertex>* ou
     assert(startSpanVertex != null_vertex);
     assert(u != null_vertex);
     endSpanVertex = u;
-    add_edge(u, exitVertex_, g_);  // terminus -> $
+    g_.AddEdge(u, exitVertex_);  // terminus -> $
+    g_.UpdateTopologicalOrder();
     tagSpan(startSpanVertex, endSpanVertex);
 }
 
@@ -201,7 +194,7 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
     VD u = exitVertex_;
     int span = 0;
     VD startSpanVertex;
-    VD endSpanVertex = alignmentColumnForVertex.at(exitVertex_)->PreviousVertex[I];
+    VD endSpanVertex = alignmentColumnForVertex.at(exitVertex_)->PreviousVertex(I);
 
     if (outputPath) {
         outputPath->resize(I);
@@ -209,9 +202,12 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
     }
 
 #define READPOS (i - 1)
-#define VERTEX_ON_PATH(readPos, v)                 \
-    if (outputPath) {                              \
-        (*outputPath)[(readPos)] = externalize(v); \
+#define VERTEX_ON_PATH(readPos, v)                     \
+    if (outputPath) {                                  \
+        (*outputPath)[(readPos)] = externalize(v);     \
+    }                                                  \
+    if (readPointers_) {                               \
+        readPointers_->Add((v), numReads_, (readPos)); \
     }
 
     while (!(u == enterVertex_ && i == 0)) {
@@ -220,14 +216,10 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
         // v: vertex last visited in traceback (could be == u)
         // forkVertex: the vertex that will be the target of a new edge
 
-        /* Vertex uExt = */ this->externalize(u);  // DEBUGGING
-        /* Vertex vExt = */ this->externalize(v);  // DEBUGGING
-
-        const AlignmentColumn* const curCol = alignmentColumnForVertex.at(u).get();
+        const AlignmentColumn* const curCol = alignmentColumnForVertex.at(u);
         assert(curCol != nullptr);
-        PoaNode& curNodeInfo = vertexInfoMap_[u];
-        VD prevVertex = curCol->PreviousVertex[i];
-        MoveType reachingMove = curCol->ReachingMove[i];
+        VD prevVertex = curCol->PreviousVertex(i);
+        MoveType reachingMove = curCol->Move(i);
 
         if (reachingMove == StartMove) {
             assert(v != null_vertex);
@@ -238,8 +230,8 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
             // In local model thread read bases, adjusting i (should stop at 0)
             while (i > 0) {
                 assert(alignMode == Align::AlignMode::LOCAL);
-                VD newForkVertex = addVertex(sequence[READPOS], 1, span);
-                add_edge(newForkVertex, forkVertex, g_);
+                VD newForkVertex = addVertex(sequence[READPOS], forkVertex, 1, span);
+                g_.AddEdge(newForkVertex, forkVertex);
                 VERTEX_ON_PATH(READPOS, newForkVertex);
                 forkVertex = newForkVertex;
                 i--;
@@ -253,13 +245,12 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
                 // Find the row # we are coming from, walk
                 // back to there, threading read bases onto
                 // graph via forkVertex, adjusting i.
-                const AlignmentColumn* const prevCol =
-                    alignmentColumnForVertex.at(prevVertex).get();
+                const AlignmentColumn* const prevCol = alignmentColumnForVertex.at(prevVertex);
                 int prevRow = ArgMax(prevCol->Score);
 
                 while (i > prevRow) {
-                    VD newForkVertex = addVertex(sequence[READPOS], 1, span);
-                    add_edge(newForkVertex, forkVertex, g_);
+                    VD newForkVertex = addVertex(sequence[READPOS], forkVertex, 1, span);
+                    g_.AddEdge(newForkVertex, forkVertex);
                     VERTEX_ON_PATH(READPOS, newForkVertex);
                     forkVertex = newForkVertex;
                     i--;
@@ -269,11 +260,11 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
             VERTEX_ON_PATH(READPOS, u);
             // if there is an extant forkVertex, join it
             if (forkVertex != null_vertex) {
-                add_edge(u, forkVertex, g_);
+                g_.AddEdge(u, forkVertex);
                 forkVertex = null_vertex;
             }
             // add to existing node
-            curNodeInfo.Reads++;
+            g_.Node(u).Reads++;
             i--;
         } else if (reachingMove == DeleteMove) {
             if (forkVertex == null_vertex) {
@@ -281,11 +272,11 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
             }
         } else if (reachingMove == ExtraMove || reachingMove == MismatchMove) {
             // begin a new arc with this read base
-            VD newForkVertex = addVertex(sequence[READPOS], 1, span);
             if (forkVertex == null_vertex) {
                 forkVertex = v;
             }
-            add_edge(newForkVertex, forkVertex, g_);
+            VD newForkVertex = addVertex(sequence[READPOS], forkVertex, 1, span);
+            g_.AddEdge(newForkVertex, forkVertex);
             VERTEX_ON_PATH(READPOS, newForkVertex);
             forkVertex = newForkVertex;
             i--;
@@ -295,16 +286,18 @@ void PoaGraphImpl::tracebackAndThread(std::string sequence,
 
         v = u;
         u = prevVertex;
-        span = curNodeInfo.SpanningReads;
+        // NB: not held across the loop body, as addVertex may reallocate nodes
+        span = g_.Node(v).SpanningReads;
     }
     startSpanVertex = v;
 
     // if there is an extant forkVertex, join it to enterVertex
     if (forkVertex != null_vertex) {
-        add_edge(enterVertex_, forkVertex, g_);
+        g_.AddEdge(enterVertex_, forkVertex);
         startSpanVertex = forkVertex;
         forkVertex = null_vertex;
     }
+    g_.UpdateTopologicalOrder();
 
     if (startSpanVertex != exitVertex_) {
         tagSpan(startSpanVertex, endSpanVertex);
@@ -0,0 +1,92 @@
+#ifndef PBCOPPER_POA_POAREADPOINTERS_H
+#define PBCOPPER_POA_POAREADPOINTERS_H
+
+#include <pbcopper/PbcopperConfig.h>
+
+#include "PoaDag.h"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace Poa {
+namespace detail {
+
+///
+/// \brief The PoaReadPointers class records, for each vertex, the (read,
+///        position) pairs threaded through it: the "aligned residues" of the
+///        Lee et al. POA.
+///
+/// Entries live in one flat array, chained per vertex in the order they were
+/// added, at 12 bytes per read base plus 8 bytes per vertex.
+///
+class PoaReadPointers
+{
+public:
+    void Add(const VD v, const std::size_t readId, const std::size_t readPos)
+    {
+        if (readId >= NONE || readPos >= NONE || entries_.size() >= NONE) {
+            throw std::length_error{"[pbcopper] poa ERROR: too many read pointers"};
+        }
+        if (v >= head_.size()) {
+            head_.resize(v + 1, NONE);
+            tail_.resize(v + 1, NONE);
+        }
+
+        const auto index = static_cast<std::uint32_t>(entries_.size());
+        entries_.push_back(
+            Entry{static_cast<std::uint32_t>(readId), static_cast<std::uint32_t>(readPos), NONE});
+        if (head_[v] == NONE) {
+            head_[v] = index;
+        } else {
+            entries_[tail_[v]].Next = index;
+        }
+        tail_[v] = index;
+    }
+
+    ///
+    /// Calls f(readId, readPos) for each read base threaded through 'v', in
+    /// the order the reads were added.
+    ///
+    template <typename F>
+    void ForEach(const VD v, F&& f) const
+    {
+        if (v >= head_.size()) {
+            return;
+        }
+        for (std::uint32_t i = head_[v]; i != NONE; i = entries_[i].Next) {
+            f(std::size_t{entries_[i].Read}, std::size_t{entries_[i].Position});
+        }
+    }
+
+    void Clear()
+    {
+        head_.clear();
+        tail_.clear();
+        entries_.clear();
+    }
+
+private:
+    static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    struct Entry
+    {
+        std::uint32_t Read;
+        std::uint32_t Position;
+        std::uint32_t Next;
+    };
+
+    std::vector<std::uint32_t> head_;
+    std::vector<std::uint32_t> tail_;
+    std::vector<Entry> entries_;
+};
+
+}  // namespace detail
+}  // namespace Poa
+}  // namespace PacBio
+
+#endif  // PBCOPPER_POA_POAREADPOINTERS_H
@@ -2,10 +2,6 @@
 
 #include "PoaGraphImpl.h"
 
-#include <boost/foreach.hpp>
-#include <boost/graph/topological_sort.hpp>
-#include <boost/range/adaptor/reversed.hpp>
-
 #include <algorithm>
 #include <map>
 #include <optional>
@@ -13,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include <climits>
 #include <cstddef>
 
 #define WIDTH 30
@@ -121,14 +118,12 @@ void SdpRangeFinder::InitRangeFinder(const PoaGraphImpl& poaGraph,
     std::cout << "RawAnchors length: " << anchors.size() << std::endl;
 #endif
 
-    std::map<VD, std::optional<IntervalPair>> directRanges;
-    std::map<VD, IntervalPair> fwdMarks, revMarks;
+    const PoaDag& g = poaGraph.g_;
+    std::vector<std::optional<IntervalPair>> directRanges(g.NumSlots());
+    std::vector<IntervalPair> fwdMarks(g.NumSlots(), emptyInterval);
+    std::vector<IntervalPair> revMarks(g.NumSlots(), emptyInterval);
 
-    std::vector<VD> sortedVertices(num_vertices(poaGraph.g_));
-    topological_sort(poaGraph.g_, sortedVertices.rbegin());
-    for (const VD v : sortedVertices) {
-        directRanges[v] = std::nullopt;
-    }
+    const std::vector<VD>& sortedVertices = g.TopologicalOrder();
 
     // Find the "direct ranges" implied by the anchors between the
     // css and this read.  Possibly null.
@@ -151,40 +146,29 @@ void SdpRangeFinder::InitRangeFinder(const PoaGraphImpl& poaGraph,
     // letting a node with null direct range have a range that is the
     // union of the "forward stepped" ranges of its predecessors
     for (const VD v : sortedVertices) {
-        /* Vertex vExt = */ poaGraph.externalize(v);  // DEBUGGING
-
-        std::optional<IntervalPair> directRange = directRanges.at(v);
+        const std::optional<IntervalPair>& directRange = directRanges[v];
         if (directRange) {
             fwdMarks[v] = *directRange;
         } else {
-            std::vector<IntervalPair> predRangesStepped;
-            for (const ED& e : inEdges(v, poaGraph.g_)) {
-                VD pred = source(e, poaGraph.g_);
-                /* Vertex predExt = */ poaGraph.externalize(pred);  // DEBUGGING
-                IntervalPair predRangeStepped = next(fwdMarks.at(pred), readLength);
-                predRangesStepped.push_back(predRangeStepped);
+            IntervalPair fwdInterval = emptyInterval;
+            for (const VD pred : g.InVertices(v)) {
+                fwdInterval = RangeUnion(fwdInterval, next(fwdMarks[pred], readLength));
             }
-            IntervalPair fwdInterval = RangeUnion(predRangesStepped);
             fwdMarks[v] = fwdInterval;
         }
     }
 
     // Do the same thing, but as a backwards recursion
-    for (const VD v : boost::adaptors::reverse(sortedVertices)) {
-        /* Vertex vExt = */ poaGraph.externalize(v);  // DEBUGGING
-
-        std::optional<IntervalPair> directRange = directRanges.at(v);
+    for (auto it = sortedVertices.rbegin(); it != sortedVertices.rend(); ++it) {
+        const VD v = *it;
+        const std::optional<IntervalPair>& directRange = directRanges[v];
         if (directRange) {
             revMarks[v] = *directRange;
         } else {
-            std::vector<IntervalPair> succRangesStepped;
-            BOOST_FOREACH (const ED& e, out_edges(v, poaGraph.g_)) {
-                VD succ = target(e, poaGraph.g_);
-                /* Vertex succExt = */ poaGraph.externalize(succ);  // DEBUGGING
-                IntervalPair succRangeStepped = prev(revMarks.at(succ), 0);
-                succRangesStepped.push_back(succRangeStepped);
+            IntervalPair revInterval = emptyInterval;
+            for (const VD succ : g.OutVertices(v)) {
+                revInterval = RangeUnion(revInterval, prev(revMarks[succ], 0));
             }
-            IntervalPair revInterval = RangeUnion(succRangesStepped);
             revMarks[v] = revInterval;
         }
     }
@@ -192,7 +176,7 @@ void SdpRangeFinder::InitRangeFinder(const PoaGraphImpl& poaGraph,
     // take hulls of extents from forward and reverse recursions
     for (const VD v : sortedVertices) {
         Vertex vExt = poaGraph.externalize(v);
-        alignableReadIntervalByVertex_[vExt] = RangeUnion(fwdMarks.at(v), revMarks.at(v));
+        alignableReadIntervalByVertex_[vExt] = RangeUnion(fwdMarks[v], revMarks[v]);
 #if DEBUG_RANGE_FINDER
         cout << vExt << "\t";
         if (anchorByVertex.find(vExt) != anchorByVertex.end()) {
@@ -69,22 +69,23 @@ detail::SdpAnchorVector SdpRangeFinder::FindAnchors(const std::string& consensus
 
 SparsePoa::SparsePoa()
     : graph_(std::make_unique<PoaGraph>())
-    , readPaths_()
+    , readLengths_()
     , reverseComplemented_()
     , rangeFinder_(std::make_unique<SdpRangeFinder>())
-{}
+{
+    graph_->EnableReadPointers();
+}
 
 SparsePoa::~SparsePoa() = default;
 
 SparsePoa::ReadKey SparsePoa::AddRead(const std::string& readSequence,
                                       const PoaAlignmentOptions& alnOptions)
 {
-    Path outputPath;
     ReadKey key = -1;
 
     if (graph_->NumReads() == 0) {
-        graph_->AddFirstRead(readSequence, &outputPath);
-        readPaths_.push_back(outputPath);
+        graph_->AddFirstRead(readSequence);
+        readLengths_.push_back(readSequence.size());
         reverseComplemented_.push_back(false);
         key = graph_->NumReads() - 1;
     } else {
@@ -92,8 +93,8 @@ SparsePoa::ReadKey SparsePoa::AddRead(const std::string& readSequence,
             graph_->TryAddRead(readSequence, alnOptions.alignConfig, rangeFinder_.get())};
 
         if (c->Score() >= alnOptions.minScoreToAdd) {
-            graph_->CommitAdd(c.get(), &outputPath);
-            readPaths_.push_back(outputPath);
+            graph_->CommitAdd(c.get());
+            readLengths_.push_back(readSequence.size());
             reverseComplemented_.push_back(false);
             key = graph_->NumReads() - 1;
         }
@@ -186,12 +187,11 @@ std::string ReverseComplement(const std::string& input)
 SparsePoa::ReadKey SparsePoa::OrientAndAddRead(const std::string& readSequence,
                                                const PoaAlignmentOptions& alnOptions)
 {
-    Path outputPath;
     ReadKey key;
 
     if (graph_->NumReads() == 0) {
-        graph_->AddFirstRead(readSequence, &outputPath);
-        readPaths_.push_back(outputPath);
+        graph_->AddFirstRead(readSequence);
+        readLengths_.push_back(readSequence.size());
         reverseComplemented_.push_back(false);
         key = graph_->NumReads() - 1;
     } else {
@@ -201,13 +201,13 @@ SparsePoa::ReadKey SparsePoa::OrientAndAddRead(const std::string& readSequence,
             TEST::ReverseComplement(readSequence), alnOptions.alignConfig, rangeFinder_.get())};
 
         if (c1->Score() >= c2->Score() && c1->Score() >= alnOptions.minScoreToAdd) {
-            graph_->CommitAdd(c1.get(), &outputPath);
-            readPaths_.push_back(outputPath);
+            graph_->CommitAdd(c1.get());
+            readLengths_.push_back(readSequence.size());
             reverseComplemented_.push_back(false);
             key = graph_->NumReads() - 1;
         } else if (c2->Score() >= c1->Score() && c2->Score() >= alnOptions.minScoreToAdd) {
-            graph_->CommitAdd(c2.get(), &outputPath);
-            readPaths_.push_back(outputPath);
+            graph_->CommitAdd(c2.get());
+            readLengths_.push_back(readSequence.size());
             reverseComplemented_.push_back(true);
             key = graph_->NumReads() - 1;
         } else {
@@ -233,50 +233,40 @@ std::shared_ptr<const PoaConsensus> SparsePoa::FindConsensus(
     if (summaries != nullptr) {
         summaries->clear();
 
-        // digest the consensus path consensus into map(vtx, pos)
-        // the fold over the readPaths
-        std::map<PoaGraph::Vertex, std::size_t> cssPosition;
-
-        int i = 0;
-        for (PoaGraph::Vertex v : pc->Path) {
-            cssPosition[v] = i;
-            i++;
+        // extents of each read on the consensus, from the read bases threaded
+        // through the consensus path; reads cross the path in order, so the
+        // first and last bases seen bound both extents
+        struct ReadExtents
+        {
+            bool Found = false;
+            std::size_t ReadS = 0;
+            std::size_t ReadE = 0;
+            std::size_t CssS = 0;
+            std::size_t CssE = 0;
+            std::size_t NumOnPath = 0;
+        };
+        std::vector<ReadExtents> extents(graph_->NumReads());
+        for (const auto& rp : graph_->ReadPointersAlong(pc->Path)) {
+            ReadExtents& e = extents[rp.Read];
+            if (!e.Found) {
+                e.ReadS = rp.ReadPosition;
+                e.CssS = rp.PathIndex;
+                e.Found = true;
+            }
+            e.ReadE = rp.ReadPosition + 1;
+            e.CssE = rp.PathIndex + 1;
+            ++e.NumOnPath;
         }
 
         for (std::size_t readId = 0; readId < graph_->NumReads(); readId++) {
-            std::size_t readS = 0;
-            std::size_t readE = 0;
-            std::size_t cssS = 0;
-            std::size_t cssE = 0;
-            bool foundStart = false;
-            std::size_t nErr = 0;
-
-            const std::vector<PoaGraph::Vertex>& readPath = readPaths_[readId];
-
-            for (std::size_t readPos = 0; readPos < readPath.size(); readPos++) {
-                PoaGraph::Vertex v = readPath[readPos];
-                if (cssPosition.find(v) != cssPosition.end()) {
-                    if (!foundStart) {
-                        cssS = cssPosition[v];
-                        readS = readPos;
-                        foundStart = true;
-                    }
-
-                    cssE = cssPosition[v] + 1;
-                    readE = readPos + 1;
-                } else {
-                    nErr += 1;
-                }
-            }
-
-            Interval readExtent(readS, readE);
-            Interval cssExtent(cssS, cssE);
+            const ReadExtents& e = extents[readId];
+            const std::size_t nErr = readLengths_[readId] - e.NumOnPath;
 
             PoaAlignmentSummary summary;
             summary.ReverseComplementedRead = reverseComplemented_[readId];
-            summary.ExtentOnRead = readExtent;
-            summary.ExtentOnConsensus = cssExtent;
-            summary.AlignmentIdentity = std::max(0.0F, 1.0F - 1.0F * nErr / cssPosition.size());
+            summary.ExtentOnRead = Interval(e.ReadS, e.ReadE);
+            summary.ExtentOnConsensus = Interval(e.CssS, e.CssE);
+            summary.AlignmentIdentity = std::max(0.0F, 1.0F - 1.0F * nErr / pc->Path.size());
 
             (*summaries).push_back(summary);
         }
@@ -305,7 +295,7 @@ void SparsePoa::PruneGraph(const int minCoverage) { graph_->PruneGraph(minCovera
 
 void SparsePoa::repCheck()
 {
-    assert(graph_->NumReads() == readPaths_.size());
+    assert(graph_->NumReads() == readLengths_.size());
     assert(graph_->NumReads() == reverseComplemented_.size());
 }
 
@@ -3,8 +3,9 @@
 
 #include <pbcopper/PbcopperConfig.h>
 
+#include "PoaArena.h"
+
 #include <algorithm>
-#include <vector>
 
 #include <cassert>
 #include <cstddef>
@@ -30,21 +31,22 @@ std::size_t ArgMax(const VectorL<T>& v);
 // without
 //  cleaning it up/refactoring it quite a bit)
 //
+// Storage comes from, and lives as long as, a PoaArena.
+//
 template <typename T>
 class VectorL
 {
 private:
-    std::vector<T> storage_;
+    T* storage_;
     std::size_t beginRow_;
     std::size_t endRow_;
 
 public:
-    VectorL(int beginRow, int endRow, T defaultVal = T())
-        : storage_(endRow - beginRow, defaultVal), beginRow_(beginRow), endRow_(endRow)
-    {}
-
-    VectorL(VectorL&&) noexcept = default;
-    VectorL& operator=(VectorL&&) noexcept = default;
+    VectorL(PoaArena* arena, int beginRow, int endRow, T defaultVal = T())
+        : storage_(arena->Allocate<T>(endRow - beginRow)), beginRow_(beginRow), endRow_(endRow)
+    {
+        std::fill_n(storage_, endRow - beginRow, defaultVal);
+    }
 
     T& operator[](std::size_t pos) noexcept
     {
@@ -67,14 +69,14 @@ public:
 template <typename T>
 T Max(const VectorL<T>& v)
 {
-    return *std::max_element(v.storage_.begin(), v.storage_.end());
+    return *std::max_element(v.storage_, v.storage_ + (v.endRow_ - v.beginRow_));
 }
 
 template <typename T>
 std::size_t ArgMax(const VectorL<T>& v)
 {
-    return v.beginRow_ + std::distance(v.storage_.begin(),
-                                       std::max_element(v.storage_.begin(), v.storage_.end()));
+    return v.beginRow_ +
+           (std::max_element(v.storage_, v.storage_ + (v.endRow_ - v.beginRow_)) - v.storage_);
 }
 
 }  // namespace detail
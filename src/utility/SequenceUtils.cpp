@@ -0,0 +1,599 @@
+#include <pbcopper/utility/SequenceUtils.h>
+
+#include <pbcopper/container/BitConversion.h>
+
+#include "../../third-party/simde/x86/sse4.1.h"
+
+// As in align/cssw/ssw.c, wider kernels are compiled with per-function target
+// attributes and selected at runtime.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PBCOPPER_SEQUENCEUTILS_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <cassert>
+#include <cstring>
+
+namespace PacBio {
+namespace Utility {
+namespace {
+
+constexpr std::size_t BLOCK = 16;
+
+///
+/// Byte-to-byte mapping of ASCII characters, any others mapping to 'fallback',
+/// applied to 16 bytes at a time: the low nibble indexes one 16-entry table
+/// per high nibble with pshufb, and the high nibble selects the result.
+///
+class ByteLookup
+{
+public:
+    ByteLookup(const std::uint8_t fallback,
+               const std::initializer_list<std::pair<char, std::uint8_t>> entries,
+               const bool caseInsensitive)
+    {
+        table_.fill(fallback);
+        for (const auto& [c, value] : entries) {
+            const auto index = static_cast<unsigned char>(c);
+            table_[index] = value;
+            if (caseInsensitive && c >= 'A' && c <= 'Z') {
+                table_[index + ('a' - 'A')] = value;
+            }
+        }
+
+        fallback_ = simde_mm_set1_epi8(static_cast<char>(fallback));
+        for (int hi = 0; hi < 8; ++hi) {
+            alignas(16) std::array<std::uint8_t, 16> row;
+            std::copy_n(table_.begin() + 16 * hi, 16, row.begin());
+            used_[hi] = std::ranges::any_of(row, [=](std::uint8_t v) { return v != fallback; });
+            rows_[hi] = simde_mm_load_si128(reinterpret_cast<const simde__m128i*>(row.data()));
+        }
+    }
+
+    std::uint8_t Fallback() const noexcept { return table_[0x80]; }
+
+    // the 16 values for characters 16 * hi + [0, 16), or null if all are the fallback
+    const std::uint8_t* Row(const int hi) const noexcept
+    {
+        return used_[hi] ? table_.data() + 16 * hi : nullptr;
+    }
+
+    std::uint8_t operator()(const char c) const noexcept
+    {
+        const auto index = static_cast<unsigned char>(c);
+        return index < 128 ? table_[index] : table_[0x80];
+    }
+
+    simde__m128i operator()(const simde__m128i v) const noexcept
+    {
+        const simde__m128i lowNibbles = simde_mm_and_si128(v, simde_mm_set1_epi8(0x0F));
+        const simde__m128i highNibbles =
+            simde_mm_and_si128(simde_mm_srli_epi16(v, 4), simde_mm_set1_epi8(0x0F));
+
+        simde__m128i result = fallback_;
+        for (int hi = 0; hi < 8; ++hi) {
+            if (used_[hi]) {
+                const simde__m128i selected =
+                    simde_mm_cmpeq_epi8(highNibbles, simde_mm_set1_epi8(static_cast<char>(hi)));
+                result = simde_mm_blendv_epi8(result, simde_mm_shuffle_epi8(rows_[hi], lowNibbles),
+                                              selected);
+            }
+        }
+        return result;
+    }
+
+private:
+    // ASCII entries, plus the fallback for all others at 0x80
+    std::array<std::uint8_t, 129> table_;
+    simde__m128i fallback_;
+    simde__m128i rows_[8];
+    std::array<bool, 8> used_;
+};
+
+// same as Complement(), 0 marks invalid bases
+const ByteLookup& ComplementLookup()
+{
+    static const ByteLookup lookup{0,
+                                   {{'A', 'T'},
+                                    {'B', 'V'},
+                                    {'C', 'G'},
+                                    {'D', 'H'},
+                                    {'G', 'C'},
+                                    {'H', 'D'},
+                                    {'K', 'M'},
+                                    {'M', 'K'},
+                                    {'N', 'N'},
+                                    {'R', 'Y'},
+                                    {'S', 'S'},
+                                    {'T', 'A'},
+                                    {'U', 'A'},
+                                    {'V', 'B'},
+                                    {'W', 'W'},
+                                    {'Y', 'R'},
+                                    {'*', '*'},
+                                    {'-', '-'}},
+                                   true};
+    return lookup;
+}
+
+const ByteLookup& CaseSensitiveComplementLookup()
+{
+    static const ByteLookup lookup{4,
+                                   {{'A', 'T'},
+                                    {'C', 'G'},
+                                    {'G', 'C'},
+                                    {'N', 'N'},
+                                    {'T', 'A'},
+                                    {'U', 'A'},
+                                    {'a', 't'},
+                                    {'c', 'g'},
+                                    {'g', 'c'},
+                                    {'t', 'a'},
+                                    {'u', 'a'},
+                                    {' ', ' '},
+                                    {'*', '*'},
+                                    {'-', '-'}},
+                                   false};
+    return lookup;
+}
+
+// BAM 4-bit codes, 0xFF marks invalid bases
+constexpr std::uint8_t INVALID_CODE = 0xFF;
+
+const ByteLookup& FourBitLookup()
+{
+    static const ByteLookup lookup{INVALID_CODE,
+                                   {{'=', 0},
+                                    {'A', 1},
+                                    {'C', 2},
+                                    {'M', 3},
+                                    {'G', 4},
+                                    {'R', 5},
+                                    {'S', 6},
+                                    {'V', 7},
+                                    {'T', 8},
+                                    {'U', 8},
+                                    {'W', 9},
+                                    {'Y', 10},
+                                    {'H', 11},
+                                    {'K', 12},
+                                    {'D', 13},
+                                    {'B', 14},
+                                    {'N', 15}},
+                                   true};
+    return lookup;
+}
+
+simde__m128i Load(const void* p) noexcept
+{
+    return simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(p));
+}
+
+void Store(void* p, const simde__m128i v) noexcept
+{
+    simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(p), v);
+}
+
+simde__m128i ReverseBytes(const simde__m128i v) noexcept
+{
+    return simde_mm_shuffle_epi8(
+        v, simde_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+bool HasByte(const simde__m128i v, const std::uint8_t byte) noexcept
+{
+    return simde_mm_movemask_epi8(
+               simde_mm_cmpeq_epi8(v, simde_mm_set1_epi8(static_cast<char>(byte)))) != 0;
+}
+
+#ifdef PBCOPPER_SEQUENCEUTILS_X86_DISPATCH
+
+#define PBCOPPER_TARGET_AVX2 __attribute__((target("avx2")))
+
+bool HasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+///
+/// ByteLookup tables for 32 bytes at a time: pshufb works within 128-bit
+/// lanes, so each row is broadcast to both.
+///
+struct WideLookup
+{
+    __m256i Fallback;
+    __m256i Rows[8];
+    __m256i HighNibbles[8];
+    int NumRows = 0;
+};
+
+PBCOPPER_TARGET_AVX2 WideLookup MakeWideLookup(const ByteLookup& lookup)
+{
+    WideLookup result;
+    result.Fallback = _mm256_set1_epi8(static_cast<char>(lookup.Fallback()));
+    for (int hi = 0; hi < 8; ++hi) {
+        if (const std::uint8_t* row = lookup.Row(hi)) {
+            result.Rows[result.NumRows] =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row)));
+            result.HighNibbles[result.NumRows] = _mm256_set1_epi8(static_cast<char>(hi));
+            ++result.NumRows;
+        }
+    }
+    return result;
+}
+
+PBCOPPER_TARGET_AVX2 inline __m256i Map(const WideLookup& lookup, const __m256i v)
+{
+    const __m256i lowNibbles = _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
+    const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+
+    __m256i result = lookup.Fallback;
+    for (int k = 0; k < lookup.NumRows; ++k) {
+        result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(lookup.Rows[k], lowNibbles),
+                                    _mm256_cmpeq_epi8(highNibbles, lookup.HighNibbles[k]));
+    }
+    return result;
+}
+
+PBCOPPER_TARGET_AVX2 inline __m256i ReverseBytes(const __m256i v)
+{
+    const __m256i reversedLanes = _mm256_shuffle_epi8(
+        v, _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12,
+                            11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    return _mm256_permute4x64_epi64(reversedLanes, 0x4E);
+}
+
+///
+/// AVX2 front end of ReverseAndMap: swaps mapped 32-byte blocks from both ends
+/// of [*i, *j), stopping before a pair that holds an 'invalid' mapping, which
+/// is left, unmodified, to the 16-byte loop.
+///
+PBCOPPER_TARGET_AVX2 void ReverseAndMapAvx2(char* const data, std::uint8_t* const quals,
+                                            const ByteLookup& byteLookup,
+                                            const std::uint8_t invalid, std::size_t* i,
+                                            std::size_t* j)
+{
+    constexpr std::size_t WIDE_BLOCK = 32;
+    const WideLookup lookup = MakeWideLookup(byteLookup);
+    const __m256i invalidBytes = _mm256_set1_epi8(static_cast<char>(invalid));
+
+    while (*j - *i >= 2 * WIDE_BLOCK) {
+        char* const front = data + *i;
+        char* const back = data + *j - WIDE_BLOCK;
+        const __m256i mappedFront =
+            Map(lookup, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(front)));
+        const __m256i mappedBack =
+            Map(lookup, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(back)));
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(mappedFront, invalidBytes),
+                                                 _mm256_cmpeq_epi8(mappedBack, invalidBytes))) !=
+            0) {
+            return;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(front), ReverseBytes(mappedBack));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(back), ReverseBytes(mappedFront));
+
+        if (quals) {
+            auto* const frontQuals = reinterpret_cast<__m256i*>(quals + *i);
+            auto* const backQuals = reinterpret_cast<__m256i*>(quals + *j - WIDE_BLOCK);
+            const __m256i reversedFront = ReverseBytes(_mm256_loadu_si256(frontQuals));
+            _mm256_storeu_si256(frontQuals, ReverseBytes(_mm256_loadu_si256(backQuals)));
+            _mm256_storeu_si256(backQuals, reversedFront);
+        }
+
+        *i += WIDE_BLOCK;
+        *j -= WIDE_BLOCK;
+    }
+}
+
+#undef PBCOPPER_TARGET_AVX2
+
+#endif  // PBCOPPER_SEQUENCEUTILS_X86_DISPATCH
+
+// Throws for the first invalid base of 'seq', as Complement()
+void ThrowInvalidBase(const std::string_view seq)
+{
+    for (const char c : seq) {
+        Complement(c);
+    }
+    assert(false);
+}
+
+void ThrowInvalidPackedBase(const char base, const char* format)
+{
+    throw std::invalid_argument{"[pbcopper] sequence utils ERROR: " + std::string(1, base) +
+                                " cannot be packed as " + format};
+}
+
+///
+/// Reverses 'seq' in place while mapping each character, and 'quals' (if not
+/// empty) alongside it. If a character maps to 'invalid', 'check' is called
+/// with the still unmodified range of 'seq' starting at or before it.
+///
+template <typename Check>
+void ReverseAndMap(std::string& seq, const std::span<std::uint8_t> quals, const ByteLookup& lookup,
+                   const std::uint8_t invalid, Check&& check)
+{
+    char* const data = seq.data();
+    std::size_t i = 0;
+    std::size_t j = seq.size();
+    const bool withQuals = !quals.empty();
+
+#ifdef PBCOPPER_SEQUENCEUTILS_X86_DISPATCH
+    if (HasAvx2()) {
+        ReverseAndMapAvx2(data, withQuals ? quals.data() : nullptr, lookup, invalid, &i, &j);
+    }
+#endif
+
+    while (j - i >= 2 * BLOCK) {
+        const simde__m128i front = ReverseBytes(lookup(Load(data + i)));
+        const simde__m128i back = ReverseBytes(lookup(Load(data + j - BLOCK)));
+        if (HasByte(front, invalid) || HasByte(back, invalid)) {
+            check(std::string_view{data + i, j - i});
+        }
+        Store(data + i, back);
+        Store(data + j - BLOCK, front);
+
+        if (withQuals) {
+            const simde__m128i frontQuals = ReverseBytes(Load(quals.data() + i));
+            Store(quals.data() + i, ReverseBytes(Load(quals.data() + j - BLOCK)));
+            Store(quals.data() + j - BLOCK, frontQuals);
+        }
+
+        i += BLOCK;
+        j -= BLOCK;
+    }
+
+    // middle, in sequence order so the first invalid base is reported
+    for (std::size_t k = i; k < j; ++k) {
+        const std::uint8_t mapped = lookup(data[k]);
+        if (mapped == invalid) {
+            check(std::string_view{data + k, j - k});
+        }
+        data[k] = static_cast<char>(mapped);
+    }
+    std::reverse(data + i, data + j);
+    if (withQuals) {
+        std::reverse(quals.data() + i, quals.data() + j);
+    }
+}
+
+// 256 entries of 'N' unpacked bases each
+template <std::size_t N>
+using UnpackTable = std::array<std::array<char, N>, 256>;
+
+constexpr UnpackTable<4> MakeTwoBitTable()
+{
+    UnpackTable<4> table{};
+    for (int byte = 0; byte < 256; ++byte) {
+        for (int k = 0; k < 4; ++k) {
+            table[byte][k] = "ACGT"[(byte >> (6 - 2 * k)) & 0b11];
+        }
+    }
+    return table;
+}
+
+constexpr UnpackTable<2> MakeFourBitTable()
+{
+    UnpackTable<2> table{};
+    for (int byte = 0; byte < 256; ++byte) {
+        table[byte][0] = "=ACMGRSVTWYHKDBN"[byte >> 4];
+        table[byte][1] = "=ACMGRSVTWYHKDBN"[byte & 0x0F];
+    }
+    return table;
+}
+
+void CheckPackedSize(const std::size_t actual, const std::size_t expected)
+{
+    if (actual != expected) {
+        throw std::invalid_argument{"[pbcopper] sequence utils ERROR: packed buffer holds " +
+                                    std::to_string(actual) + " bytes, expected " +
+                                    std::to_string(expected)};
+    }
+}
+
+}  // namespace
+
+void ReverseComplement(std::string& seq) { ReverseComplement(seq, std::span<std::uint8_t>{}); }
+
+void ReverseComplement(std::string& seq, const std::span<std::uint8_t> quals)
+{
+    if (!quals.empty() && quals.size() != seq.size()) {
+        throw std::invalid_argument{
+            "[pbcopper] sequence utils ERROR: " + std::to_string(quals.size()) + " qualities for " +
+            std::to_string(seq.size()) + " bases"};
+    }
+    ReverseAndMap(seq, quals, ComplementLookup(), 0, ThrowInvalidBase);
+}
+
+void ReverseComplementCaseSens(std::string& seq)
+{
+    // every character has a complement, so the check never fires
+    ReverseAndMap(seq, {}, CaseSensitiveComplementLookup(), 0, [](std::string_view) {});
+}
+
+std::string_view ReverseComplement(const std::string_view input, char* output)
+{
+    const ByteLookup& lookup = ComplementLookup();
+    const std::size_t strLen = input.length();
+
+    // output position 'i' complements input position 'strLen - 1 - i', so
+    // blocks are taken from the back of the input
+    std::size_t i = 0;
+    for (; i + BLOCK <= strLen; i += BLOCK) {
+        const simde__m128i block = lookup(Load(input.data() + strLen - i - BLOCK));
+        if (HasByte(block, 0)) {
+            break;
+        }
+        Store(output + i, ReverseBytes(block));
+    }
+    for (; i < strLen; ++i) {
+        output[i] = Complement(input[strLen - 1 - i]);
+    }
+    return {output, strLen};
+}
+
+void ToUpper(std::string& seq)
+{
+    char* const data = seq.data();
+    const std::size_t size = seq.size();
+
+    std::size_t i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        const simde__m128i v = Load(data + i);
+        // signed compares, leaving bytes >= 0x80 alone
+        const simde__m128i lower =
+            simde_mm_and_si128(simde_mm_cmpgt_epi8(v, simde_mm_set1_epi8('a' - 1)),
+                               simde_mm_cmplt_epi8(v, simde_mm_set1_epi8('z' + 1)));
+        Store(data + i,
+              simde_mm_sub_epi8(v, simde_mm_and_si128(lower, simde_mm_set1_epi8('a' - 'A'))));
+    }
+    for (; i < size; ++i) {
+        if (data[i] >= 'a' && data[i] <= 'z') {
+            data[i] -= ('a' - 'A');
+        }
+    }
+}
+
+std::size_t FindInvalidBase(const std::string_view seq)
+{
+    const ByteLookup& lookup = ComplementLookup();
+
+    std::size_t i = 0;
+    for (; i + BLOCK <= seq.size(); i += BLOCK) {
+        const int invalid = simde_mm_movemask_epi8(
+            simde_mm_cmpeq_epi8(lookup(Load(seq.data() + i)), simde_mm_setzero_si128()));
+        if (invalid != 0) {
+            return i + std::countr_zero(static_cast<unsigned>(invalid));
+        }
+    }
+    for (; i < seq.size(); ++i) {
+        if (lookup(seq[i]) == 0) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+void PackTwoBit(const std::string_view seq, const std::span<std::uint8_t> packed)
+{
+    CheckPackedSize(packed.size(), (seq.size() + 3) / 4);
+
+    const auto validate = [](const simde__m128i v) {
+        const simde__m128i upper = simde_mm_and_si128(v, simde_mm_set1_epi8(~0x20));
+        const simde__m128i valid = simde_mm_or_si128(
+            simde_mm_or_si128(simde_mm_cmpeq_epi8(upper, simde_mm_set1_epi8('A')),
+                              simde_mm_cmpeq_epi8(upper, simde_mm_set1_epi8('C'))),
+            simde_mm_or_si128(simde_mm_cmpeq_epi8(upper, simde_mm_set1_epi8('G')),
+                              simde_mm_cmpeq_epi8(upper, simde_mm_set1_epi8('T'))));
+        return simde_mm_movemask_epi8(valid) == 0xFFFF;
+    };
+
+    // bits 1-2 of the ASCII code are A=0, C=1, G=3, T=2
+    const auto toCodes = [](const simde__m128i v) {
+        const simde__m128i bits =
+            simde_mm_and_si128(simde_mm_srli_epi16(v, 1), simde_mm_set1_epi8(0b11));
+        return simde_mm_xor_si128(
+            bits, simde_mm_and_si128(simde_mm_srli_epi16(bits, 1), simde_mm_set1_epi8(0b01)));
+    };
+
+    std::size_t i = 0;
+    for (; i + BLOCK <= seq.size(); i += BLOCK) {
+        const simde__m128i v = Load(seq.data() + i);
+        if (!validate(v)) {
+            break;
+        }
+        // 4 * c0 + c1 per 16 bits, then 16 * (4 * c0 + c1) + (4 * c2 + c3) per 32 bits
+        const simde__m128i pairs = simde_mm_maddubs_epi16(toCodes(v), simde_mm_set1_epi16(0x0104));
+        const simde__m128i quads = simde_mm_madd_epi16(pairs, simde_mm_set1_epi32(0x00010010));
+        const simde__m128i bytes = simde_mm_shuffle_epi8(
+            quads, simde_mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        const auto word = static_cast<std::uint32_t>(simde_mm_cvtsi128_si32(bytes));
+        std::memcpy(packed.data() + i / 4, &word, sizeof(word));
+    }
+
+    for (; i < seq.size(); i += 4) {
+        std::uint8_t byte = 0;
+        for (std::size_t k = 0; k < 4; ++k) {
+            std::int32_t code = 0;
+            if (i + k < seq.size()) {
+                code = Container::ConvertAsciiTo2bit<false, true>(seq[i + k]);
+                if (code > 3) {
+                    ThrowInvalidPackedBase(seq[i + k], "2-bit");
+                }
+            }
+            byte |= code << (6 - 2 * k);
+        }
+        packed[i / 4] = byte;
+    }
+}
+
+void UnpackTwoBit(const std::span<const std::uint8_t> packed, const std::span<char> seq)
+{
+    static constexpr UnpackTable<4> TABLE = MakeTwoBitTable();
+    CheckPackedSize(packed.size(), (seq.size() + 3) / 4);
+
+    const std::size_t fullBytes = seq.size() / 4;
+    for (std::size_t i = 0; i < fullBytes; ++i) {
+        std::memcpy(seq.data() + 4 * i, TABLE[packed[i]].data(), 4);
+    }
+    if (fullBytes < packed.size()) {
+        std::memcpy(seq.data() + 4 * fullBytes, TABLE[packed[fullBytes]].data(),
+                    seq.size() - 4 * fullBytes);
+    }
+}
+
+void PackFourBit(const std::string_view seq, const std::span<std::uint8_t> packed)
+{
+    CheckPackedSize(packed.size(), (seq.size() + 1) / 2);
+    const ByteLookup& lookup = FourBitLookup();
+
+    std::size_t i = 0;
+    for (; i + BLOCK <= seq.size(); i += BLOCK) {
+        const simde__m128i codes = lookup(Load(seq.data() + i));
+        if (HasByte(codes, INVALID_CODE)) {
+            break;
+        }
+        // 16 * c0 + c1 per 16 bits
+        const simde__m128i pairs = simde_mm_maddubs_epi16(codes, simde_mm_set1_epi16(0x0110));
+        simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(packed.data() + i / 2),
+                              simde_mm_packus_epi16(pairs, pairs));
+    }
+
+    for (; i < seq.size(); i += 2) {
+        std::uint8_t byte = 0;
+        for (std::size_t k = 0; k < 2 && i + k < seq.size(); ++k) {
+            const std::uint8_t code = lookup(seq[i + k]);
+            if (code == INVALID_CODE) {
+                ThrowInvalidPackedBase(seq[i + k], "4-bit");
+            }
+            byte |= code << (4 - 4 * k);
+        }
+        packed[i / 2] = byte;
+    }
+}
+
+void UnpackFourBit(const std::span<const std::uint8_t> packed, const std::span<char> seq)
+{
+    static constexpr UnpackTable<2> TABLE = MakeFourBitTable();
+    CheckPackedSize(packed.size(), (seq.size() + 1) / 2);
+
+    const std::size_t fullBytes = seq.size() / 2;
+    for (std::size_t i = 0; i < fullBytes; ++i) {
+        std::memcpy(seq.data() + 2 * i, TABLE[packed[i]].data(), 2);
+    }
+    if (fullBytes < packed.size()) {
+        seq[2 * fullBytes] = TABLE[packed[fullBytes]][0];
+    }
+}
+
+}  // namespace Utility
+}  // namespace PacBio
@@ -0,0 +1,66 @@
+#include "Benchmark.h"
+
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+namespace Benchmarks {
+namespace {
+
+std::vector<std::pair<std::string, BenchmarkFunction>>& Registry()
+{
+    static std::vector<std::pair<std::string, BenchmarkFunction>> registry;
+    return registry;
+}
+
+int NumFailedChecks = 0;
+
+}  // namespace
+
+bool Register(std::string name, const BenchmarkFunction function)
+{
+    Registry().emplace_back(std::move(name), function);
+    return true;
+}
+
+void Check(const bool condition, const char* expression, const char* file, const int line)
+{
+    if (!condition) {
+        std::cerr << file << ':' << line << ": check failed: " << expression << '\n';
+        ++NumFailedChecks;
+    }
+}
+
+}  // namespace Benchmarks
+
+// Runs the benchmarks whose names contain any of the arguments, or all of them.
+int main(int argc, char* argv[])
+{
+    const std::vector<std::string> filters(argv + 1, argv + argc);
+    auto& registry = Benchmarks::Registry();
+    std::sort(registry.begin(), registry.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    for (const auto& [name, function] : registry) {
+        const bool selected =
+            filters.empty() ||
+            std::any_of(filters.cbegin(), filters.cend(), [&name](const std::string& filter) {
+                return name.find(filter) != std::string::npos;
+            });
+        if (!selected) {
+            continue;
+        }
+
+        std::cout << "[ " << name << " ]\n";
+        const PacBio::Utility::Stopwatch stopwatch;
+        function(std::cout);
+        std::cout << "  (" << stopwatch.ElapsedTime() << ")\n" << std::flush;
+    }
+    return Benchmarks::NumFailedChecks == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,36 @@
+#ifndef PBCOPPER_TESTS_BENCHMARK_BENCHMARK_H
+#define PBCOPPER_TESTS_BENCHMARK_BENCHMARK_H
+
+#include <iosfwd>
+#include <string>
+
+namespace Benchmarks {
+
+using BenchmarkFunction = void (*)(std::ostream& out);
+
+///
+/// Adds 'function' to the benchmarks run by pbcopper_benchmark.
+///
+/// \returns true, so that it can initialize a namespace-scope flag
+///
+bool Register(std::string name, BenchmarkFunction function);
+
+///
+/// Records a failed consistency check (e.g. two timed code paths disagreeing),
+/// making pbcopper_benchmark exit with an error.
+///
+void Check(bool condition, const char* expression, const char* file, int line);
+
+}  // namespace Benchmarks
+
+// Defines a benchmark named "Suite.Name", writing its report to 'out'.
+#define PBCOPPER_BENCHMARK(Suite, Name)                                     \
+    void Benchmark_##Suite##_##Name(std::ostream& out);                     \
+    [[maybe_unused]] const bool Suite##_##Name##_Registered =               \
+        Benchmarks::Register(#Suite "." #Name, Benchmark_##Suite##_##Name); \
+    void Benchmark_##Suite##_##Name(std::ostream& out)
+
+#define PBCOPPER_BENCHMARK_CHECK(condition) \
+    Benchmarks::Check((condition), #condition, __FILE__, __LINE__)
+
+#endif  // PBCOPPER_TESTS_BENCHMARK_BENCHMARK_H
@@ -0,0 +1,55 @@
+#include <pbcopper/algorithm/Heteroduplex.h>
+#include <pbcopper/algorithm/internal/HeteroduplexUtils.h>
+
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <algorithm>
+#include <ostream>
+#include <random>
+#include <string>
+
+#include "../../src/algorithm/SimulatedReads.h"
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(Algorithm_Heteroduplex, strand_pileup)
+{
+    // deep-coverage 10 kb amplicon
+    std::mt19937 rng{1};
+    const std::string reference = PbcopperTests::RandomSequence(10000, rng);
+    const auto reads = HeteroduplexTests::SimulateReads(reference, 2000, 0.02, rng);
+    HeteroduplexTests::SimulatedReads acgtReads = reads;
+    for (auto& seq : acgtReads.Sequences) {
+        std::replace(seq.begin(), seq.end(), 'N', 'A');
+    }
+    const Algorithm::internal::StrandInput input{acgtReads.Sequences, acgtReads.Cigars,
+                                                 acgtReads.Positions};
+
+    Utility::Stopwatch rawDataTimer;
+    const auto rawData = Algorithm::internal::CalculateStrandRawData(reference, input);
+    const auto rawDataMs = rawDataTimer.ElapsedMilliseconds();
+
+    Utility::Stopwatch pileupTimer;
+    const Algorithm::internal::StrandPileup pileup{reference.size(), input};
+    const auto pileupMs = pileupTimer.ElapsedMilliseconds();
+
+    Utility::Stopwatch parallelTimer;
+    const Algorithm::internal::StrandPileup parallelPileup{reference.size(), input, 4};
+    const auto parallelMs = parallelTimer.ElapsedMilliseconds();
+
+    Algorithm::HeteroduplexSettings settings;
+    Utility::Stopwatch findTimer;
+    const auto results =
+        Algorithm::FindHeteroduplex(reference, reads.Sequences, reads.Sequences, reads.Cigars,
+                                    reads.Cigars, reads.Positions, reads.Positions, settings);
+    const auto findMs = findTimer.ElapsedMilliseconds();
+
+    PBCOPPER_BENCHMARK_CHECK(rawData.NumReads[5000] == pileup.NumReads(5000));
+    PBCOPPER_BENCHMARK_CHECK(pileup.BaseCounts(5000) == parallelPileup.BaseCounts(5000));
+    PBCOPPER_BENCHMARK_CHECK(results.NumSignificantSites == 0);
+    out << reads.Sequences.size() << " reads x " << reference.size() << " bp: StrandRawData "
+        << rawDataMs << " ms, StrandPileup " << pileupMs << " ms (" << parallelMs
+        << " ms on 4 threads), FindHeteroduplex " << findMs << " ms\n";
+}
@@ -0,0 +1,129 @@
+#include <pbcopper/align/BandedChainAlignment.h>
+#include <pbcopper/align/ChainSeeds.h>
+#include <pbcopper/align/FindSeeds.h>
+#include <pbcopper/align/LocalAlignment.h>
+#include <pbcopper/align/SeedArray.h>
+#include <pbcopper/qgram/Index.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(Align_LocalAlignment, gcups)
+{
+    std::mt19937 rng{42};
+    const std::string target = PbcopperTests::RandomSequence(100'000, rng);
+    for (const std::size_t queryLength : {100, 1'000, 10'000}) {
+        const std::string query = PbcopperTests::RandomSequence(queryLength, rng);
+        for (const auto simd : {Align::LocalAlignSimd::SSE2, Align::LocalAlignSimd::AVX2,
+                                Align::LocalAlignSimd::AVX512BW}) {
+            auto config = Align::LocalAlignConfig::Default();
+            config.Simd = simd;
+            Utility::Stopwatch timer;
+            const auto a = Align::LocalAlign(target, query, config);
+            timer.Freeze();
+            const double cells = 1.0 * queryLength * target.size();
+            out << "query " << queryLength << " bp, simd width " << static_cast<int>(simd) << ": "
+                << (cells / timer.ElapsedNanoseconds()) << " GCUPS (score " << a.Score() << ")\n";
+        }
+    }
+}
+
+PBCOPPER_BENCHMARK(Align_BandedChainAlignment, long_read_chain)
+{
+    std::mt19937 rng{7};
+    const std::string target = PbcopperTests::RandomSequence(100'000, rng);
+    const std::string query = PbcopperTests::MutateSequence(target, 0.10, rng);
+
+    // sparse seeds every ~1 kb along the main diagonal, with gap blocks between
+    std::vector<Align::Seed> seeds;
+    for (std::size_t pos = 500; pos + 1'000 < query.size(); pos += 1'000) {
+        const std::size_t tPos = pos * target.size() / query.size();
+        seeds.emplace_back(tPos, pos, 20);
+    }
+
+    for (const float scale : {1.0F, 1.01F}) {
+        const Align::BandedChainAlignConfig config{2 * scale, -1 * scale, -2 * scale, -1 * scale,
+                                                   15};
+        const Utility::Stopwatch timer;
+        const auto result = Align::BandedChainAlign(target, query, seeds, config);
+        out << (scale == 1.0F ? "integer" : "float") << " blocks: " << timer.ElapsedTime()
+            << " (score " << result.Score() << ")\n";
+    }
+}
+
+PBCOPPER_BENCHMARK(Align_SeedArray, seed_extraction_and_chaining)
+{
+    std::mt19937 rng{1};
+    std::vector<std::string> refs;
+    for (int i = 0; i < 8; ++i) {
+        refs.push_back(PbcopperTests::RandomSequence(250'000, rng));
+    }
+    const QGram::Index index{12, refs};
+
+    std::vector<std::string> queries;
+    std::uniform_int_distribution<std::size_t> refIdx{0, refs.size() - 1};
+    std::uniform_int_distribution<std::size_t> pos{0, 240'000};
+    for (int i = 0; i < 200; ++i) {
+        const std::string_view ref = refs[refIdx(rng)];
+        queries.push_back(PbcopperTests::MutateSequence(ref.substr(pos(rng), 10'000), 0.05, rng));
+    }
+    const Align::ChainSeedsConfig config{1};
+
+    std::size_t numSeeds = 0;
+    std::size_t numChains = 0;
+    Utility::Stopwatch mapFind;
+    std::vector<std::map<std::size_t, Align::Seeds>> mapSeeds;
+    for (const auto& query : queries) {
+        mapSeeds.push_back(Align::FindSeeds(index, query));
+    }
+    const auto mapFindMs = mapFind.ElapsedMilliseconds();
+    Utility::Stopwatch mapChain;
+    for (const auto& seeds : mapSeeds) {
+        numChains += Align::ChainSeeds(seeds, config).size();
+    }
+    const auto mapChainMs = mapChain.ElapsedMilliseconds();
+
+    Utility::Stopwatch arrayFind;
+    std::vector<Align::SeedArray> arraySeeds(queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+        Align::FindSeeds(index, queries[i], &arraySeeds[i]);
+        numSeeds += arraySeeds[i].size();
+    }
+    const auto arrayFindMs = arrayFind.ElapsedMilliseconds();
+    Utility::Stopwatch arrayChain;
+    for (auto& seeds : arraySeeds) {
+        numChains += Align::ChainSeedsFlat(&seeds, config).size();
+    }
+    const auto arrayChainMs = arrayChain.ElapsedMilliseconds();
+
+    Utility::Stopwatch mergedFindAndChain;
+    std::size_t numMergedSeeds = 0;
+    for (const auto& query : queries) {
+        Align::SeedArray seeds{true};
+        Align::FindSeeds(index, query, &seeds);
+        seeds.Sort();
+        numMergedSeeds += seeds.size();
+        numChains += Align::ChainSeedsFlat(&seeds, config).size();
+    }
+    const auto mergedFindAndChainMs = mergedFindAndChain.ElapsedMilliseconds();
+
+    out << queries.size() << " queries, " << numSeeds << " seeds (" << numMergedSeeds
+        << " merged), " << numChains << " chains\n"
+        << "  map<Seeds> FindSeeds:               " << mapFindMs << " ms\n"
+        << "  map<Seeds> ChainSeeds:              " << mapChainMs << " ms\n"
+        << "  SeedArray FindSeeds:                " << arrayFindMs << " ms\n"
+        << "  SeedArray ChainSeedsFlat:           " << arrayChainMs << " ms\n"
+        << "  merged SeedArray FindSeeds + chain: " << mergedFindAndChainMs << " ms\n";
+}
@@ -0,0 +1,55 @@
+#include <pbcopper/container/BitConversion.h>
+#include <pbcopper/container/PackedDNAString.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <ostream>
+#include <random>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(Container_PackedDNAString, kmers)
+{
+    // 10 Mb reference, 4x smaller than std::string
+    std::mt19937 rng{1};
+    const auto seq = PbcopperTests::RandomSequence(10'000'000, rng);
+
+    Utility::Stopwatch packTimer;
+    const Container::PackedDNA2bitString str{seq};
+    const auto packMs = packTimer.ElapsedMilliseconds();
+
+    constexpr std::int32_t K = 21;
+    std::uint64_t scalarSum = 0;
+    Utility::Stopwatch scalarTimer;
+    std::uint64_t kmer = 0;
+    for (std::size_t i = 0; i < seq.size(); ++i) {
+        kmer = ((kmer << 2) | Container::ConvertAsciiTo2bit(seq[i])) & ((1ULL << (2 * K)) - 1);
+        if (i + 1 >= K) {
+            scalarSum += kmer;
+        }
+    }
+    const auto scalarMs = scalarTimer.ElapsedMilliseconds();
+
+    std::uint64_t packedSum = 0;
+    Utility::Stopwatch packedTimer;
+    str.ForEachKMer(K, [&](std::size_t, const std::uint64_t k) { packedSum += k; });
+    const auto packedMs = packedTimer.ElapsedMilliseconds();
+
+    std::uint64_t randomSum = 0;
+    Utility::Stopwatch randomTimer;
+    for (std::size_t i = 0; i + K <= str.Size(); i += 3) {
+        randomSum += str.KMer(i, K);
+    }
+    const auto randomMs = randomTimer.ElapsedMilliseconds();
+
+    PBCOPPER_BENCHMARK_CHECK(scalarSum == packedSum);
+    PBCOPPER_BENCHMARK_CHECK(randomSum > 0);
+    out << "10 Mb: " << seq.size() << " bytes as string, " << str.Data().size()
+        << " bytes packed in " << packMs << " ms; 21-mers from string " << scalarMs
+        << " ms, packed " << packedMs << " ms, random access (1/3) " << randomMs << " ms\n";
+}
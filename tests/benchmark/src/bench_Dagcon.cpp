@@ -0,0 +1,37 @@
+#include <pbcopper/dagcon/AlignmentGraph.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <ostream>
+#include <string>
+
+#include "../../src/dagcon/Pileup.h"
+#include "../Benchmark.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(Dagcon_AlignmentGraph, batch_build_50x)
+{
+    const auto pileup = DagconTests::MakePileup(20'000, 50, 5'000, 0.12, 1);
+
+    Utility::Stopwatch sequentialBuild;
+    Dagcon::AlignmentGraph sequential{pileup.Backbone};
+    for (auto alignment : pileup.Alignments) {
+        sequential.AddAlignment(alignment);
+    }
+    const auto sequentialBuildMs = sequentialBuild.ElapsedMilliseconds();
+    Utility::Stopwatch sequentialConsensus;
+    sequential.MergeNodes();
+    const std::string sequentialResult = sequential.Consensus();
+    const auto sequentialConsensusMs = sequentialConsensus.ElapsedMilliseconds();
+
+    Utility::Stopwatch batchBuild;
+    Dagcon::AlignmentGraph batch{pileup.Backbone, pileup.Alignments};
+    const auto batchBuildMs = batchBuild.ElapsedMilliseconds();
+    batch.MergeNodes();
+    PBCOPPER_BENCHMARK_CHECK(sequentialResult == batch.Consensus());
+
+    out << "20 kb backbone, 50x 5 kb reads, 12% error\n"
+        << "  sequential build: " << sequentialBuildMs << " ms\n"
+        << "  batch build:      " << batchBuildMs << " ms\n"
+        << "  merge+consensus:  " << sequentialConsensusMs << " ms\n";
+}
@@ -0,0 +1,261 @@
+#include <pbcopper/data/ClippedRead.h>
+#include <pbcopper/data/FrameEncoders.h>
+#include <pbcopper/data/Frames.h>
+#include <pbcopper/data/IntervalIndex.h>
+#include <pbcopper/data/IntervalTree.h>
+#include <pbcopper/data/MappedRead.h>
+#include <pbcopper/data/QualityValues.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <algorithm>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../../src/data/AlignedReads.h"
+#include "../Benchmark.h"
+
+using namespace PacBio;
+using namespace PacBio::Data;
+
+PBCOPPER_BENCHMARK(Data_ClippedRead, clip_windows)
+{
+    // CCS-length reads, clipped into 100 bp reference windows
+    std::mt19937 rng{1};
+    std::vector<MappedRead> reads;
+    for (int i = 0; i < 20; ++i) {
+        reads.push_back(MappedReadTests::MakeAlignedRead(15'000, Strand::FORWARD, &rng));
+    }
+
+    std::size_t copiedBases = 0;
+    Utility::Stopwatch copyTimer;
+    for (const auto& read : reads) {
+        for (Position start = read.TemplateStart; start < read.TemplateEnd; start += 100) {
+            auto window = read;
+            ClipToReference(window, start, start + 100, false);
+            copiedBases += window.Seq.size();
+        }
+    }
+    const auto copyMs = copyTimer.ElapsedMilliseconds();
+
+    std::size_t viewedBases = 0;
+    Utility::Stopwatch viewTimer;
+    for (const auto& read : reads) {
+        for (Position start = read.TemplateStart; start < read.TemplateEnd; start += 100) {
+            viewedBases += ClipViewToReference(read, start, start + 100, false).Seq().size();
+        }
+    }
+    const auto viewMs = viewTimer.ElapsedMilliseconds();
+
+    std::size_t sweptBases = 0;
+    Utility::Stopwatch sweepTimer;
+    std::vector<Interval> windows;
+    for (const auto& read : reads) {
+        windows.clear();
+        for (Position start = read.TemplateStart; start < read.TemplateEnd; start += 100) {
+            windows.emplace_back(start, start + 100);
+        }
+        for (const auto& view : ClipViewsToReference(read, windows, false)) {
+            sweptBases += view.Seq().size();
+        }
+    }
+    const auto sweepMs = sweepTimer.ElapsedMilliseconds();
+
+    PBCOPPER_BENCHMARK_CHECK(copiedBases == viewedBases);
+    PBCOPPER_BENCHMARK_CHECK(copiedBases == sweptBases);
+    out << reads.size() << " x 15 kb into 100 bp windows: copy + clip " << copyMs
+        << " ms, single views " << viewMs << " ms, windowed views " << sweepMs << " ms\n";
+}
+
+PBCOPPER_BENCHMARK(Data_FrameEncoder, frame_codecs)
+{
+    // IPD-like: mostly short, with a long tail
+    std::mt19937 rng{1};
+    std::geometric_distribution<int> frame{0.05};
+    std::vector<std::uint16_t> raw(10'000'000);
+    for (auto& f : raw) {
+        f = std::min(frame(rng), 65535);
+    }
+
+    const auto run = [&](const FrameEncoder& codec) {
+        Utility::Stopwatch allocating;
+        const auto encoded = codec.Encode(raw);
+        const auto decoded = codec.Decode(encoded);
+        const auto allocatingMs = allocating.ElapsedMilliseconds();
+
+        std::vector<std::uint8_t> codes(raw.size());
+        std::vector<std::uint16_t> frames(raw.size());
+        Utility::Stopwatch encodeInto;
+        codec.EncodeInto(raw, codes);
+        const auto encodeMs = encodeInto.ElapsedMilliseconds();
+        Utility::Stopwatch decodeInto;
+        codec.DecodeInto(codes, frames);
+        const auto decodeMs = decodeInto.ElapsedMilliseconds();
+
+        PBCOPPER_BENCHMARK_CHECK(encoded == codes);
+        PBCOPPER_BENCHMARK_CHECK(decoded.Data() == frames);
+        out << codec.Name() << ", 10M frames: " << allocatingMs << " ms Encode + Decode, "
+            << encodeMs << " ms EncodeInto, " << decodeMs << " ms DecodeInto\n";
+    };
+    run(V1FrameEncoder{});
+    run(V2FrameEncoder{2, 6});
+    run(V2FrameEncoder{3, 5});
+}
+
+PBCOPPER_BENCHMARK(Data_IntervalIndex, vs_interval_tree)
+{
+    // 1M masked regions over a 2 Gb genome
+    std::mt19937 rng{1};
+    std::vector<Interval> intervals;
+    for (int i = 0; i < 1000000; ++i) {
+        const Position start = rng() % 2000000000;
+        intervals.emplace_back(start, start + rng() % 200);
+    }
+    std::vector<Position> positions(2000000);
+    for (auto& p : positions) {
+        p = rng() % 2000000000;
+    }
+    // IntervalTree::Contains walks multiset iterators linearly, sample fewer
+    const std::size_t numTreeQueries = 100;
+
+    Utility::Stopwatch treeBuildTimer;
+    IntervalTree tree;
+    for (const auto& interval : intervals) {
+        if (interval.Start() < interval.End()) {
+            tree.Insert(interval);
+        }
+    }
+    const auto treeBuildMs = treeBuildTimer.ElapsedMilliseconds();
+
+    Utility::Stopwatch treeQueryTimer;
+    std::size_t treeHits = 0;
+    for (std::size_t i = 0; i < numTreeQueries; ++i) {
+        treeHits += tree.Contains(positions[i]);
+    }
+    const auto treeQueryNs = treeQueryTimer.ElapsedNanoseconds() / numTreeQueries;
+
+    Utility::Stopwatch indexBuildTimer;
+    const IntervalIndex index{intervals};
+    const auto indexBuildMs = indexBuildTimer.ElapsedMilliseconds();
+
+    Utility::Stopwatch parallelBuildTimer;
+    const IntervalIndex parallelIndex{intervals, 8};
+    const auto parallelBuildMs = parallelBuildTimer.ElapsedMilliseconds();
+
+    std::size_t sampleHits = 0;
+    for (std::size_t i = 0; i < numTreeQueries; ++i) {
+        sampleHits += index.Contains(positions[i]);
+    }
+    Utility::Stopwatch indexQueryTimer;
+    std::size_t indexHits = 0;
+    for (const auto p : positions) {
+        indexHits += index.Contains(p);
+    }
+    const auto indexQueryNs = indexQueryTimer.ElapsedNanoseconds() / positions.size();
+
+    // sorted single-base queries against the merged index
+    const IntervalIndex merged = index.Merged();
+    std::vector<Interval> queries;
+    queries.reserve(positions.size());
+    for (const auto p : positions) {
+        queries.emplace_back(p, p + 1);
+    }
+    std::sort(queries.begin(), queries.end(),
+              [](const Interval& lhs, const Interval& rhs) { return lhs.Start() < rhs.Start(); });
+    Utility::Stopwatch sweepTimer;
+    std::size_t sweepHits = 0;
+    merged.ForEachOverlap(std::span<const Interval>{queries},
+                          [&](std::size_t, std::size_t) { ++sweepHits; });
+    const auto sweepNs = sweepTimer.ElapsedNanoseconds() / queries.size();
+
+    PBCOPPER_BENCHMARK_CHECK(treeHits == sampleHits);
+    PBCOPPER_BENCHMARK_CHECK(indexHits == sweepHits);
+    PBCOPPER_BENCHMARK_CHECK(index.Size() == parallelIndex.Size());
+    out << intervals.size() << " intervals: IntervalTree build " << treeBuildMs
+        << " ms, stabbing query " << treeQueryNs << " ns; IntervalIndex build " << indexBuildMs
+        << " ms (" << parallelBuildMs << " ms on 8 threads), query " << indexQueryNs
+        << " ns, sorted sweep " << sweepNs << " ns\n";
+}
+
+PBCOPPER_BENCHMARK(Data_MappedRead, aligned_projection)
+{
+    std::mt19937 rng{1};
+    std::vector<MappedRead> reads;
+    for (int i = 0; i < 200; ++i) {
+        reads.push_back(MappedReadTests::MakeAlignedRead(
+            15'000, (i % 2) ? Strand::REVERSE : Strand::FORWARD, &rng));
+    }
+
+    for (const auto orientation : {Orientation::NATIVE, Orientation::GENOMIC}) {
+        std::size_t checksum = 0;
+        Utility::Stopwatch separate;
+        for (const auto& mr : reads) {
+            checksum += mr.AlignedSequence(orientation, GapBehavior::SHOW).size();
+            checksum += mr.AlignedQualities(orientation, GapBehavior::SHOW).size();
+            checksum += mr.AlignedIPD(orientation, GapBehavior::SHOW)->size();
+            checksum += mr.AlignedPulseWidth(orientation, GapBehavior::SHOW)->size();
+        }
+        const auto separateMs = separate.ElapsedMilliseconds();
+
+        std::string seq;
+        QualityValues quals;
+        std::optional<Frames> ipd;
+        std::optional<Frames> pw;
+        Utility::Stopwatch projected;
+        for (const auto& mr : reads) {
+            mr.ProjectAligned({&seq, &quals, &ipd, &pw}, orientation, GapBehavior::SHOW);
+            checksum -= seq.size() + quals.size() + ipd->size() + pw->size();
+        }
+        const auto projectedMs = projected.ElapsedMilliseconds();
+
+        PBCOPPER_BENCHMARK_CHECK(checksum == 0);
+        out << "200 x 15 kb, " << (orientation == Orientation::NATIVE ? "native " : "genomic")
+            << ": Aligned*() " << separateMs << " ms, ProjectAligned " << projectedMs << " ms\n";
+    }
+}
+
+PBCOPPER_BENCHMARK(Data_QualityValues, fastq_and_stats)
+{
+    // 2000 CCS-length reads
+    std::mt19937 rng{1};
+    std::vector<std::string> fastqs(2000, std::string(15000, '!'));
+    for (auto& fastq : fastqs) {
+        for (auto& c : fastq) {
+            c = '!' + rng() % 94;
+        }
+    }
+
+    std::vector<QualityValues> scalar(fastqs.size());
+    Utility::Stopwatch scalarTimer;
+    for (std::size_t i = 0; i < fastqs.size(); ++i) {
+        scalar[i].resize(fastqs[i].size());
+        std::transform(fastqs[i].cbegin(), fastqs[i].cend(), scalar[i].begin(),
+                       QualityValue::FromFastq);
+    }
+    const auto scalarMs = scalarTimer.ElapsedMilliseconds();
+
+    std::vector<QualityValues> simd;
+    Utility::Stopwatch simdTimer;
+    for (const auto& fastq : fastqs) {
+        simd.push_back(QualityValues::FromFastq(fastq));
+    }
+    const auto simdMs = simdTimer.ElapsedMilliseconds();
+
+    double meanSum = 0;
+    Utility::Stopwatch statsTimer;
+    for (const auto& quals : simd) {
+        meanSum += ComputeQualityStats(quals).ExpectedErrors;
+    }
+    const auto statsMs = statsTimer.ElapsedMilliseconds();
+
+    PBCOPPER_BENCHMARK_CHECK(scalar == simd);
+    PBCOPPER_BENCHMARK_CHECK(meanSum > 0);
+    out << fastqs.size() << " x 15 kb FASTQ to QVs: scalar " << scalarMs << " ms, simd " << simdMs
+        << " ms (incl. copy); stats " << statsMs << " ms\n";
+}
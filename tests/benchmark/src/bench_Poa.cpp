@@ -0,0 +1,128 @@
+#include <pbcopper/align/AlignConfig.h>
+#include <pbcopper/poa/BatchConsensus.h>
+#include <pbcopper/poa/PoaConsensus.h>
+#include <pbcopper/poa/PoaGraph.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+using namespace PacBio::Poa;
+
+namespace {
+
+// 'numGroups' groups of 'numReads' noisy copies of a random template each
+std::vector<std::vector<std::string>> MakeGroups(const int numGroups, const int numReads,
+                                                 const std::size_t length, const unsigned int seed)
+{
+    std::mt19937 rng{seed};
+    std::vector<std::vector<std::string>> groups;
+    for (int i = 0; i < numGroups; ++i) {
+        const std::string tpl = PbcopperTests::RandomSequence(length, rng);
+        groups.push_back(PbcopperTests::MutateSequences(tpl, numReads, 0.1, rng));
+    }
+    return groups;
+}
+
+}  // namespace
+
+PBCOPPER_BENCHMARK(Poa_BatchConsensus, batch_consensus)
+{
+    const auto groups = MakeGroups(64, 8, 1'000, 1);
+    const auto config = DefaultPoaConfig(Align::AlignMode::LOCAL);
+
+    Utility::Stopwatch serial;
+    std::vector<std::string> expected;
+    for (const auto& reads : groups) {
+        const std::unique_ptr<const PoaConsensus> pc{PoaConsensus::FindConsensus(reads, config)};
+        expected.push_back(pc->Sequence);
+    }
+    const auto serialMs = serial.ElapsedMilliseconds();
+
+    BatchConsensusOptions options;
+    options.Config = config;
+    Utility::Stopwatch batched;
+    const auto results = BatchConsensus{options}.FindConsensus(groups);
+    const auto batchedMs = batched.ElapsedMilliseconds();
+    PBCOPPER_BENCHMARK_CHECK(results.size() == expected.size());
+    for (std::size_t i = 0; i < results.size() && i < expected.size(); ++i) {
+        PBCOPPER_BENCHMARK_CHECK(results[i]->Sequence == expected[i]);
+    }
+
+    // one large group: only drafting can use more than one thread
+    const auto large = MakeGroups(1, 64, 2'000, 2);
+    Utility::Stopwatch largeSerial;
+    BatchConsensus{options}.FindConsensus(large);
+    const auto largeSerialMs = largeSerial.ElapsedMilliseconds();
+    options.DraftMinReads = 16;
+    Utility::Stopwatch largeDrafted;
+    BatchConsensus{options}.FindConsensus(large);
+    const auto largeDraftedMs = largeDrafted.ElapsedMilliseconds();
+
+    out << "64 groups x 8 reads x 1 kb, serial:  " << serialMs << " ms\n"
+        << "                           batched: " << batchedMs << " ms\n"
+        << "1 group x 64 reads x 2 kb, batched: " << largeSerialMs << " ms\n"
+        << "                           drafted: " << largeDraftedMs << " ms\n";
+}
+
+PBCOPPER_BENCHMARK(Poa_PoaGraph, add_read)
+{
+    // allocation counts are asserted by pbcopper_allocation_test
+    std::mt19937 rng{1};
+    const auto run = [&](const std::string& label, const std::size_t length,
+                         const Align::AlignConfig& config) {
+        const std::string tpl = PbcopperTests::RandomSequence(length, rng);
+        PoaGraph graph;
+        graph.AddFirstRead(PbcopperTests::MutateSequence(tpl, 0.1, rng));
+        constexpr int NUM_READS = 5;
+        std::vector<std::string> reads;
+        for (int i = 0; i < NUM_READS; ++i) {
+            reads.push_back(PbcopperTests::MutateSequence(tpl, 0.1, rng));
+        }
+
+        Utility::Stopwatch timer;
+        for (const auto& read : reads) {
+            graph.AddRead(read, config);
+        }
+        out << label << ": " << (timer.ElapsedMilliseconds() / NUM_READS) << " ms per read\n";
+    };
+
+    auto config = DefaultPoaConfig(Align::AlignMode::LOCAL);
+    run(" 3 kb, full    ", 3'000, config);
+    config.Band = Align::AlignBand::Default();
+    run(" 3 kb, banded  ", 3'000, config);
+    run("10 kb, banded  ", 10'000, config);
+}
+
+PBCOPPER_BENCHMARK(Poa_PoaConsensus, long_read_consensus)
+{
+    std::mt19937 rng{3};
+    const std::string tpl = PbcopperTests::RandomSequence(3'000, rng);
+    const auto reads = PbcopperTests::MutateSequences(tpl, 10, 0.1, rng);
+
+    const auto run = [&](const std::string& label, const Align::AlignConfig& config) {
+        Utility::Stopwatch stopwatch;
+        const std::unique_ptr<const PoaConsensus> pc{PoaConsensus::FindConsensus(reads, config)};
+        const auto elapsedMs = stopwatch.ElapsedMilliseconds();
+
+        out << label << reads.size() << " reads of ~" << tpl.size() << " bp, "
+            << pc->Sequence.size() << " bp consensus: " << elapsedMs << " ms\n";
+    };
+
+    auto config = DefaultPoaConfig(Align::AlignMode::LOCAL);
+    config.Kernel = Align::AlignKernel::SCALAR;
+    run("scalar:        ", config);
+    config.Kernel = Align::AlignKernel::SIMD;
+    run("SIMD:          ", config);
+    config.Band = Align::AlignBand::Default();
+    run("SIMD + banded: ", config);
+}
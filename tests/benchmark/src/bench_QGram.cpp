@@ -0,0 +1,35 @@
+#include <pbcopper/qgram/Index.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(QGram_Index, construction)
+{
+    std::mt19937 rng{3};
+    std::vector<std::string> seqs;
+    for (int i = 0; i < 8; ++i) {
+        seqs.push_back(PbcopperTests::RandomSequence(1'000'000, rng));
+    }
+    const std::size_t q = 12;
+
+    for (const unsigned int numThreads : {1, 2, 4, 8}) {
+        const Utility::Stopwatch timer;
+        const QGram::Index idx{q, seqs, numThreads};
+        out << "build 8 Mb, " << numThreads << " thread(s): " << timer.ElapsedTime() << '\n';
+    }
+
+    QGram::Index idx{q, std::vector<std::string>(seqs.begin(), seqs.end() - 1), 4};
+    const Utility::Stopwatch appendTimer;
+    idx.Append(seqs.back());
+    out << "append 1 Mb to 7 Mb index, 4 threads: " << appendTimer.ElapsedTime() << '\n';
+}
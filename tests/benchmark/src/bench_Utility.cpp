@@ -0,0 +1,56 @@
+#include <pbcopper/utility/SequenceUtils.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include <algorithm>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+#include "../Benchmark.h"
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+PBCOPPER_BENCHMARK(Utility_SequenceUtils, reverse_complement)
+{
+    // 2000 CCS-length reads
+    std::mt19937 rng{1};
+    std::vector<std::string> reads;
+    for (int i = 0; i < 2000; ++i) {
+        reads.push_back(PbcopperTests::RandomSequence(15000, rng, "ACGTacgtNn-"));
+    }
+
+    std::vector<std::string> scalar = reads;
+    Utility::Stopwatch scalarTimer;
+    for (auto& read : scalar) {
+        std::transform(read.begin(), read.end(), read.begin(), Utility::Complement);
+        Utility::Reverse(read);
+    }
+    const auto scalarMs = scalarTimer.ElapsedMilliseconds();
+
+    std::vector<std::string> simd = reads;
+    Utility::Stopwatch simdTimer;
+    for (auto& read : simd) {
+        Utility::ReverseComplement(read);
+    }
+    const auto simdMs = simdTimer.ElapsedMilliseconds();
+
+    // gaps have no 4-bit code
+    std::vector<std::string> ungapped = simd;
+    for (auto& read : ungapped) {
+        std::replace(read.begin(), read.end(), '-', 'N');
+    }
+    std::vector<std::uint8_t> packed((15000 + 1) / 2);
+    Utility::Stopwatch packTimer;
+    for (const auto& read : ungapped) {
+        Utility::PackFourBit(read, packed);
+    }
+    const auto packMs = packTimer.ElapsedMilliseconds();
+
+    PBCOPPER_BENCHMARK_CHECK(scalar == simd);
+    out << reads.size() << " x 15 kb reverse complement: scalar " << scalarMs << " ms, simd "
+        << simdMs << " ms; 4-bit packing " << packMs << " ms\n";
+}
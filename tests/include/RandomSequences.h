@@ -0,0 +1,70 @@
+#ifndef PBCOPPER_TESTS_RANDOMSEQUENCES_H
+#define PBCOPPER_TESTS_RANDOMSEQUENCES_H
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace PbcopperTests {
+
+// 'length' characters drawn uniformly from 'alphabet'
+inline std::string RandomSequence(const std::size_t length, std::mt19937& rng,
+                                  const std::string_view alphabet = "ACGT")
+{
+    std::uniform_int_distribution<std::size_t> index{0, alphabet.size() - 1};
+    std::string result(length, 'A');
+    for (auto& c : result) {
+        c = alphabet[index(rng)];
+    }
+    return result;
+}
+
+// what is read for base 'c': with ~'errorRate', a substitution, an insertion
+// before it, or a deletion, each equally likely
+inline std::string MutateBase(const char c, const double errorRate, std::mt19937& rng)
+{
+    static constexpr char BASES[] = "ACGT";
+    std::uniform_real_distribution<double> coin{0.0, 1.0};
+    std::uniform_int_distribution<int> base{0, 3};
+    const double p = coin(rng);
+    if (p < errorRate / 3) {
+        return std::string(1, BASES[base(rng)]);
+    } else if (p < 2 * errorRate / 3) {
+        return std::string{BASES[base(rng)], c};
+    } else if (p < errorRate) {
+        return {};
+    }
+    return std::string(1, c);
+}
+
+// 'seq' with ~'errorRate' substitutions, insertions, and deletions
+inline std::string MutateSequence(const std::string_view seq, const double errorRate,
+                                  std::mt19937& rng)
+{
+    std::string result;
+    result.reserve(seq.size());
+    for (const char c : seq) {
+        result += MutateBase(c, errorRate, rng);
+    }
+    return result;
+}
+
+// 'count' independently mutated copies of 'seq'
+inline std::vector<std::string> MutateSequences(const std::string_view seq, const int count,
+                                                const double errorRate, std::mt19937& rng)
+{
+    std::vector<std::string> result;
+    for (int i = 0; i < count; ++i) {
+        result.push_back(MutateSequence(seq, errorRate, rng));
+    }
+    return result;
+}
+
+}  // namespace PbcopperTests
+}  // namespace PacBio
+
+#endif  // PBCOPPER_TESTS_RANDOMSEQUENCES_H
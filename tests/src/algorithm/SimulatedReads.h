@@ -0,0 +1,68 @@
+#ifndef PBCOPPER_TESTS_ALGORITHM_SIMULATEDREADS_H
+#define PBCOPPER_TESTS_ALGORITHM_SIMULATEDREADS_H
+
+#include <pbcopper/data/Cigar.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+namespace HeteroduplexTests {
+
+struct SimulatedReads
+{
+    std::vector<std::string> Sequences;
+    std::vector<PacBio::Data::Cigar> Cigars;
+    std::vector<std::int32_t> Positions;
+};
+
+// reads of 'reference' with random mismatches, indels, and the occasional N
+inline SimulatedReads SimulateReads(const std::string& reference, const int numReads,
+                                    const double errorRate, std::mt19937& rng)
+{
+    const std::string bases{"ACGTNacgt"};
+    std::uniform_real_distribution<double> unit;
+    SimulatedReads result;
+    for (int r = 0; r < numReads; ++r) {
+        const int start = rng() % (reference.size() / 4);
+        const int end = reference.size() - rng() % (reference.size() / 4);
+        std::string seq;
+        PacBio::Data::Cigar cigar;
+        const auto add = [&cigar](const PacBio::Data::CigarOperationType type) {
+            if (!cigar.empty() && (cigar.back().Type() == type)) {
+                cigar.back().Length(cigar.back().Length() + 1);
+            } else {
+                cigar.emplace_back(type, 1);
+            }
+        };
+        for (int pos = start; pos < end; ++pos) {
+            const double p = unit(rng);
+            if (p < errorRate / 3) {
+                seq.push_back(bases[rng() % bases.size()]);
+                add((seq.back() == reference[pos])
+                        ? PacBio::Data::CigarOperationType::SEQUENCE_MATCH
+                        : PacBio::Data::CigarOperationType::SEQUENCE_MISMATCH);
+            } else if (p < 2 * errorRate / 3) {
+                add(PacBio::Data::CigarOperationType::DELETION);
+            } else {
+                if (p < errorRate) {
+                    seq.push_back(bases[rng() % 4]);
+                    add(PacBio::Data::CigarOperationType::INSERTION);
+                }
+                seq.push_back(reference[pos]);
+                add(PacBio::Data::CigarOperationType::SEQUENCE_MATCH);
+            }
+        }
+        result.Sequences.push_back(std::move(seq));
+        result.Cigars.push_back(std::move(cigar));
+        result.Positions.push_back(start);
+    }
+    return result;
+}
+
+}  // namespace HeteroduplexTests
+
+#endif  // PBCOPPER_TESTS_ALGORITHM_SIMULATEDREADS_H
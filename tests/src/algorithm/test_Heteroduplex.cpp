@@ -6,6 +6,12 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <random>
+
+#include <cstddef>
+
+#include "RandomSequences.h"
+#include "SimulatedReads.h"
 
 using namespace PacBio;
 
@@ -590,3 +596,93 @@ TEST(Algorithm_Heteroduplex, non_hd_bad_reference)
 }
 
 // clang-format on
+
+TEST(Algorithm_Heteroduplex, strand_pileup_matches_strand_raw_data)
+{
+    std::mt19937 rng{42};
+    const std::string reference = PbcopperTests::RandomSequence(300, rng);
+    const auto reads = HeteroduplexTests::SimulateReads(reference, 100, 0.1, rng);
+
+    // StrandRawData does not support N
+    HeteroduplexTests::SimulatedReads acgtReads = reads;
+    for (auto& seq : acgtReads.Sequences) {
+        std::replace(seq.begin(), seq.end(), 'N', 'A');
+    }
+    const Algorithm::internal::StrandInput input{acgtReads.Sequences, acgtReads.Cigars,
+                                                 acgtReads.Positions};
+    const auto rawData = Algorithm::internal::CalculateStrandRawData(reference, input);
+
+    for (const unsigned int numThreads : {1U, 4U}) {
+        SCOPED_TRACE(numThreads);
+        const Algorithm::internal::StrandPileup pileup{reference.size(), input, numThreads};
+        ASSERT_EQ(reference.size(), pileup.Size());
+        for (std::size_t i = 0; i < reference.size(); ++i) {
+            EXPECT_EQ(rawData.NumReads[i], pileup.NumReads(i));
+            EXPECT_EQ(rawData.BaseCounts[i], pileup.BaseCounts(i));
+            EXPECT_EQ(rawData.PotentialMismatches[i] != 0, pileup.PotentialMismatch(i));
+
+            std::vector<std::string_view> expected = rawData.Insertions[i];
+            std::sort(expected.begin(), expected.end());
+            std::vector<std::string_view> observed;
+            for (const auto& tally : pileup.Insertions(i)) {
+                observed.insert(observed.end(), tally.Count, tally.Sequence);
+            }
+            EXPECT_EQ(expected, observed);
+        }
+    }
+
+    // N only adds coverage
+    const Algorithm::internal::StrandPileup withN{reference.size(),
+                                                  {reads.Sequences, reads.Cigars, reads.Positions}};
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        const auto counts = withN.BaseCounts(i);
+        EXPECT_GE(withN.NumReads(i), counts[0] + counts[1] + counts[2] + counts[3] + counts[4]);
+    }
+}
+
+TEST(Algorithm_Heteroduplex, strand_pileup_throws_on_unsupported_cigar_op)
+{
+    Data::CigarOperation::DisableAutoValidation();
+    const std::vector<Data::Cigar> cigars(40, Data::Cigar{"4M"});
+    Data::CigarOperation::EnableAutoValidation();
+    const std::vector<std::string> seqs(40, "ACGT");
+    const std::vector<std::int32_t> positions(40, 0);
+
+    // thrown from a worker thread, too
+    EXPECT_THROW(Algorithm::internal::StrandPileup(4, {seqs, cigars, positions}, 2),
+                 std::runtime_error);
+}
+
+TEST(Algorithm_Heteroduplex, results_do_not_depend_on_num_threads)
+{
+    std::mt19937 rng{7};
+    const std::string reference = PbcopperTests::RandomSequence(500, rng);
+    std::string variant = reference;
+    for (std::size_t i = 50; i < variant.size(); i += 100) {
+        variant[i] = (variant[i] == 'A') ? 'C' : 'A';
+    }
+    const auto fwd = HeteroduplexTests::SimulateReads(variant, 100, 0.05, rng);
+    const auto rev = HeteroduplexTests::SimulateReads(reference, 100, 0.05, rng);
+
+    const auto find = [&](const unsigned int numThreads) {
+        Algorithm::HeteroduplexSettings settings;
+        settings.NumThreads = numThreads;
+        return Algorithm::FindHeteroduplex(reference, fwd.Sequences, rev.Sequences, fwd.Cigars,
+                                           rev.Cigars, fwd.Positions, rev.Positions, settings);
+    };
+    const auto serial = find(1);
+    EXPECT_GT(serial.NumSignificantSites, 0U);
+    for (const unsigned int numThreads : {2U, 4U}) {
+        SCOPED_TRACE(numThreads);
+        const auto parallel = find(numThreads);
+        EXPECT_EQ(serial.NumSignificantSites, parallel.NumSignificantSites);
+        EXPECT_EQ(serial.NumVariableSites, parallel.NumVariableSites);
+        EXPECT_EQ(serial.SequenceLength, parallel.SequenceLength);
+        EXPECT_EQ(serial.FractionSites, parallel.FractionSites);
+        EXPECT_EQ(serial.VariableSites, parallel.VariableSites);
+        EXPECT_EQ(serial.SignificantSites, parallel.SignificantSites);
+        EXPECT_EQ(serial.SignificantBases, parallel.SignificantBases);
+        EXPECT_EQ(serial.FwdMostCommonBases, parallel.FwdMostCommonBases);
+        EXPECT_EQ(serial.RevMostCommonBases, parallel.RevMostCommonBases);
+    }
+}
@@ -6,9 +6,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
 
 #include <gtest/gtest.h>
 
+#include "RandomSequences.h"
+
 namespace PacBio {
 namespace Align {
 namespace internal {
@@ -677,6 +680,38 @@ TEST(Align_LocalAlignment, can_generate_basic_local_alignments)
     EXPECT_EQ(21, a.Score());
 }
 
+TEST(Align_LocalAlignment, simd_instruction_sets_yield_identical_alignments)
+{
+    using PacBio::Align::LocalAlignSimd;
+
+    std::mt19937 rng{42};
+    // long queries overflow the 8-bit scores and require the 16-bit kernels
+    for (const std::size_t queryLength : {10, 33, 100, 257, 1000}) {
+        const std::string query = PacBio::PbcopperTests::RandomSequence(queryLength, rng);
+        std::string target = PacBio::PbcopperTests::RandomSequence(300, rng) + query +
+                             PacBio::PbcopperTests::RandomSequence(300, rng);
+        for (std::size_t i = 300; i < 300 + queryLength; i += 17) {
+            target[i] = 'A';
+        }
+
+        auto config = PacBio::Align::LocalAlignConfig::Default();
+        config.Simd = LocalAlignSimd::SSE2;
+        const auto expected = PacBio::Align::LocalAlign(target, query, config);
+
+        for (const auto simd : {LocalAlignSimd::AVX2, LocalAlignSimd::AVX512BW}) {
+            config.Simd = simd;
+            const auto a = PacBio::Align::LocalAlign(target, query, config);
+            EXPECT_EQ(expected.TargetBegin(), a.TargetBegin());
+            EXPECT_EQ(expected.TargetEnd(), a.TargetEnd());
+            EXPECT_EQ(expected.QueryBegin(), a.QueryBegin());
+            EXPECT_EQ(expected.QueryEnd(), a.QueryEnd());
+            EXPECT_EQ(expected.NumMismatches(), a.NumMismatches());
+            EXPECT_EQ(expected.Score(), a.Score());
+            EXPECT_EQ(expected.CigarString(), a.CigarString());
+        }
+    }
+}
+
 // --------------- Semi-Global alignment tests ------------------
 
 TEST(Align_SemiGlobalAlignment, can_generate_basic_semiglobal_alignments)
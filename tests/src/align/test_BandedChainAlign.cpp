@@ -1,15 +1,23 @@
 #include <pbcopper/align/BandedChainAlignment.h>
 
+#include <cstdint>
+
+#include <random>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <pbcopper/align/internal/BCAlignBlocks.h>
 #include <pbcopper/align/internal/BCAlignImpl.h>
 
+#include "RandomSequences.h"
+
 TEST(Align_BandedChainAlignment, can_generate_alignments_in_standard_block)
 {
     using Config = PacBio::Align::BandedChainAlignConfig;
     using Alignment = PacBio::Align::BandedChainAlignment;
-    using Block = PacBio::Align::Internal::StandardGlobalAlignBlock;
+    using Block = PacBio::Align::Internal::StandardGlobalAlignBlock<std::int32_t>;
 
     const Config config = Config::Default();
     Block block{config};
@@ -145,7 +153,7 @@ TEST(Align_BandedChainAlignment, standard_block_correctly_aligns_large_insertion
     expectedAlignment += std::string(624, 'M');
 
     using Config = PacBio::Align::BandedChainAlignConfig;
-    using Block = PacBio::Align::Internal::StandardGlobalAlignBlock;
+    using Block = PacBio::Align::Internal::StandardGlobalAlignBlock<std::int32_t>;
     const Config config{2, -1, -2, -1, 1};
     Block block{config};
     const auto cigar = block.Align(target.c_str(), target.size(), query.c_str(), query.size());
@@ -156,7 +164,7 @@ TEST(Align_BandedChainAlignment, can_generate_alignments_in_banded_block)
 {
     using Config = PacBio::Align::BandedChainAlignConfig;
     using Alignment = PacBio::Align::BandedChainAlignment;
-    using Block = PacBio::Align::Internal::BandedGlobalAlignBlock;
+    using Block = PacBio::Align::Internal::BandedGlobalAlignBlock<std::int32_t>;
     using Seed = PacBio::Align::Seed;
 
     Config config = Config::Default();
@@ -259,3 +267,92 @@ TEST(Align_BandedChainAlignment, can_generate_alignment_from_input_seeds)
         EXPECT_EQ(14, result.Score());  // end-gaps free
     }
 }
+
+TEST(Align_BandedChainAlignment, integer_blocks_match_float_blocks)
+{
+    using Config = PacBio::Align::BandedChainAlignConfig;
+    using Seed = PacBio::Align::Seed;
+    using PacBio::Align::Internal::BandedGlobalAlignBlock;
+    using PacBio::Align::Internal::StandardGlobalAlignBlock;
+
+    std::mt19937 rng{42};
+    const std::vector<Config> configs{Config::Default(), Config{1, -4, -6, -1, 3},
+                                      Config{5, -4, -10, -2, 0}, Config{2, -3, -3, -3, 8}};
+    for (const auto& config : configs) {
+        StandardGlobalAlignBlock<float> floatGap{config};
+        StandardGlobalAlignBlock<std::int32_t> intGap{config};
+        BandedGlobalAlignBlock<float> floatSeed{config};
+        BandedGlobalAlignBlock<std::int32_t> intSeed{config};
+
+        for (int n = 0; n < 50; ++n) {
+            const std::string target =
+                PacBio::PbcopperTests::RandomSequence(1 + static_cast<std::size_t>(n * 3), rng);
+            const std::string query = PacBio::PbcopperTests::MutateSequence(target, 0.15, rng);
+
+            EXPECT_EQ(floatGap.Align(target.c_str(), target.size(), query.c_str(), query.size()),
+                      intGap.Align(target.c_str(), target.size(), query.c_str(), query.size()));
+
+            const Seed seed{0, 0, target.size(), query.size()};
+            EXPECT_EQ(floatSeed.Align(target.c_str(), query.c_str(), seed),
+                      intSeed.Align(target.c_str(), query.c_str(), seed));
+        }
+    }
+}
+
+TEST(Align_BandedChainAlignment, integer_and_float_blocks_agree_on_ties)
+{
+    using Config = PacBio::Align::BandedChainAlignConfig;
+    using Seed = PacBio::Align::Seed;
+    using PacBio::Align::Internal::BandedGlobalAlignBlock;
+    using PacBio::Align::Internal::StandardGlobalAlignBlock;
+
+    // unrelated or repetitive sequences in tiny blocks and narrow bands, where
+    // many cells tie and the matrix edges (MinScore) are close to every path
+    const std::vector<std::string> seqs{"A",     "C",      "AA",         "CCC",      "ACAC",
+                                        "CACA",  "AAAAA",  "CCCCCCC",    "ACGTT",    "TTGCA",
+                                        "GGGGA", "AGGGGG", "ACACACACAC", "TGTGTGTGT"};
+    for (const std::size_t band : {0, 1, 2, 15}) {
+        for (auto config :
+             {Config::Default(), Config{1, -1, -1, -1, 0}, Config{1, -4, -6, -1, 0}}) {
+            config.bandExtend_ = band;
+            StandardGlobalAlignBlock<float> floatGap{config};
+            StandardGlobalAlignBlock<std::int32_t> intGap{config};
+            BandedGlobalAlignBlock<float> floatSeed{config};
+            BandedGlobalAlignBlock<std::int32_t> intSeed{config};
+
+            for (const auto& target : seqs) {
+                for (const auto& query : seqs) {
+                    SCOPED_TRACE(target + " / " + query + ", band " + std::to_string(band));
+                    EXPECT_EQ(
+                        floatGap.Align(target.c_str(), target.size(), query.c_str(), query.size()),
+                        intGap.Align(target.c_str(), target.size(), query.c_str(), query.size()));
+
+                    const Seed seed{0, 0, target.size(), query.size()};
+                    EXPECT_EQ(floatSeed.Align(target.c_str(), query.c_str(), seed),
+                              intSeed.Align(target.c_str(), query.c_str(), seed));
+                }
+            }
+        }
+    }
+}
+
+TEST(Align_BandedChainAlignment, non_integral_scores_use_float_blocks)
+{
+    using Config = PacBio::Align::BandedChainAlignConfig;
+    using Seed = PacBio::Align::Seed;
+
+    // can_generate_alignment_from_input_seeds, with every score scaled by 1.5:
+    // all cells scale exactly, so the alignment must not change
+    const Config config{3.0F, -1.5F, -3.0F, -1.5F, 2};
+    const std::string target{"CGAATCCATCCCACACA"};
+    const std::string query{"GGCGATNNNCATGGCACA"};
+    const auto seeds = std::vector<Seed>{Seed{0, 2, 5, 6}, Seed{6, 9, 9, 12}, Seed{11, 14, 17, 16}};
+
+    const auto result = PacBio::Align::BandedChainAlign(target, query, seeds, config);
+    EXPECT_EQ("--CGAATC--CATCCCACACA", result.alignedTarget_);
+    EXPECT_EQ("GGCG-ATNNNCATGGCACA--", result.alignedQuery_);
+    EXPECT_EQ("IIMMDMMRIIMMMRRMMMMDD", result.transcript_);
+    // 1.5 * 14 = 21 exactly, but Score() accumulates into an integer, which
+    // truncates after each of the four half-point steps
+    EXPECT_EQ(19, result.Score());
+}
@@ -0,0 +1,94 @@
+#include <pbcopper/align/ChainSeeds.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ChainSeedsTests {
+
+// 'count' collinear seeds of length 'k' along diagonal 'hOffset - vOffset',
+// one every 'spacing' bases
+std::vector<PacBio::Align::Seed> DiagonalSeeds(const std::size_t hOffset, const std::size_t vOffset,
+                                               const std::size_t count, const std::size_t spacing,
+                                               const std::size_t k)
+{
+    std::vector<PacBio::Align::Seed> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.emplace_back(hOffset + (i * spacing), vOffset + (i * spacing), k);
+    }
+    return result;
+}
+
+}  // namespace ChainSeedsTests
+
+TEST(Align_ChainSeeds, flat_chaining_finds_collinear_seeds_among_noise)
+{
+    using PacBio::Align::Seed;
+
+    const auto expected = ChainSeedsTests::DiagonalSeeds(100, 5'000, 40, 25, 12);
+    auto seeds = expected;
+
+    std::mt19937 rng{1};
+    std::uniform_int_distribution<std::size_t> pos{0, 20'000};
+    for (int i = 0; i < 200; ++i) {
+        seeds.emplace_back(pos(rng) % 1'100, pos(rng), 12);
+    }
+    std::shuffle(seeds.begin(), seeds.end(), rng);
+
+    const PacBio::Align::ChainSeedsConfig config{1};
+    const auto chains = PacBio::Align::ChainSeedsFlat(seeds, config);
+    ASSERT_EQ(1, chains.size());
+    EXPECT_EQ(expected, chains.front());
+
+    // tree-based chaining agrees on the best chain
+    PacBio::Align::Seeds seedSet;
+    for (const auto& seed : seeds) {
+        seedSet.AddSeed(seed);
+    }
+    const auto reference = PacBio::Align::ChainSeeds(seedSet, config);
+    ASSERT_EQ(1, reference.size());
+    EXPECT_EQ(reference.front(), chains.front());
+}
+
+TEST(Align_ChainSeeds, flat_chaining_reports_non_overlapping_chains_best_first)
+{
+    auto seeds = ChainSeedsTests::DiagonalSeeds(0, 10'000, 10, 20, 12);
+    const auto longer = ChainSeedsTests::DiagonalSeeds(0, 0, 30, 20, 12);
+    seeds.insert(seeds.end(), longer.begin(), longer.end());
+
+    const PacBio::Align::ChainSeedsConfig config{5};
+    const auto chains = PacBio::Align::ChainSeedsFlat(seeds, config);
+    ASSERT_EQ(2, chains.size());
+    EXPECT_EQ(longer, chains[0]);
+    EXPECT_EQ(ChainSeedsTests::DiagonalSeeds(0, 10'000, 10, 20, 12), chains[1]);
+}
+
+TEST(Align_ChainSeeds, flat_chaining_respects_min_score_and_empty_input)
+{
+    PacBio::Align::ChainSeedsConfig config{10};
+    EXPECT_TRUE(PacBio::Align::ChainSeedsFlat(std::vector<PacBio::Align::Seed>{}, config).empty());
+
+    config.minScore = 1'000;
+    const auto seeds = ChainSeedsTests::DiagonalSeeds(0, 0, 5, 20, 12);
+    EXPECT_TRUE(PacBio::Align::ChainSeedsFlat(seeds, config).empty());
+}
+
+TEST(Align_ChainSeeds, flat_chaining_across_seed_sets)
+{
+    std::map<std::size_t, PacBio::Align::Seeds> seedSets;
+    for (const auto& seed : ChainSeedsTests::DiagonalSeeds(0, 0, 5, 20, 12)) {
+        seedSets[3].AddSeed(seed);
+    }
+    for (const auto& seed : ChainSeedsTests::DiagonalSeeds(0, 0, 15, 20, 12)) {
+        seedSets[7].AddSeed(seed);
+    }
+
+    const PacBio::Align::ChainSeedsConfig config{1};
+    const auto chains = PacBio::Align::ChainSeedsFlat(seedSets, config);
+    ASSERT_EQ(1, chains.size());
+    EXPECT_EQ(7, chains.front().first);
+    EXPECT_EQ(15, chains.front().second.size());
+}
@@ -4,9 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "RandomSequences.h"
+
 TEST(Align_GlobalLocalAlignment, perfect_match)
 {
     using namespace PacBio::Align;
@@ -129,3 +133,90 @@ TEST(Align_GlobalLocalAlignment, random)
     std::cerr << t.PrettyPrintNanoseconds(time) << '\n';
 }
 #endif
+
+namespace {
+
+PacBio::Align::GlobalLocalResult NaiveGlobalLocalAlign(
+    const std::string& query, const std::string& read,
+    const PacBio::Align::GlobalLocalParameters& p)
+{
+    const std::int32_t m = query.size() + 1;
+    const std::int32_t n = read.size() + 1;
+    std::vector<std::vector<std::int32_t>> mat(m, std::vector<std::int32_t>(n, 0));
+    for (std::int32_t i = 1; i < m; ++i) {
+        for (std::int32_t j = 1; j < n; ++j) {
+            const std::int32_t diag =
+                mat[i - 1][j - 1] +
+                (query[i - 1] == read[j - 1] ? p.MatchScore : p.MismatchPenalty);
+            const std::int32_t ins = mat[i][j - 1] + p.InsertionPenalty;
+            const std::int32_t del = mat[i - 1][j] + p.DeletionPenalty;
+            mat[i][j] = std::max({diag, ins, del});
+        }
+    }
+    PacBio::Align::GlobalLocalResult result{mat[m - 1][1], 0};
+    for (std::int32_t j = 2; j < n; ++j) {
+        if (mat[m - 1][j] > result.MaxScore) {
+            result = {mat[m - 1][j], j - 1};
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(Align_GlobalLocalAlignment, bit_parallel_unit_cost)
+{
+    using namespace PacBio::Align;
+    const std::string target{"CCGGTTACATTTAT"};
+    const std::string query{"GATTACA"};
+    GlobalLocalParameters params{0, -3, -3, -3, -3, -3};
+    GlobalLocalResult result = GlobalLocalAlign(query, target, params);
+    EXPECT_EQ(-3, result.MaxScore);
+    EXPECT_EQ(0, result.EndPos);
+
+    // a missing query prefix at the start of the read is not penalized
+    result = GlobalLocalAlign(std::string{"GATTACC"}, target, params);
+    EXPECT_EQ(0, result.MaxScore);
+    EXPECT_EQ(0, result.EndPos);
+
+    result = GlobalLocalAlign(std::string{"GGTTACA"}, target, params);
+    EXPECT_EQ(0, result.MaxScore);
+    EXPECT_EQ(8, result.EndPos);
+}
+
+TEST(Align_GlobalLocalAlignment, bit_parallel_matches_naive_dp_for_unit_cost_schemes)
+{
+    using namespace PacBio::Align;
+    // clang-format off
+    const std::vector<GlobalLocalParameters> schemes{
+        { 0, -1, -1, -1, -1, -1},
+        { 0, -3, -3, -3, -3, -3},
+        { 2,  0,  0, -2, -2,  0},
+        { 2,  0, -2,  0,  0, -2},
+        { 4,  2,  0,  0,  0,  0},
+        // not bit-parallel compatible
+        { 4, -4, -3, -3, -3, -3},
+    };
+    // clang-format on
+
+    std::mt19937 rng{42};
+    GlobalLocalStorage storage;
+    for (const std::int32_t queryLength : {1, 7, 63, 64, 65, 128, 150}) {
+        for (std::int32_t iter = 0; iter < 10; ++iter) {
+            const std::string query = PacBio::PbcopperTests::RandomSequence(queryLength, rng);
+            std::string read = PacBio::PbcopperTests::RandomSequence(50, rng) + query +
+                               PacBio::PbcopperTests::RandomSequence(50, rng);
+            // mutate a few bases of the embedded query
+            std::uniform_int_distribution<std::int32_t> posDist{0, queryLength - 1};
+            for (std::int32_t k = 0; k < 1 + queryLength / 20; ++k) {
+                read[50 + posDist(rng)] = 'T';
+            }
+            for (const auto& params : schemes) {
+                const GlobalLocalResult expected = NaiveGlobalLocalAlign(query, read, params);
+                const GlobalLocalResult result = GlobalLocalAlign(query, read, params, storage);
+                EXPECT_EQ(expected.MaxScore, result.MaxScore);
+                EXPECT_EQ(expected.EndPos, result.EndPos);
+            }
+        }
+    }
+}
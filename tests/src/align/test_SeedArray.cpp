@@ -0,0 +1,181 @@
+#include <pbcopper/align/SeedArray.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbcopper/align/ChainSeeds.h>
+#include <pbcopper/align/FindSeeds.h>
+#include <pbcopper/qgram/Index.h>
+
+#include "RandomSequences.h"
+
+namespace SeedArrayTests {
+
+std::map<std::size_t, std::vector<PacBio::Align::Seed>> Flatten(
+    const std::map<std::size_t, PacBio::Align::Seeds>& seeds)
+{
+    std::map<std::size_t, std::vector<PacBio::Align::Seed>> result;
+    for (const auto& [referenceIdx, seedSet] : seeds) {
+        result[referenceIdx].assign(seedSet.begin(), seedSet.end());
+    }
+    return result;
+}
+
+}  // namespace SeedArrayTests
+
+TEST(Align_SeedArray, sorts_lazily_by_reference_and_position)
+{
+    PacBio::Align::SeedArray seeds;
+    EXPECT_TRUE(seeds.empty());
+    EXPECT_TRUE(seeds.IsSorted());
+
+    seeds.Add(2, 10, 20, 5);
+    seeds.Add(0, 30, 40, 5);
+    seeds.Add(2, 5, 50, 5);
+    seeds.Add(0, 30, 10, 5);
+    ASSERT_EQ(4, seeds.size());
+    EXPECT_FALSE(seeds.IsSorted());
+
+    // insertion order until sorted
+    EXPECT_EQ(2, seeds.ReferenceIndex(0));
+    EXPECT_EQ(10, seeds.BeginPositionH(0));
+
+    const auto ranges = seeds.ReferenceRanges();
+    EXPECT_TRUE(seeds.IsSorted());
+    ASSERT_EQ(2, ranges.size());
+    EXPECT_EQ(0, ranges[0].referenceIdx);
+    EXPECT_EQ(0, ranges[0].begin);
+    EXPECT_EQ(2, ranges[0].end);
+    EXPECT_EQ(2, ranges[1].referenceIdx);
+    EXPECT_EQ(2, ranges[1].begin);
+    EXPECT_EQ(4, ranges[1].end);
+
+    const std::vector<PacBio::Align::Seed> expected0{{30, 10, 5}, {30, 40, 5}};
+    const std::vector<PacBio::Align::Seed> expected2{{5, 50, 5}, {10, 20, 5}};
+    EXPECT_EQ(expected0, seeds.Slice(ranges[0]));
+    EXPECT_EQ(expected2, seeds.Slice(ranges[1]));
+    EXPECT_EQ(15, seeds.EndPositionH(3));
+    EXPECT_EQ(25, seeds.EndPositionV(3));
+
+    seeds.clear();
+    EXPECT_TRUE(seeds.empty());
+    EXPECT_TRUE(seeds.ReferenceRanges().empty());
+}
+
+TEST(Align_SeedArray, merges_overlapping_seeds_on_sort)
+{
+    PacBio::Align::SeedArray seeds{true};
+    EXPECT_TRUE(seeds.MergeOnSort());
+
+    // overlapping & abutting k-mers along one diagonal
+    seeds.Add(0, 2, 12, 4);
+    seeds.Add(0, 0, 10, 4);
+    seeds.Add(0, 4, 14, 4);
+    // same diagonal, with a gap
+    seeds.Add(0, 20, 30, 4);
+    // other diagonal, overlapping in H
+    seeds.Add(0, 1, 100, 4);
+    // same positions, other reference
+    seeds.Add(1, 2, 12, 4);
+
+    const auto ranges = seeds.ReferenceRanges();
+    ASSERT_EQ(2, ranges.size());
+    EXPECT_EQ(4, seeds.size());
+    const std::vector<PacBio::Align::Seed> expected0{{0, 10, 8}, {1, 100, 4}, {20, 30, 4}};
+    const std::vector<PacBio::Align::Seed> expected1{{2, 12, 4}};
+    EXPECT_EQ(expected0, seeds.Slice(ranges[0]));
+    EXPECT_EQ(expected1, seeds.Slice(ranges[1]));
+
+    // a single diagonal is in order once merged
+    PacBio::Align::SeedArray diagonal{true};
+    diagonal.Add(0, 8, 18, 4);
+    diagonal.Add(0, 30, 40, 4);
+    diagonal.Add(0, 0, 10, 4);
+    diagonal.Add(0, 4, 14, 4);
+    const auto diagonalRanges = diagonal.ReferenceRanges();
+    ASSERT_EQ(1, diagonalRanges.size());
+    const std::vector<PacBio::Align::Seed> expectedDiagonal{{0, 10, 12}, {30, 40, 4}};
+    EXPECT_EQ(expectedDiagonal, diagonal.Slice(diagonalRanges[0]));
+}
+
+TEST(Align_SeedArray, find_seeds_matches_map_overload)
+{
+    std::mt19937 rng{42};
+    std::vector<std::string> refs;
+    for (int i = 0; i < 4; ++i) {
+        refs.push_back(PacBio::PbcopperTests::RandomSequence(5'000, rng));
+    }
+    const PacBio::QGram::Index index{10, refs};
+    const std::string query = PacBio::PbcopperTests::MutateSequence(
+        std::string_view{refs[2]}.substr(1'000, 2'000), 0.05, rng);
+
+    for (const std::optional<std::size_t> qIdx : {std::optional<std::size_t>{}, {2}}) {
+        PacBio::Align::SeedArray seeds;
+        PacBio::Align::FindSeeds(index, query, &seeds, qIdx, false);
+        EXPECT_FALSE(seeds.IsSorted());
+        EXPECT_EQ(SeedArrayTests::Flatten(PacBio::Align::FindSeeds(index, query, qIdx, false)),
+                  SeedArrayTests::Flatten(seeds.ToSeeds()));
+    }
+}
+
+TEST(Align_SeedArray, find_seeds_reuses_cleared_array)
+{
+    std::mt19937 rng{5};
+    const std::vector<std::string> refs{PacBio::PbcopperTests::RandomSequence(20'000, rng)};
+    const PacBio::QGram::Index index{10, refs};
+
+    // ever longer queries through one array, cleared in between
+    PacBio::Align::SeedArray seeds;
+    int numReallocations = 0;
+    for (std::size_t i = 0; i < 200; ++i) {
+        const std::string query = PacBio::PbcopperTests::MutateSequence(
+            std::string_view{refs[0]}.substr(50 * i, 20 + 10 * i), 0.02, rng);
+        const std::size_t capacity = seeds.capacity();
+        seeds.clear();
+        PacBio::Align::FindSeeds(index, query, &seeds);
+        numReallocations += (seeds.capacity() != capacity);
+        ASSERT_EQ(SeedArrayTests::Flatten(PacBio::Align::FindSeeds(index, query)),
+                  SeedArrayTests::Flatten(seeds.ToSeeds()))
+            << "query " << i;
+    }
+    EXPECT_LE(numReallocations, 12);
+}
+
+TEST(Align_SeedArray, chaining_matches_map_overload)
+{
+    std::mt19937 rng{7};
+    std::vector<std::string> refs;
+    for (int i = 0; i < 3; ++i) {
+        refs.push_back(PacBio::PbcopperTests::RandomSequence(20'000, rng));
+    }
+    const PacBio::QGram::Index index{12, refs};
+    const std::string query = PacBio::PbcopperTests::MutateSequence(
+                                  std::string_view{refs[1]}.substr(5'000, 3'000), 0.08, rng) +
+                              PacBio::PbcopperTests::MutateSequence(
+                                  std::string_view{refs[2]}.substr(100, 1'000), 0.08, rng);
+
+    PacBio::Align::SeedArray seeds;
+    PacBio::Align::FindSeeds(index, query, &seeds);
+    const PacBio::Align::ChainSeedsConfig config{2};
+    const auto chains = PacBio::Align::ChainSeedsFlat(&seeds, config);
+    const auto expected =
+        PacBio::Align::ChainSeedsFlat(PacBio::Align::FindSeeds(index, query), config);
+
+    ASSERT_EQ(2, chains.size());
+    ASSERT_EQ(expected.size(), chains.size());
+    EXPECT_EQ(1, chains[0].first);
+    EXPECT_EQ(2, chains[1].first);
+    for (std::size_t i = 0; i < chains.size(); ++i) {
+        EXPECT_EQ(expected[i].first, chains[i].first);
+        std::vector<PacBio::Align::Seed> expectedChain(expected[i].second.begin(),
+                                                       expected[i].second.end());
+        std::sort(expectedChain.begin(), expectedChain.end(), PacBio::Align::HVCompare);
+        EXPECT_EQ(expectedChain, chains[i].second);
+    }
+}
@@ -0,0 +1,201 @@
+#include <pbcopper/container/PackedDNAString.h>
+
+#include <pbcopper/utility/SequenceUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+namespace PackedDNAStringTests {
+
+// as PackedDNA2bitString::KMer, Ns as A
+std::uint64_t ScalarKMer(const std::string& seq, const std::size_t pos, const std::int32_t k)
+{
+    std::uint64_t kmer = 0;
+    for (std::int32_t i = 0; i < k; ++i) {
+        const char base = seq[pos + i];
+        kmer = (kmer << 2) | ((base == 'N') ? 0 : Container::ConvertAsciiTo2bit(base));
+    }
+    return kmer;
+}
+
+}  // namespace PackedDNAStringTests
+
+TEST(Container_PackedDNAString, two_bit_round_trip)
+{
+    const Container::PackedDNA2bitString str{"ACGTnnACgtN"};
+    EXPECT_EQ(11, str.Size());
+    EXPECT_EQ("ACGTNNACGTN", str.ToString());
+    EXPECT_EQ("ACGTNNACGTN", std::string{str});
+    EXPECT_EQ((std::vector<std::uint8_t>{0b00'01'10'11, 0b00'00'00'01, 0b10'11'00'00}),
+              (std::vector<std::uint8_t>{str.Data().begin(), str.Data().end()}));
+    EXPECT_EQ((std::vector<Container::PackedDNA2bitString::NRun>{{4, 2}, {10, 1}}), str.NRuns());
+
+    EXPECT_EQ('T', str[3]);
+    EXPECT_EQ('N', str[4]);
+    EXPECT_EQ('N', str[5]);
+    EXPECT_EQ('A', str[6]);
+    EXPECT_EQ(0, str.Code(4));
+    EXPECT_TRUE(str.IsN(10));
+    EXPECT_FALSE(str.IsN(9));
+}
+
+TEST(Container_PackedDNAString, two_bit_grows_like_string)
+{
+    std::mt19937 rng{42};
+    for (int i = 0; i < 200; ++i) {
+        std::string expected;
+        Container::PackedDNA2bitString str;
+        for (int j = 0; j < 6; ++j) {
+            const auto chunk = PbcopperTests::RandomSequence(rng() % 40, rng, "ACGTACGTN");
+            if (rng() % 4) {
+                str.Append(chunk);
+            } else {
+                for (const char c : chunk) {
+                    str.PushBack(c);
+                }
+            }
+            expected += chunk;
+        }
+
+        ASSERT_EQ(expected.size(), str.Size());
+        EXPECT_EQ(expected, str.ToString());
+        EXPECT_EQ(Container::PackedDNA2bitString{expected}, str);
+        for (std::size_t pos = 0; pos < expected.size(); pos += 7) {
+            EXPECT_EQ(expected[pos], str[pos]);
+            const std::size_t len = rng() % (expected.size() - pos + 1);
+            EXPECT_EQ(expected.substr(pos, len), str.ToString(pos, len));
+        }
+    }
+}
+
+TEST(Container_PackedDNAString, two_bit_reverse_complement)
+{
+    std::mt19937 rng{7};
+    for (const std::size_t length : {0, 1, 3, 4, 5, 15, 16, 31, 32, 33, 63, 64, 65, 200}) {
+        SCOPED_TRACE(length);
+        const auto seq = PbcopperTests::RandomSequence(length, rng, "ACGTACGTNN");
+        Container::PackedDNA2bitString str{seq};
+        str.ReverseComplement();
+        EXPECT_EQ(Utility::ReverseComplemented(seq), str.ToString());
+        EXPECT_EQ(Container::PackedDNA2bitString{Utility::ReverseComplemented(seq)}, str);
+    }
+}
+
+TEST(Container_PackedDNAString, two_bit_kmers)
+{
+    std::mt19937 rng{3};
+    const auto seq = PbcopperTests::RandomSequence(300, rng, "ACGTACGTACGTACGTN");
+    const Container::PackedDNA2bitString str{seq};
+
+    for (const std::int32_t k : {1, 5, 15, 16, 17, 31, 32}) {
+        SCOPED_TRACE(k);
+        for (std::size_t pos = 0; pos + k <= seq.size(); ++pos) {
+            ASSERT_EQ(PackedDNAStringTests::ScalarKMer(seq, pos, k), str.KMer(pos, k));
+        }
+
+        std::size_t numKMers = 0;
+        str.ForEachKMer(k, [&](const std::size_t pos, const std::uint64_t kmer) {
+            EXPECT_EQ(std::string::npos, seq.substr(pos, k).find('N'));
+            EXPECT_EQ(str.KMer(pos, k), kmer);
+            ++numKMers;
+        });
+        std::size_t expectedKMers = 0;
+        for (std::size_t pos = 0; pos + k <= seq.size(); ++pos) {
+            expectedKMers += (seq.substr(pos, k).find('N') == std::string::npos);
+        }
+        EXPECT_EQ(expectedKMers, numKMers);
+    }
+
+    // 'CGT' = 0b01'10'11
+    EXPECT_EQ(0b01'10'11U, Container::PackedDNA2bitString{"ACGT"}.KMer(1, 3));
+}
+
+TEST(Container_PackedDNAString, two_bit_views)
+{
+    const Container::PackedDNA2bitString str{"GATTACANNCAT"};
+    const auto view = str.Substr(4, 6);
+    EXPECT_EQ(6, view.Size());
+    EXPECT_EQ("ACANNC", view.ToString());
+    EXPECT_EQ('N', view[3]);
+    EXPECT_EQ(0b00'01'00U, view.KMer(0, 3));
+
+    const auto inner = view.Substr(1, 100);
+    EXPECT_EQ("CANNC", inner.ToString());
+    EXPECT_EQ("CAT", str.Substr(9, 100).ToString());
+    EXPECT_TRUE(str.Substr(12, 1).Empty());
+}
+
+TEST(Container_PackedDNAString, two_bit_invalid_base_leaves_string_unchanged)
+{
+    Container::PackedDNA2bitString str{"ACGNN"};
+    const auto expected = str;
+
+    EXPECT_THROW(str.Append("NNACGTACGTACGTACGTACGTR"), std::invalid_argument);
+    EXPECT_EQ(expected, str);
+    EXPECT_THROW(str.PushBack('-'), std::invalid_argument);
+    EXPECT_EQ(expected, str);
+
+    str.Append("NA");
+    EXPECT_EQ("ACGNNNA", str.ToString());
+    EXPECT_EQ((std::vector<Container::PackedDNA2bitString::NRun>{{3, 3}}), str.NRuns());
+
+    str.Clear();
+    EXPECT_TRUE(str.Empty());
+    EXPECT_EQ(Container::PackedDNA2bitString{}, str);
+}
+
+TEST(Container_PackedDNAString, four_bit_round_trip)
+{
+    const Container::PackedDNA4bitString str{"ACGTnryu="};
+    EXPECT_EQ(9, str.Size());
+    EXPECT_EQ("ACGTNRYT=", str.ToString());
+    EXPECT_EQ((std::vector<std::uint8_t>{0x12, 0x48, 0xF5, 0xA8, 0x00}),
+              (std::vector<std::uint8_t>{str.Data().begin(), str.Data().end()}));
+    EXPECT_EQ('R', str[5]);
+    EXPECT_EQ(0x5, str.Code(5));
+    EXPECT_EQ(0x48F5U, str.KMer(2, 4));
+    EXPECT_EQ("TNRY", str.Substr(3, 4).ToString());
+
+    std::mt19937 rng{5};
+    const std::string_view codes{"=ACMGRSVTWYHKDBN"};
+    for (const std::size_t length : {0, 1, 2, 15, 16, 17, 31, 32, 33, 100}) {
+        SCOPED_TRACE(length);
+        const auto seq = PbcopperTests::RandomSequence(length, rng, codes);
+        Container::PackedDNA4bitString str2;
+        str2.Append(seq.substr(0, length / 3));
+        for (const char c : seq.substr(length / 3, length / 3)) {
+            str2.PushBack(c);
+        }
+        str2.Append(seq.substr(2 * (length / 3)));
+        ASSERT_EQ(seq, str2.ToString());
+        for (std::size_t pos = 0; pos < length; ++pos) {
+            EXPECT_EQ(seq.substr(pos, 5),
+                      str2.ToString(pos, std::min<std::size_t>(5, length - pos)));
+        }
+    }
+}
+
+TEST(Container_PackedDNAString, four_bit_reverse_complement)
+{
+    std::mt19937 rng{9};
+    for (const std::size_t length : {0, 1, 2, 7, 15, 16, 17, 32, 33, 101}) {
+        SCOPED_TRACE(length);
+        const auto seq = PbcopperTests::RandomSequence(length, rng, "ACGTMRWSYKVHDBN");
+        Container::PackedDNA4bitString str{seq};
+        str.ReverseComplement();
+        EXPECT_EQ(Utility::ReverseComplemented(seq), str.ToString());
+        EXPECT_EQ(Container::PackedDNA4bitString{Utility::ReverseComplemented(seq)}, str);
+    }
+
+    Container::PackedDNA4bitString str{"ACG"};
+    EXPECT_THROW(str.Append("T-"), std::invalid_argument);
+    EXPECT_EQ(Container::PackedDNA4bitString{"ACG"}, str);
+}
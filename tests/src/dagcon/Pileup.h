@@ -0,0 +1,74 @@
+#ifndef PBCOPPER_TESTS_DAGCON_PILEUP_H
+#define PBCOPPER_TESTS_DAGCON_PILEUP_H
+
+#include <pbcopper/dagcon/Alignment.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+#include "RandomSequences.h"
+
+namespace DagconTests {
+
+struct Pileup
+{
+    std::string Template;
+    std::string Backbone;
+    std::vector<PacBio::Dagcon::Alignment> Alignments;
+};
+
+// A noisy backbone read and 'coverage'-fold noisy reads of 'readLength'
+// aligned to it, both sampled from one template.
+inline Pileup MakePileup(const std::size_t length, const int coverage, const std::size_t readLength,
+                         const double errorRate, const unsigned int seed)
+{
+    std::mt19937 rng{seed};
+    Pileup pileup;
+    pileup.Template = PacBio::PbcopperTests::RandomSequence(length, rng);
+
+    std::vector<std::string> backboneBases;
+    for (const char c : pileup.Template) {
+        backboneBases.push_back(PacBio::PbcopperTests::MutateBase(c, errorRate, rng));
+        pileup.Backbone += backboneBases.back();
+    }
+
+    std::uniform_int_distribution<std::size_t> readStart{0, length - readLength};
+    const std::size_t numReads = coverage * length / readLength;
+    for (std::size_t r = 0; r < numReads; ++r) {
+        const std::size_t begin = readStart(rng);
+        PacBio::Dagcon::Alignment alignment;
+        alignment.Id = "backbone";
+        alignment.SId = "read" + std::to_string(r);
+        alignment.TargetLength = pileup.Backbone.length();
+
+        // alignment induced by the template, starting at the first backbone base
+        std::size_t backboneBefore = 0;
+        for (std::size_t i = 0; i < begin; ++i) {
+            backboneBefore += backboneBases[i].length();
+        }
+        for (std::size_t i = begin; i < begin + readLength; ++i) {
+            std::string query =
+                PacBio::PbcopperTests::MutateBase(pileup.Template[i], errorRate, rng);
+            std::string target = backboneBases[i];
+            if (alignment.Target.empty() && target.empty()) {
+                continue;
+            }
+            query.resize(std::max(query.length(), target.length()), '-');
+            target.resize(query.length(), '-');
+            alignment.Query += query;
+            alignment.Target += target;
+        }
+        alignment.Start = backboneBefore + 1;
+        PacBio::Dagcon::NormalizeGaps(alignment);
+        pileup.Alignments.push_back(std::move(alignment));
+    }
+    return pileup;
+}
+
+}  // namespace DagconTests
+
+#endif  // PBCOPPER_TESTS_DAGCON_PILEUP_H
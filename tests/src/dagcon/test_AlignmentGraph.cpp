@@ -2,13 +2,64 @@
 
 #include <array>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include <pbcopper/dagcon/Alignment.h>
 
+#include "Pileup.h"
+
 using namespace PacBio;
 
+namespace AlignmentGraphTests {
+
+void ExpectSameBestPath(Dagcon::AlignmentGraph& expected, Dagcon::AlignmentGraph& actual)
+{
+    const auto expectedPath = expected.BestPath();
+    const auto actualPath = actual.BestPath();
+    ASSERT_EQ(expectedPath.size(), actualPath.size());
+    for (std::size_t i = 0; i < expectedPath.size(); ++i) {
+        EXPECT_EQ(expectedPath[i].Base, actualPath[i].Base) << i;
+        EXPECT_EQ(expectedPath[i].Coverage, actualPath[i].Coverage) << i;
+        EXPECT_EQ(expectedPath[i].Weight, actualPath[i].Weight) << i;
+        EXPECT_EQ(expectedPath[i].Backbone, actualPath[i].Backbone) << i;
+    }
+}
+
+// builds the graph both ways, comparing best paths before and after merging
+void ExpectBatchBuildMatches(const std::string& backbone,
+                             const std::vector<Dagcon::Alignment>& alignments,
+                             const Dagcon::AlignmentGraphBuildOptions& options)
+{
+    const auto sequentialBuild = [&]() {
+        Dagcon::AlignmentGraph graph{backbone};
+        for (auto alignment : alignments) {
+            graph.AddAlignment(alignment, options.UseLocalMerge);
+        }
+        return graph;
+    };
+
+    // NOTE: BestPath leaves edges visited, so it can't precede MergeNodes
+    {
+        auto expected = sequentialBuild();
+        Dagcon::AlignmentGraph batch{backbone, alignments, options};
+        EXPECT_EQ(expected.DanglingNodes(), batch.DanglingNodes());
+        ExpectSameBestPath(expected, batch);
+    }
+
+    auto expected = sequentialBuild();
+    Dagcon::AlignmentGraph batch{backbone, alignments, options};
+    expected.MergeNodes();
+    batch.MergeNodes();
+    ExpectSameBestPath(expected, batch);
+    EXPECT_EQ(expected.Consensus(), batch.Consensus());
+}
+
+}  // namespace AlignmentGraphTests
+
 // clang-format off
 
 TEST(Dagcon_AlignmentGraph, can_generate_raw_consensus)
@@ -63,3 +114,60 @@ TEST(Dagcon_AlignmentGraph, dangling_nodes)
 }
 
 // clang-format on
+
+TEST(Dagcon_AlignmentGraph, batch_build_matches_sequential_build)
+{
+    const auto pileup = DagconTests::MakePileup(1'500, 12, 400, 0.12, 7);
+
+    for (const bool useLocalMerge : {false, true}) {
+        // windows smaller than, and larger than, the alignments
+        for (const std::size_t windowSize : {1, 37, 1'000'000}) {
+            for (const unsigned int numThreads : {1U, 3U}) {
+                Dagcon::AlignmentGraphBuildOptions options;
+                options.NumThreads = numThreads;
+                options.WindowSize = windowSize;
+                options.UseLocalMerge = useLocalMerge;
+                AlignmentGraphTests::ExpectBatchBuildMatches(pileup.Backbone, pileup.Alignments,
+                                                             options);
+            }
+        }
+    }
+}
+
+TEST(Dagcon_AlignmentGraph, batch_build_handles_unfilled_backbone_and_edge_cases)
+{
+    // 'N' backbone filled in by the alignments, alignments touching both ends,
+    // trailing insertions, and an empty alignment
+    std::vector<Dagcon::Alignment> algs(4);
+    algs[0].Target = "ATATTA---GGC";
+    algs[0].Query = "ATAT-AGCCGGC";
+    algs[0].Start = 1;
+    algs[1].Target = "TTA-GGC--";
+    algs[1].Query = "T-ACGG-AA";
+    algs[1].Start = 4;
+    algs[2].Target = "--GC";
+    algs[2].Query = "CC-C";
+    algs[2].Start = 8;
+    algs[3].Start = 5;
+
+    Dagcon::AlignmentGraphBuildOptions options;
+    options.WindowSize = 2;
+    AlignmentGraphTests::ExpectBatchBuildMatches(std::string(9, 'N'), algs, options);
+}
+
+TEST(Dagcon_AlignmentGraph, batch_build_rejects_alignments_off_the_backbone)
+{
+    const std::string backbone{"ACGT"};
+    std::vector<Dagcon::Alignment> algs(1);
+    algs[0].Target = "GTA";
+    algs[0].Query = "GTA";
+    algs[0].Start = 3;
+    EXPECT_THROW((Dagcon::AlignmentGraph{backbone, algs}), std::invalid_argument);
+
+    algs[0].Start = 0;
+    EXPECT_THROW((Dagcon::AlignmentGraph{backbone, algs}), std::invalid_argument);
+
+    algs[0].Target = "GT";
+    algs[0].Start = 3;
+    EXPECT_THROW((Dagcon::AlignmentGraph{backbone, algs}), std::invalid_argument);
+}
@@ -0,0 +1,80 @@
+#include <pbcopper/dagcon/WindowedAlignmentGraph.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbcopper/dagcon/Alignment.h>
+#include <pbcopper/dagcon/AlignmentGraph.h>
+#include <pbcopper/utility/Stopwatch.h>
+
+#include "Pileup.h"
+
+using namespace PacBio;
+
+TEST(Dagcon_WindowedAlignmentGraph, single_window_matches_alignment_graph)
+{
+    const auto pileup = DagconTests::MakePileup(2'000, 10, 500, 0.12, 5);
+
+    Dagcon::AlignmentGraph graph{pileup.Backbone, pileup.Alignments};
+    graph.MergeNodes();
+    const auto expected = graph.BestPath();
+
+    Dagcon::WindowedAlignmentGraphOptions options;
+    options.WindowSize = pileup.Backbone.length();
+    const Dagcon::WindowedAlignmentGraph windowed{pileup.Backbone, pileup.Alignments, options};
+    const auto& actual = windowed.BestPath();
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].Base, actual[i].Base);
+        EXPECT_EQ(expected[i].Coverage, actual[i].Coverage);
+        EXPECT_EQ(expected[i].Weight, actual[i].Weight);
+    }
+    EXPECT_EQ(graph.Consensus(), windowed.Consensus());
+
+    std::vector<Dagcon::ConsensusResult> expectedSeqs;
+    std::vector<Dagcon::ConsensusResult> actualSeqs;
+    graph.ConsensusWithMinFlankCoverage(expectedSeqs, 8, 3, 100);
+    windowed.ConsensusWithMinFlankCoverage(actualSeqs, 8, 3, 100);
+    ASSERT_EQ(expectedSeqs.size(), actualSeqs.size());
+    for (std::size_t i = 0; i < expectedSeqs.size(); ++i) {
+        EXPECT_EQ(expectedSeqs[i].Seq, actualSeqs[i].Seq);
+    }
+}
+
+TEST(Dagcon_WindowedAlignmentGraph, stitched_windows_match_full_consensus)
+{
+    const auto pileup = DagconTests::MakePileup(6'000, 20, 1'000, 0.12, 9);
+
+    Dagcon::AlignmentGraph graph{pileup.Backbone, pileup.Alignments};
+    graph.MergeNodes();
+    const std::string expected = graph.Consensus();
+
+    for (const unsigned int numThreads : {1U, 3U}) {
+        Dagcon::WindowedAlignmentGraphOptions options;
+        options.WindowSize = 700;
+        options.Overlap = 150;
+        options.NumThreads = numThreads;
+        const Dagcon::WindowedAlignmentGraph windowed{pileup.Backbone, pileup.Alignments, options};
+        EXPECT_EQ('^', windowed.BestPath().front().Base);
+        EXPECT_EQ('$', windowed.BestPath().back().Base);
+        EXPECT_EQ(expected, windowed.Consensus());
+    }
+}
+
+TEST(Dagcon_WindowedAlignmentGraph, rejects_alignments_off_the_backbone)
+{
+    const std::string backbone{"ACGTACGT"};
+    std::vector<Dagcon::Alignment> algs(1);
+    algs[0].Target = "CGTA";
+    algs[0].Query = "CGTA";
+    algs[0].Start = 6;
+
+    Dagcon::WindowedAlignmentGraphOptions options;
+    options.WindowSize = 3;
+    EXPECT_THROW((Dagcon::WindowedAlignmentGraph{backbone, algs, options}), std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+#ifndef PBCOPPER_TESTS_DATA_ALIGNEDREADS_H
+#define PBCOPPER_TESTS_DATA_ALIGNEDREADS_H
+
+#include <pbcopper/data/MappedRead.h>
+
+#include <random>
+#include <string>
+#include <utility>
+
+#include <cstddef>
+
+namespace MappedReadTests {
+
+// CCS-like read: 'length' bases w/ qualities & kinetics, ~1% indels, clipped
+inline PacBio::Data::MappedRead MakeAlignedRead(const std::size_t length,
+                                                const PacBio::Data::Strand strand,
+                                                std::mt19937* rng)
+{
+    using namespace PacBio::Data;
+
+    std::uniform_int_distribution<int> base{0, 3};
+    std::uniform_int_distribution<int> value{0, 90};
+    std::uniform_int_distribution<int> runLength{20, 180};
+    std::uniform_int_distribution<int> clipLength{1, 30};
+    std::string seq;
+    QualityValues quals;
+    Frames ipd;
+    Frames pw;
+    for (std::size_t i = 0; i < length; ++i) {
+        seq.push_back("ACGT"[base(*rng)]);
+        quals.push_back(value(*rng));
+        ipd.push_back(value(*rng));
+        pw.push_back(value(*rng));
+    }
+
+    Cigar cigar;
+    cigar.emplace_back(CigarOperationType::HARD_CLIP, clipLength(*rng));
+    const std::size_t leftClip = clipLength(*rng);
+    const std::size_t rightClip = clipLength(*rng);
+    std::size_t queryLength = leftClip;
+    cigar.emplace_back(CigarOperationType::SOFT_CLIP, leftClip);
+    while (queryLength + rightClip + 200 < length) {
+        const int run = runLength(*rng);
+        cigar.emplace_back(CigarOperationType::SEQUENCE_MATCH, run);
+        switch (run % 4) {
+            case 0:
+                cigar.emplace_back(CigarOperationType::DELETION, 1 + run % 3);
+                break;
+            case 1:
+                cigar.emplace_back(CigarOperationType::INSERTION, 1);
+                ++queryLength;
+                break;
+            case 2:
+                cigar.emplace_back(CigarOperationType::SEQUENCE_MISMATCH, 1);
+                ++queryLength;
+                break;
+            default:
+                cigar.emplace_back(CigarOperationType::INSERTION, 2);
+                queryLength += 2;
+                break;
+        }
+        queryLength += run;
+    }
+    cigar.emplace_back(CigarOperationType::SEQUENCE_MATCH, length - queryLength - rightClip);
+    cigar.emplace_back(CigarOperationType::SOFT_CLIP, rightClip);
+
+    Read read{"", std::move(seq), std::move(quals), SNR{0.0, 0.0, 0.0, 0.0}};
+    read.IPD = std::move(ipd);
+    read.PulseWidth = std::move(pw);
+    MappedRead mr{std::move(read), strand, 0, std::move(cigar), 60};
+    return mr;
+}
+
+}  // namespace MappedReadTests
+
+#endif  // PBCOPPER_TESTS_DATA_ALIGNEDREADS_H
@@ -1,5 +1,11 @@
 #include <pbcopper/data/Cigar.h>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
 #include <gtest/gtest.h>
 
 using Cigar = PacBio::Data::Cigar;
@@ -190,6 +196,69 @@ TEST(Data_Cigar, can_create_string_from_multi_op_cigar)
     EXPECT_EQ("100=2D34I6=6X6=", cigar.ToStdString());
 }
 
+TEST(Data_Cigar, parse_reuses_storage)
+{
+    Cigar cigar;
+    PacBio::Data::ParseCigar("100=2D34I6=6X6=", cigar);
+    ASSERT_EQ(6, cigar.size());
+    const CigarOperation* storage = cigar.data();
+
+    PacBio::Data::ParseCigar("3S5=1I4=", cigar);
+    EXPECT_EQ(storage, cigar.data());
+    EXPECT_EQ(Cigar{"3S5=1I4="}, cigar);
+
+    PacBio::Data::ParseCigar("", cigar);
+    EXPECT_TRUE(cigar.empty());
+}
+
+TEST(Data_Cigar, parse_rejects_malformed_lengths)
+{
+    Cigar cigar;
+    EXPECT_THROW(PacBio::Data::ParseCigar("10=D", cigar), std::invalid_argument);
+    EXPECT_THROW(PacBio::Data::ParseCigar("=", cigar), std::invalid_argument);
+    EXPECT_THROW(PacBio::Data::ParseCigar("268435456=", cigar), std::out_of_range);
+    EXPECT_THROW(Cigar{"I"}, std::invalid_argument);
+
+    PacBio::Data::ParseCigar("268435455=", cigar);
+    EXPECT_EQ(268435455, cigar.front().Length());
+}
+
+TEST(Data_Cigar, can_round_trip_string_and_bam_encoding)
+{
+    const std::string str{"2H3S100=2D34I6=6X1N1P6=3S"};
+    const Cigar cigar{str};
+    EXPECT_EQ(str, cigar.ToStdString());
+
+    std::string appended{"CIGAR:"};
+    PacBio::Data::AppendCigarString(cigar, appended);
+    EXPECT_EQ("CIGAR:" + str, appended);
+
+    std::vector<std::uint32_t> packed(cigar.size());
+    PacBio::Data::CigarToPacked(cigar, packed.data());
+    EXPECT_EQ((100U << 4) | 7U, packed[2]);
+    EXPECT_EQ(cigar, PacBio::Data::CigarFromPacked(packed.data(), packed.size()));
+    EXPECT_EQ(cigar[3], CigarOperation::FromPacked(cigar[3].Packed()));
+}
+
+TEST(Data_CigarView, views_part_of_a_cigar)
+{
+    const Cigar cigar{"3S5=1I4=2D3S"};
+    const PacBio::Data::CigarView view{cigar};
+    ASSERT_EQ(cigar.size(), view.size());
+    EXPECT_EQ(cigar.data(), view.data());
+    EXPECT_EQ(cigar, view);
+
+    const auto aligned = view.SubView(1, 4);
+    EXPECT_EQ("5=1I4=2D", aligned.ToStdString());
+    EXPECT_EQ(Cigar{"5=1I4=2D"}, aligned.ToCigar());
+    EXPECT_EQ(CigarOperationType::SEQUENCE_MATCH, aligned.front().Type());
+    EXPECT_EQ(CigarOperationType::DELETION, aligned.back().Type());
+    EXPECT_NE(view, aligned);
+    EXPECT_EQ(11, PacBio::Data::ReferenceLength(aligned));
+    EXPECT_EQ(9, PacBio::Data::CigarOpsCalculator(aligned).MatchBases);
+    EXPECT_TRUE(PacBio::Data::CigarView{}.empty());
+}
+
 TEST(Data_CigarOpsCalculator, can_count_base_events){
  const Cigar cigar = Cigar::FromStdString("5=1X2D3I");
  const auto results = CigarOpsCalculator(cigar);
@@ -0,0 +1,297 @@
+#include <pbcopper/data/ClippedRead.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio::Data;
+
+namespace ClippedReadTests {
+
+MappedRead MakeMappedRead(const Strand strand, std::mt19937& rng)
+{
+    static constexpr CigarOperationType middleOps[] = {
+        CigarOperationType::SEQUENCE_MATCH, CigarOperationType::SEQUENCE_MATCH,
+        CigarOperationType::SEQUENCE_MISMATCH, CigarOperationType::INSERTION,
+        CigarOperationType::DELETION};
+    std::uniform_int_distribution<int> opDist{0, 4};
+    std::uniform_int_distribution<std::uint32_t> lengthDist{1, 6};
+
+    Cigar cigar;
+    if (rng() % 2) {
+        cigar.emplace_back(CigarOperationType::SOFT_CLIP, lengthDist(rng));
+    }
+    for (int i = 0; i < 12; ++i) {
+        cigar.emplace_back(middleOps[opDist(rng)], lengthDist(rng));
+    }
+    if (rng() % 2) {
+        cigar.emplace_back(CigarOperationType::SOFT_CLIP, lengthDist(rng));
+    }
+
+    std::string seq;
+    for (const auto& op : cigar) {
+        if (ConsumesQuery(op.Type())) {
+            seq.append(op.Length(), "ACGT"[rng() % 4]);
+        }
+    }
+    Frames pw;
+    Frames ipd;
+    for (std::size_t i = 0; i < seq.size(); ++i) {
+        pw.push_back(i);
+        ipd.push_back(2 * i);
+    }
+    std::string fastq(seq.size(), '+');
+    std::generate(fastq.begin(), fastq.end(), [&rng]() { return '!' + rng() % 40; });
+
+    const Position qStart = 500;
+    const Position qEnd = qStart + seq.size();
+    Read read{"m/0/500_" + std::to_string(qEnd),
+              std::move(seq),
+              QualityValues::FromFastq(fastq),
+              SNR{1, 1, 1, 1},
+              qStart,
+              qEnd,
+              std::move(pw),
+              std::move(ipd)};
+    return MappedRead{std::move(read), strand, 1000, std::move(cigar), 60};
+}
+
+void ExpectSameMappedRead(const MappedRead& expected, const MappedRead& observed)
+{
+    EXPECT_EQ(expected.FullName(), observed.FullName());
+    EXPECT_EQ(expected.Seq, observed.Seq);
+    EXPECT_EQ(expected.Qualities, observed.Qualities);
+    EXPECT_EQ(expected.PulseWidth, observed.PulseWidth);
+    EXPECT_EQ(expected.IPD, observed.IPD);
+    EXPECT_EQ(expected.QueryStart, observed.QueryStart);
+    EXPECT_EQ(expected.QueryEnd, observed.QueryEnd);
+    EXPECT_EQ(expected.Strand, observed.Strand);
+    EXPECT_EQ(expected.TemplateStart, observed.TemplateStart);
+    EXPECT_EQ(expected.TemplateEnd, observed.TemplateEnd);
+    EXPECT_EQ(expected.Cigar, observed.Cigar);
+    EXPECT_EQ(expected.MapQuality, observed.MapQuality);
+}
+
+}  // namespace ClippedReadTests
+
+TEST(Data_ClippedRead, view_to_reference_points_into_read)
+{
+    const std::string seq{"AACCGTTAGC"};
+    const MappedRead read{
+        Read{"name/0/500_510", seq, QualityValues::FromFastq("0123456789"), SNR{0.9, 0.9, 0.9, 0.9},
+             500, 510, Frames(seq.size(), 1), Frames(seq.size(), 2)},
+        Strand::FORWARD, 100, Cigar{"4=1D2I2D4="}, 80};
+
+    const auto view = ClipViewToReference(read, 102, 107, false);
+    EXPECT_EQ("CCGT", view.Seq());
+    EXPECT_EQ(read.Seq.data() + 2, view.Seq().data());
+    EXPECT_EQ(502, view.QueryStart());
+    EXPECT_EQ(506, view.QueryEnd());
+    EXPECT_EQ(102, view.TemplateStart());
+    EXPECT_EQ(107, view.TemplateEnd());
+    ASSERT_EQ(4, view.NumCigarOperations());
+    EXPECT_EQ(CigarOperation(CigarOperationType::SEQUENCE_MATCH, 2), view.CigarOperationAt(0));
+    EXPECT_EQ(Cigar{"2=1D2I2D"}, view.Cigar());
+    EXPECT_EQ(std::size_t{2}, view.Span().FrontTrim);
+
+    // untouched source
+    EXPECT_EQ(seq, read.Seq);
+    EXPECT_EQ(Cigar{"4=1D2I2D4="}, read.Cigar);
+
+    // outside of alignment
+    const auto empty = ClipViewToReference(read, 0, 50, false);
+    EXPECT_TRUE(empty.Seq().empty());
+    EXPECT_EQ(255, empty.ToMappedRead().MapQuality);
+}
+
+TEST(Data_ClippedRead, clips_match_hand_computed_reads)
+{
+    struct Expected
+    {
+        std::string Seq;
+        std::string Qualities;
+        Position QueryStart;
+        Position QueryEnd;
+        Position TemplateStart;
+        Position TemplateEnd;
+        std::string Cigar;
+        std::uint8_t MapQuality;
+    };
+    const auto check = [](const MappedRead& read, const Expected& e) {
+        EXPECT_EQ(e.Seq, read.Seq);
+        EXPECT_EQ(e.Qualities, read.Qualities.Fastq());
+        EXPECT_EQ(e.QueryStart, read.QueryStart);
+        EXPECT_EQ(e.QueryEnd, read.QueryEnd);
+        EXPECT_EQ(e.TemplateStart, read.TemplateStart);
+        EXPECT_EQ(e.TemplateEnd, read.TemplateEnd);
+        EXPECT_EQ(e.Cigar, read.Cigar.ToStdString());
+        EXPECT_EQ(e.MapQuality, read.MapQuality);
+    };
+
+    // query [500, 514), reference [100, 112)
+    //   cigar: S S = = = I X X D D = = = I = =
+    //   seq:   T T A C G T A G - - G C A T C C
+    //   ref:       100     103 105 107     110
+    const auto makeRead = [](const Strand strand) {
+        const std::string seq{"TTACGTAGGCATCC"};
+        return MappedRead{
+            Read{"m/0/500_514", seq, QualityValues::FromFastq("0123456789:;<="), SNR{1, 1, 1, 1},
+                 500, 514, Frames(seq.size(), 1), Frames(seq.size(), 2)},
+            strand, 100, Cigar{"2S3=1I2X2D3=1I2="}, 60};
+    };
+
+    // clipped in place and as a view
+    const auto checkQueryClip = [&](const Strand strand, const Position start, const Position end,
+                                    const Expected& e) {
+        auto read = makeRead(strand);
+        check(ClipViewToQuery(read, start, end).ToMappedRead(), e);
+        ClipToQuery(read, start, end);
+        check(read, e);
+    };
+    const auto checkReferenceClip = [&](const Strand strand, const Position start,
+                                        const Position end, const bool excise, const Expected& e) {
+        auto read = makeRead(strand);
+        check(ClipViewToReference(read, start, end, excise).ToMappedRead(), e);
+        ClipToReference(read, start, end, excise);
+        check(read, e);
+    };
+
+    {
+        SCOPED_TRACE("query, trims ops at both ends");
+        checkQueryClip(Strand::FORWARD, 503, 510,
+                       {"CGTAGGC", "3456789", 503, 510, 101, 109, "2=1I2X2D2=", 60});
+    }
+    {
+        SCOPED_TRACE("query, reverse strand, drops the soft clip");
+        checkQueryClip(Strand::REVERSE, 500, 512,
+                       {"TTACGTAGGCAT", "0123456789:;", 500, 512, 100, 112, "3=1I2X2D3=1I2=", 60});
+    }
+    {
+        SCOPED_TRACE("reference, keeps flanking insertion");
+        checkReferenceClip(Strand::FORWARD, 102, 108, false,
+                           {"GTAGG", "45678", 504, 509, 102, 108, "1=1I2X2D1=", 60});
+    }
+    {
+        SCOPED_TRACE("reference, reverse strand");
+        checkReferenceClip(Strand::REVERSE, 102, 108, false,
+                           {"TAGGC", "56789", 505, 510, 102, 108, "1=1I2X2D1=", 60});
+    }
+    {
+        SCOPED_TRACE("reference, excises leading insertion");
+        checkReferenceClip(Strand::FORWARD, 103, 107, true,
+                           {"AG", "67", 506, 508, 103, 107, "2X2D", 60});
+    }
+    {
+        SCOPED_TRACE("reference, excises trailing insertion, keeps soft clip");
+        checkReferenceClip(Strand::FORWARD, 100, 103, true,
+                           {"TTACG", "01234", 500, 505, 100, 103, "2S3=", 60});
+    }
+    {
+        SCOPED_TRACE("reference, covers the alignment");
+        checkReferenceClip(
+            Strand::FORWARD, 90, 120, true,
+            {"TTACGTAGGCATCC", "0123456789:;<=", 500, 514, 100, 112, "2S3=1I2X2D3=1I2=", 60});
+    }
+    {
+        SCOPED_TRACE("reference, disjoint");
+        checkReferenceClip(Strand::FORWARD, 112, 130, false, {"", "", -1, -1, -1, -1, "", 255});
+    }
+}
+
+// in-place clips are checked against hand-computed reads above
+TEST(Data_ClippedRead, views_match_in_place_clips)
+{
+    std::mt19937 rng{42};
+    for (int i = 0; i < 2000; ++i) {
+        SCOPED_TRACE(i);
+        const auto strand = (i % 2) ? Strand::REVERSE : Strand::FORWARD;
+        const auto read = ClippedReadTests::MakeMappedRead(strand, rng);
+
+        const Position qLength = read.QueryEnd - read.QueryStart;
+        const Position qStart = read.QueryStart - 2 + rng() % (qLength + 4);
+        const Position qEnd = qStart + rng() % (qLength + 4);
+        auto clipped = read;
+        ClipToQuery(clipped, qStart, qEnd);
+        const auto queryView = ClipViewToQuery(read, qStart, qEnd);
+        ClippedReadTests::ExpectSameMappedRead(clipped, queryView.ToMappedRead());
+
+        const Position tLength = read.TemplateEnd - read.TemplateStart;
+        const Position tStart = read.TemplateStart - 2 + rng() % (tLength + 4);
+        const Position tEnd = tStart + 1 + rng() % (tLength + 4);
+        const bool excise = rng() % 2;
+        clipped = read;
+        ClipToReference(clipped, tStart, tEnd, excise);
+        const auto refView = ClipViewToReference(read, tStart, tEnd, excise);
+        ClippedReadTests::ExpectSameMappedRead(clipped, refView.ToMappedRead());
+        if (clipped.TemplateStart != UNMAPPED_POSITION) {
+            EXPECT_EQ(clipped.TemplateEnd - clipped.TemplateStart,
+                      static_cast<Position>(ReferenceLength(refView.Cigar())));
+        }
+    }
+}
+
+TEST(Data_ClippedRead, windowed_views_match_single_views)
+{
+    std::mt19937 rng{11};
+    for (int i = 0; i < 200; ++i) {
+        SCOPED_TRACE(i);
+        const auto strand = (i % 2) ? Strand::REVERSE : Strand::FORWARD;
+        const auto read = ClippedReadTests::MakeMappedRead(strand, rng);
+        const bool excise = i % 3;
+
+        // overlapping, sorted windows, then one out of order
+        std::vector<Interval> windows;
+        for (Position start = read.TemplateStart - 4; start < read.TemplateEnd + 4; start += 3) {
+            windows.emplace_back(start, start + 1 + rng() % 8);
+        }
+        std::sort(windows.begin(), windows.end(),
+                  [](const Interval& lhs, const Interval& rhs) { return lhs.End() < rhs.End(); });
+        windows.emplace_back(read.TemplateStart + 1, read.TemplateStart + 5);
+
+        const auto views = ClipViewsToReference(read, windows, excise);
+        ASSERT_EQ(windows.size(), views.size());
+        for (std::size_t j = 0; j < windows.size(); ++j) {
+            const auto expected =
+                ClipViewToReference(read, windows[j].Start(), windows[j].End(), excise);
+            ClippedReadTests::ExpectSameMappedRead(expected.ToMappedRead(),
+                                                   views[j].ToMappedRead());
+        }
+    }
+}
+
+TEST(Data_ClippedRead, unmapped_view_matches_in_place_clip)
+{
+    const Read read{"m/0/500_510",   "AACCGTTAGC", QualityValues::FromFastq("0123456789"),
+                    SNR{1, 1, 1, 1}, 500,          510};
+
+    const auto view = ClipViewToQuery(read, 502, 509);
+    EXPECT_EQ("CCGTTAG", view.Seq());
+    EXPECT_FALSE(view.PulseWidth());
+
+    auto clipped = read;
+    ClipToQuery(clipped, 502, 509);
+    EXPECT_EQ(clipped.Seq, view.ToRead().Seq);
+    EXPECT_EQ(clipped.Qualities, view.ToRead().Qualities);
+    EXPECT_EQ(502, view.ToRead().QueryStart);
+    EXPECT_EQ(509, view.ToRead().QueryEnd);
+}
+
+TEST(Data_ClippedRead, in_place_clip_keeps_storage)
+{
+    std::mt19937 rng{7};
+    auto read = ClippedReadTests::MakeMappedRead(Strand::FORWARD, rng);
+    const char* seq = read.Seq.data();
+    const auto* quals = read.Qualities.data();
+    const auto* ipd = read.IPD->Data().data();
+    const auto* cigar = read.Cigar.data();
+
+    ClipToReference(read, read.TemplateStart + 3, read.TemplateEnd - 3, true);
+    ClipToQuery(read, read.QueryStart + 1, read.QueryEnd - 1);
+    EXPECT_EQ(seq, read.Seq.data());
+    EXPECT_EQ(quals, read.Qualities.data());
+    EXPECT_EQ(ipd, read.IPD->Data().data());
+    EXPECT_EQ(cigar, read.Cigar.data());
+}
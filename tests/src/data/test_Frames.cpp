@@ -1,9 +1,12 @@
 #include <pbcopper/data/FrameEncoders.h>
 #include <pbcopper/data/Frames.h>
 
+#include <cmath>
 #include <cstdint>
 
 #include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -30,6 +33,54 @@ const std::vector<std::uint8_t> EncodedFrames{
 }  // namespace FramesTests
 // clang-format on
 
+namespace FramesTests {
+
+// V2 codec, per element, the way it was computed before the lookup tables
+std::uint8_t ReferenceV2Encode(const std::uint16_t x, const int exponentBits,
+                               const int mantissaBits)
+{
+    const int base = 1 << mantissaBits;
+    const int max = (1 << (exponentBits + mantissaBits)) - 1;
+    const int exponent = std::log2(x / base + 1);
+    if (exponent >= (1 << exponentBits)) {
+        return max;
+    }
+    const int mantissa = (x - base * (static_cast<int>(std::pow(2, exponent)) - 1)) >> exponent;
+    return std::min((exponent << mantissaBits) | mantissa, max);
+}
+
+double ReferenceV2Decode(const std::uint8_t x, const int mantissaBits)
+{
+    const int base = 1 << mantissaBits;
+    const int mantissa = x & (base - 1);
+    const int exponent = x >> mantissaBits;
+    return (base * (std::pow(2, exponent) - 1)) + (std::pow(2, exponent) * mantissa);
+}
+
+// codec with only the allocating API
+struct NegatingEncoder
+{
+    std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& rawFrames) const
+    {
+        std::vector<std::uint8_t> result;
+        for (const auto f : rawFrames) {
+            result.push_back(255 - std::min<std::uint16_t>(f, 255));
+        }
+        return result;
+    }
+    Frames Decode(const std::vector<std::uint8_t>& encodedFrames) const
+    {
+        Frames result;
+        for (const auto c : encodedFrames) {
+            result.push_back(255 - c);
+        }
+        return result;
+    }
+    std::string Name() const { return "Negating"; }
+};
+
+}  // namespace FramesTests
+
 TEST(Data_Frames, default_is_empty)
 {
     const Frames f;
@@ -148,3 +199,100 @@ TEST(Data_FrameEncoder, v2_decoder_produces_expected_values)
     std::vector<std::uint8_t> outOfRange{64, 65, 66};
     EXPECT_THROW(v2.Decode(outOfRange), std::runtime_error);
 }
+
+TEST(Data_FrameEncoder, v2_codec_matches_reference_for_all_configurations)
+{
+    std::vector<std::uint16_t> allFrames(65536);
+    std::iota(allFrames.begin(), allFrames.end(), 0);
+    std::vector<std::uint8_t> allCodes(256);
+    std::iota(allCodes.begin(), allCodes.end(), 0);
+
+    for (int exponentBits = 1; exponentBits <= 8; ++exponentBits) {
+        for (int mantissaBits = 0; exponentBits + mantissaBits <= 8; ++mantissaBits) {
+            const PacBio::Data::V2FrameEncoder v2{exponentBits, mantissaBits};
+            const std::string label = v2.Name();
+
+            // every frame value, so both the vectorized body and scalar tail are hit
+            const auto encoded = v2.Encode(allFrames);
+            for (std::size_t x = 0; x < allFrames.size(); ++x) {
+                ASSERT_EQ(FramesTests::ReferenceV2Encode(x, exponentBits, mantissaBits), encoded[x])
+                    << label << ", frame " << x;
+            }
+
+            const int numCodes = 1 << (exponentBits + mantissaBits);
+            const std::vector<std::uint8_t> codes(allCodes.begin(), allCodes.begin() + numCodes);
+            const auto decoded = v2.Decode(codes);
+            for (const auto code : codes) {
+                const double expected = FramesTests::ReferenceV2Decode(code, mantissaBits);
+                EXPECT_EQ(std::min(expected, 65535.0), decoded[code])
+                    << label << ", code " << int{code};
+            }
+        }
+    }
+}
+
+TEST(Data_FrameEncoder, v2_throws_on_unsupported_configuration)
+{
+    EXPECT_THROW(PacBio::Data::V2FrameEncoder(0, 4), std::invalid_argument);
+    EXPECT_THROW(PacBio::Data::V2FrameEncoder(2, -1), std::invalid_argument);
+    EXPECT_THROW(PacBio::Data::V2FrameEncoder(4, 5), std::invalid_argument);
+    EXPECT_NO_THROW(PacBio::Data::V2FrameEncoder(3, 5));
+}
+
+TEST(Data_FrameEncoder, can_encode_and_decode_into_existing_storage)
+{
+    const PacBio::Data::FrameEncoder v1 = PacBio::Data::V1FrameEncoder{};
+    const PacBio::Data::FrameEncoder v2 = PacBio::Data::V2FrameEncoder{2, 4};
+
+    for (const auto& codec : {v1, v2}) {
+        const auto expectedEncoded = codec.Encode(FramesTests::RawFrames);
+        const auto expectedDecoded = codec.Decode(expectedEncoded);
+
+        std::vector<std::uint8_t> encoded(FramesTests::RawFrames.size());
+        codec.EncodeInto(FramesTests::RawFrames, encoded);
+        EXPECT_EQ(expectedEncoded, encoded) << codec.Name();
+
+        std::vector<std::uint16_t> decoded(encoded.size());
+        codec.DecodeInto(encoded, decoded);
+        EXPECT_EQ(expectedDecoded.Data(), decoded) << codec.Name();
+
+        // buffers must match the input
+        decoded.pop_back();
+        EXPECT_THROW(codec.DecodeInto(encoded, decoded), std::invalid_argument);
+        encoded.push_back(0);
+        EXPECT_THROW(codec.EncodeInto(FramesTests::RawFrames, encoded), std::invalid_argument);
+    }
+
+    // Frames helpers resize, and reuse, their output
+    Frames frames{1, 2, 3};
+    Frames::DecodeInto(FramesTests::EncodedFrames, frames);
+    EXPECT_EQ(Frames::Decode(FramesTests::EncodedFrames), frames);
+
+    std::vector<std::uint8_t> codes(1000, 7);
+    Frames::EncodeInto(FramesTests::RawFrames, codes);
+    EXPECT_EQ(FramesTests::EncodedFrames, codes);
+
+    Frames::DecodeInto(std::vector<std::uint8_t>{16, 17}, frames,
+                       PacBio::Data::V2FrameEncoder{2, 4});
+    EXPECT_EQ((Frames{16, 18}), frames);
+}
+
+TEST(Data_FrameEncoder, type_erased_encoder_wraps_codecs_without_span_api)
+{
+    PacBio::Data::FrameEncoder codec = FramesTests::NegatingEncoder{};
+    const PacBio::Data::FrameEncoder copy = codec;
+    codec = PacBio::Data::V1FrameEncoder{};
+    EXPECT_EQ("CodecV1", codec.Name());
+    EXPECT_EQ("Negating", copy.Name());
+
+    const std::vector<std::uint16_t> raw{0, 5, 300};
+    std::vector<std::uint8_t> encoded(raw.size());
+    copy.EncodeInto(raw, encoded);
+    EXPECT_EQ((std::vector<std::uint8_t>{255, 250, 0}), encoded);
+
+    std::vector<std::uint16_t> decoded(encoded.size());
+    copy.DecodeInto(encoded, decoded);
+    EXPECT_EQ((std::vector<std::uint16_t>{0, 5, 255}), decoded);
+    EXPECT_THROW(copy.DecodeInto(encoded, std::span<std::uint16_t>{decoded}.first(2)),
+                 std::invalid_argument);
+}
@@ -0,0 +1,177 @@
+#include <pbcopper/data/IntervalIndex.h>
+
+#include <pbcopper/data/IntervalTree.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio::Data;
+
+namespace IntervalIndexTests {
+
+std::vector<Interval> RandomIntervals(const std::size_t n, const Position maxStart,
+                                      const Position maxLength, std::mt19937& rng)
+{
+    std::vector<Interval> result;
+    result.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Position start = rng() % maxStart;
+        result.emplace_back(start, start + rng() % maxLength);
+    }
+    return result;
+}
+
+// brute force: input indices of the intervals overlapping 'query'
+std::vector<std::size_t> ExpectedOverlaps(const std::vector<Interval>& intervals,
+                                          const Interval& query)
+{
+    std::vector<std::size_t> result;
+    if (query.Start() >= query.End()) {
+        return result;
+    }
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        if ((intervals[i].Start() < query.End()) && (query.Start() < intervals[i].End()) &&
+            (intervals[i].Start() < intervals[i].End())) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+std::vector<std::size_t> ToInputIndices(const IntervalIndex& index,
+                                        const std::vector<std::size_t>& hits)
+{
+    std::vector<std::size_t> result;
+    for (const auto hit : hits) {
+        result.push_back(index.InputIndex(hit));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}  // namespace IntervalIndexTests
+
+TEST(Data_IntervalIndex, overlap_and_stabbing_queries)
+{
+    const std::vector<Interval> intervals{{10, 20}, {0, 100}, {15, 16}, {30, 40}, {50, 50}};
+    const IntervalIndex index{intervals};
+
+    // empty interval left out
+    ASSERT_EQ(4, index.Size());
+    EXPECT_EQ(Interval(0, 100), index[0]);
+    EXPECT_EQ(Interval(10, 20), index[1]);
+    EXPECT_EQ(Interval(15, 16), index[2]);
+    EXPECT_EQ(Interval(30, 40), index[3]);
+    EXPECT_EQ(1, index.InputIndex(0));
+    EXPECT_FALSE(index.IsDisjoint());
+
+    EXPECT_EQ((std::vector<std::size_t>{0, 1, 2}), index.Stabbing(15));
+    EXPECT_EQ((std::vector<std::size_t>{0, 1}), index.Stabbing(16));
+    EXPECT_EQ((std::vector<std::size_t>{0}), index.Stabbing(20));
+    EXPECT_EQ((std::vector<std::size_t>{0, 1, 3}), index.Overlapping({19, 31}));
+    EXPECT_TRUE(index.Overlapping({100, 200}).empty());
+    EXPECT_TRUE(index.Overlapping({25, 25}).empty());
+
+    EXPECT_TRUE(index.Contains(0));
+    EXPECT_TRUE(index.Contains(99));
+    EXPECT_FALSE(index.Contains(100));
+    EXPECT_FALSE(index.Contains(-1));
+
+    const IntervalIndex empty;
+    EXPECT_FALSE(empty.Contains(0));
+    EXPECT_TRUE(empty.Overlapping({0, 10}).empty());
+}
+
+TEST(Data_IntervalIndex, queries_match_brute_force)
+{
+    std::mt19937 rng{42};
+    for (const std::size_t n : {1, 2, 3, 7, 8, 9, 16, 17, 100, 1000, 3000}) {
+        SCOPED_TRACE(n);
+        const auto intervals = IntervalIndexTests::RandomIntervals(n, 10000, 500, rng);
+        const IntervalIndex index{intervals};
+
+        for (int q = 0; q < 200; ++q) {
+            const Position start = static_cast<Position>(rng() % 11000) - 500;
+            const Interval query{start, start + static_cast<Position>(rng() % 300)};
+            const auto hits = index.Overlapping(query);
+            ASSERT_TRUE(std::is_sorted(hits.cbegin(), hits.cend()));
+            ASSERT_EQ(IntervalIndexTests::ExpectedOverlaps(intervals, query),
+                      IntervalIndexTests::ToInputIndices(index, hits));
+            ASSERT_EQ(!IntervalIndexTests::ExpectedOverlaps(intervals, {start, start + 1}).empty(),
+                      index.Contains(start));
+        }
+    }
+}
+
+TEST(Data_IntervalIndex, batched_queries_match_single_queries)
+{
+    std::mt19937 rng{7};
+    const auto intervals = IntervalIndexTests::RandomIntervals(2000, 100000, 80, rng);
+    auto queries = IntervalIndexTests::RandomIntervals(500, 100000, 200, rng);
+
+    const IntervalIndex overlapping{intervals};
+    const IntervalIndex merged = overlapping.Merged();
+    ASSERT_TRUE(merged.IsDisjoint());
+
+    for (const bool sorted : {false, true}) {
+        if (sorted) {
+            // Interval::operator< is not a strict weak order for empty intervals
+            std::sort(queries.begin(), queries.end(), [](const Interval& lhs, const Interval& rhs) {
+                return lhs.Start() < rhs.Start();
+            });
+        }
+        for (const IntervalIndex* index : {&overlapping, &merged}) {
+            std::vector<std::vector<std::size_t>> batched(queries.size());
+            index->ForEachOverlap(
+                std::span<const Interval>{queries},
+                [&](const std::size_t q, const std::size_t i) { batched[q].push_back(i); });
+            for (std::size_t q = 0; q < queries.size(); ++q) {
+                EXPECT_EQ(index->Overlapping(queries[q]), batched[q]);
+            }
+        }
+    }
+}
+
+TEST(Data_IntervalIndex, merged_matches_interval_tree)
+{
+    std::mt19937 rng{3};
+    const auto intervals = IntervalIndexTests::RandomIntervals(3000, 100000, 60, rng);
+
+    IntervalTree tree;
+    for (const auto& interval : intervals) {
+        if (interval.Start() < interval.End()) {
+            tree.Insert(interval);
+        }
+    }
+    const IntervalIndex merged = IntervalIndex{intervals}.Merged();
+
+    ASSERT_EQ(tree.size(), merged.Size());
+    std::size_t i = 0;
+    for (const auto& interval : tree) {
+        EXPECT_EQ(interval, merged[i++]);
+    }
+    for (Position p = 0; p < 100000; p += 7) {
+        ASSERT_EQ(tree.Contains(p), merged.Contains(p));
+    }
+}
+
+TEST(Data_IntervalIndex, parallel_build_matches_serial)
+{
+    std::mt19937 rng{11};
+    const auto intervals = IntervalIndexTests::RandomIntervals(300000, 1000000, 100, rng);
+    const IntervalIndex serial{intervals};
+    for (const unsigned int numThreads : {3U, 4U}) {
+        SCOPED_TRACE(numThreads);
+        const IntervalIndex parallel{intervals, numThreads};
+
+        ASSERT_EQ(serial.Size(), parallel.Size());
+        for (std::size_t i = 0; i < serial.Size(); ++i) {
+            ASSERT_EQ(serial[i], parallel[i]);
+            ASSERT_EQ(serial.InputIndex(i), parallel.InputIndex(i));
+        }
+        EXPECT_EQ(serial.Overlapping({5000, 6000}), parallel.Overlapping({5000, 6000}));
+    }
+}
@@ -2,12 +2,16 @@
 
 #include <cassert>
 
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "AlignedReads.h"
+
 // clang-format off
 
 namespace MappedReadTests {
@@ -634,3 +638,160 @@ TEST(Data_MappedRead, can_fetch_aligned_frames)
 }
 
 // clang-format on
+
+namespace MappedReadTests {
+
+// Reference for ProjectAligned: orients & projects one field base by base,
+// the way AlignedSequence & co. did before they shared ProjectAligned.
+template <typename Container, typename Complement>
+Container NaiveAligned(const Container& native, const MappedRead& mr, const Orientation orientation,
+                       const GapBehavior gapBehavior, const SoftClipBehavior softClipBehavior,
+                       const typename Container::value_type deletion,
+                       const typename Container::value_type padding, const Complement& complement)
+{
+    using PacBio::Data::CigarOperationType;
+
+    if (mr.Strand == Strand::UNMAPPED || mr.Cigar.empty()) {
+        return native;
+    }
+
+    const auto reverseComplement = [&](const Container& input) {
+        Container result;
+        for (auto it = input.crbegin(); it != input.crend(); ++it) {
+            result.push_back(complement(*it));
+        }
+        return result;
+    };
+
+    const bool reverse = (mr.Strand == Strand::REVERSE);
+    Container genomic = reverse ? reverseComplement(native) : native;
+    if (gapBehavior == GapBehavior::SHOW || softClipBehavior == SoftClipBehavior::REMOVE) {
+        const bool showGaps = (gapBehavior == GapBehavior::SHOW);
+        const bool keepClips = (softClipBehavior == SoftClipBehavior::KEEP);
+        Container projected;
+        std::size_t srcIndex = 0;
+        for (const auto& op : mr.Cigar) {
+            for (std::size_t i = 0; i < op.Length(); ++i) {
+                switch (op.Type()) {
+                    case CigarOperationType::SOFT_CLIP:
+                        if (keepClips) {
+                            projected.push_back(genomic.at(srcIndex));
+                        }
+                        ++srcIndex;
+                        break;
+                    case CigarOperationType::ALIGNMENT_MATCH:
+                    case CigarOperationType::SEQUENCE_MATCH:
+                    case CigarOperationType::SEQUENCE_MISMATCH:
+                    case CigarOperationType::INSERTION:
+                        projected.push_back(genomic.at(srcIndex));
+                        ++srcIndex;
+                        break;
+                    case CigarOperationType::DELETION:
+                        if (showGaps) {
+                            projected.push_back(deletion);
+                        }
+                        break;
+                    case CigarOperationType::PADDING:
+                        if (showGaps) {
+                            projected.push_back(padding);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        genomic = std::move(projected);
+    }
+    return (reverse && orientation == Orientation::NATIVE) ? reverseComplement(genomic) : genomic;
+}
+
+}  // namespace MappedReadTests
+
+TEST(Data_MappedRead, aligned_projection_matches_per_base_reference)
+{
+    using namespace PacBio::Data;
+
+    const auto identity = [](const auto x) { return x; };
+    const auto complement = [](const char c) {
+        switch (c) {
+            case 'A':
+                return 'T';
+            case 'C':
+                return 'G';
+            case 'G':
+                return 'C';
+            case 'T':
+                return 'A';
+            default:
+                return c;
+        }
+    };
+
+    std::mt19937 rng{2};
+    for (int i = 0; i < 20; ++i) {
+        for (const auto strand : {Strand::FORWARD, Strand::REVERSE, Strand::UNMAPPED}) {
+            const auto mr = MappedReadTests::MakeAlignedRead(1'000, strand, &rng);
+
+            // outputs are reused across calls
+            std::string seq;
+            QualityValues quals;
+            std::optional<Frames> ipd;
+            std::optional<Frames> pw;
+            for (const auto orientation : {Orientation::NATIVE, Orientation::GENOMIC}) {
+                for (const auto gaps : {GapBehavior::IGNORE, GapBehavior::SHOW}) {
+                    for (const auto clips : {SoftClipBehavior::KEEP, SoftClipBehavior::REMOVE}) {
+                        const auto naive = [&](const auto& native, const auto deletion,
+                                               const auto padding, const auto& comp) {
+                            return MappedReadTests::NaiveAligned(native, mr, orientation, gaps,
+                                                                 clips, deletion, padding, comp);
+                        };
+                        mr.ProjectAligned({&seq, &quals, &ipd, &pw}, orientation, gaps, clips);
+                        EXPECT_EQ(naive(mr.Seq, '-', '*', complement), seq);
+                        EXPECT_EQ(naive(mr.Qualities, QualityValue{0}, QualityValue{0}, identity),
+                                  quals);
+                        EXPECT_EQ(Frames{naive(mr.IPD->Data(), std::uint16_t{0}, std::uint16_t{0},
+                                               identity)},
+                                  ipd);
+                        EXPECT_EQ(Frames{naive(mr.PulseWidth->Data(), std::uint16_t{0},
+                                               std::uint16_t{0}, identity)},
+                                  pw);
+                        EXPECT_EQ(seq, mr.AlignedSequence(orientation, gaps, clips));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Data_MappedRead, aligned_projection_fills_only_requested_outputs)
+{
+    using namespace PacBio::Data;
+
+    Read r{"", "ACGTACGT", QualityValues{}, MappedReadTests::baseSNR};
+    r.IPD = Frames{1, 2, 3, 4, 5, 6, 7, 8};
+    MappedRead mr{std::move(r)};
+    mr.Cigar = Cigar{"2S2=2D4="};
+    mr.Strand = Strand::REVERSE;
+
+    std::string seq;
+    auto quals = QualityValues::FromFastq("+++");
+    std::optional<Frames> ipd;
+    std::optional<Frames> pw = Frames{9};
+    mr.ProjectAligned({.Sequence = &seq, .Qualities = &quals, .IPD = &ipd, .PulseWidth = &pw},
+                      Orientation::GENOMIC, GapBehavior::SHOW, SoftClipBehavior::REMOVE);
+    EXPECT_EQ("GT--ACGT", seq);
+    EXPECT_TRUE(quals.empty());  // read has no qualities
+    EXPECT_EQ((Frames{6, 5, 0, 0, 4, 3, 2, 1}), ipd);
+    EXPECT_FALSE(pw);  // read has no pulse widths
+
+    // clipping without gaps
+    mr.ProjectAligned({.Sequence = &seq}, Orientation::NATIVE, GapBehavior::IGNORE,
+                      SoftClipBehavior::REMOVE);
+    EXPECT_EQ("ACGTAC", seq);
+
+    // CIGAR consuming more query than there is
+    mr.Cigar = Cigar{"10="};
+    EXPECT_THROW(mr.ProjectAligned({.Sequence = &seq}, Orientation::NATIVE, GapBehavior::SHOW),
+                 std::runtime_error);
+}
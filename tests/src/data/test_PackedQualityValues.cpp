@@ -0,0 +1,95 @@
+#include <pbcopper/data/PackedQualityValues.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio::Data;
+
+namespace PackedQualityValuesTests {
+
+// HiFi-style binning
+const std::vector<QualityValue> BINS{2, 5, 12, 17, 22, 27, 32, 40};
+
+QualityValues RandomBinnedQualities(const std::size_t length, std::mt19937& rng)
+{
+    QualityValues result;
+    for (std::size_t i = 0; i < length; ++i) {
+        result.push_back(BINS[rng() % BINS.size()]);
+    }
+    return result;
+}
+
+}  // namespace PackedQualityValuesTests
+
+TEST(Data_PackedQualityValues, packs_binned_qualities_losslessly)
+{
+    const QualityValues quals = QualityValues::FromFastq("#&-27<AI#");
+    const PackedQualityValues packed{quals};
+
+    EXPECT_EQ(9, packed.Size());
+    EXPECT_EQ(PackedQualityValuesTests::BINS,
+              std::vector<QualityValue>(packed.Bins().begin(), packed.Bins().end()));
+    EXPECT_EQ((std::vector<std::uint8_t>{0x01, 0x23, 0x45, 0x67, 0x00}),
+              std::vector<std::uint8_t>(packed.Data().begin(), packed.Data().end()));
+    EXPECT_EQ(40, packed[7]);
+    EXPECT_EQ(7, packed.Code(7));
+    EXPECT_EQ(quals, packed.Unpack());
+    EXPECT_EQ("#&-27<AI#", packed.Fastq());
+
+    std::mt19937 rng{42};
+    for (const std::size_t length : {0, 1, 15, 16, 17, 32, 33, 1001}) {
+        SCOPED_TRACE(length);
+        const auto random = PackedQualityValuesTests::RandomBinnedQualities(length, rng);
+        const PackedQualityValues randomPacked{random};
+        EXPECT_EQ(random, randomPacked.Unpack());
+        EXPECT_EQ(random.Fastq(), randomPacked.Fastq());
+        EXPECT_EQ((length + 1) / 2, randomPacked.Data().size());
+    }
+}
+
+TEST(Data_PackedQualityValues, bins_arbitrary_qualities)
+{
+    const QualityValues quals{std::vector<std::uint8_t>{0, 1, 2, 4, 5, 11, 12, 39, 40, 93}};
+    const PackedQualityValues packed{quals, PackedQualityValuesTests::BINS};
+    const QualityValues expected{std::vector<std::uint8_t>{2, 2, 2, 2, 5, 5, 12, 32, 40, 40}};
+    EXPECT_EQ(expected, packed.Unpack());
+    EXPECT_EQ(packed, PackedQualityValues(expected, packed.Bins()));
+    EXPECT_NE(PackedQualityValues{expected}, packed);
+}
+
+TEST(Data_PackedQualityValues, throws_on_invalid_bins)
+{
+    QualityValues quals;
+    for (std::uint8_t qv = 0; qv < 17; ++qv) {
+        quals.push_back(qv);
+    }
+    EXPECT_THROW(PackedQualityValues{quals}, std::invalid_argument);
+
+    const std::vector<QualityValue> unsorted{5, 2};
+    EXPECT_THROW(PackedQualityValues(quals, unsorted), std::invalid_argument);
+    EXPECT_THROW(PackedQualityValues(quals, std::span<const QualityValue>{}),
+                 std::invalid_argument);
+
+    const PackedQualityValues packed{quals, PackedQualityValuesTests::BINS};
+    std::vector<QualityValue> tooFew(3);
+    EXPECT_THROW(packed.UnpackInto(tooFew), std::invalid_argument);
+}
+
+TEST(Data_PackedQualityValues, stats_match_unpacked)
+{
+    std::mt19937 rng{7};
+    for (const std::size_t length : {1, 2, 7, 100, 1001}) {
+        SCOPED_TRACE(length);
+        const auto quals = PackedQualityValuesTests::RandomBinnedQualities(length, rng);
+        const auto expected = ComputeQualityStats(std::span<const QualityValue>{quals});
+        const auto observed = ComputeQualityStats(PackedQualityValues{quals});
+        EXPECT_DOUBLE_EQ(expected.Mean, observed.Mean);
+        EXPECT_EQ(expected.Min, observed.Min);
+        EXPECT_DOUBLE_EQ(expected.ExpectedErrors, observed.ExpectedErrors);
+    }
+    EXPECT_DOUBLE_EQ(0.0, ComputeQualityStats(PackedQualityValues{}).Mean);
+}
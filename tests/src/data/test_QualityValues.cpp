@@ -1,6 +1,9 @@
 #include <pbcopper/data/QualityValues.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -101,3 +104,63 @@ TEST(Data_QualityValues, can_be_constructed_from_fastq_string)
 }
 
 // clang-format on
+
+TEST(Data_QualityValues, fastq_conversion_matches_scalar_for_every_character)
+{
+    std::string fastq(300, '!');
+    for (int c = 0; c < 256; ++c) {
+        std::fill(fastq.begin(), fastq.end(), static_cast<char>(c));
+        fastq[c % fastq.size()] = 'K';
+
+        std::vector<QualityValue> quals(fastq.size());
+        PacBio::Data::FromFastq(fastq, quals);
+        for (std::size_t i = 0; i < fastq.size(); ++i) {
+            ASSERT_EQ(QualityValue::FromFastq(fastq[i]), quals[i]) << c << " @ " << i;
+        }
+
+        std::string roundTrip(quals.size(), ' ');
+        PacBio::Data::ToFastq(quals, roundTrip);
+        for (std::size_t i = 0; i < quals.size(); ++i) {
+            ASSERT_EQ(quals[i].Fastq(), roundTrip[i]);
+        }
+    }
+
+    // constructor still trims whitespace
+    EXPECT_EQ("KKBB!!", QualityValues{"  KKBB!!\n"}.Fastq());
+
+    std::vector<QualityValue> tooFew(3);
+    EXPECT_THROW(PacBio::Data::FromFastq("KKBB", tooFew), std::invalid_argument);
+}
+
+TEST(Data_QualityValues, stats_match_scalar)
+{
+    std::mt19937 rng{42};
+    for (const std::size_t length : {1, 15, 16, 17, 100, 1001}) {
+        SCOPED_TRACE(length);
+        std::vector<QualityValue> quals(length);
+        for (auto& qv : quals) {
+            qv = 5 + rng() % 89;
+        }
+
+        double sum = 0;
+        double errors = 0;
+        for (const auto qv : quals) {
+            sum += qv;
+            errors += std::pow(10.0, -qv / 10.0);
+        }
+        const auto min = *std::min_element(quals.cbegin(), quals.cend());
+
+        const auto stats = PacBio::Data::ComputeQualityStats(quals);
+        EXPECT_DOUBLE_EQ(sum / length, stats.Mean);
+        EXPECT_EQ(min, stats.Min);
+        EXPECT_NEAR(errors, stats.ExpectedErrors, 1e-9);
+
+        EXPECT_DOUBLE_EQ(sum / length, PacBio::Data::MeanQuality(quals));
+        EXPECT_EQ(min, PacBio::Data::MinQuality(quals));
+        EXPECT_NEAR(errors, PacBio::Data::ExpectedErrors(quals), 1e-9);
+    }
+
+    EXPECT_DOUBLE_EQ(0.1, PacBio::Data::PhredToErrorProbability(10));
+    EXPECT_DOUBLE_EQ(0.0, PacBio::Data::ComputeQualityStats({}).Mean);
+    EXPECT_EQ(0, PacBio::Data::MinQuality({}));
+}
@@ -0,0 +1,190 @@
+#include <pbcopper/data/ReadBatch.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio::Data;
+
+namespace ReadBatchTests {
+
+std::vector<Read> MakeReads()
+{
+    std::vector<Read> reads;
+
+    // full kinetics, ID from movie/hole/interval
+    reads.emplace_back(ReadId{"m64011_190228_190319", 4, Interval{100, 110}}, "AACCGTTAGC",
+                       Frames{1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+                       Frames{10, 20, 30, 40, 50, 60, 70, 80, 90, 100},
+                       LocalContextFlags(ADAPTER_BEFORE | ADAPTER_AFTER), Accuracy{0.9F},
+                       SNR{1, 2, 3, 4}, "S/P5-C2/5.0");
+    reads.back().Qualities = QualityValues::FromFastq("0123456789");
+
+    // qualities only, ID parsed from name
+    reads.emplace_back("m64011_190228_190319/7/ccs", "GATTACA", QualityValues::FromFastq("+++++++"),
+                       SNR{5, 6, 7, 8});
+
+    // nothing but bases, IPD only
+    reads.emplace_back("m54001_160101_000000/9/0_4", "ACGT", QualityValues{}, SNR{1, 1, 1, 1}, 0,
+                       4);
+    reads.back().IPD = Frames{7, 7, 7, 7};
+
+    // empty read, same movie & model as the first
+    reads.emplace_back(ReadId{"m64011_190228_190319", 11}, "", std::nullopt, std::nullopt,
+                       NO_LOCAL_CONTEXT, Accuracy{0.5F}, SNR{0, 0, 0, 0}, "S/P5-C2/5.0");
+    return reads;
+}
+
+std::vector<MappedRead> MakeMappedReads()
+{
+    std::vector<MappedRead> mapped;
+    const auto reads = MakeReads();
+    mapped.emplace_back(reads[0], Strand::FORWARD, 1000, Cigar{"2S6=1X1S"}, 60);
+    mapped.back().RefId = 3;
+    mapped.emplace_back(reads[1], Strand::REVERSE, 50, Cigar{"1H3=1I3="}, 20);
+    mapped.back().PinEnd = true;
+    mapped.emplace_back(reads[2]);
+    mapped.emplace_back(reads[3], Strand::FORWARD, 10, 10, true, false);
+    return mapped;
+}
+
+void ExpectSameRead(const Read& expected, const Read& observed)
+{
+    EXPECT_EQ(expected.FullName(), observed.FullName());
+    EXPECT_EQ(expected.Id.MovieName, observed.Id.MovieName);
+    EXPECT_EQ(expected.Id.HoleNumber, observed.Id.HoleNumber);
+    EXPECT_EQ(expected.Id.ZmwInterval, observed.Id.ZmwInterval);
+    EXPECT_EQ(expected.Id.ReadName, observed.Id.ReadName);
+    EXPECT_EQ(expected.Seq, observed.Seq);
+    EXPECT_EQ(expected.Qualities, observed.Qualities);
+    EXPECT_EQ(expected.PulseWidth, observed.PulseWidth);
+    EXPECT_EQ(expected.IPD, observed.IPD);
+    EXPECT_EQ(expected.QueryStart, observed.QueryStart);
+    EXPECT_EQ(expected.QueryEnd, observed.QueryEnd);
+    EXPECT_EQ(expected.Flags, observed.Flags);
+    EXPECT_EQ(float{expected.ReadAccuracy}, float{observed.ReadAccuracy});
+    EXPECT_EQ(expected.SignalToNoise, observed.SignalToNoise);
+    EXPECT_EQ(expected.Model, observed.Model);
+    EXPECT_EQ(expected.FullLength, observed.FullLength);
+}
+
+}  // namespace ReadBatchTests
+
+TEST(Data_ReadBatch, round_trips_reads)
+{
+    const auto reads = ReadBatchTests::MakeReads();
+    const ReadBatch batch{reads};
+    ASSERT_EQ(reads.size(), batch.Size());
+    EXPECT_EQ(21, batch.NumBases());
+
+    const auto roundTripped = batch.ToReads();
+    for (std::size_t i = 0; i < reads.size(); ++i) {
+        SCOPED_TRACE(i);
+        ReadBatchTests::ExpectSameRead(reads[i], roundTripped[i]);
+    }
+}
+
+TEST(Data_ReadBatch, views_mirror_read_fields)
+{
+    const auto reads = ReadBatchTests::MakeReads();
+    const ReadBatch batch{reads};
+
+    for (std::size_t i = 0; i < reads.size(); ++i) {
+        SCOPED_TRACE(i);
+        const auto& read = reads[i];
+        const ReadView view = batch[i];
+        EXPECT_EQ(read.Seq, view.Seq());
+        EXPECT_EQ(read.Length(), view.Length());
+        EXPECT_TRUE(std::ranges::equal(read.Qualities, view.Qualities()));
+        ASSERT_EQ(read.PulseWidth.has_value(), view.PulseWidth().has_value());
+        if (read.PulseWidth) {
+            EXPECT_TRUE(std::ranges::equal(*read.PulseWidth, *view.PulseWidth()));
+        }
+        ASSERT_EQ(read.IPD.has_value(), view.IPD().has_value());
+        if (read.IPD) {
+            EXPECT_TRUE(std::ranges::equal(*read.IPD, *view.IPD()));
+        }
+        EXPECT_EQ(std::string(read.Id), std::string(view.Id()));
+        EXPECT_EQ(read.QueryStart, view.QueryStart());
+        EXPECT_EQ(read.QueryEnd, view.QueryEnd());
+        EXPECT_EQ(read.Model, view.Model());
+        EXPECT_EQ(read.FullLength, view.FullLength());
+        EXPECT_EQ(read.SignalToNoise, view.SignalToNoise());
+    }
+
+    // bases are contiguous across reads
+    EXPECT_EQ(batch[0].Seq().data() + batch[0].Seq().size(), batch[1].Seq().data());
+}
+
+TEST(Data_ReadBatch, round_trips_mapped_reads_and_mapping_accessors)
+{
+    const auto reads = ReadBatchTests::MakeMappedReads();
+    const ReadBatch batch{reads};
+    const auto roundTripped = batch.ToMappedReads();
+
+    for (std::size_t i = 0; i < reads.size(); ++i) {
+        SCOPED_TRACE(i);
+        const auto& read = reads[i];
+        const auto& copy = roundTripped[i];
+        ReadBatchTests::ExpectSameRead(read, copy);
+        EXPECT_EQ(read.RefId, copy.RefId);
+        EXPECT_EQ(read.Strand, copy.Strand);
+        EXPECT_EQ(read.TemplateStart, copy.TemplateStart);
+        EXPECT_EQ(read.TemplateEnd, copy.TemplateEnd);
+        EXPECT_EQ(read.PinStart, copy.PinStart);
+        EXPECT_EQ(read.PinEnd, copy.PinEnd);
+        EXPECT_EQ(read.Cigar, copy.Cigar);
+        EXPECT_EQ(read.MapQuality, copy.MapQuality);
+
+        const MappedReadView view = batch.Mapped(i);
+        EXPECT_EQ(CigarView{read.Cigar}, view.Cigar());
+        EXPECT_EQ(read.NumMismatches(), view.NumMismatches());
+        EXPECT_EQ(read.AlignedStrand(), view.AlignedStrand());
+        if (read.Strand == Strand::UNMAPPED || read.QueryStart == UNMAPPED_POSITION) {
+            EXPECT_THROW(read.AlignedStart(), std::runtime_error);
+            EXPECT_THROW(view.AlignedStart(), std::runtime_error);
+        } else {
+            EXPECT_EQ(read.AlignedStart(), view.AlignedStart());
+            EXPECT_EQ(read.AlignedEnd(), view.AlignedEnd());
+        }
+        if (read.TemplateStart == UNMAPPED_POSITION) {
+            EXPECT_THROW(view.ReferenceStart(), std::runtime_error);
+        } else {
+            EXPECT_EQ(read.ReferenceStart(), view.ReferenceStart());
+            EXPECT_EQ(read.ReferenceEnd(), view.ReferenceEnd());
+        }
+    }
+}
+
+TEST(Data_ReadBatch, plain_reads_are_unmapped)
+{
+    const auto reads = ReadBatchTests::MakeReads();
+    ReadBatch batch;
+    batch.Add(reads[0]);
+    batch.Add(ReadBatchTests::MakeMappedReads()[1]);
+
+    const auto view = batch.Mapped(0);
+    EXPECT_EQ(Strand::UNMAPPED, view.Strand());
+    EXPECT_TRUE(view.Cigar().empty());
+    EXPECT_EQ(UNMAPPED_POSITION, view.TemplateStart());
+    EXPECT_EQ(Cigar{"1H3=1I3="}, batch.ToMappedRead(1).Cigar);
+}
+
+TEST(Data_ReadBatch, clear_keeps_batch_reusable)
+{
+    const auto reads = ReadBatchTests::MakeReads();
+    ReadBatch batch{reads};
+    const char* bases = batch[0].Seq().data();
+
+    batch.Clear();
+    EXPECT_TRUE(batch.Empty());
+    EXPECT_EQ(0, batch.NumBases());
+
+    batch.Add(reads[1]);
+    ASSERT_EQ(1, batch.Size());
+    EXPECT_EQ(bases, batch[0].Seq().data());
+    ReadBatchTests::ExpectSameRead(reads[1], batch.ToRead(0));
+}
@@ -0,0 +1,118 @@
+#include <pbcopper/poa/BatchConsensus.h>
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbcopper/poa/PoaConsensus.h>
+
+#include "RandomSequences.h"
+
+using namespace PacBio;
+using namespace PacBio::Poa;
+
+namespace BatchConsensusTests {
+
+struct Batch
+{
+    std::vector<std::string> Templates;
+    std::vector<std::vector<std::string>> Groups;
+};
+
+Batch MakeBatch(const int numGroups, const int numReads, const std::size_t length,
+                const double errorRate, const unsigned int seed)
+{
+    std::mt19937 rng{seed};
+    Batch batch;
+    for (int i = 0; i < numGroups; ++i) {
+        batch.Templates.push_back(PacBio::PbcopperTests::RandomSequence(length, rng));
+        batch.Groups.push_back(PacBio::PbcopperTests::MutateSequences(batch.Templates.back(),
+                                                                      numReads, errorRate, rng));
+    }
+    return batch;
+}
+
+}  // namespace BatchConsensusTests
+
+TEST(Poa_BatchConsensus, MatchesSerialConsensusInInputOrder)
+{
+    const auto batch = BatchConsensusTests::MakeBatch(24, 6, 300, 0.05, 11);
+
+    BatchConsensusOptions options;
+    options.NumThreads = 4;
+    BatchConsensus batchConsensus{options};
+
+    for (int pass = 0; pass < 2; ++pass) {
+        // workspaces are reused across runs
+        std::vector<std::size_t> order;
+        batchConsensus.Run(batch.Groups,
+                           [&](const std::size_t i, std::unique_ptr<const PoaConsensus> consensus) {
+                               order.push_back(i);
+                               ASSERT_TRUE(consensus);
+                               const std::unique_ptr<const PoaConsensus> expected{
+                                   PoaConsensus::FindConsensus(batch.Groups[i], options.Config)};
+                               EXPECT_EQ(expected->Sequence, consensus->Sequence);
+                               EXPECT_EQ(expected->Path, consensus->Path);
+                           });
+        ASSERT_EQ(batch.Groups.size(), order.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            EXPECT_EQ(i, order[i]);
+        }
+    }
+}
+
+TEST(Poa_BatchConsensus, DraftedGroupsDoNotDependOnThreadCount)
+{
+    // few large groups, so idle threads help align drafted rounds
+    const auto batch = BatchConsensusTests::MakeBatch(3, 25, 500, 0.05, 5);
+
+    std::vector<std::string> expected;
+    for (const unsigned int numThreads : {1U, 2U, 8U}) {
+        BatchConsensusOptions options;
+        options.Config = DefaultPoaConfig(Align::AlignMode::LOCAL);
+        options.NumThreads = numThreads;
+        options.DraftMinReads = 10;
+        options.DraftRoundSize = 4;
+        const auto results = BatchConsensus{options}.FindConsensus(batch.Groups);
+        ASSERT_EQ(batch.Groups.size(), results.size());
+
+        std::vector<std::string> sequences;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            sequences.push_back(results[i]->Sequence);
+            EXPECT_EQ(batch.Templates[i], results[i]->Sequence);
+        }
+        if (expected.empty()) {
+            expected = sequences;
+        }
+        EXPECT_EQ(expected, sequences);
+    }
+}
+
+TEST(Poa_BatchConsensus, RethrowsGroupErrors)
+{
+    auto batch = BatchConsensusTests::MakeBatch(8, 3, 100, 0.05, 3);
+    batch.Groups[5].push_back("");
+
+    BatchConsensusOptions options;
+    options.NumThreads = 2;
+    BatchConsensus batchConsensus{options};
+    EXPECT_THROW(batchConsensus.FindConsensus(batch.Groups), std::invalid_argument);
+
+    // still usable
+    batch.Groups[5].pop_back();
+    EXPECT_EQ(batch.Groups.size(), batchConsensus.FindConsensus(batch.Groups).size());
+
+    std::size_t numCalls = 0;
+    EXPECT_THROW(batchConsensus.Run(batch.Groups,
+                                    [&numCalls](std::size_t, std::unique_ptr<const PoaConsensus>) {
+                                        if (++numCalls == 2) {
+                                            throw std::runtime_error{"callback"};
+                                        }
+                                    }),
+                 std::runtime_error);
+    EXPECT_EQ(2, numCalls);
+}
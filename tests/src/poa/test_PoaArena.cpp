@@ -0,0 +1,34 @@
+#include "../../../src/poa/PoaArena.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio;
+
+TEST(Poa_PoaArena, allocates_aligned_storage_in_growing_blocks)
+{
+    Poa::detail::PoaArena arena{64};
+
+    auto* bytes = arena.Allocate<std::uint8_t>(3);
+    auto* floats = arena.Allocate<float>(4);
+    auto* words = arena.Allocate<std::uint64_t>(2);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(floats) % alignof(float));
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(words) % alignof(std::uint64_t));
+    EXPECT_EQ(bytes + 4, reinterpret_cast<std::uint8_t*>(floats));
+    EXPECT_EQ(1, arena.NumBlocks());
+
+    // doesn't fit: next block is twice the size
+    arena.Allocate<std::uint8_t>(100);
+    EXPECT_EQ(2, arena.NumBlocks());
+
+    // blocks are reused after Reset
+    arena.Reset();
+    EXPECT_EQ(bytes, arena.Allocate<std::uint8_t>(3));
+    arena.Allocate<std::uint8_t>(100);
+    EXPECT_EQ(2, arena.NumBlocks());
+
+    // oversized requests get a block of their own
+    arena.Allocate<std::uint8_t>(10'000);
+    EXPECT_EQ(3, arena.NumBlocks());
+}
@@ -0,0 +1,85 @@
+// Built as its own executable (pbcopper_allocation_test): the global
+// operator new below counts every allocation in the binary.
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include <pbcopper/align/AlignConfig.h>
+#include <pbcopper/poa/PoaConsensus.h>
+#include <pbcopper/poa/PoaGraph.h>
+
+#include "RandomSequences.h"
+
+using namespace PacBio;
+using namespace PacBio::Poa;
+
+namespace PoaArenaAllocationTests {
+
+// counts every (unaligned) operator new in this binary
+std::atomic<std::size_t> NumAllocations{0};
+
+// allocations made aligning 'read' to 'graph', which it is then threaded into
+std::size_t AddRead(PoaGraph* graph, const std::string& read, const Align::AlignConfig& config)
+{
+    const std::size_t before = NumAllocations;
+    std::unique_ptr<PoaAlignmentMatrix> mat{graph->TryAddRead(read, config)};
+    const std::size_t result = NumAllocations - before;
+    graph->CommitAdd(mat.get());
+    return result;
+}
+
+}  // namespace PoaArenaAllocationTests
+
+// Every replaceable form that the binary may use is replaced, so that each
+// pointer from the malloc-based operator new (and new[]) is released by the
+// matching free-based operator delete (and delete[]), sized or not.
+
+void* operator new(const std::size_t size)
+{
+    ++PoaArenaAllocationTests::NumAllocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](const std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
+
+TEST(Poa_PoaArenaAllocations, alignment_columns_do_not_allocate_individually)
+{
+    std::mt19937 rng{3};
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(2'000, rng);
+
+    for (const bool banded : {false, true}) {
+        auto config = DefaultPoaConfig(Align::AlignMode::LOCAL);
+        if (banded) {
+            config.Band = Align::AlignBand::Default();
+        }
+        PoaGraph graph;
+        graph.AddFirstRead(PacBio::PbcopperTests::MutateSequence(tpl, 0.1, rng));
+        for (int i = 0; i < 4; ++i) {
+            PoaArenaAllocationTests::AddRead(
+                &graph, PacBio::PbcopperTests::MutateSequence(tpl, 0.1, rng), config);
+        }
+
+        // previously ~5 allocations per column, i.e. > 10k here
+        const std::size_t numAllocations = PoaArenaAllocationTests::AddRead(
+            &graph, PacBio::PbcopperTests::MutateSequence(tpl, 0.1, rng), config);
+        EXPECT_LT(numAllocations, 50) << (banded ? "banded" : "full");
+    }
+}
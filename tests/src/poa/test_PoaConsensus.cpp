@@ -3,8 +3,12 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <iostream>
 #include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -16,6 +20,9 @@
 
 #include <gtest/gtest.h>
 
+#include "../../../src/poa/PoaAlignmentMatrix.h"
+#include "RandomSequences.h"
+
 using boost::erase_all_copy;
 
 using namespace boost::assign;  // NOLINT
@@ -582,3 +589,176 @@ TEST(PoaConsensus, NondeterminismRegressionTest)
     }
     ASSERT_EQ(1, answers.size());
 }
+
+TEST(PoaConsensus, RecoversTemplateFromNoisyReads)
+{
+    std::mt19937 rng{11};
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(1'000, rng);
+    const auto reads = PacBio::PbcopperTests::MutateSequences(tpl, 15, 0.05, rng);
+
+    std::unique_ptr<const PacBio::Poa::PoaConsensus> pc{
+        PoaConsensus::FindConsensus(reads, AlignMode::GLOBAL)};
+    EXPECT_EQ(tpl, pc->Sequence);
+
+    // pruning drops the low-coverage side branches of the graph
+    PoaGraph graph;
+    for (const auto& read : reads) {
+        graph.AddRead(read, DefaultPoaConfig(AlignMode::GLOBAL));
+    }
+    const auto numLines = [](const std::string& dot) {
+        return std::count(dot.begin(), dot.end(), '\n');
+    };
+    const auto fullGraphLines = numLines(graph.ToGraphViz());
+    graph.PruneGraph(3);
+    const auto prunedGraphLines = numLines(graph.ToGraphViz());
+    EXPECT_LT(prunedGraphLines, fullGraphLines);
+    EXPECT_GT(prunedGraphLines, 2 * static_cast<std::ptrdiff_t>(tpl.size()));
+}
+
+TEST(PoaConsensus, SimdKernelMatchesScalarKernel)
+{
+    std::mt19937 rng{5};
+    std::vector<std::vector<std::string>> readSets;
+    for (const std::size_t length : {1, 7, 250, 1'001}) {
+        const std::string tpl = PacBio::PbcopperTests::RandomSequence(length, rng);
+        readSets.push_back(PacBio::PbcopperTests::MutateSequences(tpl, 8, 0.15, rng));
+    }
+    // staggered reads, for the local & semiglobal start/end moves
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(600, rng);
+    std::vector<std::string> staggered;
+    for (std::size_t start = 0; start < 400; start += 50) {
+        staggered.push_back(tpl.substr(start, 200 + start / 2));
+    }
+    readSets.push_back(std::move(staggered));
+
+    for (const AlignMode mode : {AlignMode::GLOBAL, AlignMode::SEMIGLOBAL, AlignMode::LOCAL}) {
+        AlignConfig scalarConfig = DefaultPoaConfig(mode);
+        scalarConfig.Kernel = AlignKernel::SCALAR;
+        AlignConfig simdConfig = DefaultPoaConfig(mode);
+        simdConfig.Kernel = AlignKernel::SIMD;
+
+        for (const auto& reads : readSets) {
+            std::unique_ptr<const PacBio::Poa::PoaConsensus> scalar{
+                PoaConsensus::FindConsensus(reads, scalarConfig)};
+            std::unique_ptr<const PacBio::Poa::PoaConsensus> simd{
+                PoaConsensus::FindConsensus(reads, simdConfig)};
+            EXPECT_EQ(scalar->Sequence, simd->Sequence);
+            EXPECT_EQ(scalar->Path, simd->Path);
+            EXPECT_EQ(scalar->ToGraphViz(PoaGraph::VERBOSE_NODES),
+                      simd->ToGraphViz(PoaGraph::VERBOSE_NODES));
+
+            // alignment scores of one more read
+            PoaGraph graph;
+            for (const auto& read : reads) {
+                graph.AddRead(read, scalarConfig);
+            }
+            std::unique_ptr<PoaAlignmentMatrix> scalarMat{
+                graph.TryAddRead(reads.front(), scalarConfig)};
+            std::unique_ptr<PoaAlignmentMatrix> simdMat{
+                graph.TryAddRead(reads.front(), simdConfig)};
+            EXPECT_EQ(scalarMat->Score(), simdMat->Score());
+        }
+    }
+}
+
+TEST(PoaConsensus, AdaptiveBandMatchesFullAlignment)
+{
+    std::mt19937 rng{23};
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(2'000, rng);
+    const auto reads = PacBio::PbcopperTests::MutateSequences(tpl, 10, 0.1, rng);
+
+    // staggered reads, so semiglobal alignments start mid-graph
+    std::vector<std::string> staggered;
+    for (std::size_t start = 0; start < 1'000; start += 100) {
+        staggered.push_back(
+            PacBio::PbcopperTests::MutateSequence(tpl.substr(start, 1'000), 0.05, rng));
+    }
+
+    for (const AlignMode mode : {AlignMode::GLOBAL, AlignMode::SEMIGLOBAL, AlignMode::LOCAL}) {
+        const AlignConfig full = DefaultPoaConfig(mode);
+        AlignConfig banded = full;
+        banded.Band = AlignBand::Default();
+
+        // staggered reads don't align end-to-end, and the band can't find
+        // where local alignments of them begin
+        const std::size_t numReadSets = (mode == AlignMode::SEMIGLOBAL ? 2 : 1);
+        for (std::size_t k = 0; k < numReadSets; ++k) {
+            const auto& readSet = (k == 0 ? reads : staggered);
+            std::unique_ptr<const PacBio::Poa::PoaConsensus> expected{
+                PoaConsensus::FindConsensus(readSet, full)};
+            std::unique_ptr<const PacBio::Poa::PoaConsensus> observed{
+                PoaConsensus::FindConsensus(readSet, banded)};
+            EXPECT_EQ(expected->Sequence, observed->Sequence);
+        }
+    }
+
+    AlignConfig banded = DefaultPoaConfig(AlignMode::GLOBAL);
+    banded.Band = AlignBand::Default();
+    PoaGraph graph;
+    graph.AddRead(reads[0], banded);
+    std::unique_ptr<PoaAlignmentMatrix> fullMat{
+        graph.TryAddRead(reads[1], DefaultPoaConfig(AlignMode::GLOBAL))};
+    std::unique_ptr<PoaAlignmentMatrix> bandedMat{graph.TryAddRead(reads[1], banded)};
+    EXPECT_EQ(fullMat->Score(), bandedMat->Score());
+
+    // banded columns only cover part of the read, unlike the full alignment's
+    // (whose only narrow column is the graph's enter vertex)
+    const auto countNarrowColumns = [&](const PoaAlignmentMatrix& mat) {
+        const auto& impl = dynamic_cast<const PacBio::Poa::detail::PoaAlignmentMatrixImpl&>(mat);
+        return static_cast<std::size_t>(
+            std::count_if(impl.columns_.cbegin(), impl.columns_.cend(), [&](const auto* col) {
+                return col && (col->EndRow() - col->BeginRow() < reads[1].size());
+            }));
+    };
+    EXPECT_LE(countNarrowColumns(*fullMat), 1);
+    EXPECT_GT(countNarrowColumns(*bandedMat), reads[1].size() / 2);
+}
+
+TEST(PoaGraph, ReadPointersMatchReadPaths)
+{
+    std::mt19937 rng{29};
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(500, rng);
+    auto reads = PacBio::PbcopperTests::MutateSequences(tpl, 6, 0.1, rng);
+    reads.push_back(tpl.substr(100, 200));
+
+    const AlignConfig config = DefaultPoaConfig(AlignMode::LOCAL);
+    PoaGraph graph;
+    EXPECT_FALSE(graph.HasReadPointers());
+    EXPECT_THROW(graph.ReadPointersAlong({}), std::runtime_error);
+    graph.EnableReadPointers();
+    EXPECT_TRUE(graph.HasReadPointers());
+
+    std::vector<std::vector<PoaGraph::Vertex>> readPaths(reads.size());
+    for (std::size_t i = 0; i < reads.size(); ++i) {
+        graph.AddRead(reads[i], config, nullptr, &readPaths[i]);
+    }
+    EXPECT_THROW(PoaGraph{graph}.EnableReadPointers(), std::runtime_error);
+    graph.PruneGraph(2);
+
+    std::unique_ptr<const PacBio::Poa::PoaConsensus> pc{graph.FindConsensus(config)};
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> expected;
+    for (std::size_t pathIndex = 0; pathIndex < pc->Path.size(); ++pathIndex) {
+        for (std::size_t read = 0; read < reads.size(); ++read) {
+            const auto& path = readPaths[read];
+            const auto it = std::find(path.cbegin(), path.cend(), pc->Path[pathIndex]);
+            if (it != path.cend()) {
+                expected.emplace_back(pathIndex, read, it - path.cbegin());
+            }
+        }
+    }
+
+    // also carried over to the consensus' copy of the graph
+    for (const PoaGraph* g : {static_cast<const PoaGraph*>(&graph), &pc->Graph}) {
+        std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> observed;
+        for (const auto& rp : g->ReadPointersAlong(pc->Path)) {
+            observed.emplace_back(rp.PathIndex, rp.Read, rp.ReadPosition);
+        }
+        EXPECT_EQ(expected, observed);
+    }
+
+    graph.Clear();
+    EXPECT_TRUE(graph.HasReadPointers());
+    graph.AddRead("ACGT", config);
+    std::unique_ptr<const PacBio::Poa::PoaConsensus> small{graph.FindConsensus(config)};
+    EXPECT_EQ(4, graph.ReadPointersAlong(small->Path).size());
+}
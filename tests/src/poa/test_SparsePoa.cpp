@@ -3,14 +3,19 @@
 #include <cstddef>
 
 #include <random>
+#include <string>
+#include <vector>
 
 #include <boost/assign.hpp>
 #include <boost/assign/std/vector.hpp>
 
 #include <gtest/gtest.h>
 
+#include <pbcopper/align/AlignConfig.h>
 #include <pbcopper/poa/PoaConsensus.h>
 
+#include "RandomSequences.h"
+
 using namespace boost::assign;
 
 using namespace PacBio::Poa;
@@ -213,3 +218,39 @@ TEST(SparsePoaTest, SingleAndHalfNTimes)
         EXPECT_TRUE(summaries[id2].ReverseComplementedRead);
     }
 }
+
+TEST(SparsePoaTest, SimdKernelMatchesScalarKernel)
+{
+    std::mt19937 rng{17};
+    const std::string tpl = PacBio::PbcopperTests::RandomSequence(2'000, rng);
+    std::vector<std::string> reads;
+    for (std::size_t start = 0; start < 1'000; start += 97) {
+        reads.push_back(
+            PacBio::PbcopperTests::MutateSequence(tpl.substr(start, 800 + start), 0.09, rng));
+    }
+
+    PacBio::Align::AlignConfig scalarConfig = DefaultPoaConfig(PacBio::Align::AlignMode::LOCAL);
+    scalarConfig.Kernel = PacBio::Align::AlignKernel::SCALAR;
+    PacBio::Align::AlignConfig simdConfig = DefaultPoaConfig(PacBio::Align::AlignMode::LOCAL);
+    simdConfig.Kernel = PacBio::Align::AlignKernel::SIMD;
+    const PoaAlignmentOptions scalarOptions{scalarConfig, 0};
+    const PoaAlignmentOptions simdOptions{simdConfig, 0};
+
+    SparsePoa scalar;
+    SparsePoa simd;
+    for (const auto& read : reads) {
+        EXPECT_EQ(scalar.OrientAndAddRead(read, scalarOptions),
+                  simd.OrientAndAddRead(read, simdOptions));
+    }
+    std::vector<PoaAlignmentSummary> scalarSummaries;
+    std::vector<PoaAlignmentSummary> simdSummaries;
+    EXPECT_EQ(scalar.FindConsensus(3, &scalarSummaries)->Sequence,
+              simd.FindConsensus(3, &simdSummaries)->Sequence);
+    ASSERT_EQ(scalarSummaries.size(), simdSummaries.size());
+    for (std::size_t i = 0; i < scalarSummaries.size(); ++i) {
+        EXPECT_EQ(scalarSummaries[i].ExtentOnRead, simdSummaries[i].ExtentOnRead);
+        EXPECT_EQ(scalarSummaries[i].ExtentOnConsensus, simdSummaries[i].ExtentOnConsensus);
+        EXPECT_EQ(scalarSummaries[i].AlignmentScore, simdSummaries[i].AlignmentScore);
+    }
+    EXPECT_EQ(scalar.ToGraphViz(), simd.ToGraphViz());
+}
@@ -1,7 +1,13 @@
 #include <pbcopper/qgram/Index.h>
 
+#include <random>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "RandomSequences.h"
+
 TEST(QGram_Index, shape_throws_on_invalid_qgram_sizes)
 {
     EXPECT_THROW(PacBio::QGram::internal::Shape(0, "ACGTACGT"), std::invalid_argument);
@@ -365,3 +371,114 @@ TEST(QGram_Index, index_hits_PUBLIC_API_empty_hits_result_when_query_seq_is_too_
     EXPECT_TRUE(idx.Hits("").empty());
     EXPECT_TRUE(idx.Hits("ACG").empty());
 }
+
+TEST(QGram_Index, parallel_construction_matches_serial)
+{
+    using IndexImpl = PacBio::QGram::internal::IndexImpl;
+
+    std::mt19937 rng{1};
+    std::vector<std::string> seqs;
+    for (int i = 0; i < 5; ++i) {
+        seqs.push_back(PacBio::PbcopperTests::RandomSequence(90'000, rng));
+    }
+    seqs.push_back("ACGTACGT");
+    const IndexImpl serial{8, seqs, 1};
+    for (const unsigned int numThreads : {2, 3, 8}) {
+        const IndexImpl parallel{8, seqs, numThreads};
+        EXPECT_EQ(serial.HashLookup(), parallel.HashLookup()) << numThreads << " threads";
+        EXPECT_EQ(serial.SuffixArray(), parallel.SuffixArray()) << numThreads << " threads";
+    }
+}
+
+TEST(QGram_Index, sparse_dense_and_in_place_insertion_agree)
+{
+    using IndexImpl = PacBio::QGram::internal::IndexImpl;
+
+    // q = 6 has 4096 buckets: the first sequence is counted in place, the
+    // short one is sorted in, and the long appends are counted by one and by
+    // four threads
+    std::mt19937 rng{3};
+    std::vector<std::string> seqs;
+    for (const std::size_t length : {100'000, 100'000, 300, 300'000, 10}) {
+        seqs.push_back(PacBio::PbcopperTests::RandomSequence(length, rng));
+    }
+    const IndexImpl serial{6, seqs, 1};
+    const IndexImpl parallel{6, seqs, 4};
+    EXPECT_EQ(serial.HashLookup(), parallel.HashLookup());
+    EXPECT_EQ(serial.SuffixArray(), parallel.SuffixArray());
+
+    IndexImpl incremental{6, {seqs[0]}, 4};
+    incremental.Append({seqs[1]});
+    incremental.Append({seqs[2]});
+    incremental.Append({seqs[3], seqs[4]});
+    EXPECT_EQ(serial.HashLookup(), incremental.HashLookup());
+    EXPECT_EQ(serial.SuffixArray(), incremental.SuffixArray());
+}
+
+TEST(QGram_Index, append_matches_full_rebuild)
+{
+    using IndexImpl = PacBio::QGram::internal::IndexImpl;
+
+    {
+        SCOPED_TRACE("short sequences");
+        const std::vector<std::string> seqs{"CATGATTACATA", "TTAGATAACTTC", "CATGATTACATA"};
+        const IndexImpl full{3, seqs};
+
+        IndexImpl incremental{3, {seqs.front()}};
+        incremental.Append({seqs[1]});
+        incremental.Append({seqs[2]});
+        EXPECT_EQ(full.HashLookup(), incremental.HashLookup());
+        EXPECT_EQ(full.SuffixArray(), incremental.SuffixArray());
+    }
+    {
+        SCOPED_TRACE("long sequences, multi-threaded");
+        std::mt19937 rng{2};
+        std::vector<std::string> seqs;
+        for (int i = 0; i < 4; ++i) {
+            seqs.push_back(PacBio::PbcopperTests::RandomSequence(100'000, rng));
+        }
+        const IndexImpl full{10, seqs};
+
+        IndexImpl incremental{10, {seqs[0]}, 4};
+        incremental.Append({seqs[1], seqs[2]});
+        incremental.Append({seqs[3]});
+        EXPECT_EQ(full.HashLookup(), incremental.HashLookup());
+        EXPECT_EQ(full.SuffixArray(), incremental.SuffixArray());
+    }
+    {
+        SCOPED_TRACE("empty index");
+        const std::vector<std::string> seqs{"CATGATTACATA"};
+        const IndexImpl full{3, seqs};
+
+        IndexImpl incremental{3, {}};
+        incremental.Append(seqs);
+        EXPECT_EQ(full.HashLookup(), incremental.HashLookup());
+        EXPECT_EQ(full.SuffixArray(), incremental.SuffixArray());
+    }
+}
+
+TEST(QGram_Index, index_append_PUBLIC_API)
+{
+    PacBio::QGram::Index idx{4, "CATGATTACATA"};
+    idx.Append("TTGATTACAA");
+
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> observed;
+    for (const auto& hits : idx.Hits("ATTACA")) {
+        for (const auto& hit : hits) {
+            observed.emplace_back(hit.Id(), hit.Position());
+        }
+    }
+    const std::vector<std::pair<std::uint32_t, std::uint64_t>> expected{{0, 4}, {1, 3}, {0, 5},
+                                                                        {1, 4}, {0, 6}, {1, 5}};
+    EXPECT_EQ(expected, observed);
+
+    // invalid input leaves index unchanged
+    EXPECT_THROW(idx.Append(std::vector<std::string>{"GATTACA", "ACG"}), std::invalid_argument);
+    EXPECT_EQ(observed.size(), [&idx]() {
+        std::size_t n = 0;
+        for (const auto& hits : idx.Hits("ATTACA")) {
+            n += hits.size();
+        }
+        return n;
+    }());
+}
@@ -0,0 +1,183 @@
+#include <pbcopper/qgram/MinimizerIndex.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbcopper/align/FindSeeds.h>
+#include <pbcopper/align/SparseAlignment.h>
+
+#include "RandomSequences.h"
+
+namespace MinimizerIndexTests {
+
+// brute-force (w,k)-minimizer positions
+std::vector<std::uint64_t> NaiveMinimizerPositions(const std::size_t k, const std::size_t w,
+                                                   const std::string& seq)
+{
+    std::vector<std::uint64_t> hashes;
+    const std::uint64_t mask = (k == 32 ? ~0ULL : ((1ULL << (2 * k)) - 1));
+    for (std::size_t i = 0; i + k <= seq.size(); ++i) {
+        std::uint64_t kmer = 0;
+        for (std::size_t j = 0; j < k; ++j) {
+            kmer = (kmer << 2) | PacBio::QGram::internal::BaseCode(seq[i + j]);
+        }
+        hashes.push_back(PacBio::QGram::internal::MinimizerHash(kmer, mask));
+    }
+
+    std::set<std::uint64_t> positions;
+    const std::size_t numWindows = (hashes.size() >= w ? hashes.size() - w + 1 : 1);
+    for (std::size_t i = 0; i < numWindows && !hashes.empty(); ++i) {
+        const auto windowEnd = hashes.begin() + std::min(hashes.size(), i + w);
+        positions.insert(
+            std::distance(hashes.begin(), std::min_element(hashes.begin() + i, windowEnd)));
+    }
+    return {positions.begin(), positions.end()};
+}
+
+}  // namespace MinimizerIndexTests
+
+TEST(QGram_MinimizerIndex, throws_on_invalid_parameters)
+{
+    using PacBio::QGram::MinimizerIndex;
+    EXPECT_THROW(MinimizerIndex(0, 5, "ACGTACGT"), std::invalid_argument);
+    EXPECT_THROW(MinimizerIndex(33, 5, "ACGTACGT"), std::invalid_argument);
+    EXPECT_THROW(MinimizerIndex(4, 0, "ACGTACGT"), std::invalid_argument);
+    EXPECT_NO_THROW(MinimizerIndex(32, 5, "ACGTACGT"));
+}
+
+TEST(QGram_MinimizerIndex, minimizers_match_brute_force)
+{
+    std::mt19937 rng{17};
+    const std::string seq = PacBio::PbcopperTests::RandomSequence(2000, rng);
+    for (const std::size_t k : {1, 5, 15, 19, 32}) {
+        for (const std::size_t w : {1, 2, 10, 50}) {
+            std::vector<std::uint64_t> positions;
+            for (const auto& m : PacBio::QGram::internal::Minimizers(k, w, seq)) {
+                positions.push_back(m.position);
+            }
+            EXPECT_EQ(MinimizerIndexTests::NaiveMinimizerPositions(k, w, seq), positions)
+                << "k=" << k << " w=" << w;
+        }
+    }
+
+    // fewer k-mers than a window yields a single minimizer
+    EXPECT_EQ(1, PacBio::QGram::internal::Minimizers(5, 10, "ACGTACGT").size());
+    EXPECT_TRUE(PacBio::QGram::internal::Minimizers(5, 10, "ACG").empty());
+}
+
+TEST(QGram_MinimizerIndex, samples_reference_positions)
+{
+    std::mt19937 rng{3};
+    const std::string seq = PacBio::PbcopperTests::RandomSequence(100'000, rng);
+    const PacBio::QGram::MinimizerIndex index{15, 10, seq};
+
+    EXPECT_EQ(15, index.Size());
+    EXPECT_EQ(10, index.WindowSize());
+
+    // expected density is 2/(w+1)
+    EXPECT_GT(index.NumHits(), seq.size() / 10);
+    EXPECT_LT(index.NumHits(), seq.size() / 3);
+}
+
+TEST(QGram_MinimizerIndex, finds_query_substring)
+{
+    std::mt19937 rng{5};
+    const std::string ref = PacBio::PbcopperTests::RandomSequence(50'000, rng);
+    const PacBio::QGram::MinimizerIndex index{19, 10, ref};
+
+    const std::size_t offset = 12'345;
+    const std::string query = ref.substr(offset, 500);
+    const auto hits = index.Hits(query);
+    ASSERT_FALSE(hits.empty());
+
+    std::size_t onDiagonal = 0;
+    for (const auto& queryHits : hits) {
+        for (const auto& hit : queryHits) {
+            EXPECT_EQ(0, hit.Id());
+            if (hit.Position() == offset + queryHits.QueryPosition()) {
+                ++onDiagonal;
+            }
+        }
+    }
+    EXPECT_EQ(hits.size(), onDiagonal);
+}
+
+TEST(QGram_MinimizerIndex, multiple_sequences_report_sequence_ids)
+{
+    std::mt19937 rng{7};
+    const std::string a = PacBio::PbcopperTests::RandomSequence(1000, rng);
+    const std::string b = PacBio::PbcopperTests::RandomSequence(1000, rng);
+    const PacBio::QGram::MinimizerIndex index{11, 5, std::vector<std::string>{a, "AC", b}};
+
+    std::set<std::uint32_t> ids;
+    for (const auto& queryHits : index.Hits(b.substr(100, 200))) {
+        for (const auto& hit : queryHits) {
+            ids.insert(hit.Id());
+        }
+    }
+    EXPECT_EQ(std::set<std::uint32_t>{2}, ids);
+}
+
+TEST(QGram_MinimizerIndex, occurrence_cap_masks_repeats)
+{
+    std::mt19937 rng{9};
+    const std::string unit = PacBio::PbcopperTests::RandomSequence(100, rng);
+    std::string seq;
+    for (int i = 0; i < 10; ++i) {
+        seq += unit;
+    }
+    seq += PacBio::PbcopperTests::RandomSequence(1000, rng);
+
+    const PacBio::QGram::MinimizerIndex unmasked{15, 5, seq};
+    const PacBio::QGram::MinimizerIndex masked{15, 5, seq, 5};
+    EXPECT_LT(masked.NumHits(), unmasked.NumHits());
+
+    for (const auto& queryHits : masked.Hits(unit)) {
+        EXPECT_LE(queryHits.size(), 5);
+    }
+    for (const auto& queryHits : masked.Hits(seq)) {
+        EXPECT_LE(queryHits.size(), 5);
+    }
+}
+
+TEST(QGram_MinimizerIndex, homopolymer_filter)
+{
+    std::mt19937 rng{11};
+    const std::string seq = PacBio::PbcopperTests::RandomSequence(500, rng) + std::string(50, 'A');
+    const PacBio::QGram::MinimizerIndex index{8, 4, seq};
+
+    const std::string query(30, 'A');
+    EXPECT_FALSE(index.Hits(query).empty());
+    EXPECT_TRUE(index.Hits(query, true).empty());
+}
+
+TEST(QGram_MinimizerIndex, can_find_and_chain_seeds)
+{
+    std::mt19937 rng{13};
+    const std::string ref = PacBio::PbcopperTests::RandomSequence(20'000, rng);
+    const std::string other = PacBio::PbcopperTests::RandomSequence(5'000, rng);
+    const PacBio::QGram::MinimizerIndex index{15, 5, std::vector<std::string>{other, ref}};
+
+    const std::size_t offset = 8'000;
+    const std::string query = ref.substr(offset, 1'000);
+
+    const auto seeds = PacBio::Align::FindSeeds(index, query);
+    ASSERT_EQ(1, seeds.size());
+    EXPECT_EQ(1, seeds.cbegin()->first);
+    for (const auto& seed : seeds.cbegin()->second) {
+        EXPECT_EQ(15, seed.Size());
+        EXPECT_EQ(seed.BeginPositionH() + offset, seed.BeginPositionV());
+    }
+
+    const auto chain = PacBio::Align::SparseAlignSeeds(index, 1, query);
+    ASSERT_FALSE(chain.empty());
+    for (const auto& seed : chain) {
+        EXPECT_EQ(seed.BeginPositionH() + offset, seed.BeginPositionV());
+    }
+    EXPECT_TRUE(PacBio::Align::SparseAlignSeeds(index, 0, query).empty());
+}
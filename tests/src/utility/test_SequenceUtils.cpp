@@ -0,0 +1,195 @@
+#include <pbcopper/utility/SequenceUtils.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "RandomSequences.h"
+
+using namespace PacBio;
+
+namespace SequenceUtilsTests {
+
+// scalar reference: message of the exception thrown, if any
+std::optional<std::string> ScalarReverseComplement(std::string& seq)
+{
+    try {
+        std::transform(seq.begin(), seq.end(), seq.begin(), Utility::Complement);
+        Utility::Reverse(seq);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> SimdReverseComplement(std::string& seq)
+{
+    try {
+        Utility::ReverseComplement(seq);
+    } catch (const std::invalid_argument& e) {
+        return e.what();
+    }
+    return std::nullopt;
+}
+
+}  // namespace SequenceUtilsTests
+
+TEST(Utility_SequenceUtils, reverse_complement_matches_scalar_for_every_character)
+{
+    std::mt19937 rng{42};
+    for (int c = 0; c < 256; ++c) {
+        for (const std::size_t length : {1, 16, 17, 33, 64, 70, 127, 200}) {
+            SCOPED_TRACE(std::to_string(c) + " @ length " + std::to_string(length));
+            std::string seq = PbcopperTests::RandomSequence(length, rng, "ACGTacgtNn-");
+            seq[rng() % length] = static_cast<char>(c);
+            std::string expected = seq;
+
+            const auto expectedError = SequenceUtilsTests::ScalarReverseComplement(expected);
+            const auto error = SequenceUtilsTests::SimdReverseComplement(seq);
+            EXPECT_EQ(expectedError, error);
+            if (!expectedError) {
+                EXPECT_EQ(expected, seq);
+            }
+        }
+    }
+}
+
+TEST(Utility_SequenceUtils, reverse_complement_reports_first_invalid_base)
+{
+    std::mt19937 rng{7};
+    std::string seq = PbcopperTests::RandomSequence(100, rng, "ACGTacgtNn-");
+    seq[90] = 'X';
+    seq[10] = '!';
+    EXPECT_THROW(
+        {
+            try {
+                Utility::ReverseComplement(seq);
+            } catch (const std::invalid_argument& e) {
+                EXPECT_EQ("! is an invalid base!", std::string{e.what()});
+                throw;
+            }
+        },
+        std::invalid_argument);
+}
+
+TEST(Utility_SequenceUtils, reverse_complement_into_buffer)
+{
+    std::mt19937 rng{1};
+    for (const std::size_t length : {0, 5, 16, 31, 100}) {
+        const std::string seq = PbcopperTests::RandomSequence(length, rng, "ACGTacgtNn-");
+        std::string output(length, ' ');
+        EXPECT_EQ(Utility::ReverseComplemented(seq),
+                  Utility::ReverseComplement(seq, output.data()));
+    }
+
+    std::string output(40, ' ');
+    EXPECT_THROW(Utility::ReverseComplement(std::string(39, 'A') + "Z", output.data()),
+                 std::invalid_argument);
+}
+
+TEST(Utility_SequenceUtils, reverse_complement_with_qualities)
+{
+    std::mt19937 rng{3};
+    for (const std::size_t length : {0, 1, 31, 32, 33, 100, 200}) {
+        SCOPED_TRACE(length);
+        std::string seq = PbcopperTests::RandomSequence(length, rng, "ACGTacgtNn-");
+        std::vector<std::uint8_t> quals(length);
+        for (auto& q : quals) {
+            q = rng() % 94;
+        }
+
+        const std::string expectedSeq = Utility::ReverseComplemented(seq);
+        const std::vector<std::uint8_t> expectedQuals = Utility::Reversed(quals);
+        Utility::ReverseComplement(seq, quals);
+        EXPECT_EQ(expectedSeq, seq);
+        EXPECT_EQ(expectedQuals, quals);
+    }
+
+    std::string seq{"ACGT"};
+    std::vector<std::uint8_t> noQuals;
+    Utility::ReverseComplement(seq, noQuals);
+    EXPECT_EQ("ACGT", seq);
+
+    std::vector<std::uint8_t> tooFew(3);
+    EXPECT_THROW(Utility::ReverseComplement(seq, tooFew), std::invalid_argument);
+}
+
+TEST(Utility_SequenceUtils, case_sensitive_reverse_complement)
+{
+    std::string seq{"ACGTNacgtn U*- Zu"};
+    Utility::ReverseComplementCaseSens(seq);
+    EXPECT_EQ(std::string{"a\x04 -*A \x04"
+                          "acgtNACGT"},
+              seq);
+
+    std::string longSeq = std::string(40, 'a') + std::string(40, 'C');
+    Utility::ReverseComplementCaseSens(longSeq);
+    EXPECT_EQ(std::string(40, 'G') + std::string(40, 't'), longSeq);
+}
+
+TEST(Utility_SequenceUtils, to_upper_and_find_invalid_base)
+{
+    std::string seq{"acgtNnxyz-*ACGT0123456789abcdefghijklmnopqrstuvwxyz\xe0"};
+    Utility::ToUpper(seq);
+    EXPECT_EQ("ACGTNNXYZ-*ACGT0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ\xe0", seq);
+
+    EXPECT_EQ(std::string_view::npos, Utility::FindInvalidBase(""));
+    EXPECT_EQ(std::string_view::npos,
+              Utility::FindInvalidBase("ACGTURYSWKMBDHVN-*acgturyswkmbdhvn"));
+    EXPECT_EQ(std::size_t{6}, Utility::FindInvalidBase("ACGTNN!ACGT"));
+    EXPECT_EQ(std::size_t{40}, Utility::FindInvalidBase(std::string(40, 'g') + "e" + "AX"));
+}
+
+TEST(Utility_SequenceUtils, two_bit_packing)
+{
+    std::vector<std::uint8_t> packed(2);
+    Utility::PackTwoBit("ACGTtg", packed);
+    EXPECT_EQ((std::vector<std::uint8_t>{0b00'01'10'11, 0b11'10'00'00}), packed);
+
+    std::mt19937 rng{5};
+    for (const std::size_t length : {0, 1, 4, 15, 16, 17, 64, 101}) {
+        SCOPED_TRACE(length);
+        std::string seq = PbcopperTests::RandomSequence(length, rng, "ACGTacgt");
+        packed.assign((length + 3) / 4, 0);
+        Utility::PackTwoBit(seq, packed);
+
+        std::string unpacked(length, ' ');
+        Utility::UnpackTwoBit(packed, unpacked);
+        Utility::ToUpper(seq);
+        EXPECT_EQ(seq, unpacked);
+    }
+
+    packed.assign(5, 0);
+    EXPECT_THROW(Utility::PackTwoBit(std::string(19, 'A') + "N", packed), std::invalid_argument);
+    EXPECT_THROW(Utility::PackTwoBit("ACGT", packed), std::invalid_argument);
+}
+
+TEST(Utility_SequenceUtils, four_bit_packing)
+{
+    std::vector<std::uint8_t> packed(3);
+    Utility::PackFourBit("ACGTn", packed);
+    EXPECT_EQ((std::vector<std::uint8_t>{0x12, 0x48, 0xF0}), packed);
+
+    const std::string codes{"=ACMGRSVTWYHKDBN"};
+    std::mt19937 rng{9};
+    for (const std::size_t length : {0, 1, 2, 15, 16, 17, 64, 101}) {
+        SCOPED_TRACE(length);
+        const std::string seq = PbcopperTests::RandomSequence(length, rng, codes);
+        packed.assign((length + 1) / 2, 0);
+        Utility::PackFourBit(seq, packed);
+
+        std::string unpacked(length, ' ');
+        Utility::UnpackFourBit(packed, unpacked);
+        EXPECT_EQ(seq, unpacked);
+    }
+
+    packed.assign(10, 0);
+    EXPECT_THROW(Utility::PackFourBit(std::string(19, 'A') + "-", packed), std::invalid_argument);
+}